@@ -1187,7 +1187,7 @@ ExportReport::draw_waveform (Cairo::RefPtr<Cairo::ImageSurface>& wave, ExportAna
 	}
 	cr->stroke ();
 
-	// >= -1dBTP (coeff >= .89125, libs/vamp-plugins/TruePeak.cpp)
+	// >= -1dBTP (coeff >= .89125, libs/audiographer/src/general/analyser.cc)
 	cr->set_source_rgba (1.0, 0.7, 0, 0.7);
 	for (std::set<samplepos_t>::const_iterator i = p->truepeakpos[c].begin (); i != p->truepeakpos[c].end (); ++i) {
 		cr->move_to (m_l + (*i) - .5, clip_top);
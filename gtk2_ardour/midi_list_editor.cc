@@ -148,8 +148,8 @@ MidiListEditor::MidiListEditor (Session* s, boost::shared_ptr<MidiRegion> r, boo
 
 	redisplay_model ();
 
-	region->midi_source(0)->model()->ContentsChanged.connect (content_connections, invalidator (*this),
-	                                                          boost::bind (&MidiListEditor::redisplay_model, this), gui_context());
+	region->model()->ContentsChanged.connect (content_connections, invalidator (*this),
+	                                          boost::bind (&MidiListEditor::redisplay_model, this), gui_context());
 	region->RegionPropertyChanged.connect (content_connections, invalidator (*this),
 	                                       boost::bind (&MidiListEditor::redisplay_model, this), gui_context());
 
@@ -764,7 +764,7 @@ MidiListEditor::redisplay_model ()
 	if (_session) {
 
 		BeatsSamplesConverter conv (_session->tempo_map(), region->position());
-		boost::shared_ptr<MidiModel> m (region->midi_source(0)->model());
+		boost::shared_ptr<MidiModel> m (region->model());
 		TreeModel::Row row;
 		stringstream ss;
 
@@ -193,8 +193,7 @@ MidiStreamView::display_region(MidiRegionView* region_view, bool load_model)
 	}
 
 	if (load_model) {
-		Glib::Threads::Mutex::Lock lm(source->mutex());
-		source->load_model(lm);
+		source->ensure_model();
 	}
 
 	if (!source->model()) {
@@ -226,11 +225,10 @@ MidiStreamView::update_contents_metrics(boost::shared_ptr<Region> r)
 {
 	boost::shared_ptr<MidiRegion> mr = boost::dynamic_pointer_cast<MidiRegion>(r);
 	if (mr) {
-		Glib::Threads::Mutex::Lock lm(mr->midi_source(0)->mutex());
-		mr->midi_source(0)->load_model(lm);
+		boost::shared_ptr<MidiModel> model = mr->midi_source(0)->ensure_model();
 		_range_dirty = update_data_note_range(
-			mr->model()->lowest_note(),
-			mr->model()->highest_note());
+			model->lowest_note(),
+			model->highest_note());
 	}
 }
 
@@ -34,6 +34,7 @@ PluginLoadStatsGui::PluginLoadStatsGui (boost::shared_ptr<ARDOUR::PluginInsert>
 	, _lbl_max ("", ALIGN_RIGHT, ALIGN_CENTER)
 	, _lbl_avg ("", ALIGN_RIGHT, ALIGN_CENTER)
 	, _lbl_dev ("", ALIGN_RIGHT, ALIGN_CENTER)
+	, _lbl_slp ("", ALIGN_RIGHT, ALIGN_CENTER)
 	, _reset_button (_("Reset"))
 	, _valid (false)
 {
@@ -51,16 +52,19 @@ PluginLoadStatsGui::PluginLoadStatsGui (boost::shared_ptr<ARDOUR::PluginInsert>
 			0, 1, 2, 3, Gtk::FILL, Gtk::SHRINK, 2, 0);
 	attach (*manage (new Gtk::Label (_("Std.Dev"), ALIGN_RIGHT, ALIGN_CENTER)),
 			0, 1, 3, 4, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	attach (*manage (new Gtk::Label (_("Asleep"), ALIGN_RIGHT, ALIGN_CENTER)),
+			0, 1, 4, 5, Gtk::FILL, Gtk::SHRINK, 2, 0);
 
 	attach (_lbl_min, 1, 2, 0, 1, Gtk::FILL, Gtk::SHRINK, 2, 0);
 	attach (_lbl_max, 1, 2, 1, 2, Gtk::FILL, Gtk::SHRINK, 2, 0);
 	attach (_lbl_avg, 1, 2, 2, 3, Gtk::FILL, Gtk::SHRINK, 2, 0);
 	attach (_lbl_dev, 1, 2, 3, 4, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	attach (_lbl_slp, 1, 2, 4, 5, Gtk::FILL, Gtk::SHRINK, 2, 0);
 
 	attach (*manage (new Gtk::VSeparator ()),
-			2, 3, 0, 4, Gtk::FILL, Gtk::FILL, 4, 0);
+			2, 3, 0, 5, Gtk::FILL, Gtk::FILL, 4, 0);
 
-	attach (_darea, 3, 4, 0, 4, Gtk::FILL|Gtk::EXPAND, Gtk::FILL, 4, 4);
+	attach (_darea, 3, 4, 0, 5, Gtk::FILL|Gtk::EXPAND, Gtk::FILL, 4, 4);
 
 	attach (_reset_button, 4, 5, 2, 4, Gtk::FILL, Gtk::SHRINK);
 }
@@ -87,7 +91,6 @@ PluginLoadStatsGui::update_cpu_label()
 		_lbl_max.set_text (string_compose (_("%1 [ms]"), rint (_max / 10.) / 100.));
 		_lbl_avg.set_text (string_compose (_("%1 [ms]"), rint (_avg) / 1000.));
 		_lbl_dev.set_text (string_compose (_("%1 [ms]"), rint (_dev) / 1000.));
-		_lbl_dev.set_text (string_compose (_("%1 [ms]"), rint (_dev) / 1000.));
 	} else {
 		_valid = false;
 		_lbl_min.set_text ("-");
@@ -95,6 +98,16 @@ PluginLoadStatsGui::update_cpu_label()
 		_lbl_avg.set_text ("-");
 		_lbl_dev.set_text ("-");
 	}
+
+	/* plugins that sleep on silent input save their average load
+	 * for every cycle that they skip.
+	 */
+	const double ratio = _insert->sleep_ratio ();
+	if (_valid && ratio > 0) {
+		_lbl_slp.set_text (string_compose (_("%1%% (saved %2 [ms])"), rint (100 * ratio), rint (ratio * _avg) / 1000.));
+	} else {
+		_lbl_slp.set_text ("-");
+	}
 	_darea.queue_draw ();
 }
 
@@ -2318,6 +2318,16 @@ RCOptionEditor::RCOptionEditor ()
 		procs->set_note (string_compose (_("This setting will only take effect when %1 is restarted."), PROGRAM_NAME));
 
 		add_option (_("General"), procs);
+
+		bo = new BoolOption (
+				"use-convolution-pool",
+				_("Share convolution threads (experimental)"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_use_convolution_pool),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_use_convolution_pool)
+				);
+		Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+				_("<b>When enabled</b> the long partitions of all convolvers are processed by one set of worker threads, instead of dedicated threads for every convolver. This reduces the number of threads of sessions with many convolvers, but may cause more x-runs.\n\nThis setting applies to convolvers that are added afterwards."));
+		add_option (_("General"), bo);
 	}
 
 	/* Image cache size */
@@ -2985,6 +2995,45 @@ RCOptionEditor::RCOptionEditor ()
 
 	add_option (_("Audio"), new BufferingOptions (_rc_config));
 
+	{
+		SpinOption<uint32_t>* so = new SpinOption<uint32_t> (
+			"playlist-render-cache-regions",
+			_("Render playlists with at least this many regions"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_playlist_render_cache_regions),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_playlist_render_cache_regions),
+			0, 10000, 1, 10
+			);
+		Gtkmm2ext::UI::instance()->set_tip (so->tip_widget(),
+				_("Playlists with many regions and crossfades are flattened into a file in the background, which is played back instead of the regions. Edited ranges are played from the regions until they have been rendered again. Zero disables this."));
+		add_option (_("Audio"), so);
+	}
+
+	{
+		SpinOption<float>* so = new SpinOption<float> (
+			"cue-buffer-seconds",
+			_("Keep audio at markers in memory"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_cue_buffer_seconds),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_cue_buffer_seconds),
+			0, 10, .5, 1, _("sec"), 1, 1
+			);
+		Gtkmm2ext::UI::instance()->set_tip (so->tip_widget(),
+				_("The first seconds after the loop start, the playhead return position and markers close to the playhead are kept in memory for every track, so that playback can resume immediately after locating there. This uses this many seconds of memory per track, channel and position. Zero disables this."));
+		add_option (_("Audio"), so);
+	}
+
+	{
+		SpinOption<uint32_t>* so = new SpinOption<uint32_t> (
+			"decoded-audio-cache-size",
+			_("Decoded audio cache size"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_decoded_audio_cache_size),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_decoded_audio_cache_size),
+			0, 16384, 16, 256, _("MB")
+			);
+		Gtkmm2ext::UI::instance()->set_tip (so->tip_widget(),
+				_("Audio of compressed (FLAC, Ogg, MP3) and multi-channel files is decoded once, and shared by all regions, the auditioner and analysis. Zero disables this."));
+		add_option (_("Audio"), so);
+	}
+
 	add_option (_("Audio"), new OptionEditorHeading (_("Denormals")));
 
 	add_option (_("Audio"),
@@ -3067,6 +3116,16 @@ RCOptionEditor::RCOptionEditor ()
 		     -1, 65536, 1, 10
 		     ));
 
+	bo = new BoolOption (
+		     "lazy-midi-models",
+		     _("Load MIDI data on demand"),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::get_lazy_midi_models),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::set_lazy_midi_models)
+		     );
+	add_option (_("MIDI"), bo);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+			_("<b>When enabled</b>, MIDI files are played directly from disk when a session is loaded, and the data is only loaded into memory when a region is displayed or edited. This reduces memory use and session load time of sessions with many MIDI sources."));
+
 	add_option (_("MIDI"), new OptionEditorHeading (_("Audition")));
 
 	add_option (_("MIDI"),
@@ -3579,6 +3638,37 @@ RCOptionEditor::RCOptionEditor ()
 	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
 					    _("<b>When enabled</b> plugins will be reset at transport stop. When disabled plugins will be left unchanged at transport stop.\n\nThis mostly affects plugins with a \"tail\" like Reverbs."));
 
+	bo = new BoolOption (
+		"plugin-sleep-on-silence",
+		_("Sleep plugins on silent input"),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::get_plugin_sleep_on_silence),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::set_plugin_sleep_on_silence)
+		);
+	add_option (_("Plugins"), bo);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+					    _("<b>When enabled</b> plugins are not processed while their input is silent, once the plugin's output has been silent for longer than its tail. Processing resumes when signal returns, on parameter changes and on transport changes. Instruments and generators are always processed.\n\nThis reduces DSP load of large sessions with many silent tracks. The DSP load saved is shown in the plugin DSP load window."));
+
+	SpinOption<float>* sof = new SpinOption<float> (
+		"plugin-default-tail",
+		_("Tail of plugins that do not report one"),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::get_plugin_default_tail),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::set_plugin_default_tail),
+		0, 30, .5, 1, _("sec"), 1, 1
+		);
+	add_option (_("Plugins"), sof);
+	Gtkmm2ext::UI::instance()->set_tip (sof->tip_widget(),
+					    _("Only few plugin standards allow a plugin to report how long its output continues after the input became silent (e.g. reverb or delay). For all other plugins this duration is used before they go to sleep."));
+
+	bo = new BoolOption (
+		"sample-accurate-plugin-automation",
+		_("Sample-accurate plugin automation"),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::get_sample_accurate_plugin_automation),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::set_sample_accurate_plugin_automation)
+		);
+	add_option (_("Plugins"), bo);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+					    _("<b>When enabled</b> automation events are passed to VST3 plugins with their exact position, and the plugin is processed once per cycle. When disabled the process cycle is split at automation events instead.\n\nOnly VST3 plugins support this. Other plugins are always processed in sub-blocks between automation events. LV2 plugins with MIDI input are not split and receive automation once per cycle. Automated LV2 properties (e.g. sample file names or parameters that are not control ports) are never sample-accurate: their values reach the plugin at the end of each sub-block."));
+
 	bo = new BoolOption (
 		"new-plugins-active",
 			_("Make new plugins active"),
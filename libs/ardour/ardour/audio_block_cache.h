@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __ardour_audio_block_cache_h__
+#define __ardour_audio_block_cache_h__
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <glibmm/threads.h>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+class AudioSource;
+
+/** Process-wide cache of decoded audio.
+ *
+ * Files are decoded in blocks of all channels at a time, and kept
+ * de-interleaved, keyed by (file, channel, block). All sources, regions
+ * and readers of the same file share the cache, so compressed or
+ * interleaved files are only decoded once.
+ *
+ * The total size is bounded by RCConfiguration::decoded_audio_cache_size,
+ * the least recently used blocks are dropped first.
+ *
+ * A background thread decodes the blocks following a read, so that
+ * sequential reads of compressed files after a locate hit the cache.
+ * The source's lock is only taken while reading each block from the
+ * file, never while queueing or de-interleaving.
+ */
+class LIBARDOUR_API AudioBlockCache
+{
+public:
+	/** Decode interleaved audio of all channels.
+	 * (Sample* dst, samplepos_t start, samplecnt_t cnt) -> samples per channel
+	 */
+	typedef boost::function<samplecnt_t (Sample*, samplepos_t, samplecnt_t)> DecodeFunction;
+
+	/** samples per channel and block */
+	static const samplecnt_t block_size = 32768;
+
+	/** blocks decoded ahead of the most recent read */
+	static const int read_ahead_blocks = 4;
+
+	/** Read channel \a chn of file \a path. Blocks that are not cached
+	 * are decoded using \a decode and added to the cache.
+	 * @return number of samples read, less than \a cnt at the end of the file
+	 */
+	static samplecnt_t read (std::string const& path, Sample* dst, samplepos_t start, samplecnt_t cnt,
+	                         uint32_t chn, uint32_t n_chn, DecodeFunction const& decode);
+
+	/** Queue decoding the blocks following \a pos in the background.
+	 * The blocks are decoded using \a decode with the lock of \a src held,
+	 * \a src must be kept alive by a shared_ptr. This must not be called
+	 * with the source's lock held.
+	 */
+	static void read_ahead (AudioSource const& src, std::string const& path, uint32_t chn, uint32_t n_chn,
+	                        samplepos_t pos, DecodeFunction const& decode);
+
+	/** true if the cache is enabled */
+	static bool enabled ();
+
+	/** remove all blocks of channel \a chn of the given file.
+	 * Other channels may still be used by their sources.
+	 */
+	static void drop (std::string const& path, uint32_t chn);
+	static void clear ();
+
+	/** total size of cached audio data in bytes */
+	static size_t size ();
+
+	static void init ();
+	/** discard queued read-ahead, wait for the current one to finish
+	 * and reject new requests until resume() is called.
+	 */
+	static void flush ();
+	static void resume ();
+	static void work ();
+
+private:
+	typedef boost::shared_ptr<std::vector<Sample> > Block;
+
+	struct Key {
+		Key (std::string const& p, uint32_t c, samplepos_t b) : path (p), chn (c), block (b) {}
+		bool operator< (Key const& other) const;
+
+		std::string path;
+		uint32_t    chn;
+		samplepos_t block;
+	};
+
+	typedef std::list<Key> LRU;
+
+	struct Entry {
+		Block         data;
+		LRU::iterator lru;
+	};
+
+	typedef std::map<Key, Entry> Blocks;
+
+	struct ReadAhead {
+		ReadAhead (boost::shared_ptr<AudioSource> s, std::string const& p, uint32_t c, uint32_t nc, samplepos_t b, DecodeFunction const& d)
+			: src (s), path (p), chn (c), n_chn (nc), block (b), decode (d) {}
+
+		boost::weak_ptr<AudioSource> src; // keeps the source of \a decode alive while locked
+		std::string    path;
+		uint32_t       chn;
+		uint32_t       n_chn;
+		samplepos_t    block;
+		DecodeFunction decode;
+	};
+
+	static Block lookup (Key const&);
+	static bool  contains (Key const&);
+	static Block insert (std::string const& path, uint32_t n_chn, samplepos_t block, uint32_t chn, Sample const* interleaved, samplecnt_t n_samples);
+	static void  evict (size_t max_size);
+
+	static Glib::Threads::Mutex _lock;
+	static Blocks               _blocks;
+	static LRU                  _lru; // least recently used first
+	static size_t               _size;
+
+	static Glib::Threads::Mutex   _read_ahead_lock;
+	static Glib::Threads::Mutex   _read_ahead_active_lock;
+	static Glib::Threads::Cond    _read_ahead_cond;
+	static std::list<ReadAhead>   _read_ahead_queue;
+	static Glib::Threads::Thread* _read_ahead_thread;
+	static bool                   _read_ahead_closing; // protected by _read_ahead_lock
+};
+
+} /* namespace ARDOUR */
+
+#endif /* __ardour_audio_block_cache_h__ */
@@ -162,6 +162,7 @@ class LIBARDOUR_API AUPlugin : public ARDOUR::Plugin
 
   private:
 	samplecnt_t plugin_latency() const;
+	samplecnt_t plugin_tailtime () const;
 	void find_presets ();
 
 	boost::shared_ptr<CAComponent> comp;
@@ -25,6 +25,8 @@
 #include <vector>
 #include <list>
 
+#include <boost/scoped_ptr.hpp>
+
 #include "ardour/ardour.h"
 #include "ardour/playlist.h"
 
@@ -34,6 +36,7 @@ class Session;
 class AudioRegion;
 class Source;
 class AudioPlaylist;
+class PlaylistRenderCache;
 
 class LIBARDOUR_API AudioPlaylist : public ARDOUR::Playlist
 {
@@ -42,9 +45,12 @@ public:
 	AudioPlaylist (Session&, std::string name, bool hidden = false);
 	AudioPlaylist (boost::shared_ptr<const AudioPlaylist>, std::string name, bool hidden = false);
 	AudioPlaylist (boost::shared_ptr<const AudioPlaylist>, samplepos_t start, samplecnt_t cnt, std::string name, bool hidden = false);
+	~AudioPlaylist ();
 
 	samplecnt_t read (Sample *dst, Sample *mixdown, float *gain_buffer, samplepos_t start, samplecnt_t cnt, uint32_t chan_n=0);
 
+	PlaylistRenderCache& render_cache () { return *_render_cache; }
+
 	bool destroy_region (boost::shared_ptr<Region>);
 
 protected:
@@ -59,6 +65,10 @@ private:
 	bool region_changed (const PBD::PropertyChange&, boost::shared_ptr<Region>);
 	void source_offset_changed (boost::shared_ptr<AudioRegion>);
         void load_legacy_crossfades (const XMLNode&, int version);
+
+	void region_added_or_removed (boost::weak_ptr<Region>);
+
+	boost::scoped_ptr<PlaylistRenderCache> _render_cache;
 };
 
 } /* namespace ARDOUR */
@@ -95,6 +95,7 @@ private:
 	void config_changed (std::string);
 
 	bool flush_tracks_to_disk_normal (boost::shared_ptr<RouteList>, uint32_t& errors);
+	bool refill_cues (boost::shared_ptr<RouteList>);
 
 	/**
 	 * Add request to butler thread request queue
@@ -20,8 +20,13 @@
 
 #include <vector>
 
+#include <glibmm/threads.h>
+
 #include "zita-convolver/zita-convolver.h"
 
+#include "pbd/mpmc_queue.h"
+#include "pbd/semutils.h"
+
 #include "ardour/libardour_visibility.h"
 
 #include "ardour/buffer_set.h"
@@ -30,11 +35,66 @@
 
 namespace ARDOUR { namespace DSP {
 
+/** Thread pool shared by all Convolution instances, if
+ * RCConfiguration::use_convolution_pool is set.
+ *
+ * The shortest partitions of a convolver are processed in the caller's
+ * thread, the longer (late) partitions are queued here and run
+ * concurrently by worker threads, instead of using dedicated threads for
+ * each partition size of every convolver.
+ *
+ * As with zita-convolver's own threads, each partition size has its own
+ * workers, whose priority decreases with the partition size. A worker
+ * busy with a long partition is preempted when a shorter one is due.
+ */
+class LIBARDOUR_API ConvolutionPool : public ArdourZita::Convsched
+{
+public:
+	ConvolutionPool (uint32_t n_threads, bool realtime, int priority);
+	~ConvolutionPool ();
+
+	bool schedule (ArdourZita::Convlevel*, int prio);
+
+	uint32_t n_threads () const;
+
+	/** get the shared pool, create it if needed */
+	static ConvolutionPool* acquire ();
+	static void release ();
+
+private:
+	struct Level {
+		Level (ConvolutionPool* p);
+
+		ConvolutionPool*                       pool;
+		PBD::MPMCQueue<ArdourZita::Convlevel*> queue;
+		PBD::Semaphore                         sem;
+		std::vector<pthread_t>                 threads;
+	};
+
+	static void* _thread_run (void*);
+	void run (Level*);
+
+	enum {
+		/* late partitions are 2 .. 64 times the cycle-size,
+		 * see Convolution::restart()
+		 */
+		n_levels   = 6,
+		queue_size = 256
+	};
+
+	Level* _levels[n_levels];
+	gint   _run;
+
+	static ConvolutionPool*     _instance;
+	static uint32_t             _instance_refs;
+	static Glib::Threads::Mutex _instance_lock;
+};
+
 class LIBARDOUR_API Convolution : public SessionHandleRef
 {
 public:
 	Convolution (Session&, uint32_t n_in, uint32_t n_out);
-	virtual ~Convolution () {}
+	virtual ~Convolution ();
 
 	bool add_impdata (
 	    uint32_t                    c_in,
@@ -56,6 +116,7 @@ public:
 
 protected:
 	ArdourZita::Convproc _convproc;
+	ConvolutionPool*     _pool;
 
 	uint32_t _n_samples;
 	uint32_t _max_size;
@@ -174,7 +174,7 @@ protected:
 	};
 
 	typedef std::vector<ChannelInfo*> ChannelList;
-	SerializedRCUManager<ChannelList> channels;
+	EpochRCUManager<ChannelList> channels;
 
 	virtual int add_channel_to (boost::shared_ptr<ChannelList>, uint32_t how_many) = 0;
 	int remove_channel_from (boost::shared_ptr<ChannelList>, uint32_t how_many);
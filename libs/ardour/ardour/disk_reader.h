@@ -20,7 +20,11 @@
 #ifndef _ardour_disk_reader_h_
 #define _ardour_disk_reader_h_
 
+#include <list>
+#include <vector>
+
 #include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include "evoral/Curve.h"
 
@@ -82,6 +86,12 @@ public:
 	/** For contexts outside the normal butler refill loop (allocates temporary working buffers) */
 	int do_refill_with_alloc (bool partial_fill, bool reverse);
 
+	/** Called by the Butler when there is no other disk I/O to do.
+	 * Reads audio at the cue positions, see set_cue_positions().
+	 * @return 1 if there is more work to do.
+	 */
+	int refill_cues ();
+
 	bool pending_overwrite () const;
 
 	/* Working buffers for do_refill (butler thread) */
@@ -117,6 +127,12 @@ public:
 	static void reset_loop_declick (Location*, samplecnt_t sample_rate);
 	static void alloc_loop_declick (samplecnt_t sample_rate);
 
+	/** Set positions that are likely locate targets (markers, loop-start).
+	 * Every DiskReader keeps audio after these positions in memory, so
+	 * that a seek there does not have to read from disk.
+	 */
+	static void set_cue_positions (std::vector<samplepos_t> const&);
+
 protected:
 	friend class Track;
 	friend class MidiTrack;
@@ -244,6 +260,38 @@ private:
 
 	samplepos_t last_refill_loop_start;
 	void setup_preloop_buffer ();
+	void setup_render_cache ();
+
+	struct CueBuffer {
+		CueBuffer (samplepos_t p);
+		~CueBuffer ();
+
+		void reset (uint32_t n_chans, samplecnt_t size, samplecnt_t shift, Location*);
+		bool matches (uint32_t n_chans, samplecnt_t shift, Location*) const;
+
+		samplepos_t position;   ///< locate target
+		samplecnt_t shift;      ///< data starts at position - shift
+		samplecnt_t size;       ///< allocated samples per channel
+		samplecnt_t length;     ///< valid samples per channel
+		samplepos_t read_pos;   ///< file position after length samples
+		samplepos_t loop_start; ///< loop-range used to read the data, if any
+		samplepos_t loop_end;
+		LoopFadeChoice         loop_fade;
+		std::vector<Sample*>   data;
+	};
+
+	typedef std::list<boost::shared_ptr<CueBuffer> > CueList;
+
+	Glib::Threads::Mutex _cue_lock;
+	CueList              _cues;
+	gint                 _cue_generation;
+	gint                 _cues_invalid;
+
+	bool refill_from_cue (samplepos_t sample, samplecnt_t shift);
+
+	static Glib::Threads::Mutex     _cue_position_lock;
+	static std::vector<samplepos_t> _cue_positions;
+	static gint                     _cue_position_generation;
 };
 
 } // namespace ARDOUR
@@ -19,15 +19,14 @@
 #ifndef __ardour_ebur128_analysis_h__
 #define __ardour_ebur128_analysis_h__
 
-#include "ardour/audioanalyser.h"
+#include <boost/utility.hpp>
+
+#include "ardour/libardour_visibility.h"
 #include "ardour/readable.h"
 
 namespace ARDOUR {
 
-class AudioSource;
-class Session;
-
-class LIBARDOUR_API EBUr128Analysis : public AudioAnalyser
+class LIBARDOUR_API EBUr128Analysis : public boost::noncopyable
 {
 public:
 	EBUr128Analysis (float sample_rate);
@@ -38,10 +37,8 @@ public:
 	float loudness () const { return _loudness; }
 	float loudness_range () const { return _loudness_range; }
 
-protected:
-	int use_features (Vamp::Plugin::FeatureSet&, std::ostream*);
-
 private:
+	float _sample_rate;
 	float _loudness;
 	float _loudness_range;
 
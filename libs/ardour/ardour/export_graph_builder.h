@@ -25,10 +25,10 @@
 #include "ardour/export_handler.h"
 #include "ardour/export_analysis.h"
 
+#include "audiographer/general/threader_pool.h"
 #include "audiographer/utils/identity_vertex.h"
 
 #include <boost/ptr_container/ptr_list.hpp>
-#include <glibmm/threadpool.h>
 
 namespace AudioGrapher {
 	class SampleRateConverter;
@@ -281,7 +281,7 @@ class LIBARDOUR_API ExportGraphBuilder
 	bool        _realtime;
 	samplecnt_t _master_align;
 
-	Glib::ThreadPool     thread_pool;
+	AudioGrapher::ThreaderPool thread_pool;
 	Glib::Threads::Mutex engine_request_lock;
 };
 
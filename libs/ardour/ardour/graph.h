@@ -32,6 +32,7 @@
 
 #include "pbd/mpmc_queue.h"
 #include "pbd/semutils.h"
+#include "pbd/timing.h"
 
 #include "ardour/audio_backend.h"
 #include "ardour/libardour_visibility.h"
@@ -76,6 +77,15 @@ public:
 
 	bool in_process_thread () const;
 
+	/** time from waking the graph until all routes are processed, in microseconds */
+	PBD::TimingHistogram& dsp_histogram () { return _dsp_histogram; }
+
+	/** time graph threads wait for a route to become ready, per wake-up, in microseconds.
+	 * A wait that began before the current cycle counts from the start of the cycle
+	 * (this is the latency of waking the thread).
+	 */
+	PBD::TimingHistogram& wait_histogram () { return _wait_histogram; }
+
 protected:
 	virtual void session_going_away ();
 
@@ -103,6 +113,12 @@ private:
 	PBD::Semaphore _callback_start_sem;
 	PBD::Semaphore _callback_done_sem;
 
+	PBD::TimingHistogram _dsp_histogram;
+	PBD::TimingHistogram _wait_histogram;
+
+	/** g_get_monotonic_time () when the current cycle was started */
+	int64_t _cycle_start;
+
 	/** The number of unprocessed nodes that do not feed any other node; updated during processing */
 	volatile guint _terminal_refcnt;
 
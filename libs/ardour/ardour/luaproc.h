@@ -129,6 +129,13 @@ public:
 	DSP::DspShm* instance_shm () { return &lshm; }
 	LuaTableRef* instance_ref () { return &lref; }
 
+	/** memory pool statistics of this instance, in bytes
+	 * @param used currently allocated
+	 * @param peak high-water-mark of \p used
+	 * @param size part of the pool that is locked in memory
+	 */
+	void arena_usage (size_t& used, size_t& peak, size_t& size) const;
+
 private:
 	samplecnt_t plugin_latency() const { return _signal_latency; }
 	void find_presets ();
@@ -143,6 +150,12 @@ protected:
 	const std::string& origin() const { return _origin; }
 
 private:
+	static const size_t max_arena_size = 3145728;
+	static size_t arena_size (LuaScripting::DSPScriptPtr);
+	void update_arena_peak () const;
+
+	size_t _arena_size;
+	bool   _dsp_ran;
 #ifdef USE_TLSF
 	PBD::TLSF _mempool;
 #else
@@ -151,6 +164,7 @@ private:
 	LuaState lua;
 	luabridge::LuaRef * _lua_dsp;
 	luabridge::LuaRef * _lua_latency;
+	LuaScripting::DSPScriptPtr _dsp_script;
 	std::string _script;
 	std::string _origin;
 	std::string _docs;
@@ -17,6 +17,7 @@
  */
 #ifndef _ardour_luascripting_h_
 #define _ardour_luascripting_h_
+#include <map>
 #include <vector>
 
 #include <boost/shared_ptr.hpp>
@@ -128,6 +129,35 @@ public:
 		bool operator() (LuaScriptInfoPtr const a, LuaScriptInfoPtr const b) const;
 	};
 
+	/** A DSP script, compiled once and shared by all LuaProc instances */
+	struct LIBARDOUR_API DSPScript {
+		DSPScript (LuaScriptInfoPtr i, std::string const& h, std::string const& bc)
+			: info (i)
+			, hash (h)
+			, bytecode (bc)
+			, arena_peak (0)
+		{}
+
+		LuaScriptInfoPtr info;
+		std::string      hash;       ///< sha1 of the script
+		std::string      bytecode;   ///< lua_dump() of the script's main chunk
+		size_t           arena_peak; ///< high-water-mark of the memory pool, as last saved
+	};
+
+	typedef boost::shared_ptr<DSPScript> DSPScriptPtr;
+
+	/** look up a DSP script by its hash, compile it on first use.
+	 * @return the compiled script or an empty pointer if it is invalid
+	 */
+	DSPScriptPtr dsp_script (const std::string& script);
+
+	/** @return memory used by the most demanding instance of the script, or 0 if unknown.
+	 * Peaks are kept in the user's cache folder, so they also apply after a restart.
+	 */
+	size_t dsp_arena_peak (DSPScriptPtr);
+	/** update the high-water-mark of a DSP script's memory pool, measured after dsp_run() */
+	void set_dsp_arena_peak (DSPScriptPtr, size_t bytes);
+
 private:
 	static LuaScripting* _instance; // singleton
 	LuaScripting ();
@@ -135,6 +165,7 @@ private:
 	void scan ();
 	static LuaScriptInfoPtr scan_script (const std::string &, const std::string & sc = "");
 	static void lua_print (std::string s);
+	static std::string script_hash (const std::string&);
 
 	LuaScriptList *_sl_dsp;
 	LuaScriptList *_sl_session;
@@ -146,6 +177,10 @@ private:
 	LuaScriptList  _empty_script_info;
 
 	Glib::Threads::Mutex _lock;
+
+	typedef std::map<std::string, DSPScriptPtr> DSPScriptCache;
+	DSPScriptCache       _dsp_cache; // key: sha1 of the script
+	Glib::Threads::Mutex _dsp_cache_lock;
 };
 
 } // namespace ARDOUR
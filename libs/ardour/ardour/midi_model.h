@@ -151,6 +151,8 @@ public:
 
 		std::set<NotePtr> side_effect_removals;
 
+		void extend_range (TimeType& start, TimeType& end, bool& valid);
+
 		XMLNode &marshal_change(const NoteChange&);
 		NoteChange unmarshal_change(XMLNode *xml_note);
 
@@ -300,6 +302,10 @@ public:
 	int set_state(const XMLNode&) { return 0; }
 
 	PBD::Signal0<void> ContentsChanged;
+	/** Emitted right before ContentsChanged by note edits, with the
+	 * (model time) range covered by the notes before and after the edit.
+	 */
+	PBD::Signal2<void, TimeType, TimeType> ContentsRangeChanged;
 	PBD::Signal1<void, double> ContentsShifted;
 
 	boost::shared_ptr<const MidiSource> midi_source ();
@@ -25,6 +25,7 @@
 
 #include <vector>
 #include <list>
+#include <map>
 
 #include <boost/utility.hpp>
 
@@ -37,6 +38,7 @@
 #include "ardour/playlist.h"
 #include "evoral/Note.h"
 #include "evoral/Parameter.h"
+#include "evoral/Range.h"
 #include "ardour/rt_midibuffer.h"
 
 namespace Evoral {
@@ -71,6 +73,12 @@ public:
 
 	~MidiPlaylist ();
 
+	/** Render the playlist into the buffer returned by ::rendered ().
+	 * Only the time ranges that changed since the last call are
+	 * re-rendered and spliced into the buffer, unless a complete
+	 * render is required (first call, channel filter, note-mode
+	 * or solo-selection changes).
+	 */
 	void render (MidiChannelFilter*);
 	RTMidiBuffer* rendered();
 
@@ -86,14 +94,29 @@ public:
   protected:
 	void remove_dependents (boost::shared_ptr<Region> region);
 	void region_going_away (boost::weak_ptr<Region> region);
+	bool region_changed (const PBD::PropertyChange&, boost::shared_ptr<Region>);
 
   private:
 	void dump () const;
 
+	typedef std::map<PBD::ID, Evoral::Range<samplepos_t> > RenderExtents;
+
+	static Evoral::Range<samplepos_t> render_extent (boost::shared_ptr<Region>);
+	void render_all (std::vector<boost::shared_ptr<Region> > const&, MidiChannelFilter*);
+
 	NoteMode     _note_mode;
 	samplepos_t  _read_end;
 
 	RTMidiBuffer _rendered;
+
+	/* incremental rendering, protected by _render_lock */
+	Glib::Threads::Mutex           _render_lock;
+	Evoral::RangeList<samplepos_t> _render_dirty;   ///< ranges to re-render
+	RenderExtents                  _render_extents; ///< region extents at the time of the last render
+	bool                           _render_needs_all;
+	bool                           _render_solo_selection;
+	NoteMode                       _render_note_mode;
+	uint32_t                       _render_filter;
 };
 
 } /* namespace ARDOUR */
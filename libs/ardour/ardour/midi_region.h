@@ -123,6 +123,24 @@ class LIBARDOUR_API MidiRegion : public Region
 	            NoteMode                        mode,
 	            MidiChannelFilter*              filter) const;
 
+	/** Render the events that render () writes within @a range (session
+	 * samples, inclusive). If the model is loaded, only the events in the
+	 * range are read: the model is searched for the range's start and
+	 * reading stops at its end.
+	 */
+	int render_range (Evoral::EventSink<samplepos_t>& dst,
+	                  uint32_t                        chan_n,
+	                  NoteMode                        mode,
+	                  MidiChannelFilter*              filter,
+	                  Evoral::Range<samplepos_t> const& range) const;
+
+	/** Range (in session samples) of the model edit that is being signalled
+	 * by a Properties::contents change. Only valid while that change is
+	 * being emitted.
+	 * @return false if the range is not known, i.e. the whole region changed
+	 */
+	bool contents_change_range (samplepos_t& start, samplepos_t& end) const;
+
   protected:
 
 	virtual bool can_trim_start_before_source_start () const {
@@ -165,6 +183,7 @@ class LIBARDOUR_API MidiRegion : public Region
 
 	void model_changed ();
 	void model_contents_changed ();
+	void model_contents_range_changed (Temporal::Beats, Temporal::Beats);
 	void model_shifted (double qn_distance);
 	void model_automation_state_changed (Evoral::Parameter const &);
 
@@ -177,7 +196,11 @@ class LIBARDOUR_API MidiRegion : public Region
 	PBD::ScopedConnection _model_changed_connection;
 	PBD::ScopedConnection _source_connection;
 	PBD::ScopedConnection _model_contents_connection;
+	PBD::ScopedConnection _model_range_connection;
 	bool _ignore_shift;
+	bool        _contents_range_valid;
+	samplepos_t _contents_range_start;
+	samplepos_t _contents_range_end;
 };
 
 } /* namespace ARDOUR */
@@ -193,6 +193,19 @@ class LIBARDOUR_API MidiSource : virtual public Source
 	void set_note_mode(const Glib::Threads::Mutex::Lock& lock, NoteMode mode);
 
 	boost::shared_ptr<MidiModel> model() { return _model; }
+
+	/** @return the model, after loading it if that has not been done yet
+	 * (see SMFSource::load_length). Emits ModelChanged if the model was
+	 * loaded, here or by ensure_model (const Lock&). Takes the source lock
+	 * only if the model does not exist yet.
+	 */
+	boost::shared_ptr<MidiModel> ensure_model ();
+
+	/** As ensure_model (), for callers holding the source lock.
+	 * ModelChanged is emitted by the next call of ensure_model ()
+	 * without the lock.
+	 */
+	boost::shared_ptr<MidiModel> ensure_model (const Glib::Threads::Mutex::Lock& lock);
 	void set_model(const Glib::Threads::Mutex::Lock& lock, boost::shared_ptr<MidiModel>);
 	void drop_model(const Glib::Threads::Mutex::Lock& lock);
 
@@ -238,6 +251,7 @@ class LIBARDOUR_API MidiSource : virtual public Source
 
 	boost::shared_ptr<MidiModel> _model;
 	bool                         _writing;
+	gint                         _model_loaded; ///< ModelChanged is pending for a model loaded on demand
 
 	Temporal::Beats _length_beats;
 
@@ -21,6 +21,8 @@
 #define _ardour_mp3file_importable_source_h_
 
 #include <stdint.h>
+#include <string>
+#include <vector>
 
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
@@ -43,7 +45,10 @@ namespace ARDOUR {
 
 class LIBARDOUR_API Mp3FileImportableSource : public ImportableSource {
 public:
-	Mp3FileImportableSource (const std::string& path);
+	/** @param index_path file to load the seek index from, or to save it to
+	 * after it was built. Empty to not persist the index.
+	 */
+	Mp3FileImportableSource (const std::string& path, const std::string& index_path = "");
 	virtual ~Mp3FileImportableSource();
 
 	/* ImportableSource API */
@@ -61,9 +66,21 @@ public:
 	samplecnt_t read_unlocked (Sample*, samplepos_t start, samplecnt_t cnt, uint32_t chn);
 
 private:
+	struct SeekPoint {
+		SeekPoint (samplepos_t p, uint64_t o) : pos (p), offset (o) {}
+		samplepos_t pos;    // first sample of the frame
+		uint64_t    offset; // byte offset of the frame in the file
+	};
+
 	void unmap_mem ();
 	int  decode_mp3 (bool parse_only = false);
 
+	void build_index ();
+	bool load_index (const std::string& index_path, int64_t mtime);
+	void save_index (const std::string& index_path, int64_t mtime) const;
+
+	std::vector<SeekPoint> _index;
+
 	mp3dec_t            _mp3d;
 	mp3dec_frame_info_t _info;
 	samplecnt_t         _length;
@@ -42,6 +42,8 @@ public:
 	int flush_header () { return 0; }
 	void set_header_natural_position () {};
 
+	samplecnt_t read (Sample *dst, samplepos_t start, samplecnt_t cnt, int channel=0) const;
+
 	static int get_soundfile_info (string path, SoundFileInfo& _info, string& error_msg);
 
 protected:
@@ -52,6 +54,8 @@ protected:
 	samplecnt_t write_unlocked (Sample *, samplecnt_t) { return 0; }
 
 private:
+	samplecnt_t decode_block (Sample* dst, samplepos_t start, samplecnt_t cnt) const;
+
 	mutable Mp3FileImportableSource _mp3;
 	int _channel;
 };
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __ardour_playlist_render_cache_h__
+#define __ardour_playlist_render_cache_h__
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include <glibmm/threads.h>
+#include <boost/weak_ptr.hpp>
+#include <sndfile.h>
+
+#include "evoral/Range.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+class AudioPlaylist;
+class Session;
+
+/** Flattened audio of an AudioPlaylist, one raw float file per channel.
+ *
+ * Rendering (regions, envelopes, fades, layers) is done by a background
+ * thread, once the playlist has not been modified for a while. Edits
+ * only invalidate the affected range, reads of a modified range fall
+ * back to reading the playlist until it has been rendered again.
+ */
+class LIBARDOUR_API PlaylistRenderCache
+{
+public:
+	PlaylistRenderCache (Session&, AudioPlaylist&);
+	~PlaylistRenderCache ();
+
+	/** start rendering the complete playlist, or drop the cache */
+	void set_enabled (bool);
+	bool enabled () const { return _enabled; }
+
+	/** read a channel from the cache.
+	 * @return false if [start, start + cnt) is not rendered, the caller
+	 * then has to read from the playlist.
+	 */
+	bool read (Sample* buf, samplepos_t start, samplecnt_t cnt, uint32_t chn);
+
+	/** mark a range of the playlist as modified */
+	void invalidate (Evoral::Range<samplepos_t> const&);
+
+	static void init ();
+	static void flush ();
+	static void work ();
+
+private:
+	typedef std::list<Evoral::Range<samplepos_t> > RangeList;
+
+	enum RenderResult {
+		Done,
+		More,
+		Later
+	};
+
+	RenderResult render ();
+	bool open_files (uint32_t n_chans);
+	void close_files ();
+	void queue ();
+	bool is_dirty (samplepos_t start, samplepos_t end) const;
+
+	Session&             _session;
+	AudioPlaylist&       _playlist;
+	Glib::Threads::Mutex _lock;
+	bool                 _enabled;
+	bool                 _queued;
+	int64_t              _last_change;
+	uint32_t             _failures;
+	RangeList            _dirty;
+	RangeList            _busy;
+	RangeList            _failed;
+	std::vector<SNDFILE*>    _sf;
+	std::vector<std::string> _paths;
+
+	static Glib::Threads::Mutex render_active_lock;
+	static Glib::Threads::Mutex render_queue_lock;
+	static Glib::Threads::Cond  PlaylistsToRender;
+	static std::list<boost::weak_ptr<AudioPlaylist> > render_queue;
+};
+
+} /* namespace ARDOUR */
+
+#endif /* __ardour_playlist_render_cache_h__ */
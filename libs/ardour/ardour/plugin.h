@@ -160,9 +160,26 @@ public:
 	/** the max possible latency a plugin will have */
 	virtual samplecnt_t max_latency () const { return 0; }
 
+	/** Duration after the input became silent until the plugin's
+	 * output has decayed to silence (reverb, delay, release).
+	 * If the plugin does not report a tail, the configured default is used.
+	 * Not realtime safe.
+	 */
+	samplecnt_t signal_tailtime () const;
+
 	virtual int  set_block_size (pframes_t nframes) = 0;
 	virtual bool requires_fixed_sized_buffers () const { return false; }
 	virtual bool inplace_broken () const { return false; }
+
+	/** @return true if the plugin applies set_parameter() calls at the given
+	 * sample-offset within a single run (e.g. VST3 IParameterChanges).
+	 * The host then does not need to split the cycle at automation events.
+	 *
+	 * Only VST3 does this. LV2 control ports hold a single value per run(),
+	 * and automated LV2 properties (patch:Set) are queued via the UI ring,
+	 * which delivers them at the end of each run; neither is sample-accurate.
+	 */
+	virtual bool sample_accurate_parameters () const { return false; }
 	virtual bool connect_all_audio_outputs () const { return false; }
 
 	virtual int connect_and_run (BufferSet&  bufs,
@@ -402,6 +419,9 @@ protected:
 private:
 	virtual samplecnt_t plugin_latency () const = 0;
 
+	/** @return tail in samples, -1 if the plugin does not report one */
+	virtual samplecnt_t plugin_tailtime () const { return -1; }
+
 	/** Fill _presets with our presets */
 	virtual void find_presets () = 0;
 
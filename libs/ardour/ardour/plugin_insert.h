@@ -194,12 +194,21 @@ public:
 	void realtime_locate (bool);
 	void monitoring_changed ();
 
+	void set_output_latency (samplecnt_t);
+
 	bool load_preset (Plugin::PresetRecord);
 
 	bool provides_stats () const;
 	bool get_stats (uint64_t& min, uint64_t& max, double& avg, double& dev) const;
 	void clear_stats ();
 
+	/** @return the fraction of cycles since the stats were last reset, in
+	 * which the plugin was not run because its input was silent and its
+	 * tail had decayed (see RCConfiguration::plugin_sleep_on_silence)
+	 */
+	double sleep_ratio () const;
+	bool sleeping () const { return _sleeping; }
+
 	/** A control that manipulates a plugin parameter (control port). */
 	struct PluginControl : public AutomationControl
 	{
@@ -401,11 +410,18 @@ private:
 	PinMappings _out_map;
 	ChanMapping _thru_map; // out-idx <=  in-idx
 
+	bool sample_accurate_automation () const;
 	void automate_and_run (BufferSet& bufs, samplepos_t start, samplepos_t end, double speed, pframes_t nframes);
 	void connect_and_run (BufferSet& bufs, samplepos_t start, samplecnt_t end, double speed, pframes_t nframes, samplecnt_t offset, bool with_auto);
 	void bypass (BufferSet& bufs, pframes_t nframes);
 	void inplace_silence_unconnected (BufferSet&, const PinMappings&, samplecnt_t nframes, samplecnt_t offset) const;
 
+	bool input_is_silent (BufferSet&, pframes_t nframes) const;
+	bool output_is_silent (BufferSet&, pframes_t nframes) const;
+	void silence_outputs (BufferSet&, pframes_t nframes) const;
+	void update_sleep_tail ();
+	void wake_up () { g_atomic_int_set (&_wake_up, 1); }
+
 	void create_automatable_parameters ();
 	void control_list_automation_state_changed (Evoral::Parameter, AutoState);
 	void set_parameter_state_2X (const XMLNode& node, int version);
@@ -440,6 +456,15 @@ private:
 
 	PBD::TimingStats _timing_stats;
 	volatile gint _stat_reset;
+
+	/* sleep on silent input */
+	bool          _sleeping;
+	bool          _sleep_rolling;  // transport state when last run
+	samplecnt_t   _silent_samples; // since input or output was last non-silent
+	volatile gint _sleep_tail;     // plugin tail in samples, -1: never sleep
+	volatile gint _wake_up;        // parameter change, locate
+	volatile gint _run_cycles;
+	volatile gint _sleep_cycles;
 };
 
 } // namespace ARDOUR
@@ -37,6 +37,7 @@
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
 #include "ardour/plugin.h"
+#include "ardour/plugin_scan_index.h"
 
 namespace ARDOUR {
 
@@ -232,6 +233,8 @@ private:
 	bool _cancel_scan;
 	bool _cancel_timeout;
 
+	PluginScanIndex _scan_index;
+
 	void detect_name_ambiguities (ARDOUR::PluginInfoList*);
 	void detect_type_ambiguities (ARDOUR::PluginInfoList&);
 
@@ -251,6 +254,8 @@ private:
 	void lxvst_refresh (bool cache_only = false);
 	void vst3_refresh (bool cache_only = false);
 
+	void vst2_parallel_scan (std::string const& type, std::vector<std::string> const& plugin_objects, std::set<std::string>& scanned);
+
 	void add_lrdf_data (const std::string &path);
 	void add_ladspa_presets ();
 	void add_windows_vst_presets ();
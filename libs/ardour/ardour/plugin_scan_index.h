@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _ardour_plugin_scan_index_h_
+#define _ardour_plugin_scan_index_h_
+
+#include <map>
+#include <string>
+#include <stdint.h>
+
+#include <boost/utility.hpp>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/plugin_types.h"
+
+namespace ARDOUR {
+
+/** Persistent index of plugin modules that were successfully scanned.
+ *
+ * Every entry is keyed by the module's path and records its
+ * modification-time and file-size at the time of the scan.
+ * A module whose stat() still matches the index is known to be
+ * unchanged, and its per-plugin cache can be used without
+ * re-running a scanner (and without consulting the blacklist).
+ */
+class LIBARDOUR_API PluginScanIndex : public boost::noncopyable
+{
+public:
+	PluginScanIndex (std::string const& name);
+
+	bool load ();
+	bool save ();
+
+	/** remove all entries of the given plugin type */
+	void clear (PluginType);
+
+	/** @return true if @a path is indexed and its mtime and size are unchanged */
+	bool unchanged (std::string const& path) const;
+
+	/** @return true if @a path is indexed, but was modified since */
+	bool stale (std::string const& path) const;
+
+	/** (re) index @a path after it was successfully scanned */
+	void update (std::string const& path, PluginType);
+
+	/** remove @a path, e.g. after a failed scan */
+	void remove (std::string const& path);
+
+	size_t size () const { return _entries.size (); }
+
+private:
+	struct Entry {
+		Entry () : type (LXVST), mtime (0), size (0) {}
+
+		/* same file, regardless of type */
+		bool operator== (Entry const& other) const {
+			return mtime == other.mtime && size == other.size;
+		}
+
+		PluginType type;
+		int64_t    mtime;
+		uint64_t   size;
+	};
+
+	static bool stat_entry (std::string const& path, Entry&);
+
+	typedef std::map<std::string, Entry> EntryMap;
+
+	EntryMap    _entries;
+	std::string _path;
+	bool        _dirty;
+};
+
+} // namespace ARDOUR
+
+#endif /* _ardour_plugin_scan_index_h_ */
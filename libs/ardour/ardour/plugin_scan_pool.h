@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _ardour_plugin_scan_pool_h_
+#define _ardour_plugin_scan_pool_h_
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/utility.hpp>
+
+#include "pbd/signals.h"
+
+#include "ardour/libardour_visibility.h"
+
+namespace ARDOUR {
+
+class SystemExec;
+
+/** Run external plugin scanner applications concurrently.
+ *
+ * Bundles are queued with add(), run() then keeps up to
+ * n_jobs scanner processes alive until the queue is drained.
+ * Every process is subject to the "vst-scan-timeout" and the
+ * PluginManager's cancel/timeout state, exactly as serial scans.
+ */
+class LIBARDOUR_API PluginScanPool : public boost::noncopyable
+{
+public:
+	/** @param scanner_bin path to the scanner application
+	 * @param type plugin-type name used for PluginScanMessage
+	 * @param n_jobs max concurrent processes, 0: use "plugin-scan-jobs" preference
+	 */
+	PluginScanPool (std::string const& scanner_bin, std::string const& type, uint32_t n_jobs = 0);
+	~PluginScanPool ();
+
+	/** queue a scan. @a args are passed to the scanner before @a bundle_path */
+	void add (std::string const& bundle_path, std::vector<std::string> const& args = std::vector<std::string> ());
+
+	/** run all queued scans, block until they completed.
+	 * @return number of scans that did not complete (timeout, cancel, launch error)
+	 */
+	size_t run ();
+
+	size_t n_queued () const { return _queue.size (); }
+	uint32_t n_jobs () const { return _n_jobs; }
+
+	/** called with the bundle path for every scan that was aborted
+	 * (cancel, launch error), to clean up partial cache files.
+	 */
+	boost::function<void (std::string const&)> aborted;
+
+	/** called with the bundle path for every scan that timed out.
+	 * Unlike aborted scans, the plugin is expected to remain blacklisted.
+	 */
+	boost::function<void (std::string const&)> timed_out;
+
+	static uint32_t default_concurrency ();
+
+private:
+	struct Job {
+		Job (std::string const& p, std::vector<std::string> const& a)
+			: bundle_path (p), args (a), exec (0), timeout (0) {}
+
+		std::string              bundle_path;
+		std::vector<std::string> args;
+		ARDOUR::SystemExec*      exec;
+		PBD::ScopedConnection    log_connection;
+		int                      timeout;
+	};
+
+	enum Result {
+		Completed,
+		Aborted,
+		TimedOut
+	};
+
+	bool start (Job*);
+	void finish (Job*, Result);
+
+	static void scanner_log (std::string msg, std::string bundle_path);
+
+	std::string     _scanner_bin;
+	std::string     _type;
+	uint32_t        _n_jobs;
+	std::list<Job*> _queue;
+	std::list<Job*> _active;
+	size_t          _n_failed;
+};
+
+} // namespace ARDOUR
+
+#endif /* _ardour_plugin_scan_pool_h_ */
@@ -27,6 +27,7 @@
 
 #include <stdint.h>
 
+#include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include "pbd/rcu.h"
@@ -202,7 +203,7 @@ public:
 protected:
 	boost::shared_ptr<AudioBackend> _backend;
 
-	SerializedRCUManager<Ports> ports;
+	EpochRCUManager<Ports> ports;
 
 	bool                   _port_remove_in_progress;
 	PBD::RingBuffer<Port*> _port_deletions_pending;
@@ -210,8 +211,10 @@ protected:
 	boost::shared_ptr<Port> register_port (DataType type, const std::string& portname, bool input, bool async = false, PortFlags extra_flags = PortFlags (0));
 	void                    port_registration_failure (const std::string& portname);
 
-	/** List of ports to be used between \ref cycle_start() and \ref cycle_end() */
-	boost::shared_ptr<Ports> _cycle_ports;
+	/** List of ports to be used between \ref cycle_start() and \ref cycle_end(),
+	 * valid for the current process cycle only.
+	 */
+	Ports* _cycle_ports;
 
 	void silence (pframes_t nframes, Session* s = 0);
 	void silence_outputs (pframes_t nframes);
@@ -231,6 +234,17 @@ protected:
 
 	void cycle_end_fade_out (gain_t, gain_t, pframes_t, Session* s = 0);
 
+	/* vari-speed: audio ports are resampled in parallel, in batches.
+	 * Task lists for RTTaskList, one entry per batch. */
+	std::vector<boost::function<void ()> > _cycle_start_batches;
+	std::vector<boost::function<void ()> > _cycle_end_batches;
+	pframes_t                              _batch_nframes;
+
+	bool parallel_resampling (Session*) const;
+	void cycle_start_batch (size_t batch);
+	void cycle_end_batch (size_t batch);
+	void cycle_end_ports (pframes_t nframes, Session* s);
+
 	typedef std::map<std::string, MidiPortInformation> MidiPortInfo;
 
 	mutable Glib::Threads::Mutex midi_port_info_mutex;
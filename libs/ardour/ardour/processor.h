@@ -27,6 +27,7 @@
 #include <exception>
 
 #include "pbd/statefuldestructible.h"
+#include "pbd/timing.h"
 
 #include "ardour/ardour.h"
 #include "ardour/buffer_set.h"
@@ -157,6 +158,9 @@ class LIBARDOUR_API Processor : public SessionObject, public Automatable, public
 	virtual void set_owner (SessionObject*);
 	SessionObject* owner() const;
 
+	/** time spent in run() by the owning route, in microseconds */
+	PBD::TimingHistogram& dsp_histogram () { return _dsp_histogram; }
+
 protected:
 	virtual XMLNode& state ();
 	virtual int set_state_2X (const XMLNode&, int version);
@@ -182,6 +186,8 @@ protected:
 	samplecnt_t _capture_offset;
 	samplecnt_t _playback_offset;
 	Location*   _loop_location;
+
+	PBD::TimingHistogram _dsp_histogram;
 };
 
 } // namespace ARDOUR
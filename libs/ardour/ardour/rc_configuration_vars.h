@@ -94,6 +94,10 @@ CONFIG_VARIABLE (BufferingPreset, buffering_preset, "buffering-preset", Medium)
 CONFIG_VARIABLE (float, audio_capture_buffer_seconds, "capture-buffer-seconds", 5.0)
 CONFIG_VARIABLE (float, audio_playback_buffer_seconds, "playback-buffer-seconds", 5.0)
 CONFIG_VARIABLE (float, midi_track_buffer_seconds, "midi-track-buffer-seconds", 1.0)
+CONFIG_VARIABLE (bool, lazy_midi_models, "lazy-midi-models", true)
+CONFIG_VARIABLE (uint32_t, playlist_render_cache_regions, "playlist-render-cache-regions", 0)
+CONFIG_VARIABLE (float, cue_buffer_seconds, "cue-buffer-seconds", 0.0)
+CONFIG_VARIABLE (uint32_t, decoded_audio_cache_size, "decoded-audio-cache-size", 256) /* MiB, 0: disabled */
 CONFIG_VARIABLE (uint32_t, disk_choice_space_threshold,  "disk-choice-space-threshold", 57600000)
 CONFIG_VARIABLE (bool, auto_analyse_audio, "auto-analyse-audio", false)
 CONFIG_VARIABLE (float, transient_sensitivity, "transient-sensitivity", 50)
@@ -209,6 +213,7 @@ CONFIG_VARIABLE_SPECIAL (std::string, default_session_parent_dir, "default-sessi
 #endif
 CONFIG_VARIABLE (bool, allow_special_bus_removal, "allow-special-bus-removal", false)
 CONFIG_VARIABLE (int32_t, processor_usage, "processor-usage", -1)
+CONFIG_VARIABLE (bool, use_convolution_pool, "use-convolution-pool", false) /* applies to convolvers created afterwards */
 CONFIG_VARIABLE (gain_t, max_gain, "max-gain", 2.0) /* +6.0dB */
 CONFIG_VARIABLE (uint32_t, max_recent_sessions, "max-recent-sessions", 10)
 CONFIG_VARIABLE (uint32_t, max_recent_templates, "max-recent-templates", 10)
@@ -220,6 +225,9 @@ CONFIG_VARIABLE (EditMode, edit_mode, "edit-mode", Slide)
 /* plugin related */
 
 CONFIG_VARIABLE (bool, new_plugins_active, "new-plugins-active", true)
+CONFIG_VARIABLE (bool, plugin_sleep_on_silence, "plugin-sleep-on-silence", false)
+CONFIG_VARIABLE (float, plugin_default_tail, "plugin-default-tail", 2.0) /* seconds, for plugins that do not report a tail */
+CONFIG_VARIABLE (bool, sample_accurate_plugin_automation, "sample-accurate-plugin-automation", true) /* VST3 only, see Plugin::sample_accurate_parameters */
 CONFIG_VARIABLE (bool, use_plugin_own_gui, "use-plugin-own-gui", true)
 CONFIG_VARIABLE (bool, use_windows_vst, "use-windows-vst", true)
 CONFIG_VARIABLE (bool, use_lxvst, "use-lxvst", true)
@@ -229,6 +237,7 @@ CONFIG_VARIABLE (bool, verbose_plugin_scan, "verbose-plugin-scan", false)
 CONFIG_VARIABLE (bool, conceal_lv1_if_lv2_exists, "conceal-lv1-if-lv2-exists", true)
 CONFIG_VARIABLE (bool, conceal_vst2_if_vst3_exists, "conceal-vst2-if-vst3-exists", true)
 CONFIG_VARIABLE (int, vst_scan_timeout, "vst-scan-timeout", 1200) /* deciseconds, per plugin, <= 0 no timeout */
+CONFIG_VARIABLE (uint32_t, plugin_scan_jobs, "plugin-scan-jobs", 0) /* concurrent external scanner processes, 0: number of CPUs */
 CONFIG_VARIABLE (bool, discover_audio_units, "discover-audio-units", false)
 CONFIG_VARIABLE (bool, ask_replace_instrument, "ask-replace-instrument", true)
 CONFIG_VARIABLE (bool, ask_setup_instrument, "ask-setup-instrument", true)
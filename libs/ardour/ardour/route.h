@@ -41,6 +41,7 @@
 #include "pbd/stateful.h"
 #include "pbd/controllable.h"
 #include "pbd/destructible.h"
+#include "pbd/timing.h"
 
 #include "ardour/ardour.h"
 #include "ardour/gain_control.h"
@@ -236,6 +237,9 @@ public:
 	bool has_io_processor_named (const std::string&);
 	ChanCount max_processor_streams () const { return processor_max_streams; }
 
+	/** time spent processing this route in the process graph, in microseconds */
+	PBD::TimingHistogram& dsp_histogram () { return _dsp_histogram; }
+
 	std::list<std::string> unknown_processors () const;
 
 	RoutePinWindowProxy * pinmgr_proxy () const { return _pinmgr_proxy; }
@@ -353,6 +357,13 @@ public:
 	samplecnt_t signal_latency() const { return _signal_latency; }
 	samplecnt_t playback_latency (bool incl_downstream = false) const;
 
+	/** Include this route (and the routes it feeds) in the next
+	 * incremental latency update, see Session::update_route_latency ().
+	 * This is realtime-safe.
+	 */
+	void queue_latency_recompute () { g_atomic_int_set (&_pending_latency_recompute, 1); }
+	bool latency_recompute_queued () const { return g_atomic_int_get (const_cast<gint*> (&_pending_latency_recompute)) != 0; }
+
 	virtual samplecnt_t output_latency () const { return _output_latency; }
 
 	PBD::Signal0<void> active_changed;
@@ -650,6 +661,7 @@ protected:
 	gint           _pending_process_reorder; // atomic
 	gint           _pending_listen_change; // atomic
 	gint           _pending_signals; // atomic
+	gint           _pending_latency_recompute; // atomic
 
 	MeterPoint     _meter_point;
 	MeterPoint     _pending_meter_point;
@@ -701,6 +713,8 @@ protected:
 
 	boost::shared_ptr<DelayLine> _delayline;
 
+	PBD::TimingHistogram _dsp_histogram;
+
 	bool is_internal_processor (boost::shared_ptr<Processor>) const;
 
 	boost::shared_ptr<Processor> the_instrument_unlocked() const;
@@ -44,11 +44,15 @@ public:
 	bool has (GraphVertex from, GraphVertex to, bool* via_sends_only);
 	bool feeds (GraphVertex from, GraphVertex to);
 	std::set<GraphVertex> from (GraphVertex r) const;
+	std::set<GraphVertex> to (GraphVertex r) const;
 	void remove (GraphVertex from, GraphVertex to);
 	bool has_none_to (GraphVertex to) const;
 	bool empty () const;
 	void dump () const;
 
+	bool operator== (GraphEdges const&) const;
+	bool operator!= (GraphEdges const& other) const { return !(*this == other); }
+
 private:
 	void insert (EdgeMap& e, GraphVertex a, GraphVertex b);
 
@@ -73,6 +77,11 @@ boost::shared_ptr<RouteList> topological_sort (
 	GraphEdges
 	);
 
+boost::shared_ptr<RouteList> incremental_topological_sort (
+	boost::shared_ptr<RouteList>,
+	GraphEdges const&
+	);
+
 }
 
 #endif
@@ -28,6 +28,7 @@
 #include <glibmm/threads.h>
 
 #include "evoral/Event.h"
+#include "evoral/EventList.h"
 #include "evoral/EventSink.h"
 #include "ardour/types.h"
 
@@ -52,6 +53,12 @@ class LIBARDOUR_API RTMidiBuffer : public Evoral::EventSink<samplepos_t>
 	uint32_t write (TimeType time, Evoral::EventType type, uint32_t size, const uint8_t* buf);
 	uint32_t read (MidiBuffer& dst, samplepos_t start, samplepos_t end, MidiStateTracker& tracker, samplecnt_t offset = 0);
 
+	/** Replace all events from @a start to @a end (inclusive) with @a events,
+	 * which must be sorted by time and lie within that range.
+	 * The caller must hold the write lock (WriteProtectRender).
+	 */
+	void splice (TimeType start, TimeType end, Evoral::EventList<TimeType> const& events);
+
 	void dump (uint32_t);
 	void reverse ();
 	bool reversed() const;
@@ -72,6 +79,19 @@ class LIBARDOUR_API RTMidiBuffer : public Evoral::EventSink<samplepos_t>
 		uint8_t data[0];
 	};
 
+	/* Items with more than 3 bytes of data have a non-zero bytes[0],
+	 * and the offset of their Blob in bytes[1..3]
+	 */
+	static uint32_t blob_offset (Item const& item) {
+		return item.bytes[1] | (item.bytes[2] << 8) | (item.bytes[3] << 16);
+	}
+	static void set_blob_offset (Item& item, uint32_t offset) {
+		item.bytes[0] = 1;
+		item.bytes[1] = offset & 0xff;
+		item.bytes[2] = (offset >> 8) & 0xff;
+		item.bytes[3] = (offset >> 16) & 0xff;
+	}
+
 	/* The main store. Holds Items (timestamp+up to 3 bytes of data OR
 	 * offset into secondary storage below)
 	 */
@@ -82,10 +102,16 @@ class LIBARDOUR_API RTMidiBuffer : public Evoral::EventSink<samplepos_t>
 	bool   _reversed;
 	/* secondary blob storage. Holds Blobs (arbitrary size + data) */
 
+	/* blob offsets are stored in 24 bits, see set_blob_offset() */
+	static const uint32_t max_blob_offset = (1 << 24);
+
 	uint32_t alloc_blob (uint32_t size);
-	uint32_t store_blob (uint32_t size, uint8_t const * data);
+	bool     store_blob (uint32_t size, uint8_t const * data, uint32_t& offset);
+	bool     store (Item&, uint32_t size, uint8_t const * data);
+	void     compact_pool ();
 	uint32_t _pool_size;
 	uint32_t _pool_capacity;
+	uint32_t _pool_unused; ///< bytes of blobs that were spliced out
 	uint8_t* _pool;
 
 	Glib::Threads::RWLock _lock;
@@ -19,7 +19,7 @@
 #ifndef _ardour_rt_tasklist_h_
 #define _ardour_rt_tasklist_h_
 
-#include <list>
+#include <vector>
 #include <boost/function.hpp>
 
 #include "pbd/semutils.h"
@@ -37,12 +37,21 @@ public:
 	RTTaskList ();
 	~RTTaskList ();
 
-	// TODO use dedicated allocator of a boost::intrusive::list
-	typedef std::list<boost::function<void ()> > TaskList;
+	/* Task lists are meant to be prepared once, and re-used for every
+	 * process cycle. Any per-cycle arguments are to be passed by the
+	 * object that the tasks are bound to.
+	 */
+	typedef std::vector<boost::function<void ()> > TaskList;
 
-	/** process tasks in list in parallel, wait for them to complete */
+	/** process tasks in list in parallel, wait for them to complete.
+	 * The calling thread takes part in processing. This does not
+	 * allocate memory and is realtime safe.
+	 */
 	void process (TaskList const&);
 
+	/** number of worker threads, excluding the calling thread */
+	size_t n_threads () const { return _threads.size (); }
+
 private:
 	gint _threads_active;
 	std::vector<pthread_t> _threads;
@@ -50,17 +59,17 @@ private:
 	void reset_thread_list ();
 	void drop_threads ();
 
-	void process_tasklist ();
+	void run_tasks ();
 
 	static void* _thread_run (void *arg);
 	void run ();
 
 	Glib::Threads::Mutex _process_mutex;
-	Glib::Threads::Mutex _tasklist_mutex;
 	PBD::Semaphore _task_run_sem;
 	PBD::Semaphore _task_end_sem;
 
-	TaskList _tasklist;
+	TaskList const* _tasklist;
+	gint            _next_task;
 };
 
 } // namespace ARDOUR
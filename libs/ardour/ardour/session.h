@@ -45,6 +45,7 @@
 #include <queue>
 #include <stdint.h>
 
+#include <boost/atomic.hpp>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/weak_ptr.hpp>
@@ -61,6 +62,7 @@
 #include "pbd/reallocpool.h"
 #include "pbd/statefuldestructible.h"
 #include "pbd/signals.h"
+#include "pbd/timing.h"
 #include "pbd/undo.h"
 
 #include "lua/luastate.h"
@@ -105,6 +107,7 @@ class Parser;
 
 namespace PBD {
 class Controllable;
+class TimingHistogram;
 }
 
 namespace luabridge {
@@ -307,6 +310,7 @@ public:
 	void butler_transport_work ();
 
 	void refresh_disk_space ();
+	void update_cue_positions ();
 
 	int load_routes (const XMLNode&, int);
 	boost::shared_ptr<RouteList> get_routes() const {
@@ -342,6 +346,16 @@ public:
 
 	bool plot_process_graph (std::string const& file_name) const;
 
+	/* DSP profile: per route and processor timing histograms */
+	bool write_dsp_profile (std::string const& file_name) const;
+	void reset_dsp_profile ();
+	PBD::TimingHistogram* process_graph_dsp_histogram () const;
+	PBD::TimingHistogram* process_graph_wait_histogram () const;
+
+	/* time spent updating latency compensation, in usec per update */
+	PBD::TimingHistogram& latency_compensation_histogram () { return _latency_compensation_histogram; }
+	PBD::TimingHistogram& latency_callback_histogram () { return _latency_callback_histogram; }
+
 	boost::shared_ptr<BundleList> bundles () {
 		return _bundles.reader ();
 	}
@@ -464,7 +478,7 @@ public:
 	void request_play_loop (bool yn, bool leave_rolling = false);
 	bool get_play_loop () const { return play_loop; }
 
-	samplepos_t last_transport_start () const { return _last_roll_location; }
+	samplepos_t last_transport_start () const { return _last_roll_location.load (); }
 	void goto_end ();
 	void goto_start (bool and_roll = false);
 	void use_rf_shuttle_speed ();
@@ -680,6 +694,33 @@ public:
 		bool _reconfigure_on_delete;
 	};
 
+	/** Coalesce changes of the route graph (connections, sends), the
+	 * routes are sorted once when the last blocker goes out of scope.
+	 */
+	class GraphReorderBlocker {
+	public:
+		GraphReorderBlocker (Session* s)
+			: _session (s)
+		{
+			g_atomic_int_inc (&s->_ignore_graph_reorders);
+		}
+
+		~GraphReorderBlocker ()
+		{
+			if (g_atomic_int_dec_and_test (&_session->_ignore_graph_reorders)) {
+				/* atomically take ownership of a deferred reorder, which
+				 * graph_reordered () may still be setting concurrently.
+				 * This is not called from a backend callback.
+				 */
+				if (g_atomic_int_compare_and_exchange (&_session->_ignored_a_graph_reorder, 1, 0)) {
+					_session->graph_reordered (false);
+				}
+			}
+		}
+	private:
+		Session* _session;
+	};
+
 	RouteGroup* new_route_group (const std::string&);
 	void add_route_group (RouteGroup *);
 	void remove_route_group (RouteGroup* rg) { if (rg) remove_route_group (*rg); }
@@ -1284,7 +1325,7 @@ protected:
 	void set_sample_rate (samplecnt_t nframes);
 
 	friend class Route;
-	void update_latency_compensation (bool force, bool called_from_backend);
+	void update_latency_compensation (bool force, bool called_from_backend, bool incremental = false);
 
 	/* transport API */
 
@@ -1363,7 +1404,9 @@ private:
 	void remove_monitor_section ();
 
 	void update_latency (bool playback);
-	bool update_route_latency (bool reverse, bool apply_to_delayline, bool* delayline_update_needed);
+	bool update_route_latency (bool reverse, bool apply_to_delayline, bool* delayline_update_needed, RouteList const* subset = 0, std::set<GraphVertex>* changed_routes = 0);
+	void routes_affected_by_latency_change (RouteList const&, RouteList&) const;
+	void routes_connected_to (RouteList const&, std::set<GraphVertex> const&, bool upstream, RouteList&) const;
 	void initialize_latencies ();
 	void set_worst_output_latency ();
 	void set_worst_input_latency ();
@@ -1498,11 +1541,17 @@ private:
 	int        load_state (std::string snapshot_name, bool from_template = false);
 	static int parse_stateful_loading_version (const std::string&);
 
-	samplepos_t _last_roll_location;
+	/** set by the process thread, read by the butler (cue positions) */
+	boost::atomic<samplepos_t> _last_roll_location;
 	/** the session sample time at which we last rolled, located, or changed transport direction */
 	samplepos_t _last_roll_or_reversal_location;
 	samplepos_t _last_record_location;
 
+	/* locate targets for DiskReader cue buffers */
+	gint        _cue_positions_dirty;
+	samplepos_t _cue_return_location;
+	void set_cue_positions (const Locations::LocationList&);
+
 	bool              pending_abort;
 	bool              pending_auto_loop;
 
@@ -1644,10 +1693,30 @@ private:
 
 	Glib::Threads::Mutex  _update_latency_lock;
 
+	/* Scope of the next engine latency callback (update_latency) for
+	 * each direction (capture, playback). An incremental
+	 * update_latency_compensation () that delegates to the engine sets
+	 * LatencyCallbackChanged, and the callback then only visits routes
+	 * connected to _latency_changed_routes.
+	 * Protected by _update_latency_lock.
+	 */
+	enum LatencyCallbackScope {
+		LatencyCallbackIdle,    ///< not requested by the session, update all routes
+		LatencyCallbackChanged, ///< only routes connected to _latency_changed_routes
+		LatencyCallbackAll      ///< a full update is pending
+	};
+
+	LatencyCallbackScope  _latency_callback_scope[2];
+	std::set<GraphVertex> _latency_changed_routes;
+
+	PBD::TimingHistogram  _latency_compensation_histogram;
+	PBD::TimingHistogram  _latency_callback_histogram;
+
 	typedef std::queue<AutoConnectRequest> AutoConnectQueue;
 	Glib::Threads::Mutex  _auto_connect_queue_lock;
 	AutoConnectQueue _auto_connect_queue;
 	guint _latency_recompute_pending;
+	guint _latency_recompute_all;
 
 	void get_physical_ports (std::vector<std::string>& inputs, std::vector<std::string>& outputs, DataType type,
 	                         MidiPortFlags include = MidiPortFlags (0),
@@ -1655,6 +1724,7 @@ private:
 
 	void auto_connect (const AutoConnectRequest&);
 	void queue_latency_recompute ();
+	void route_latency_changed (boost::weak_ptr<Route>);
 
 	/* SessionEventManager interface */
 
@@ -1814,7 +1884,7 @@ private:
 
 	boost::shared_ptr<Graph> _process_graph;
 
-	SerializedRCUManager<RouteList>  routes;
+	EpochRCUManager<RouteList>       routes;
 
 	void add_routes (RouteList&, bool input_auto_connect, bool output_auto_connect, PresentationInfo::order_t);
 	void add_routes_inner (RouteList&, bool input_auto_connect, bool output_auto_connect, PresentationInfo::order_t);
@@ -2158,6 +2228,8 @@ private:
 	    and solo/mute computations.
 	*/
 	GraphEdges _current_route_graph;
+	/** the order of routes after the last successful sort */
+	std::vector<boost::weak_ptr<Route> > _current_route_order;
 
 	void ensure_route_presentation_info_gap (PresentationInfo::order_t, uint32_t gap_size);
 
@@ -2165,6 +2237,10 @@ private:
 	gint            _ignore_route_processor_changes; /* atomic */
 	gint            _ignored_a_processor_change;
 
+	friend class    GraphReorderBlocker;
+	gint            _ignore_graph_reorders; /* atomic */
+	gint            _ignored_a_graph_reorder; /* atomic */
+
 	MidiClockTicker* midi_clock;
 
 	boost::shared_ptr<Port>  _ltc_output_port;
@@ -25,7 +25,11 @@
 
 #include <cstdio>
 #include <time.h>
+
+#include <boost/scoped_ptr.hpp>
+
 #include "evoral/SMF.h"
+#include "evoral/SMFMap.h"
 #include "ardour/midi_source.h"
 #include "ardour/file_source.h"
 
@@ -68,6 +72,12 @@ public:
 	void load_model (const Glib::Threads::Mutex::Lock& lock, bool force_reload=false);
 	void destroy_model (const Glib::Threads::Mutex::Lock& lock);
 
+	/** Set the length of the source from the file on disk, without
+	 * building the model. Playback streams events from the file until
+	 * the model is needed, see MidiSource::ensure_model().
+	 */
+	void load_length (const Glib::Threads::Mutex::Lock& lock);
+
 	static bool safe_midi_file_extension (const std::string& path);
 	static bool valid_midi_file (const std::string& path);
 
@@ -87,9 +97,17 @@ public:
 	/** time (in SMF ticks, 1 tick per _ppqn) of the last event read by read_unlocked */
 	mutable samplepos_t _smf_last_read_time;
 
+	/** the file mapped by read_unlocked, while libsmf has not loaded it */
+	mutable boost::scoped_ptr<Evoral::SMFMap>              _map;
+	mutable boost::scoped_ptr<Evoral::SMFMap::TrackReader> _map_reader;
+
 	int open_for_write ();
 
 	void ensure_disk_file (const Lock& lock);
+	void read_model (const Glib::Threads::Mutex::Lock& lock);
+	bool load_model_mapped ();
+	bool map_file () const;
+	void unmap_file () const;
 
 	samplecnt_t read_unlocked (const Lock&                    lock,
 	                           Evoral::EventSink<samplepos_t>& dst,
@@ -70,6 +70,8 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 
 	bool clamped_at_unity () const;
 
+	samplecnt_t read (Sample *dst, samplepos_t start, samplecnt_t cnt, int channel=0) const;
+
 	static const Source::Flag default_writable_flags;
 
 	static int get_soundfile_info (const std::string& path, SoundFileInfo& _info, std::string& error_msg);
@@ -91,6 +93,9 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 
 	void init_sndfile ();
 	int open();
+
+	bool use_block_cache () const;
+	samplecnt_t decode_block (Sample* dst, samplepos_t start, samplecnt_t cnt) const;
 	int setup_broadcast_info (samplepos_t when, struct tm&, time_t);
 	void file_closed ();
 
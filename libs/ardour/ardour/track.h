@@ -137,6 +137,7 @@ public:
 	float playback_buffer_load () const;
 	float capture_buffer_load () const;
 	int do_refill ();
+	int refill_cues ();
 	int do_flush (RunContext, bool force = false);
 	void set_pending_overwrite (OverwriteReason);
 	int seek (samplepos_t, bool complete_refill = false);
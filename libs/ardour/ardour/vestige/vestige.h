@@ -114,6 +114,8 @@
 #define effGetProductString 48
 #define effGetVendorVersion 49
 #define effCanDo 51 // currently unused
+/* from http://asseca.com/vst-24-specs/efGetTailSize.html */
+#define effGetTailSize 52
 /* from http://asseca.com/vst-24-specs/efIdle.html */
 #define effIdle 53
 /* from http://asseca.com/vst-24-specs/efGetParameterProperties.html */
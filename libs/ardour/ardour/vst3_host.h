@@ -251,6 +251,16 @@ public:
 		_id = Vst::kNoParamId;
 	}
 
+	/* std::vector does not copy the capacity, Vst3ParameterChanges::set_n_params
+	 * copy-constructs queues, which must not allocate later in the process thread.
+	 */
+	Vst3ParamValueQueue (Vst3ParamValueQueue const& other)
+		: _values (other._values)
+		, _id (other._id)
+	{
+		_values.reserve (maxNumPoints);
+	}
+
 	Vst::ParamID PLUGIN_API getParameterId() SMTG_OVERRIDE { return _id; }
 
 	void setParameterId (Vst::ParamID id) {
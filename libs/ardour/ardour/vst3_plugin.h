@@ -158,6 +158,7 @@ public:
 
 	/* API for Ardour -- Setup/Processing */
 	uint32_t  plugin_latency ();
+	uint32_t  plugin_tailtime ();
 	bool      set_block_size (int32_t);
 	bool      activate ();
 	bool      deactivate ();
@@ -336,6 +337,7 @@ public:
 	void deactivate () { _plug->deactivate (); }
 
 	int set_block_size (pframes_t);
+	bool sample_accurate_parameters () const { return true; }
 
 	void set_owner (ARDOUR::SessionObject* o);
 
@@ -359,6 +361,7 @@ public:
 
 private:
 	samplecnt_t plugin_latency () const;
+	samplecnt_t plugin_tailtime () const;
 	void        init ();
 	void        find_presets ();
 	void        forward_resize_view (int w, int h);
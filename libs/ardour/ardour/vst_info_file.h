@@ -50,6 +50,18 @@ enum VSTScanMode {
 
 LIBARDOUR_API extern void vstfx_free_info_list (std::vector<VSTInfo *> *infos);
 
+/** @return true if @a dllpath is neither blacklisted nor has an up-to-date cache file */
+LIBARDOUR_API extern bool vstfx_needs_scan (const char* dllpath);
+
+/** un-blacklist @a dllpath if an up-to-date cache file exists (after an external scan) */
+LIBARDOUR_API extern void vstfx_scan_completed (const char* dllpath);
+
+/** clean up after an incomplete external scan: remove partial cache- and blacklist-entries */
+LIBARDOUR_API extern void vstfx_scan_aborted (const char* dllpath);
+
+/** clean up after an external scan timed out: remove partial cache-files, keep the plugin blacklisted */
+LIBARDOUR_API extern void vstfx_scan_timed_out (const char* dllpath);
+
 #ifdef LXVST_SUPPORT
 LIBARDOUR_API extern std::vector<VSTInfo*> * vstfx_get_info_lx (char *, enum VSTScanMode mode = VST_SCAN_USE_APP);
 #endif
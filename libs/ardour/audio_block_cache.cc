@@ -0,0 +1,323 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstring>
+
+#include "pbd/pthread_utils.h"
+
+#include "ardour/audio_block_cache.h"
+#include "ardour/audiosource.h"
+#include "ardour/rc_configuration.h"
+
+using namespace ARDOUR;
+
+Glib::Threads::Mutex    AudioBlockCache::_lock;
+AudioBlockCache::Blocks AudioBlockCache::_blocks;
+AudioBlockCache::LRU    AudioBlockCache::_lru;
+size_t                  AudioBlockCache::_size = 0;
+
+Glib::Threads::Mutex                   AudioBlockCache::_read_ahead_lock;
+Glib::Threads::Mutex                   AudioBlockCache::_read_ahead_active_lock;
+Glib::Threads::Cond                    AudioBlockCache::_read_ahead_cond;
+std::list<AudioBlockCache::ReadAhead>  AudioBlockCache::_read_ahead_queue;
+Glib::Threads::Thread*                 AudioBlockCache::_read_ahead_thread = 0;
+bool                                   AudioBlockCache::_read_ahead_closing = false;
+
+bool
+AudioBlockCache::Key::operator< (Key const& other) const
+{
+	if (block != other.block) {
+		return block < other.block;
+	}
+	if (chn != other.chn) {
+		return chn < other.chn;
+	}
+	return path < other.path;
+}
+
+bool
+AudioBlockCache::enabled ()
+{
+	return Config->get_decoded_audio_cache_size () > 0;
+}
+
+samplecnt_t
+AudioBlockCache::read (std::string const& path, Sample* dst, samplepos_t start, samplecnt_t cnt,
+                       uint32_t chn, uint32_t n_chn, DecodeFunction const& decode)
+{
+	assert (chn < n_chn);
+
+	std::vector<Sample> interleaved;
+	samplecnt_t done = 0;
+
+	while (done < cnt) {
+		const samplepos_t pos    = start + done;
+		const samplepos_t block  = pos / block_size;
+		const samplecnt_t offset = pos - block * block_size;
+
+		Block b = lookup (Key (path, chn, block));
+
+		if (!b) {
+			/* decode all channels of the complete block */
+			interleaved.resize (block_size * n_chn);
+			const samplecnt_t n = decode (&interleaved[0], block * block_size, block_size);
+			if (n <= 0) {
+				break;
+			}
+			b = insert (path, n_chn, block, chn, &interleaved[0], n);
+		}
+
+		const samplecnt_t avail = b->size ();
+		if (offset >= avail) {
+			/* end of file */
+			break;
+		}
+
+		const samplecnt_t n = std::min (cnt - done, avail - offset);
+		memcpy (&dst[done], &(*b)[offset], n * sizeof (Sample));
+		done += n;
+
+		if (avail < block_size) {
+			break;
+		}
+	}
+
+	return done;
+}
+
+AudioBlockCache::Block
+AudioBlockCache::lookup (Key const& key)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	Blocks::iterator i = _blocks.find (key);
+	if (i == _blocks.end ()) {
+		return Block ();
+	}
+	/* move to the end of the LRU list */
+	_lru.splice (_lru.end (), _lru, i->second.lru);
+	return i->second.data;
+}
+
+bool
+AudioBlockCache::contains (Key const& key)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	return _blocks.find (key) != _blocks.end ();
+}
+
+AudioBlockCache::Block
+AudioBlockCache::insert (std::string const& path, uint32_t n_chn, samplepos_t block, uint32_t chn, Sample const* interleaved, samplecnt_t n_samples)
+{
+	std::vector<Block> chans;
+	for (uint32_t c = 0; c < n_chn; ++c) {
+		Block b (new std::vector<Sample> (n_samples));
+		Sample const* src = &interleaved[c];
+		for (samplecnt_t s = 0; s < n_samples; ++s, src += n_chn) {
+			(*b)[s] = *src;
+		}
+		chans.push_back (b);
+	}
+
+	const size_t max_size = Config->get_decoded_audio_cache_size () * 1048576;
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	for (uint32_t c = 0; c < n_chn; ++c) {
+		Key key (path, c, block);
+		if (_blocks.find (key) != _blocks.end ()) {
+			/* another reader decoded it concurrently */
+			continue;
+		}
+		Entry& e = _blocks[key];
+		e.data = chans[c];
+		e.lru  = _lru.insert (_lru.end (), key);
+		_size += n_samples * sizeof (Sample);
+	}
+
+	evict (max_size);
+
+	/* the caller holds a reference, even if the block was evicted right away */
+	return chans[chn];
+}
+
+void
+AudioBlockCache::evict (size_t max_size)
+{
+	/* called with _lock held */
+	while (_size > max_size && !_lru.empty ()) {
+		Blocks::iterator i = _blocks.find (_lru.front ());
+		assert (i != _blocks.end ());
+		_size -= i->second.data->size () * sizeof (Sample);
+		_blocks.erase (i);
+		_lru.pop_front ();
+	}
+}
+
+void
+AudioBlockCache::drop (std::string const& path, uint32_t chn)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	for (Blocks::iterator i = _blocks.begin (); i != _blocks.end ();) {
+		if (i->first.chn != chn || i->first.path != path) {
+			++i;
+			continue;
+		}
+		_size -= i->second.data->size () * sizeof (Sample);
+		_lru.erase (i->second.lru);
+		_blocks.erase (i++);
+	}
+}
+
+void
+AudioBlockCache::clear ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	_blocks.clear ();
+	_lru.clear ();
+	_size = 0;
+}
+
+size_t
+AudioBlockCache::size ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	return _size;
+}
+
+void
+AudioBlockCache::read_ahead (AudioSource const& src, std::string const& path, uint32_t chn, uint32_t n_chn,
+                             samplepos_t pos, DecodeFunction const& decode)
+{
+	if (!_read_ahead_thread) {
+		return;
+	}
+
+	const samplepos_t block = pos / block_size;
+	if (pos >= src.readable_length () || contains (Key (path, chn, block + read_ahead_blocks - 1))) {
+		return;
+	}
+
+	boost::shared_ptr<AudioSource> s;
+	try {
+		s = boost::const_pointer_cast<AudioSource> (boost::dynamic_pointer_cast<AudioSource const> (src.shared_from_this ()));
+	} catch (boost::bad_weak_ptr const&) {
+		/* not yet owned by a shared_ptr */
+		return;
+	}
+
+	if (!s) {
+		return;
+	}
+
+	Glib::Threads::Mutex::Lock lq (_read_ahead_lock);
+	if (_read_ahead_closing) {
+		return;
+	}
+	for (std::list<ReadAhead>::const_iterator i = _read_ahead_queue.begin (); i != _read_ahead_queue.end (); ++i) {
+		if (i->block == block && i->chn == chn && i->path == path) {
+			return;
+		}
+	}
+	_read_ahead_queue.push_back (ReadAhead (s, path, chn, n_chn, block, decode));
+	_read_ahead_cond.signal ();
+}
+
+static void
+read_ahead_work ()
+{
+	pthread_set_name ("AudioReadAhead");
+	AudioBlockCache::work ();
+}
+
+void
+AudioBlockCache::init ()
+{
+	_read_ahead_thread = Glib::Threads::Thread::create (sigc::ptr_fun (read_ahead_work));
+}
+
+void
+AudioBlockCache::flush ()
+{
+	Glib::Threads::Mutex::Lock lq (_read_ahead_lock);
+	_read_ahead_closing = true;
+	_read_ahead_queue.clear ();
+	lq.release ();
+
+	/* wait for the block currently being decoded */
+	Glib::Threads::Mutex::Lock la (_read_ahead_active_lock);
+}
+
+void
+AudioBlockCache::resume ()
+{
+	Glib::Threads::Mutex::Lock lq (_read_ahead_lock);
+	_read_ahead_closing = false;
+}
+
+void
+AudioBlockCache::work ()
+{
+	std::vector<Sample> interleaved;
+
+	while (true) {
+		_read_ahead_lock.lock ();
+
+	  wait:
+		if (_read_ahead_queue.empty ()) {
+			_read_ahead_cond.wait (_read_ahead_lock);
+		}
+
+		if (_read_ahead_queue.empty ()) {
+			goto wait;
+		}
+
+		ReadAhead ra (_read_ahead_queue.front ());
+		_read_ahead_queue.pop_front ();
+
+		Glib::Threads::Mutex::Lock la (_read_ahead_active_lock);
+		_read_ahead_lock.unlock ();
+
+		boost::shared_ptr<AudioSource> src (ra.src.lock ());
+		if (!src) {
+			continue;
+		}
+
+		interleaved.resize (block_size * ra.n_chn);
+
+		for (samplepos_t b = ra.block; b < ra.block + read_ahead_blocks && enabled (); ++b) {
+			if (contains (Key (ra.path, ra.chn, b))) {
+				continue;
+			}
+
+			samplecnt_t n;
+			{
+				/* the file handle is shared with the source's readers */
+				Glib::Threads::Mutex::Lock lm (src->mutex ());
+				n = ra.decode (&interleaved[0], b * block_size, block_size);
+			}
+
+			if (n <= 0) {
+				break;
+			}
+			insert (ra.path, ra.n_chn, b, ra.chn, &interleaved[0], n);
+			if (n < block_size) {
+				break;
+			}
+		}
+	}
+}
@@ -29,6 +29,7 @@
 #include "ardour/debug.h"
 #include "ardour/audioplaylist.h"
 #include "ardour/audioregion.h"
+#include "ardour/playlist_render_cache.h"
 #include "ardour/region_sorters.h"
 #include "ardour/session.h"
 
@@ -40,6 +41,7 @@ using namespace PBD;
 
 AudioPlaylist::AudioPlaylist (Session& session, const XMLNode& node, bool hidden)
 	: Playlist (session, node, DataType::AUDIO, hidden)
+	, _render_cache (new PlaylistRenderCache (session, *this))
 {
 #ifndef NDEBUG
 	XMLProperty const * prop = node.property("type");
@@ -55,20 +57,30 @@ AudioPlaylist::AudioPlaylist (Session& session, const XMLNode& node, bool hidden
 	relayer ();
 
 	load_legacy_crossfades (node, Stateful::loading_state_version);
+
+	RegionAdded.connect_same_thread (*this, boost::bind (&AudioPlaylist::region_added_or_removed, this, _1));
+	RegionRemoved.connect_same_thread (*this, boost::bind (&AudioPlaylist::region_added_or_removed, this, _1));
 }
 
 AudioPlaylist::AudioPlaylist (Session& session, string name, bool hidden)
 	: Playlist (session, name, DataType::AUDIO, hidden)
+	, _render_cache (new PlaylistRenderCache (session, *this))
 {
+	RegionAdded.connect_same_thread (*this, boost::bind (&AudioPlaylist::region_added_or_removed, this, _1));
+	RegionRemoved.connect_same_thread (*this, boost::bind (&AudioPlaylist::region_added_or_removed, this, _1));
 }
 
 AudioPlaylist::AudioPlaylist (boost::shared_ptr<const AudioPlaylist> other, string name, bool hidden)
 	: Playlist (other, name, hidden)
+	, _render_cache (new PlaylistRenderCache (_session, *this))
 {
+	RegionAdded.connect_same_thread (*this, boost::bind (&AudioPlaylist::region_added_or_removed, this, _1));
+	RegionRemoved.connect_same_thread (*this, boost::bind (&AudioPlaylist::region_added_or_removed, this, _1));
 }
 
 AudioPlaylist::AudioPlaylist (boost::shared_ptr<const AudioPlaylist> other, samplepos_t start, samplecnt_t cnt, string name, bool hidden)
 	: Playlist (other, start, cnt, name, hidden)
+	, _render_cache (new PlaylistRenderCache (_session, *this))
 {
 	RegionReadLock rlock2 (const_cast<AudioPlaylist*> (other.get()));
 	in_set_state++;
@@ -139,9 +151,27 @@ AudioPlaylist::AudioPlaylist (boost::shared_ptr<const AudioPlaylist> other, samp
 
 	in_set_state--;
 
+	RegionAdded.connect_same_thread (*this, boost::bind (&AudioPlaylist::region_added_or_removed, this, _1));
+	RegionRemoved.connect_same_thread (*this, boost::bind (&AudioPlaylist::region_added_or_removed, this, _1));
+
 	/* this constructor does NOT notify others (session) */
 }
 
+AudioPlaylist::~AudioPlaylist ()
+{
+	/* _render_cache is gone before ~Playlist */
+	drop_connections ();
+}
+
+void
+AudioPlaylist::region_added_or_removed (boost::weak_ptr<Region> wr)
+{
+	boost::shared_ptr<Region> r (wr.lock ());
+	if (r) {
+		_render_cache->invalidate (r->range ());
+	}
+}
+
 /** Sort by descending layer and then by ascending position */
 struct ReadSorter {
     bool operator() (boost::shared_ptr<Region> a, boost::shared_ptr<Region> b) {
@@ -341,10 +371,6 @@ AudioPlaylist::destroy_region (boost::shared_ptr<Region> region)
 bool
 AudioPlaylist::region_changed (const PropertyChange& what_changed, boost::shared_ptr<Region> region)
 {
-	if (in_flush || in_set_state) {
-		return false;
-	}
-
 	PropertyChange bounds;
 	bounds.add (Properties::start);
 	bounds.add (Properties::position);
@@ -360,6 +386,24 @@ AudioPlaylist::region_changed (const PropertyChange& what_changed, boost::shared
 	our_interests.add (Properties::fade_in);
 	our_interests.add (Properties::fade_out);
 
+	PropertyChange rendered;
+	rendered.add (bounds);
+	rendered.add (our_interests);
+	rendered.add (Properties::muted);
+	rendered.add (Properties::layer);
+	rendered.add (Properties::opaque);
+	rendered.add (Properties::contents);
+
+	/* also during flush, relayering changes the output */
+	if (what_changed.contains (rendered)) {
+		_render_cache->invalidate (region->last_range ());
+		_render_cache->invalidate (region->range ());
+	}
+
+	if (in_flush || in_set_state) {
+		return false;
+	}
+
 	bool parent_wants_notify;
 
 	parent_wants_notify = Playlist::region_changed (what_changed, region);
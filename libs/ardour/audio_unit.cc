@@ -968,6 +968,17 @@ AUPlugin::plugin_latency () const
 	return lat;
 }
 
+samplecnt_t
+AUPlugin::plugin_tailtime () const
+{
+	Float64 tail;
+	UInt32 size = sizeof (tail);
+	if (noErr != unit->GetProperty (kAudioUnitProperty_TailTime, kAudioUnitScope_Global, 0, &tail, &size)) {
+		return -1;
+	}
+	return tail * _session.sample_rate ();
+}
+
 void
 AUPlugin::set_parameter (uint32_t which, float val, sampleoffset_t when)
 {
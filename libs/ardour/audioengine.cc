@@ -39,6 +39,7 @@
 #include "pbd/epa.h"
 #include "pbd/file_utils.h"
 #include "pbd/pthread_utils.h"
+#include "pbd/rcu.h"
 #include "pbd/stacktrace.h"
 #include "pbd/unknown_type.h"
 
@@ -284,6 +285,12 @@ AudioEngine::process_callback (pframes_t nframes)
 		thread_init_callback (NULL);
 	}
 
+	/* Everything below may use EpochRCUManager::rt_reader () values, which
+	 * remain valid until the end of the cycle. This also covers the graph
+	 * process threads, which complete before Session::process returns.
+	 */
+	PBD::RCUEpoch::ReadSection rcu_section;
+
 	/* This is for JACK, where the latency callback arrives in sync with
 	 * port registration (usually while ardour holds the process-lock
 	 * or with _adding_routes_in_progress or _route_deletion_in_progress set,
@@ -1388,6 +1395,7 @@ AudioEngine::thread_init_callback (void* arg)
 	SessionEvent::create_per_thread_pool (thread_name, 512);
 	PBD::notify_event_loops_about_thread_creation (pthread_self(), thread_name, 4096);
 	AsyncMIDIPort::set_process_thread (pthread_self());
+	PBD::RCUEpoch::register_thread ();
 
 	if (arg) {
 		delete AudioEngine::instance()->_main_thread;
@@ -30,6 +30,7 @@
 
 #include "pbd/error.h"
 #include "pbd/pthread_utils.h"
+#include "pbd/rcu.h"
 
 #include "ardour/butler.h"
 #include "ardour/debug.h"
@@ -293,6 +294,11 @@ Butler::thread_work ()
 			goto restart;
 		}
 
+		if (!err && !disk_work_outstanding && !transport_work_requested()) {
+			/* only once playback buffers are filled and captured data is written */
+			disk_work_outstanding = refill_cues (rl);
+		}
+
 		if (!disk_work_outstanding) {
 			_session.refresh_disk_space ();
 		}
@@ -312,6 +318,9 @@ Butler::thread_work ()
 
 		DEBUG_TRACE (DEBUG::Butler, "butler emptying pool trash\n");
 		empty_pool_trash ();
+
+		/* delete old RCU values that process threads can no longer use */
+		PBD::RCUEpoch::reclaim ();
 	}
 
 	return (0);
@@ -362,6 +371,36 @@ Butler::flush_tracks_to_disk_normal (boost::shared_ptr<RouteList> rl, uint32_t&
 	return disk_work_outstanding;
 }
 
+/** Read the audio at likely locate targets, one chunk per track at a time */
+bool
+Butler::refill_cues (boost::shared_ptr<RouteList> rl)
+{
+	bool cue_work_outstanding = false;
+
+	_session.update_cue_positions ();
+
+	for (RouteList::iterator i = rl->begin(); !transport_work_requested() && should_run && i != rl->end(); ++i) {
+
+		boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+
+		if (!tr) {
+			continue;
+		}
+
+		boost::shared_ptr<IO> io = tr->input ();
+
+		if (io && !io->active()) {
+			continue;
+		}
+
+		if (tr->refill_cues ()) {
+			cue_work_outstanding = true;
+		}
+	}
+
+	return cue_work_outstanding;
+}
+
 bool
 Butler::flush_tracks_to_disk_after_locate (boost::shared_ptr<RouteList> rl, uint32_t& errors)
 {
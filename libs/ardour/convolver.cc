@@ -17,6 +17,7 @@
  */
 
 #include <assert.h>
+#include <cstring>
 
 #include "pbd/error.h"
 #include "pbd/pthread_utils.h"
@@ -27,11 +28,13 @@
 #include "ardour/chan_mapping.h"
 #include "ardour/convolver.h"
 #include "ardour/dsp_filter.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/readable.h"
 #include "ardour/session.h"
 #include "ardour/source_factory.h"
 #include "ardour/srcfilesource.h"
 #include "ardour/types.h"
+#include "ardour/utils.h"
 
 #include "pbd/i18n.h"
 
@@ -39,8 +42,154 @@ using namespace ARDOUR;
 using namespace ARDOUR::DSP;
 using namespace ArdourZita;
 
+ConvolutionPool*     ConvolutionPool::_instance      = 0;
+uint32_t             ConvolutionPool::_instance_refs = 0;
+Glib::Threads::Mutex ConvolutionPool::_instance_lock;
+
+ConvolutionPool::Level::Level (ConvolutionPool* p)
+	: pool (p)
+	, queue (queue_size)
+	, sem ("convolution", 0)
+{
+}
+
+ConvolutionPool::ConvolutionPool (uint32_t n_threads, bool realtime, int priority)
+	: _run (1)
+{
+	for (int l = 0; l < n_levels; ++l) {
+		_levels[l] = new Level (this);
+	}
+
+	for (int l = 0; l < n_levels; ++l) {
+		/* like zita-convolver, one step lower for each doubling of the partition size */
+		const int level_priority = priority - 1 - l;
+
+		for (uint32_t i = 0; i < std::max<uint32_t> (1, n_threads); ++i) {
+			pthread_t thread_id;
+			int rv = 1;
+			/* same stack-size as zita-convolver's threads */
+			if (realtime) {
+				rv = pbd_realtime_pthread_create (PBD_SCHED_FIFO, level_priority, 0x10000, &thread_id, _thread_run, _levels[l]);
+			}
+			if (rv) {
+				rv = pbd_pthread_create (0x10000, &thread_id, _thread_run, _levels[l]);
+			}
+			if (rv) {
+				/* schedule() will fail, and partitions are processed by the caller */
+				PBD::error << string_compose (_("Convolution: cannot create worker thread (%1)"), strerror (rv)) << endmsg;
+				break;
+			}
+			pbd_mach_set_realtime_policy (thread_id, 5. * 1e-5);
+			_levels[l]->threads.push_back (thread_id);
+		}
+	}
+}
+
+ConvolutionPool::~ConvolutionPool ()
+{
+	g_atomic_int_set (&_run, 0);
+
+	for (int l = 0; l < n_levels; ++l) {
+		for (uint32_t i = 0; i < _levels[l]->threads.size (); ++i) {
+			_levels[l]->sem.signal ();
+		}
+		for (std::vector<pthread_t>::const_iterator i = _levels[l]->threads.begin (); i != _levels[l]->threads.end (); ++i) {
+			pthread_join (*i, NULL);
+		}
+		delete _levels[l];
+	}
+}
+
+uint32_t
+ConvolutionPool::n_threads () const
+{
+	uint32_t n = 0;
+	for (int l = 0; l < n_levels; ++l) {
+		n += _levels[l]->threads.size ();
+	}
+	return n;
+}
+
+ConvolutionPool*
+ConvolutionPool::acquire ()
+{
+	Glib::Threads::Mutex::Lock lm (_instance_lock);
+	if (_instance_refs++ == 0) {
+		AudioEngine* engine = AudioEngine::instance ();
+		/* late partitions have a deadline of at least two cycles,
+		 * run them below the process threads.
+		 */
+		_instance = new ConvolutionPool (how_many_dsp_threads (), engine->is_realtime (),
+		                                 pbd_absolute_rt_priority (PBD_SCHED_FIFO, engine->client_real_time_priority () - 2));
+	}
+	return _instance;
+}
+
+void
+ConvolutionPool::release ()
+{
+	Glib::Threads::Mutex::Lock lm (_instance_lock);
+	assert (_instance_refs > 0);
+	if (--_instance_refs == 0) {
+		delete _instance;
+		_instance = 0;
+	}
+}
+
+bool
+ConvolutionPool::schedule (Convlevel* lev, int prio)
+{
+	/* prio is relative: 0 for the cycle-size partition, which is
+	 * processed by the caller, -1 for twice that size, etc.
+	 * With synchronous processing every level has at most one pending cycle.
+	 */
+	Level* l = _levels[std::max (0, std::min (-prio, (int)n_levels) - 1)];
+
+	if (l->threads.empty ()) {
+		return false;
+	}
+	if (!l->queue.push_back (lev)) {
+		return false;
+	}
+	l->sem.signal ();
+	return true;
+}
+
+/*static*/ void*
+ConvolutionPool::_thread_run (void* arg)
+{
+	Level* l = static_cast<Level*> (arg);
+	pthread_set_name ("Convolution");
+	l->pool->run (l);
+	pthread_exit (0);
+	return 0;
+}
+
+void
+ConvolutionPool::run (Level* l)
+{
+	while (true) {
+		l->sem.wait ();
+
+		if (0 == g_atomic_int_get (&_run)) {
+			break;
+		}
+
+		Convlevel* lev = 0;
+		while (!l->queue.pop_front (lev)) {
+			/* a producer has claimed a slot, but not yet written it */
+			sched_yield ();
+		}
+
+		Convsched::run (lev);
+	}
+}
+
+/* ****************************************************************************/
+
 Convolution::Convolution (Session& session, uint32_t n_in, uint32_t n_out)
     : SessionHandleRef (session)
+    , _pool (Config->get_use_convolution_pool () ? ConvolutionPool::acquire () : 0)
     , _n_samples (0)
     , _max_size (0)
     , _offset (0)
@@ -48,9 +197,20 @@ Convolution::Convolution (Session& session, uint32_t n_in, uint32_t n_out)
     , _n_inputs (n_in)
     , _n_outputs (n_out)
 {
+	_convproc.set_scheduler (_pool);
 	AudioEngine::instance ()->BufferSizeChanged.connect_same_thread (*this, boost::bind (&Convolution::restart, this));
 }
 
+Convolution::~Convolution ()
+{
+	/* wait for pending cycles in the pool */
+	_convproc.stop_process ();
+	_convproc.cleanup ();
+	if (_pool) {
+		ConvolutionPool::release ();
+	}
+}
+
 bool
 Convolution::add_impdata (
     uint32_t                    c_in,
@@ -98,7 +258,12 @@ Convolution::restart ()
 	for (power_of_two = 1; 1U << power_of_two < _n_samples; ++power_of_two) ;
 	_n_samples = 1 << power_of_two;
 
-	int n_part = std::min ((uint32_t)Convproc::MAXPART, 4 * _n_samples);
+	/* Late partitions run concurrently in the ConvolutionPool, with a
+	 * deadline proportional to their size. Large partitions considerably
+	 * reduce the cost of long IRs, without adding latency.
+	 * zita-convolver's own threads keep the previous limit.
+	 */
+	int n_part = std::min ((uint32_t)Convproc::MAXPART, (_pool ? 64 : 4) * _n_samples);
 
 	int rv = _convproc.configure (
 	    /*in*/ _n_inputs,
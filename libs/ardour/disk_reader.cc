@@ -38,6 +38,8 @@
 #include "ardour/pannable.h"
 #include "ardour/playlist.h"
 #include "ardour/playlist_factory.h"
+#include "ardour/playlist_render_cache.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/session.h"
 #include "ardour/session_playlists.h"
 
@@ -57,6 +59,10 @@ DiskReader::Declicker DiskReader::loop_declick_in;
 DiskReader::Declicker DiskReader::loop_declick_out;
 samplecnt_t           DiskReader::loop_fade_length (0);
 
+Glib::Threads::Mutex     DiskReader::_cue_position_lock;
+std::vector<samplepos_t> DiskReader::_cue_positions;
+gint                     DiskReader::_cue_position_generation (0);
+
 DiskReader::DiskReader (Session& s, string const& str, DiskIOProcessor::Flag f)
 	: DiskIOProcessor (s, str, f)
 	, overwrite_sample (0)
@@ -65,10 +71,12 @@ DiskReader::DiskReader (Session& s, string const& str, DiskIOProcessor::Flag f)
 	, _declick_offs (0)
 	, _declick_enabled (false)
 	, last_refill_loop_start (0)
+	, _cue_generation (-1)
 {
 	file_sample[DataType::AUDIO] = 0;
 	file_sample[DataType::MIDI]  = 0;
 	g_atomic_int_set (&_pending_overwrite, 0);
+	g_atomic_int_set (&_cues_invalid, 0);
 }
 
 DiskReader::~DiskReader ()
@@ -239,9 +247,31 @@ DiskReader::adjust_buffering ()
 void
 DiskReader::playlist_modified ()
 {
+	g_atomic_int_set (&_cues_invalid, 1);
+	setup_render_cache ();
 	_session.request_overwrite_buffer (_track, PlaylistModified);
 }
 
+/** Automatically flatten playlists with many regions into a file, which is
+ * read instead of the playlist's regions when possible.
+ */
+void
+DiskReader::setup_render_cache ()
+{
+	boost::shared_ptr<AudioPlaylist> pl = audio_playlist ();
+	if (!pl) {
+		return;
+	}
+
+	const uint32_t min_regions = Config->get_playlist_render_cache_regions ();
+
+	if (min_regions == 0) {
+		pl->render_cache ().set_enabled (false);
+	} else if (pl->n_regions () >= min_regions) {
+		pl->render_cache ().set_enabled (true);
+	}
+}
+
 int
 DiskReader::use_playlist (DataType dt, boost::shared_ptr<Playlist> playlist)
 {
@@ -255,6 +285,11 @@ DiskReader::use_playlist (DataType dt, boost::shared_ptr<Playlist> playlist)
 		return -1;
 	}
 
+	if (dt == DataType::AUDIO) {
+		g_atomic_int_set (&_cues_invalid, 1);
+		setup_render_cache ();
+	}
+
 	/* don't do this if we've already asked for it *or* if we are setting up
 	 * the diskstream for the very first time - the input changed handling will
 	 * take care of the buffer refill. */
@@ -270,7 +305,7 @@ void
 DiskReader::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sample, double speed, pframes_t nframes, bool result_required)
 {
 	uint32_t                       n;
-	boost::shared_ptr<ChannelList> c = channels.reader ();
+	ChannelList*                   c = channels.rt_reader ();
 	ChannelList::iterator          chan;
 	sampleoffset_t                 disk_samples_to_consume;
 	MonitorState                   ms = _track->monitoring_state ();
@@ -615,6 +650,10 @@ DiskReader::set_pending_overwrite (OverwriteReason why)
 		run_must_resolve = true;
 	}
 
+	if (why & (PlaylistModified | PlaylistChanged)) {
+		g_atomic_int_set (&_cues_invalid, 1);
+	}
+
 	while (true) {
 		OverwriteReason current = OverwriteReason (g_atomic_int_get (&_pending_overwrite));
 		OverwriteReason next    = OverwriteReason (current | why);
@@ -880,7 +919,10 @@ DiskReader::seek (samplepos_t sample, bool complete_refill)
 	file_sample[DataType::AUDIO] = sample;
 	file_sample[DataType::MIDI]  = sample;
 
-	if (complete_refill) {
+	if (!read_reversed && refill_from_cue (sample + shift, shift)) {
+		/* the butler will read the rest */
+		ret = 0;
+	} else if (complete_refill) {
 		/* call _do_refill() to refill the entire buffer, using
 		 * the largest reads possible. */
 		while ((ret = do_refill_with_alloc (false, read_reversed)) > 0)
@@ -1045,7 +1087,9 @@ DiskReader::audio_read (Sample*            sum_buffer,
 		 * useful after the return from AudioPlayback::read()
 		 */
 
-		if (audio_playlist ()->read (sum_buffer, mixdown_buffer, gain_buffer, start, this_read, channel) != this_read) {
+		if (audio_playlist ()->render_cache ().read (sum_buffer, start, this_read, channel)) {
+			/* read the flattened playlist as single stream */
+		} else if (audio_playlist ()->read (sum_buffer, mixdown_buffer, gain_buffer, start, this_read, channel) != this_read) {
 			error << string_compose (_("DiskReader %1: cannot read %2 from playlist at sample %3"), id (), this_read, start) << endmsg;
 			return 0;
 		}
@@ -1959,3 +2003,228 @@ DiskReader::setup_preloop_buffer ()
 		}
 	}
 }
+
+DiskReader::CueBuffer::CueBuffer (samplepos_t p)
+	: position (p)
+	, shift (0)
+	, size (0)
+	, length (0)
+	, read_pos (0)
+	, loop_start (-1)
+	, loop_end (-1)
+	, loop_fade (NoLoopFade)
+{
+}
+
+DiskReader::CueBuffer::~CueBuffer ()
+{
+	for (vector<Sample*>::iterator i = data.begin (); i != data.end (); ++i) {
+		delete[] *i;
+	}
+}
+
+void
+DiskReader::CueBuffer::reset (uint32_t n_chans, samplecnt_t sz, samplecnt_t s, Location* loc)
+{
+	if (sz != size || n_chans != data.size ()) {
+		for (vector<Sample*>::iterator i = data.begin (); i != data.end (); ++i) {
+			delete[] *i;
+		}
+		data.clear ();
+		for (uint32_t n = 0; n < n_chans; ++n) {
+			data.push_back (new Sample[sz]);
+		}
+		size = sz;
+	}
+
+	shift      = s;
+	length     = 0;
+	read_pos   = position - shift;
+	loop_start = loc ? loc->start () : -1;
+	loop_end   = loc ? loc->end () : -1;
+	loop_fade  = Config->get_loop_fade_choice ();
+}
+
+bool
+DiskReader::CueBuffer::matches (uint32_t n_chans, samplecnt_t s, Location* loc) const
+{
+	/* audio_read() uses the loop-range and loop-fades, the data is only
+	 * valid if those did not change. */
+	return n_chans == data.size ()
+		&& s == shift
+		&& loop_start == (loc ? loc->start () : -1)
+		&& loop_end == (loc ? loc->end () : -1)
+		&& loop_fade == Config->get_loop_fade_choice ();
+}
+
+void
+DiskReader::set_cue_positions (vector<samplepos_t> const& pos)
+{
+	Glib::Threads::Mutex::Lock lm (_cue_position_lock);
+	if (pos == _cue_positions) {
+		return;
+	}
+	_cue_positions = pos;
+	g_atomic_int_inc (&_cue_position_generation);
+}
+
+int
+DiskReader::refill_cues ()
+{
+	/* called from the butler thread */
+
+	if (_session.loading ()) {
+		return 0;
+	}
+
+	boost::shared_ptr<ChannelList> c = channels.reader ();
+
+	const samplecnt_t cue_length = Config->get_cue_buffer_seconds () * _session.nominal_sample_rate ();
+	const bool        reset      = g_atomic_int_compare_and_exchange (&_cues_invalid, 1, 0);
+
+	Glib::Threads::Mutex::Lock lm (_cue_lock);
+
+	if (cue_length <= 0 || c->empty () || !_playlists[DataType::AUDIO]) {
+		_cues.clear ();
+		_cue_generation = -1;
+		return 0;
+	}
+
+	const gint gen = g_atomic_int_get (&_cue_position_generation);
+
+	if (gen != _cue_generation) {
+		vector<samplepos_t> pos;
+		{
+			Glib::Threads::Mutex::Lock lp (_cue_position_lock);
+			pos = _cue_positions;
+		}
+
+		/* keep the data of positions that did not change */
+		CueList cues;
+		for (vector<samplepos_t>::const_iterator p = pos.begin (); p != pos.end (); ++p) {
+			CueList::iterator i;
+			for (i = _cues.begin (); i != _cues.end (); ++i) {
+				if ((*i)->position == *p) {
+					break;
+				}
+			}
+			if (i != _cues.end ()) {
+				cues.push_back (*i);
+			} else {
+				cues.push_back (boost::shared_ptr<CueBuffer> (new CueBuffer (*p)));
+			}
+		}
+		_cues.swap (cues);
+		_cue_generation = gen;
+	}
+
+	/* the data must fit into the playback buffer, including the
+	 * reserved part for backwards internal-seeks, see ::seek() */
+	const samplecnt_t reservation = c->front ()->rbuf->reservation_size ();
+	const samplecnt_t capacity    = c->front ()->rbuf->bufsize () - reservation - 1;
+	Location*         loc         = _loop_location;
+
+	boost::shared_ptr<CueBuffer> cue;
+
+	for (CueList::iterator i = _cues.begin (); i != _cues.end (); ++i) {
+		const samplecnt_t shift = min ((*i)->position, reservation);
+		const samplecnt_t size  = min (shift + cue_length, capacity);
+		if (reset || size != (*i)->size || !(*i)->matches (c->size (), shift, loc)) {
+			(*i)->reset (c->size (), size, shift, loc);
+		}
+		if (!cue && (*i)->length < (*i)->size) {
+			cue = *i;
+		}
+	}
+
+	if (!cue) {
+		return 0;
+	}
+
+	/* read one chunk at a time, to not delay any transport work */
+	const samplecnt_t to_read = min (_chunk_samples, cue->size - cue->length);
+
+	boost::optional<bool> last_read_reversed = _last_read_reversed;
+	boost::optional<bool> last_read_loop     = _last_read_loop;
+
+	samplepos_t pos = cue->read_pos;
+	uint32_t    n   = 0;
+
+	for (ChannelList::iterator chan = c->begin (); chan != c->end (); ++chan, ++n) {
+		pos = cue->read_pos;
+		if (audio_read (cue->data[n] + cue->length, _mixdown_buffer, _gain_buffer, pos, to_read, dynamic_cast<ReaderChannelInfo*> (*chan), n, false) != to_read) {
+			break;
+		}
+	}
+
+	_last_read_reversed = last_read_reversed;
+	_last_read_loop     = last_read_loop;
+
+	if (n != c->size ()) {
+		/* try again, when the playlist changes */
+		cue->size = cue->length;
+		return 0;
+	}
+
+	cue->read_pos = pos;
+	cue->length += to_read;
+
+	for (CueList::const_iterator i = _cues.begin (); i != _cues.end (); ++i) {
+		if ((*i)->length < (*i)->size) {
+			return 1;
+		}
+	}
+
+	DEBUG_TRACE (DEBUG::DiskIO, string_compose ("%1: %2 cue buffers complete\n", name (), _cues.size ()));
+	return 0;
+}
+
+/** Fill the playback buffers with data from a cue buffer, instead of reading from disk.
+ * Called by ::seek() after the buffers were reset.
+ */
+bool
+DiskReader::refill_from_cue (samplepos_t sample, samplecnt_t shift)
+{
+	if (g_atomic_int_get (&_cues_invalid)) {
+		return false;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_cue_lock);
+
+	boost::shared_ptr<ChannelList> c   = channels.reader ();
+	Location*                      loc = _loop_location;
+
+	for (CueList::const_iterator i = _cues.begin (); i != _cues.end (); ++i) {
+		boost::shared_ptr<CueBuffer> cue (*i);
+
+		if (cue->position != sample) {
+			continue;
+		}
+
+		/* use partial data only if there is at least one chunk to play */
+		if (cue->length <= shift || cue->length < min (cue->size, shift + _chunk_samples) || !cue->matches (c->size (), shift, loc)) {
+			return false;
+		}
+
+		for (ChannelList::iterator chan = c->begin (); chan != c->end (); ++chan) {
+			if ((*chan)->rbuf->write_space () < (guint) cue->length) {
+				return false;
+			}
+		}
+
+		uint32_t n = 0;
+		for (ChannelList::iterator chan = c->begin (); chan != c->end (); ++chan, ++n) {
+			(*chan)->rbuf->write (cue->data[n], cue->length);
+			dynamic_cast<ReaderChannelInfo*> (*chan)->initialized = true;
+		}
+
+		file_sample[DataType::AUDIO] = cue->read_pos;
+		_last_read_reversed          = false;
+		_last_read_loop              = (bool)loc;
+
+		DEBUG_TRACE (DEBUG::DiskIO, string_compose ("%1: seek to %2 using %3 samples of cue buffer\n", name (), sample, cue->length));
+		return true;
+	}
+
+	return false;
+}
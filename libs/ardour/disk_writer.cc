@@ -375,7 +375,7 @@ DiskWriter::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 	_active = _pending_active;
 
 	uint32_t n;
-	boost::shared_ptr<ChannelList> c = channels.reader();
+	ChannelList* c = channels.rt_reader ();
 	ChannelList::iterator chan;
 
 	samplecnt_t rec_offset = 0;
@@ -631,7 +631,7 @@ DiskWriter::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 		/* not recording this time, but perhaps we were before .. */
 
 		if (_was_recording) {
-			finish_capture (c);
+			finish_capture (channels.reader ());
 			_accumulated_capture_offset = 0;
 		}
 	}
@@ -17,21 +17,21 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
-#include <cmath>
-#include <cstring>
+#include <vector>
+
+#include <boost/scoped_array.hpp>
+
+#include "audiographer/general/loudness_dsp.h"
 
 #include "ardour/ebur128_analysis.h"
 
 #include "pbd/i18n.h"
 
-using namespace Vamp;
 using namespace ARDOUR;
 using namespace std;
 
-/* need a static initializer function for this */
-
 EBUr128Analysis::EBUr128Analysis (float sr)
-	: AudioAnalyser (sr, X_("libardourvampplugins:ebur128"))
+	: _sample_rate (sr)
 	, _loudness (0)
 	, _loudness_range (0)
 {
@@ -44,71 +44,34 @@ EBUr128Analysis::~EBUr128Analysis()
 int
 EBUr128Analysis::run (Readable* src)
 {
-	int ret = -1;
-	bool done = false;
-	samplecnt_t len = src->readable_length();
-	samplepos_t pos = 0;
-	uint32_t n_channels = src->n_channels();
-	Plugin::FeatureSet features;
-
-	plugin->reset ();
-	if (!plugin->initialise (n_channels, stepsize, bufsize)) {
-		return -1;
-	}
+	const samplecnt_t bufsize = 8192;
+	const samplecnt_t len = src->readable_length();
+	const uint32_t n_channels = src->n_channels();
+
+	AudioGrapher::LoudnessDsp ebu;
+	ebu.init (n_channels, _sample_rate);
+	ebu.integr_start ();
 
-	float** bufs = (float**) malloc(n_channels * sizeof(float*));
+	boost::scoped_array<Sample> data (new Sample[bufsize * n_channels]);
+	vector<Sample const*> bufs (n_channels);
 	for (uint32_t c = 0; c < n_channels; ++c) {
-		bufs[c] = (float*) malloc(bufsize * sizeof(float));
+		bufs[c] = &data[c * bufsize];
 	}
 
-	while (!done) {
-		samplecnt_t to_read;
-		to_read = min ((len - pos), (samplecnt_t) bufsize);
+	for (samplepos_t pos = 0; pos < len; pos += bufsize) {
+		const samplecnt_t to_read = min (len - pos, bufsize);
 
 		for (uint32_t c = 0; c < n_channels; ++c) {
-			if (src->read (bufs[c], pos, to_read, c) != to_read) {
-				goto out;
-			}
-			/* zero fill buffer if necessary */
-			if (to_read != bufsize) {
-				memset (bufs[c] + to_read, 0, (bufsize - to_read) * sizeof (float));
+			if (src->read (&data[c * bufsize], pos, to_read, c) != to_read) {
+				return -1;
 			}
 		}
 
-		plugin->process (bufs, RealTime::fromSeconds ((double) pos / sample_rate));
-
-		pos += min (stepsize, to_read);
-
-		if (pos >= len) {
-			done = true;
-		}
+		ebu.process (&bufs[0], to_read);
 	}
 
-	features = plugin->getRemainingFeatures ();
-
-	if (use_features (features, 0)) {
-		goto out;
-	}
-
-	ret = 0;
-
-out:
-	for (uint32_t c = 0; c < n_channels; ++c) {
-		free (bufs[c]);
-	}
-	free (bufs);
-
-	return ret;
-}
-
-int
-EBUr128Analysis::use_features (Plugin::FeatureSet& features, ostream* out)
-{
-	if (features.empty() || features.size() != 2) {
-		return 0;
-	}
-	_loudness = features[0][0].values[0];
-	_loudness_range = features[1][0].values[0];
+	_loudness = ebu.integrated ();
+	_loudness_range = ebu.loudness_range ();
 
 	return 0;
 }
@@ -99,6 +99,7 @@
 #include "LuaBridge/LuaBridge.h"
 
 #include "ardour/analyser.h"
+#include "ardour/audio_block_cache.h"
 #include "ardour/audio_backend.h"
 #include "ardour/audio_library.h"
 #include "ardour/audioengine.h"
@@ -116,6 +117,7 @@
 #include "ardour/mix.h"
 #include "ardour/operations.h"
 #include "ardour/panner_manager.h"
+#include "ardour/playlist_render_cache.h"
 #include "ardour/plugin_manager.h"
 #include "ardour/presentation_info.h"
 #include "ardour/process_thread.h"
@@ -549,6 +551,8 @@ ARDOUR::init (bool use_windows_vst, bool try_optimization, const char* localedir
 
 	SourceFactory::init ();
 	Analyser::init ();
+	PlaylistRenderCache::init ();
+	AudioBlockCache::init ();
 
 	/* singletons - first object is "it" */
 	(void)PluginManager::instance ();
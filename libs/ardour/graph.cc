@@ -65,6 +65,7 @@ Graph::Graph (Session& session)
 	, _current_chain (0)
 	, _pending_chain (0)
 	, _setup_chain (1)
+	, _cycle_start (0)
 {
 	g_atomic_int_set (&_terminal_refcnt, 0);
 	g_atomic_int_set (&_terminate, 0);
@@ -304,6 +305,8 @@ Graph::reached_terminal_node ()
 			return;
 		}
 
+		_wait_histogram.record (std::max<int64_t> (0, g_get_monotonic_time () - _cycle_start));
+
 		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 prepare new cycle.\n", pthread_name ()));
 
 		/* Prepare next cycle:
@@ -423,12 +426,15 @@ Graph::run_one ()
 		assert (g_atomic_uint_get (&_idle_thread_cnt) <= _n_workers);
 
 		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 goes to sleep\n", pthread_name ()));
+		const int64_t t0 = g_get_monotonic_time ();
 		_execution_sem.wait ();
 
 		if (g_atomic_int_get (&_terminate)) {
 			return;
 		}
 
+		_wait_histogram.record (std::max<int64_t> (0, g_get_monotonic_time () - std::max (t0, _cycle_start)));
+
 		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 is awake\n", pthread_name ()));
 
 		g_atomic_int_dec_and_test (&_idle_thread_cnt);
@@ -508,6 +514,8 @@ again:
 		return;
 	}
 
+	_wait_histogram.record (std::max<int64_t> (0, g_get_monotonic_time () - _cycle_start));
+
 	/* Bootstrap the trigger-list
 	 * (later this is done by Graph_reached_terminal_node) */
 	prep ();
@@ -622,8 +630,11 @@ Graph::process_routes (pframes_t nframes, samplepos_t start_sample, samplepos_t
 	_process_need_butler = false;
 
 	DEBUG_TRACE (DEBUG::ProcessThreads, "wake graph for non-silent process\n");
+	const int64_t t0 = g_get_monotonic_time ();
+	_cycle_start = t0;
 	_callback_start_sem.signal ();
 	_callback_done_sem.wait ();
+	_dsp_histogram.record (g_get_monotonic_time () - t0);
 	DEBUG_TRACE (DEBUG::ProcessThreads, "graph execution complete\n");
 
 	need_butler = _process_need_butler;
@@ -650,8 +661,11 @@ Graph::routes_no_roll (pframes_t nframes, samplepos_t start_sample, samplepos_t
 	_process_need_butler = false;
 
 	DEBUG_TRACE (DEBUG::ProcessThreads, "wake graph for no-roll process\n");
+	const int64_t t0 = g_get_monotonic_time ();
+	_cycle_start = t0;
 	_callback_start_sem.signal ();
 	_callback_done_sem.wait ();
+	_dsp_histogram.record (g_get_monotonic_time () - t0);
 	DEBUG_TRACE (DEBUG::ProcessThreads, "graph execution complete\n");
 
 	return _process_retval;
@@ -666,12 +680,16 @@ Graph::process_one_route (Route* route)
 
 	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 runs route %2\n", pthread_name (), route->name ()));
 
+	const int64_t t0 = g_get_monotonic_time ();
+
 	if (_process_noroll) {
 		retval = route->no_roll (_process_nframes, _process_start_sample, _process_end_sample, _process_non_rt_pending);
 	} else {
 		retval = route->roll (_process_nframes, _process_start_sample, _process_end_sample, need_butler);
 	}
 
+	route->dsp_histogram ().record (g_get_monotonic_time () - t0);
+
 	if (retval) {
 		_process_retval = retval;
 	}
@@ -76,7 +76,14 @@ InternalReturn::set_playback_offset (samplecnt_t cnt)
 
 	Glib::Threads::Mutex::Lock lm (_sends_mutex); // TODO reader lock
 	for (list<InternalSend*>::iterator i = _sends.begin(); i != _sends.end(); ++i) {
+		if ((*i)->get_delay_out () == cnt) {
+			continue;
+		}
 		(*i)->set_delay_out (cnt);
+		/* the send's latency changed, its route has to be updated again */
+		if (boost::shared_ptr<Route> r = (*i)->source_route ()) {
+			r->queue_latency_recompute ();
+		}
 	}
 }
 
@@ -24,6 +24,7 @@
 
 #include "pbd/stateful_diff_command.h"
 #include "pbd/openuri.h"
+#include "pbd/timing.h"
 
 #include "temporal/bbt_time.h"
 
@@ -400,6 +401,19 @@ LuaBindings::common (lua_State* L)
 
 		.beginStdVector <PBD::ID> ("IdVector").endClass ()
 
+		.beginClass <PBD::TimingHistogram> ("TimingHistogram")
+		.addFunction ("count", &PBD::TimingHistogram::count)
+		.addFunction ("max", &PBD::TimingHistogram::max)
+		.addFunction ("avg", &PBD::TimingHistogram::avg)
+		.addFunction ("percentile", &PBD::TimingHistogram::percentile)
+		.addFunction ("count_above", &PBD::TimingHistogram::count_above)
+		.addFunction ("bin", &PBD::TimingHistogram::bin)
+		.addFunction ("summary", &PBD::TimingHistogram::summary)
+		.addFunction ("request_reset", &PBD::TimingHistogram::request_reset)
+		.addStaticFunction ("bin_lower", &PBD::TimingHistogram::bin_lower)
+		.addStaticFunction ("bin_upper", &PBD::TimingHistogram::bin_upper)
+		.endClass ()
+
 		.beginClass <XMLNode> ("XMLNode")
 		.addFunction ("name", &XMLNode::name)
 		.endClass ()
@@ -1087,6 +1101,7 @@ LuaBindings::common (lua_State* L)
 		.deriveWSPtrClass <Route, Stripable> ("Route")
 		.addCast<Track> ("to_track")
 		.addFunction ("set_name", &Route::set_name)
+		.addFunction ("dsp_histogram", &Route::dsp_histogram)
 		.addFunction ("comment", &Route::comment)
 		.addFunction ("active", &Route::active)
 		.addFunction ("data_type", &Route::data_type)
@@ -1438,6 +1453,7 @@ LuaBindings::common (lua_State* L)
 #endif
 		.addCast<PeakMeter> ("to_meter")
 		.addFunction ("display_name", &Processor::display_name)
+		.addFunction ("dsp_histogram", &Processor::dsp_histogram)
 		.addFunction ("display_to_user", &Processor::display_to_user)
 		.addFunction ("active", &Processor::active)
 		.addFunction ("activate", &Processor::activate)
@@ -1563,6 +1579,8 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("is_channelstrip", &PluginInsert::is_channelstrip)
 		.addFunction ("clear_stats", &PluginInsert::clear_stats)
 		.addRefFunction ("get_stats", &PluginInsert::get_stats)
+		.addFunction ("sleep_ratio", &PluginInsert::sleep_ratio)
+		.addFunction ("sleeping", &PluginInsert::sleeping)
 		.endClass ()
 
 		.deriveWSPtrClass <ReadOnlyControl, PBD::StatefulDestructible> ("ReadOnlyControl")
@@ -2447,6 +2465,12 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("get_stripables", (StripableList (Session::*)() const)&Session::get_stripables)
 		.addFunction ("get_routelist", &Session::get_routelist)
 		.addFunction ("plot_process_graph", &Session::plot_process_graph)
+		.addFunction ("write_dsp_profile", &Session::write_dsp_profile)
+		.addFunction ("reset_dsp_profile", &Session::reset_dsp_profile)
+		.addFunction ("process_graph_dsp_histogram", &Session::process_graph_dsp_histogram)
+		.addFunction ("process_graph_wait_histogram", &Session::process_graph_wait_histogram)
+		.addFunction ("latency_compensation_histogram", &Session::latency_compensation_histogram)
+		.addFunction ("latency_callback_histogram", &Session::latency_callback_histogram)
 
 		.addFunction ("name", &Session::name)
 		.addFunction ("path", &Session::path)
@@ -43,16 +43,22 @@
 using namespace ARDOUR;
 using namespace PBD;
 
+const size_t LuaProc::max_arena_size;
+
 LuaProc::LuaProc (AudioEngine& engine,
                   Session& session,
                   const std::string &script)
 	: Plugin (engine, session)
-	, _mempool ("LuaProc", 3145728)
+	, _arena_size (0)
+	, _dsp_ran (false)
 #ifdef USE_TLSF
+	, _mempool ("LuaProc", max_arena_size, false)
 	, lua (lua_newstate (&PBD::TLSF::lalloc, &_mempool))
 #elif defined USE_MALLOC
+	, _mempool ("LuaProc", max_arena_size)
 	, lua ()
 #else
+	, _mempool ("LuaProc", max_arena_size)
 	, lua (lua_newstate (&PBD::ReallocPool::lalloc, &_mempool))
 #endif
 	, _lua_dsp (0)
@@ -81,12 +87,16 @@ LuaProc::LuaProc (AudioEngine& engine,
 
 LuaProc::LuaProc (const LuaProc &other)
 	: Plugin (other)
-	, _mempool ("LuaProc", 3145728)
+	, _arena_size (0)
+	, _dsp_ran (false)
 #ifdef USE_TLSF
+	, _mempool ("LuaProc", max_arena_size, false)
 	, lua (lua_newstate (&PBD::TLSF::lalloc, &_mempool))
 #elif defined USE_MALLOC
+	, _mempool ("LuaProc", max_arena_size)
 	, lua ()
 #else
+	, _mempool ("LuaProc", max_arena_size)
 	, lua (lua_newstate (&PBD::ReallocPool::lalloc, &_mempool))
 #endif
 	, _lua_dsp (0)
@@ -129,7 +139,14 @@ LuaProc::~LuaProc () {
 				0.0001f * _stats_max[1],
 				_stats_max[1] * (float)_stats_cnt / _stats_avg[1]);
 	}
+	if (_info) {
+		size_t used, peak, size;
+		arena_usage (used, peak, size);
+		printf ("LuaProc: '%s' mem   used: %zu  peak: %zu  size: %zu [bytes]\n",
+				_info->name.c_str (), used, peak, size);
+	}
 #endif
+	update_arena_peak ();
 	lua.collect_garbage ();
 	delete (_lua_dsp);
 	delete (_lua_latency);
@@ -182,6 +199,50 @@ LuaProc::init ()
 	lua.do_command ("function ardour () end");
 }
 
+size_t
+LuaProc::arena_size (LuaScripting::DSPScriptPtr ds)
+{
+	const size_t min_size = 524288;
+
+	/* The pool always has max_arena_size, only this part of it is
+	 * prefaulted and locked in memory up front. Once an instance of the
+	 * script has processed audio, use its high-water-mark with 100%
+	 * headroom: GC is only stepped incrementally during run(), and
+	 * dsp_run() may allocate depending on parameters or input.
+	 * A script that needs more still has room in the pool, at the cost
+	 * of page-faults on first use. Until a peak is known, use all of it.
+	 */
+	size_t peak = LuaScripting::instance ().dsp_arena_peak (ds);
+	if (peak == 0) {
+		return max_arena_size;
+	}
+	return std::min (max_arena_size, std::max (min_size, 2 * peak));
+}
+
+void
+LuaProc::update_arena_peak () const
+{
+	if (!_dsp_script || !_dsp_ran) {
+		/* the peak after load_script() does not include dsp_run() */
+		return;
+	}
+	size_t used, peak, size;
+	arena_usage (used, peak, size);
+	LuaScripting::instance ().set_dsp_arena_peak (_dsp_script, peak);
+}
+
+void
+LuaProc::arena_usage (size_t& used, size_t& peak, size_t& size) const
+{
+#ifdef USE_TLSF
+	used = _mempool.get_used_size ();
+	peak = _mempool.get_max_size ();
+#else
+	used = peak = 0;
+#endif
+	size = _arena_size;
+}
+
 void
 LuaProc::drop_references ()
 {
@@ -223,8 +284,22 @@ LuaProc::load_script ()
 	//     { [sample] => { Event }, .. }
 	//   or  { { sample, Event }, .. }
 
+	/* compiled once, shared by all instances of the script */
+	_dsp_script = LuaScripting::instance ().dsp_script (_script);
+	if (!_dsp_script) {
+		return true;
+	}
+
+	LuaScriptInfoPtr lsi = _dsp_script->info;
+
+#ifdef USE_TLSF
+	_arena_size = arena_size (_dsp_script);
+	_mempool.make_resident (_arena_size);
+#else
+	_arena_size = max_arena_size;
+#endif
+
 	try {
-		LuaScriptInfoPtr lsi = LuaScripting::script_info (_script);
 		lpi = LuaPluginInfoPtr (new LuaPluginInfo (lsi));
 		assert (lpi);
 		set_info (lpi);
@@ -235,7 +310,12 @@ LuaProc::load_script ()
 	}
 
 	lua_State* L = lua.getState ();
-	lua.do_command (_script);
+
+	std::string const& bytecode (_dsp_script->bytecode);
+	if (luaL_loadbufferx (L, bytecode.data (), bytecode.size (), lsi->name.c_str (), "b") || lua_pcall (L, 0, 0, 0)) {
+		lua_print ("Error: " + std::string (lua_tostring (L, -1)));
+		lua_pop (L, 1);
+	}
 
 	// check if script has a DSP callback
 	luabridge::LuaRef lua_dsp_run = luabridge::getGlobal (L, "dsp_run");
@@ -780,6 +860,8 @@ LuaProc::connect_and_run (BufferSet& bufs,
 			_signal_latency = (*_lua_latency)();
 		}
 
+		_dsp_ran = true;
+
 	} catch (luabridge::LuaException const& e) {
 #ifndef NDEBUG
 		std::cerr << "LuaException: " << e.what () << "\n";
@@ -814,6 +896,8 @@ LuaProc::add_state (XMLNode* root) const
 {
 	XMLNode*    child;
 
+	update_arena_peak ();
+
 	gchar* b64 = g_base64_encode ((const guchar*)_script.c_str (), _script.size ());
 	std::string b64s (b64);
 	g_free (b64);
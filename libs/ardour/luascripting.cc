@@ -16,6 +16,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 #include <cstring>
+#include <sstream>
 #include <glibmm.h>
 
 #include "pbd/error.h"
@@ -357,6 +358,132 @@ LuaScripting::by_name (const std::string& name, LuaScriptInfo::ScriptType type)
 	return LuaScriptInfoPtr();
 }
 
+std::string
+LuaScripting::script_hash (const std::string& script)
+{
+	char hash[41];
+	Sha1Digest s;
+	sha1_init (&s);
+	sha1_write (&s, (const uint8_t *) script.c_str(), script.size ());
+	sha1_result_hash (&s, hash);
+	return hash;
+}
+
+static int
+bytecode_writer (lua_State*, const void* p, size_t sz, void* ud)
+{
+	static_cast<std::string*> (ud)->append (static_cast<const char*> (p), sz);
+	return 0;
+}
+
+LuaScripting::DSPScriptPtr
+LuaScripting::dsp_script (const std::string& script)
+{
+	const std::string hash = script_hash (script);
+
+	{
+		Glib::Threads::Mutex::Lock lm (_dsp_cache_lock);
+		DSPScriptCache::const_iterator i = _dsp_cache.find (hash);
+		if (i != _dsp_cache.end ()) {
+			return i->second;
+		}
+	}
+
+	LuaScriptInfoPtr lsi = scan_script ("", script);
+	if (!lsi || lsi->type != LuaScriptInfo::DSP) {
+		return DSPScriptPtr ();
+	}
+
+	/* only compile the main chunk here, it is executed by every
+	 * LuaProc in its own interpreter. Keep debug information for
+	 * line-numbers in error messages.
+	 */
+	LuaState l;
+	lua_State* L = l.getState ();
+	const std::string chunkname = "=" + lsi->name;
+
+	if (luaL_loadbuffer (L, script.c_str (), script.size (), chunkname.c_str ()) != LUA_OK) {
+		lua_print (string_compose ("Error: %1", lua_tostring (L, -1)));
+		return DSPScriptPtr ();
+	}
+
+	std::string bytecode;
+	if (lua_dump (L, &bytecode_writer, &bytecode, 0) != 0 || bytecode.empty ()) {
+		return DSPScriptPtr ();
+	}
+
+	DSPScriptPtr ds (new DSPScript (lsi, hash, bytecode));
+
+	Glib::Threads::Mutex::Lock lm (_dsp_cache_lock);
+	/* keep the first, in case another thread compiled it meanwhile */
+	return _dsp_cache.insert (std::make_pair (hash, ds)).first->second;
+}
+
+/* peak memory-pool usage of DSP scripts, one "<sha1> <bytes>" per line */
+static std::string
+dsp_arena_file ()
+{
+	return Glib::build_filename (user_cache_directory (), "lua_dsp_arena");
+}
+
+static void
+load_dsp_arena_peaks (std::map<std::string, size_t>& peaks)
+{
+	gchar* buf = NULL;
+	if (!g_file_get_contents (dsp_arena_file ().c_str (), &buf, NULL, NULL)) {
+		return;
+	}
+	std::stringstream ss (buf);
+	g_free (buf);
+
+	std::string hash;
+	size_t      bytes;
+	while (ss >> hash >> bytes) {
+		peaks[hash] = bytes;
+	}
+}
+
+size_t
+LuaScripting::dsp_arena_peak (DSPScriptPtr ds)
+{
+	/* always read the file, it may have been updated by another process */
+	std::map<std::string, size_t> peaks;
+	Glib::Threads::Mutex::Lock lm (_dsp_cache_lock);
+	load_dsp_arena_peaks (peaks);
+
+	std::map<std::string, size_t>::const_iterator i = peaks.find (ds->hash);
+	if (i == peaks.end ()) {
+		return 0;
+	}
+	ds->arena_peak = std::max (ds->arena_peak, i->second);
+	return i->second;
+}
+
+void
+LuaScripting::set_dsp_arena_peak (DSPScriptPtr ds, size_t bytes)
+{
+	Glib::Threads::Mutex::Lock lm (_dsp_cache_lock);
+	if (bytes <= ds->arena_peak) {
+		return;
+	}
+	ds->arena_peak = bytes;
+
+	std::map<std::string, size_t> peaks;
+	load_dsp_arena_peaks (peaks);
+	if (peaks[ds->hash] >= bytes) {
+		return;
+	}
+	peaks[ds->hash] = bytes;
+
+	std::stringstream ss;
+	for (std::map<std::string, size_t>::const_iterator i = peaks.begin (); i != peaks.end (); ++i) {
+		ss << i->first << " " << i->second << "\n";
+	}
+	if (!g_file_set_contents (dsp_arena_file ().c_str (), ss.str ().c_str (), -1, NULL)) {
+		PBD::warning << string_compose (_("Could not save Lua DSP memory usage to %1"), dsp_arena_file ()) << endmsg;
+	}
+}
+
 std::string
 LuaScriptInfo::type2str (const ScriptType t) {
 	switch (t) {
@@ -52,7 +52,7 @@ MidiAutomationListBinder::MidiAutomationListBinder (XMLNode* node, Session::Sour
 AutomationList*
 MidiAutomationListBinder::get () const
 {
-	boost::shared_ptr<MidiModel> model = _source->model ();
+	boost::shared_ptr<MidiModel> model = _source->ensure_model ();
 	assert (model);
 
 	boost::shared_ptr<AutomationControl> control = model->automation_control (_parameter);
@@ -230,12 +230,47 @@ MidiModel::NoteDiffCommand::operator+= (const NoteDiffCommand& other)
 	return *this;
 }
 
+void
+MidiModel::NoteDiffCommand::extend_range (TimeType& start, TimeType& end, bool& valid)
+{
+	NoteList notes (_added_notes);
+	notes.insert (notes.end (), _removed_notes.begin (), _removed_notes.end ());
+	notes.insert (notes.end (), side_effect_removals.begin (), side_effect_removals.end ());
+
+	for (ChangeList::iterator i = _changes.begin(); i != _changes.end(); ++i) {
+		if (!i->note) {
+			i->note = _model->find_note (i->note_id);
+		}
+		if (i->note) {
+			notes.push_back (i->note);
+		}
+	}
+
+	for (NoteList::const_iterator i = notes.begin(); i != notes.end(); ++i) {
+		if (!valid) {
+			start = (*i)->time ();
+			end   = (*i)->end_time ();
+			valid = true;
+		} else {
+			start = std::min (start, (*i)->time ());
+			end   = std::max (end, (*i)->end_time ());
+		}
+	}
+}
+
 void
 MidiModel::NoteDiffCommand::operator() ()
 {
+	TimeType range_start;
+	TimeType range_end;
+	bool     range_valid = false;
+
 	{
 		MidiModel::WriteLock lock(_model->edit_lock());
 
+		/* notes as they are before the change ... */
+		extend_range (range_start, range_end, range_valid);
+
 		for (NoteList::iterator i = _added_notes.begin(); i != _added_notes.end(); ++i) {
 			if (!_model->add_note_unlocked(*i)) {
 				/* failed to add it, so don't leave it in the removed list, to
@@ -322,17 +357,29 @@ MidiModel::NoteDiffCommand::operator() ()
 				cerr << "\t" << *i << ' ' << **i << endl;
 			}
 		}
+
+		/* ... and after */
+		extend_range (range_start, range_end, range_valid);
 	}
 
+	if (range_valid) {
+		_model->ContentsRangeChanged (range_start, range_end); /* EMIT SIGNAL */
+	}
 	_model->ContentsChanged(); /* EMIT SIGNAL */
 }
 
 void
 MidiModel::NoteDiffCommand::undo ()
 {
+	TimeType range_start;
+	TimeType range_end;
+	bool     range_valid = false;
+
 	{
 		MidiModel::WriteLock lock(_model->edit_lock());
 
+		extend_range (range_start, range_end, range_valid);
+
 		for (NoteList::iterator i = _added_notes.begin(); i != _added_notes.end(); ++i) {
 			_model->remove_note_unlocked(*i);
 		}
@@ -432,8 +479,13 @@ MidiModel::NoteDiffCommand::undo ()
 		for (set<NotePtr>::iterator i = side_effect_removals.begin(); i != side_effect_removals.end(); ++i) {
 			_model->add_note_unlocked (*i);
 		}
+
+		extend_range (range_start, range_end, range_valid);
 	}
 
+	if (range_valid) {
+		_model->ContentsRangeChanged (range_start, range_end); /* EMIT SIGNAL */
+	}
 	_model->ContentsChanged(); /* EMIT SIGNAL */
 }
 
@@ -30,6 +30,7 @@
 
 #include "ardour/beats_samples_converter.h"
 #include "ardour/debug.h"
+#include "ardour/midi_channel_filter.h"
 #include "ardour/midi_model.h"
 #include "ardour/midi_playlist.h"
 #include "ardour/midi_region.h"
@@ -51,6 +52,10 @@ MidiPlaylist::MidiPlaylist (Session& session, const XMLNode& node, bool hidden)
 	: Playlist (session, node, DataType::MIDI, hidden)
 	, _note_mode(Sustained)
 	, _read_end(0)
+	, _render_needs_all (true)
+	, _render_solo_selection (false)
+	, _render_note_mode (Sustained)
+	, _render_filter (0)
 {
 #ifndef NDEBUG
 	XMLProperty const * prop = node.property("type");
@@ -70,6 +75,10 @@ MidiPlaylist::MidiPlaylist (Session& session, string name, bool hidden)
 	: Playlist (session, name, DataType::MIDI, hidden)
 	, _note_mode(Sustained)
 	, _read_end(0)
+	, _render_needs_all (true)
+	, _render_solo_selection (false)
+	, _render_note_mode (Sustained)
+	, _render_filter (0)
 {
 }
 
@@ -77,6 +86,10 @@ MidiPlaylist::MidiPlaylist (boost::shared_ptr<const MidiPlaylist> other, string
 	: Playlist (other, name, hidden)
 	, _note_mode(other->_note_mode)
 	, _read_end(0)
+	, _render_needs_all (true)
+	, _render_solo_selection (false)
+	, _render_note_mode (Sustained)
+	, _render_filter (0)
 {
 }
 
@@ -88,6 +101,10 @@ MidiPlaylist::MidiPlaylist (boost::shared_ptr<const MidiPlaylist> other,
 	: Playlist (other, start, dur, name, hidden)
 	, _note_mode(other->_note_mode)
 	, _read_end(0)
+	, _render_needs_all (true)
+	, _render_solo_selection (false)
+	, _render_note_mode (Sustained)
+	, _render_filter (0)
 {
 }
 
@@ -298,28 +315,208 @@ MidiPlaylist::contained_automation()
 	return ret;
 }
 
+namespace {
+
+/** EventSink that keeps only the events within a time range.
+ * MidiRegion::render_range () reads only the range if the model is loaded,
+ * but streams a region's file from the region's start.
+ */
+class RangeEventSink : public Evoral::EventSink<samplepos_t>
+{
+public:
+	RangeEventSink (Evoral::EventList<samplepos_t>& dst, Evoral::Range<samplepos_t> const& range)
+		: _dst (dst)
+		, _range (range)
+	{}
+
+	uint32_t write (samplepos_t time, Evoral::EventType type, uint32_t size, const uint8_t* buf) {
+		if (time < _range.from || time > _range.to) {
+			return size;
+		}
+		return _dst.write (time, type, size, buf);
+	}
+
+private:
+	Evoral::EventList<samplepos_t>& _dst;
+	Evoral::Range<samplepos_t>      _range;
+};
+
+}
+
+Evoral::Range<samplepos_t>
+MidiPlaylist::render_extent (boost::shared_ptr<Region> r)
+{
+	/* MidiRegion::render resolves notes at the sample after the end of the region */
+	return Evoral::Range<samplepos_t> (r->first_sample (), r->last_sample () + 1);
+}
+
+bool
+MidiPlaylist::region_changed (const PBD::PropertyChange& what_changed, boost::shared_ptr<Region> region)
+{
+	/* moved or trimmed regions are found by comparing extents in ::render (),
+	 * here we only need to handle changes of a region's content.
+	 */
+	PropertyChange our_interests;
+	our_interests.add (Properties::start);
+	our_interests.add (Properties::muted);
+	our_interests.add (Properties::contents);
+
+	if (what_changed.contains (our_interests)) {
+
+		Evoral::Range<samplepos_t> range (render_extent (region));
+		boost::shared_ptr<MidiRegion> mr = boost::dynamic_pointer_cast<MidiRegion> (region);
+		samplepos_t start;
+		samplepos_t end;
+
+		if (mr && what_changed.size () == 1 && mr->contents_change_range (start, end)) {
+			/* a note edit, only re-render the range of the notes involved */
+			range.from = max (range.from, start);
+			range.to   = min (range.to, end);
+		}
+
+		if (range.from <= range.to) {
+			Glib::Threads::Mutex::Lock lm (_render_lock);
+			_render_dirty.add (range);
+		}
+	}
+
+	return Playlist::region_changed (what_changed, region);
+}
+
 void
 MidiPlaylist::render (MidiChannelFilter* filter)
 {
-	typedef pair<MidiStateTracker*,samplepos_t> TrackerInfo;
-
 	Playlist::RegionReadLock rl (this);
 
 	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- MidiPlaylist::render (regions: %1)-----\n", regions.size()));
 
 	std::vector< boost::shared_ptr<Region> > regs;
 
+	bool const solo_selection = _session.solo_selection_active() && SoloSelectedActive();
+
 	for (RegionList::iterator i = regions.begin(); i != regions.end(); ++i) {
 
 		/* check for the case of solo_selection */
 
-		if (_session.solo_selection_active() && SoloSelectedActive() && !SoloSelectedListIncludes ((const Region*) &(**i))) {
+		if (solo_selection && !SoloSelectedListIncludes ((const Region*) &(**i))) {
 			continue;
 		}
 
 		regs.push_back (*i);
 	}
 
+	RenderExtents extents;
+	for (vector<boost::shared_ptr<Region> >::const_iterator i = regs.begin(); i != regs.end(); ++i) {
+		extents.insert (make_pair ((*i)->id (), render_extent (*i)));
+	}
+
+	uint32_t const filter_state = filter ? ((uint32_t) filter->get_channel_mode () << 16) | filter->get_channel_mask () : 0;
+
+	Evoral::RangeList<samplepos_t> dirty;
+	bool                           all;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_render_lock);
+
+		all = _render_needs_all
+			|| _rendered.reversed ()
+			|| solo_selection || _render_solo_selection
+			|| _note_mode != _render_note_mode
+			|| filter_state != _render_filter;
+
+		if (!all) {
+			dirty = _render_dirty;
+
+			/* regions that were removed, moved or trimmed ... */
+			for (RenderExtents::const_iterator i = _render_extents.begin(); i != _render_extents.end(); ++i) {
+				RenderExtents::const_iterator e = extents.find (i->first);
+				if (e == extents.end ()) {
+					dirty.add (i->second);
+				} else if (!(e->second == i->second)) {
+					dirty.add (i->second);
+					dirty.add (e->second);
+				}
+			}
+
+			/* ... and regions that were added */
+			for (RenderExtents::const_iterator e = extents.begin(); e != extents.end(); ++e) {
+				if (_render_extents.find (e->first) == _render_extents.end ()) {
+					dirty.add (e->second);
+				}
+			}
+		}
+
+		_render_dirty          = Evoral::RangeList<samplepos_t> ();
+		_render_extents        = extents;
+		_render_needs_all      = false;
+		_render_solo_selection = solo_selection;
+		_render_note_mode      = _note_mode;
+		_render_filter         = filter_state;
+	}
+
+	if (all) {
+		render_all (regs, filter);
+		return;
+	}
+
+	Evoral::RangeList<samplepos_t>::List const& ranges (dirty.get ());
+
+	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("\t%1 ranges to re-render\n", ranges.size ()));
+
+	if (ranges.empty ()) {
+		return;
+	}
+
+	/* render every dirty range before taking the write lock, readers
+	 * continue to use the current data meanwhile.
+	 */
+
+	std::vector<Evoral::EventList<samplepos_t> > evlists (ranges.size ());
+	std::vector<Evoral::EventList<samplepos_t> >::iterator evl = evlists.begin ();
+
+	EventsSortByTimeAndType<samplepos_t> cmp;
+
+	for (Evoral::RangeList<samplepos_t>::List::const_iterator r = ranges.begin(); r != ranges.end(); ++r, ++evl) {
+
+		RangeEventSink sink (*evl, *r);
+
+		for (vector<boost::shared_ptr<Region> >::iterator i = regs.begin(); i != regs.end(); ++i) {
+
+			boost::shared_ptr<MidiRegion> mr = boost::dynamic_pointer_cast<MidiRegion>(*i);
+
+			if (!mr || Evoral::coverage (r->from, r->to, mr->first_sample (), mr->last_sample () + 1) == Evoral::OverlapNone) {
+				continue;
+			}
+
+			DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("render %1 .. %2 from %3\n", r->from, r->to, mr->name()));
+			mr->render_range (sink, 0, _note_mode, filter, *r);
+		}
+
+		evl->sort (cmp);
+	}
+
+	{
+		RTMidiBuffer::WriteProtectRender wpr (_rendered);
+		wpr.acquire ();
+
+		evl = evlists.begin ();
+		for (Evoral::RangeList<samplepos_t>::List::const_iterator r = ranges.begin(); r != ranges.end(); ++r, ++evl) {
+			_rendered.splice (r->from, r->to, *evl);
+		}
+	}
+
+	for (evl = evlists.begin (); evl != evlists.end (); ++evl) {
+		for (Evoral::EventList<samplepos_t>::iterator e = evl->begin(); e != evl->end(); ++e) {
+			delete *e;
+		}
+	}
+
+	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- End MidiPlaylist::render, events: %1\n", _rendered.size()));
+}
+
+void
+MidiPlaylist::render_all (std::vector<boost::shared_ptr<Region> > const& regs, MidiChannelFilter* filter)
+{
 	/* If we are reading from a single region, we can read directly into _rendered.  Otherwise,
 	   we read into a temporarily list, sort it, then write that to _rendered.
 	*/
@@ -344,7 +541,7 @@ MidiPlaylist::render (MidiChannelFilter* filter)
 
 		DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("\t%1 regions to read, direct: %2\n", regs.size(), (regs.size() == 1)));
 
-		for (vector<boost::shared_ptr<Region> >::iterator i = regs.begin(); i != regs.end(); ++i) {
+		for (vector<boost::shared_ptr<Region> >::const_iterator i = regs.begin(); i != regs.end(); ++i) {
 
 			boost::shared_ptr<MidiRegion> mr = boost::dynamic_pointer_cast<MidiRegion>(*i);
 
@@ -88,6 +88,9 @@ MidiRegion::MidiRegion (const SourceList& srcs)
 	, _start_beats (Properties::start_beats, 0.0)
 	, _length_beats (Properties::length_beats, midi_source(0)->length_beats().to_double())
 	, _ignore_shift (false)
+	, _contents_range_valid (false)
+	, _contents_range_start (0)
+	, _contents_range_end (0)
 {
 	register_properties ();
 	midi_source(0)->ModelChanged.connect_same_thread (_source_connection, boost::bind (&MidiRegion::model_changed, this));
@@ -101,6 +104,9 @@ MidiRegion::MidiRegion (boost::shared_ptr<const MidiRegion> other)
 	, _start_beats (Properties::start_beats, other->_start_beats)
 	, _length_beats (Properties::length_beats, other->_length_beats)
 	, _ignore_shift (false)
+	, _contents_range_valid (false)
+	, _contents_range_start (0)
+	, _contents_range_end (0)
 {
 	//update_length_beats ();
 	register_properties ();
@@ -116,6 +122,9 @@ MidiRegion::MidiRegion (boost::shared_ptr<const MidiRegion> other, MusicSample o
 	, _start_beats (Properties::start_beats, other->_start_beats)
 	, _length_beats (Properties::length_beats, other->_length_beats)
 	, _ignore_shift (false)
+	, _contents_range_valid (false)
+	, _contents_range_start (0)
+	, _contents_range_end (0)
 {
 
 	register_properties ();
@@ -190,9 +199,7 @@ MidiRegion::clone (boost::shared_ptr<MidiSource> newsrc) const
 		boost::shared_ptr<MidiSource> ms = midi_source(0);
 		Source::Lock lm (ms->mutex());
 
-		if (!ms->model()) {
-			ms->load_model (lm);
-		}
+		ms->ensure_model (lm);
 
 		/* Lock our source since we'll be reading from it.  write_to() will
 		   take a lock on newsrc.
@@ -557,6 +564,91 @@ MidiRegion::render (Evoral::EventSink<samplepos_t>& dst,
 	return 0;
 }
 
+int
+MidiRegion::render_range (Evoral::EventSink<samplepos_t>& dst,
+                          uint32_t                        chan_n,
+                          NoteMode                        mode,
+                          MidiChannelFilter*              filter,
+                          Evoral::Range<samplepos_t> const& range) const
+{
+	assert(chan_n == 0);
+
+	if (muted()) {
+		return 0; /* read nothing */
+	}
+
+	const samplepos_t region_end = _position + _length; // notes are resolved here
+	const samplepos_t read_end   = std::min (range.to + 1, region_end);
+	samplepos_t       read_start = std::max (range.from, _position);
+
+	if (range.from > region_end || range.to < _position) {
+		return 0;
+	}
+
+	boost::shared_ptr<MidiSource> src = midi_source(chan_n);
+
+	Glib::Threads::Mutex::Lock lm(src->mutex());
+
+	src->set_note_mode(lm, mode);
+
+	const samplepos_t source_start = _position - _start;
+
+	MidiCursor cursor;
+	MidiStateTracker tracker;
+
+	boost::shared_ptr<MidiModel> model = src->model ();
+
+	if (!model) {
+		/* events are streamed from the file, which is read from its
+		 * start anyway. Read from the region's start, so that notes
+		 * sounding at the range's start are tracked.
+		 */
+		read_start = _position;
+
+	} else if (read_start > _position) {
+
+		/* notes of this region that sound at the start of the range:
+		 * the iterator plays their note-offs, and they are resolved at the
+		 * end of the region. Only the notes' times are compared, no events
+		 * are read before the range.
+		 */
+		BeatsSamplesConverter bfc (_session.tempo_map(), source_start);
+		const Temporal::Beats t     = bfc.from (read_start - source_start);
+		const Temporal::Beats first = bfc.from (_start);
+
+		MidiModel::ReadLock rl (model->read_lock ());
+
+		for (MidiModel::Notes::const_iterator n = model->note_lower_bound (first); n != model->notes().end() && (*n)->time() < t; ++n) {
+			if ((*n)->end_time() > t) {
+				cursor.active_notes.insert (*n);
+				tracker.add ((*n)->note(), (*n)->channel());
+			}
+		}
+	}
+
+	if (read_end > read_start) {
+		src->midi_read (
+			lm, // source lock
+			dst, // destination buffer
+			source_start, // start position of the source in session samples
+			read_start - source_start, // where to start reading in the source
+			read_end - read_start, // length to read
+			0,
+			cursor,
+			&tracker,
+			filter,
+			_filtered_parameters,
+			quarter_note(),
+			_start_beats);
+	}
+
+	if (range.to >= region_end) {
+		tracker.resolve_notes (dst, region_end);
+	}
+
+	return 0;
+}
+
 
 XMLNode&
 MidiRegion::state ()
@@ -614,13 +706,13 @@ MidiRegion::control (const Evoral::Parameter& id) const
 boost::shared_ptr<MidiModel>
 MidiRegion::model()
 {
-	return midi_source()->model();
+	return midi_source()->ensure_model();
 }
 
 boost::shared_ptr<const MidiModel>
 MidiRegion::model() const
 {
-	return midi_source()->model();
+	return midi_source()->ensure_model();
 }
 
 boost::shared_ptr<MidiSource>
@@ -650,7 +742,10 @@ MidiRegion::clobber_sources (boost::shared_ptr<MidiSource> s)
 void
 MidiRegion::model_changed ()
 {
-	if (!model()) {
+	/* do not load the model, this is called again when it is loaded */
+	boost::shared_ptr<MidiModel> model = midi_source()->model();
+
+	if (!model) {
 		return;
 	}
 
@@ -658,7 +753,7 @@ MidiRegion::model_changed ()
 
 	_filtered_parameters.clear ();
 
-	Automatable::Controls const & c = model()->controls();
+	Automatable::Controls const & c = model->controls();
 
 	for (Automatable::Controls::const_iterator i = c.begin(); i != c.end(); ++i) {
 		boost::shared_ptr<AutomationControl> ac = boost::dynamic_pointer_cast<AutomationControl> (i->second);
@@ -673,14 +768,38 @@ MidiRegion::model_changed ()
 		_model_connection, boost::bind (&MidiRegion::model_automation_state_changed, this, _1)
 		);
 
-	model()->ContentsShifted.connect_same_thread (_model_shift_connection, boost::bind (&MidiRegion::model_shifted, this, _1));
-	model()->ContentsChanged.connect_same_thread (_model_changed_connection, boost::bind (&MidiRegion::model_contents_changed, this));
+	model->ContentsShifted.connect_same_thread (_model_shift_connection, boost::bind (&MidiRegion::model_shifted, this, _1));
+	model->ContentsChanged.connect_same_thread (_model_changed_connection, boost::bind (&MidiRegion::model_contents_changed, this));
+	model->ContentsRangeChanged.connect_same_thread (_model_range_connection, boost::bind (&MidiRegion::model_contents_range_changed, this, _1, _2));
+}
+
+void
+MidiRegion::model_contents_range_changed (Temporal::Beats start, Temporal::Beats end)
+{
+	/* model time is relative to the start of the source */
+	double const start_qn = quarter_note () - _start_beats;
+
+	_contents_range_start = _session.tempo_map ().sample_at_quarter_note (start_qn + start.to_double ());
+	_contents_range_end   = _session.tempo_map ().sample_at_quarter_note (start_qn + end.to_double ());
+	_contents_range_valid = true;
 }
 
 void
 MidiRegion::model_contents_changed ()
 {
 	send_change (Properties::contents);
+	_contents_range_valid = false;
+}
+
+bool
+MidiRegion::contents_change_range (samplepos_t& start, samplepos_t& end) const
+{
+	if (!_contents_range_valid) {
+		return false;
+	}
+	start = _contents_range_start;
+	end   = _contents_range_end;
+	return true;
 }
 
 void
@@ -66,6 +66,7 @@ using namespace PBD;
 MidiSource::MidiSource (Session& s, string name, Source::Flag flags)
 	: Source(s, DataType::MIDI, name, flags)
 	, _writing(false)
+	, _model_loaded(0)
 	, _length_beats(0.0)
 	, _capture_length(0)
 	, _capture_loop_length(0)
@@ -75,6 +76,7 @@ MidiSource::MidiSource (Session& s, string name, Source::Flag flags)
 MidiSource::MidiSource (Session& s, const XMLNode& node)
 	: Source(s, node)
 	, _writing(false)
+	, _model_loaded(0)
 	, _length_beats(0.0)
 	, _capture_length(0)
 	, _capture_loop_length(0)
@@ -500,6 +502,37 @@ MidiSource::drop_model (const Lock& lock)
 	ModelChanged (); /* EMIT SIGNAL */
 }
 
+boost::shared_ptr<MidiModel>
+MidiSource::ensure_model ()
+{
+	if (!_model) {
+		Lock lm (_lock);
+		ensure_model (lm);
+	}
+
+	/* regions of sources whose model is loaded on demand
+	 * (see SMFSource::load_length) connect to the model now.
+	 */
+	if (g_atomic_int_compare_and_exchange (&_model_loaded, 1, 0)) {
+		ModelChanged (); /* EMIT SIGNAL */
+	}
+
+	return _model;
+}
+
+boost::shared_ptr<MidiModel>
+MidiSource::ensure_model (const Lock& lock)
+{
+	if (!_model) {
+		load_model (lock);
+		if (_model) {
+			g_atomic_int_set (&_model_loaded, 1);
+		}
+	}
+
+	return _model;
+}
+
 void
 MidiSource::set_model (const Lock& lock, boost::shared_ptr<MidiModel> m)
 {
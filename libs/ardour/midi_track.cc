@@ -394,7 +394,7 @@ MidiTrack::non_realtime_locate (samplepos_t pos)
 	}
 
 	/* the source may be missing, but the control still referenced in the GUI */
-	if (!region->midi_source() || !region->model()) {
+	if (!region->midi_source()) {
 		return;
 	}
 
@@ -418,9 +418,16 @@ MidiTrack::non_realtime_locate (samplepos_t pos)
 		boost::shared_ptr<MidiTrack::MidiControl> tcontrol;
 		boost::shared_ptr<Evoral::Control>        rcontrol;
 
-		if ((tcontrol = boost::dynamic_pointer_cast<MidiTrack::MidiControl>(c->second)) &&
+		if (!(tcontrol = boost::dynamic_pointer_cast<MidiTrack::MidiControl>(c->second))) {
+			continue;
+		}
+
+		/* only load the region's model if a control plays it back */
+		if (!region->model()) {
+			return;
+		}
 
-		    (rcontrol = region->control(tcontrol->parameter()))) {
+		if ((rcontrol = region->control(tcontrol->parameter()))) {
 			const Temporal::Beats pos_beats = bfc.from(pos - origin);
 			if (rcontrol->list()->size() > 0) {
 				tcontrol->set_value(rcontrol->list()->eval(pos_beats.to_double()), Controllable::NoGroup);
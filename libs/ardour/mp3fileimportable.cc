@@ -19,6 +19,8 @@
 
 #define MINIMP3_IMPLEMENTATION
 
+#include <algorithm>
+#include <cstdio>
 #include <fcntl.h>
 
 #ifdef PLATFORM_WINDOWS
@@ -37,7 +39,10 @@ using namespace std;
 
 namespace ARDOUR {
 
-Mp3FileImportableSource::Mp3FileImportableSource (const string& path)
+/* add a seek-point every N mp3 frames */
+static const int seek_interval = 8;
+
+Mp3FileImportableSource::Mp3FileImportableSource (const string& path, const string& index_path)
 	: _fd (-1)
 	, _map_addr (0)
 	, _map_length (0)
@@ -94,17 +99,18 @@ Mp3FileImportableSource::Mp3FileImportableSource (const string& path)
 		throw failed_constructor ();
 	}
 
-	/* estimate length, fixed bitrate */
-	_length = _n_frames * _map_length / _info.frame_bytes;
-
-#if 1 /* detect accurate length by parsing frame headers */
-	_length = _n_frames;
-	while (decode_mp3 (true)) {
-		_length += _n_frames;
+	/* detect accurate length by parsing frame headers, unless a
+	 * seek index for this file exists
+	 */
+	if (index_path.empty () || !load_index (index_path, statbuf.st_mtime)) {
+		build_index ();
+		if (!index_path.empty ()) {
+			save_index (index_path, statbuf.st_mtime);
+		}
 	}
+
 	_read_position = _length;
 	seek (0);
-#endif
 }
 
 Mp3FileImportableSource::~Mp3FileImportableSource ()
@@ -131,7 +137,16 @@ Mp3FileImportableSource::decode_mp3 (bool parse_only)
 {
 	_pcm_off = 0;
 	do {
-		_n_frames = mp3dec_decode_frame (&_mp3d, _buffer, _remain, parse_only ? NULL : _pcm, &_info);
+		/* parse the header first: after seeking, the bit reservoir is
+		 * empty and the first frame(s) cannot be decoded. Those are
+		 * replaced with silence to keep the sample-count accurate.
+		 */
+		_n_frames = mp3dec_decode_frame (&_mp3d, _buffer, _remain, NULL, &_info);
+		if (_n_frames && !parse_only) {
+			if (!mp3dec_decode_frame (&_mp3d, _buffer, _remain, _pcm, &_info)) {
+				memset (_pcm, 0, _n_frames * _info.channels * sizeof (mp3d_sample_t));
+			}
+		}
 		_buffer += _info.frame_bytes;
 		_remain -= _info.frame_bytes;
 		if (_n_frames) {
@@ -141,6 +156,106 @@ Mp3FileImportableSource::decode_mp3 (bool parse_only)
 	return _n_frames;
 }
 
+void
+Mp3FileImportableSource::build_index ()
+{
+	/* the first frame was decoded by the c'tor */
+	_index.clear ();
+	_index.push_back (SeekPoint (0, 0));
+	_length = _n_frames;
+
+	for (int n = 1;; ++n) {
+		const uint64_t offset = _buffer - _map_addr;
+		if (!decode_mp3 (true)) {
+			break;
+		}
+		if (n % seek_interval == 0) {
+			_index.push_back (SeekPoint (_length, offset));
+		}
+		_length += _n_frames;
+	}
+}
+
+/* Seek index file: a header followed by pairs of (sample, byte-offset).
+ * The file size and modification time of the mp3 are used to
+ * detect stale index files.
+ */
+struct SeekIndexHeader {
+	char     magic[8];
+	uint64_t file_size;
+	int64_t  mtime;
+	int64_t  length;
+	uint64_t n_points;
+};
+
+static const char seek_index_magic[8] = { 'A', 'M', 'P', '3', 'I', 'D', 'X', '1' };
+
+bool
+Mp3FileImportableSource::load_index (const string& index_path, int64_t mtime)
+{
+	FILE* f = g_fopen (index_path.c_str (), "rb");
+	if (!f) {
+		return false;
+	}
+
+	SeekIndexHeader hdr;
+	bool ok = fread (&hdr, sizeof (hdr), 1, f) == 1
+		&& !memcmp (hdr.magic, seek_index_magic, sizeof (seek_index_magic))
+		&& hdr.file_size == _map_length
+		&& hdr.mtime == mtime
+		&& hdr.n_points > 0 && hdr.n_points <= _map_length;
+
+	if (ok) {
+		std::vector<int64_t> data (2 * hdr.n_points);
+		ok = fread (&data[0], sizeof (int64_t), data.size (), f) == data.size ();
+		_index.clear ();
+		for (uint64_t i = 0; ok && i < hdr.n_points; ++i) {
+			_index.push_back (SeekPoint (data[2 * i], data[2 * i + 1]));
+			ok = _index.back ().offset < _map_length && (i == 0 || _index[i - 1].pos < _index.back ().pos);
+		}
+		_length = hdr.length;
+	}
+
+	fclose (f);
+
+	if (!ok) {
+		_index.clear ();
+	}
+	return ok;
+}
+
+void
+Mp3FileImportableSource::save_index (const string& index_path, int64_t mtime) const
+{
+	const string tmp = index_path + ".tmp";
+	FILE* f = g_fopen (tmp.c_str (), "wb");
+	if (!f) {
+		return;
+	}
+
+	SeekIndexHeader hdr;
+	memcpy (hdr.magic, seek_index_magic, sizeof (seek_index_magic));
+	hdr.file_size = _map_length;
+	hdr.mtime     = mtime;
+	hdr.length    = _length;
+	hdr.n_points  = _index.size ();
+
+	bool ok = fwrite (&hdr, sizeof (hdr), 1, f) == 1;
+	for (std::vector<SeekPoint>::const_iterator i = _index.begin (); ok && i != _index.end (); ++i) {
+		const int64_t pt[2] = { i->pos, (int64_t) i->offset };
+		ok = fwrite (pt, sizeof (int64_t), 2, f) == 2;
+	}
+
+	if (fclose (f) || !ok || g_rename (tmp.c_str (), index_path.c_str ())) {
+		::g_unlink (tmp.c_str ());
+	}
+}
+
+struct SeekPointCompare {
+	template <typename T>
+	bool operator() (samplepos_t pos, T const& p) const { return pos < p.pos; }
+};
+
 void
 Mp3FileImportableSource::seek (samplepos_t pos)
 {
@@ -148,11 +263,20 @@ Mp3FileImportableSource::seek (samplepos_t pos)
 		return;
 	}
 
-	/* rewind, then decode to pos */
-	if (pos < _read_position) {
-		_buffer        = _map_addr;
-		_remain        = _map_length;
-		_read_position = 0;
+	/* jump to the last seek-point that leaves a few frames before the
+	 * target for the decoder to refill the bit reservoir.
+	 */
+	const samplepos_t context = 3 * 1152;
+	std::vector<SeekPoint>::const_iterator sp = std::upper_bound (_index.begin (), _index.end (), pos - context, SeekPointCompare ());
+
+	if (sp != _index.begin ()) {
+		--sp;
+	}
+
+	if (sp != _index.end () && (pos < _read_position || sp->pos > _read_position)) {
+		_buffer        = _map_addr + sp->offset;
+		_remain        = _map_length - sp->offset;
+		_read_position = sp->pos;
 		_pcm_off       = 0;
 		mp3dec_init (&_mp3d);
 		decode_mp3 ();
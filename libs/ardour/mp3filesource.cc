@@ -16,15 +16,30 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <cstring>
+
+#include <boost/bind.hpp>
+
 #include "pbd/error.h"
 #include "pbd/compose.h"
+#include "ardour/audio_block_cache.h"
+#include "ardour/filename_extensions.h"
 #include "ardour/mp3filesource.h"
+#include "ardour/session.h"
 
 #include "pbd/i18n.h"
 
 using namespace ARDOUR;
 using namespace PBD;
 
+/** The seek index is kept next to the peak-files, one for all channels */
+static string
+seek_index_path (Session& s, const string& path)
+{
+	const string peak_path = s.construct_peak_filepath (path);
+	return peak_path.substr (0, peak_path.size () - strlen (peakfile_suffix)) + seekindex_suffix;
+}
+
 /** Constructor to be called for existing external-to-session files
  * Sources created with this method are never writable or removable.
  */
@@ -34,7 +49,7 @@ Mp3FileSource::Mp3FileSource (Session& s, const string& path, int chn, Flag flag
 			Source::Flag (flags & ~(Writable|Removable|RemovableIfEmpty|RemoveAtDestroy)))
 	, AudioFileSource (s, path,
 			Source::Flag (flags & ~(Writable|Removable|RemovableIfEmpty|RemoveAtDestroy)))
-	, _mp3 (path)
+	, _mp3 (path, seek_index_path (s, path))
 	, _channel (chn)
 {
 	_length = _mp3.length ();
@@ -47,6 +62,7 @@ Mp3FileSource::Mp3FileSource (Session& s, const string& path, int chn, Flag flag
 
 Mp3FileSource::~Mp3FileSource ()
 {
+	AudioBlockCache::drop (_path, _channel);
 }
 
 void
@@ -54,12 +70,37 @@ Mp3FileSource::close ()
 {
 }
 
+samplecnt_t
+Mp3FileSource::read (Sample* dst, samplepos_t start, samplecnt_t cnt, int channel) const
+{
+	samplecnt_t ret = AudioFileSource::read (dst, start, cnt, channel);
+
+	/* queue read-ahead without holding the source's lock */
+	if (ret > 0 && AudioBlockCache::enabled ()) {
+		AudioBlockCache::read_ahead (*this, _path, _channel, _mp3.channels (), start + ret,
+		                             boost::bind (&Mp3FileSource::decode_block, this, _1, _2, _3));
+	}
+	return ret;
+}
+
 samplecnt_t
 Mp3FileSource::read_unlocked (Sample* dst, samplepos_t start, samplecnt_t cnt) const
 {
+	if (AudioBlockCache::enabled ()) {
+		samplecnt_t ret = AudioBlockCache::read (_path, dst, start, cnt, _channel, _mp3.channels (),
+		                                         boost::bind (&Mp3FileSource::decode_block, this, _1, _2, _3));
+		return ret;
+	}
 	return _mp3.read_unlocked (dst, start, cnt, _channel);
 }
 
+samplecnt_t
+Mp3FileSource::decode_block (Sample* dst, samplepos_t start, samplecnt_t cnt) const
+{
+	_mp3.seek (start);
+	return _mp3.read (dst, cnt * _mp3.channels ()) / _mp3.channels ();
+}
+
 int
 Mp3FileSource::get_soundfile_info (string path, SoundFileInfo& _info, string& error_msg)
 {
@@ -0,0 +1,441 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstring>
+#include <fcntl.h>
+
+#include <glib.h>
+#include "pbd/gstdio_compat.h"
+#include <glibmm/miscutils.h>
+#include <glibmm/timer.h>
+
+#include <boost/scoped_array.hpp>
+
+#include "pbd/compose.h"
+#include "pbd/error.h"
+#include "pbd/pthread_utils.h"
+
+#include "ardour/audioplaylist.h"
+#include "ardour/audioregion.h"
+#include "ardour/debug.h"
+#include "ardour/playlist_render_cache.h"
+#include "ardour/session.h"
+#include "ardour/session_directory.h"
+
+#include "pbd/i18n.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+Glib::Threads::Mutex PlaylistRenderCache::render_active_lock;
+Glib::Threads::Mutex PlaylistRenderCache::render_queue_lock;
+Glib::Threads::Cond  PlaylistRenderCache::PlaylistsToRender;
+list<boost::weak_ptr<AudioPlaylist> > PlaylistRenderCache::render_queue;
+
+/* samples per channel rendered at a time */
+static const samplecnt_t render_chunk = 65536;
+
+/* only render once a playlist has not been modified for this long [usec] */
+static const int64_t settle_time = 2000000;
+
+/* give up on a range after this many consecutive failed attempts */
+static const uint32_t max_attempts = 4;
+
+PlaylistRenderCache::PlaylistRenderCache (Session& s, AudioPlaylist& pl)
+	: _session (s)
+	, _playlist (pl)
+	, _enabled (false)
+	, _queued (false)
+	, _last_change (0)
+	, _failures (0)
+{
+}
+
+PlaylistRenderCache::~PlaylistRenderCache ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	close_files ();
+}
+
+void
+PlaylistRenderCache::set_enabled (bool yn)
+{
+	/* do not hold _lock while taking the playlist's region lock */
+	pair<samplepos_t, samplepos_t> ext (0, 0);
+	if (yn) {
+		ext = _playlist.get_extent ();
+	}
+
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		if (yn == _enabled) {
+			return;
+		}
+
+		DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("Playlist %1 render cache %2\n", _playlist.name (), yn ? "enabled" : "disabled"));
+
+		_enabled = yn;
+		_dirty.clear ();
+		_failed.clear ();
+		_failures = 0;
+
+		if (!yn) {
+			close_files ();
+			return;
+		}
+
+		if (ext.second > 0) {
+			_dirty.push_back (Evoral::Range<samplepos_t> (0, ext.second - 1));
+		}
+		_last_change = 0;
+	}
+
+	queue ();
+}
+
+void
+PlaylistRenderCache::invalidate (Evoral::Range<samplepos_t> const& range)
+{
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		if (!_enabled) {
+			return;
+		}
+
+		_last_change = g_get_monotonic_time ();
+
+		Evoral::Range<samplepos_t> r (range);
+		for (RangeList::iterator i = _dirty.begin (); i != _dirty.end ();) {
+			if (Evoral::coverage (r.from, r.to, i->from, i->to) != Evoral::OverlapNone) {
+				r.from = min (r.from, i->from);
+				r.to   = max (r.to, i->to);
+				i = _dirty.erase (i);
+			} else {
+				++i;
+			}
+		}
+		/* the playlist changed, retry ranges that failed to render */
+		for (RangeList::iterator i = _failed.begin (); i != _failed.end ();) {
+			if (Evoral::coverage (r.from, r.to, i->from, i->to) != Evoral::OverlapNone) {
+				r.from = min (r.from, i->from);
+				r.to   = max (r.to, i->to);
+				i = _failed.erase (i);
+			} else {
+				++i;
+			}
+		}
+		_dirty.push_back (r);
+	}
+
+	queue ();
+}
+
+bool
+PlaylistRenderCache::is_dirty (samplepos_t start, samplepos_t end) const
+{
+	for (RangeList::const_iterator i = _dirty.begin (); i != _dirty.end (); ++i) {
+		if (Evoral::coverage (start, end, i->from, i->to) != Evoral::OverlapNone) {
+			return true;
+		}
+	}
+	for (RangeList::const_iterator i = _busy.begin (); i != _busy.end (); ++i) {
+		if (Evoral::coverage (start, end, i->from, i->to) != Evoral::OverlapNone) {
+			return true;
+		}
+	}
+	for (RangeList::const_iterator i = _failed.begin (); i != _failed.end (); ++i) {
+		if (Evoral::coverage (start, end, i->from, i->to) != Evoral::OverlapNone) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool
+PlaylistRenderCache::read (Sample* buf, samplepos_t start, samplecnt_t cnt, uint32_t chn)
+{
+	if (cnt <= 0) {
+		return false;
+	}
+
+	/* never wait for the render thread, read the playlist instead */
+	Glib::Threads::Mutex::Lock lm (_lock, Glib::Threads::TRY_LOCK);
+
+	if (!lm.locked () || !_enabled || chn >= _sf.size ()) {
+		return false;
+	}
+
+	if (is_dirty (start, start + cnt - 1)) {
+		return false;
+	}
+
+	if (sf_seek (_sf[chn], start, SEEK_SET) != start) {
+		return false;
+	}
+
+	return sf_readf_float (_sf[chn], buf, cnt) == cnt;
+}
+
+bool
+PlaylistRenderCache::open_files (uint32_t n_chans)
+{
+	while (_sf.size () < n_chans) {
+		const uint32_t chn = _sf.size ();
+		const string path = Glib::build_filename (_session.session_directory ().peak_path (),
+		                                          string_compose ("%1-%2.render", _playlist.id ().to_s (), chn));
+
+		SF_INFO info;
+		memset (&info, 0, sizeof (info));
+		info.samplerate = _session.nominal_sample_rate ();
+		info.channels   = 1;
+		info.format     = SF_FORMAT_RAW | SF_FORMAT_FLOAT | SF_ENDIAN_CPU;
+
+#ifdef PLATFORM_WINDOWS
+		int fd = g_open (path.c_str (), O_CREAT | O_TRUNC | O_RDWR, 0644);
+#else
+		int fd = ::open (path.c_str (), O_CREAT | O_TRUNC | O_RDWR, 0644);
+#endif
+		if (fd == -1) {
+			return false;
+		}
+
+		SNDFILE* sf = sf_open_fd (fd, SFM_RDWR, &info, true);
+		if (!sf) {
+			::g_unlink (path.c_str ());
+			return false;
+		}
+
+		_sf.push_back (sf);
+		_paths.push_back (path);
+	}
+	return true;
+}
+
+void
+PlaylistRenderCache::close_files ()
+{
+	for (vector<SNDFILE*>::const_iterator i = _sf.begin (); i != _sf.end (); ++i) {
+		sf_close (*i);
+	}
+	for (vector<string>::const_iterator i = _paths.begin (); i != _paths.end (); ++i) {
+		::g_unlink (i->c_str ());
+	}
+	_sf.clear ();
+	_paths.clear ();
+}
+
+/** render the next chunk of a modified range */
+PlaylistRenderCache::RenderResult
+PlaylistRenderCache::render ()
+{
+	/* channel-count, without holding _lock */
+	uint32_t n_chans = 0;
+	boost::shared_ptr<RegionList> rl = _playlist.region_list ();
+	for (RegionList::const_iterator i = rl->begin (); i != rl->end (); ++i) {
+		boost::shared_ptr<AudioRegion> ar = boost::dynamic_pointer_cast<AudioRegion> (*i);
+		if (ar) {
+			n_chans = max (n_chans, ar->n_channels ());
+		}
+	}
+
+	Evoral::Range<samplepos_t> r (0, 0);
+
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+
+		if (!_enabled || _dirty.empty ()) {
+			_queued = false;
+			return Done;
+		}
+
+		/* back off exponentially after failed attempts */
+		if (g_get_monotonic_time () < _last_change + (settle_time << _failures)) {
+			return Later;
+		}
+
+		if (!open_files (n_chans)) {
+			error << string_compose (_("Cannot create render cache for playlist %1"), _playlist.name ()) << endmsg;
+			_enabled = false;
+			_queued = false;
+			_dirty.clear ();
+			close_files ();
+			return Done;
+		}
+
+		/* split off a chunk, the rest stays dirty */
+		r = _dirty.front ();
+		if (r.to - r.from >= render_chunk) {
+			r.to = r.from + render_chunk - 1;
+			_dirty.front ().from = r.to + 1;
+		} else {
+			_dirty.pop_front ();
+		}
+		_busy.push_back (r);
+		n_chans = _sf.size ();
+	}
+
+	/* read the playlist without holding _lock. If the range is modified
+	 * meanwhile, it is added to _dirty again and stays unavailable.
+	 */
+	const samplecnt_t cnt = r.to - r.from + 1;
+
+	boost::scoped_array<Sample> buf (new Sample[cnt]);
+	boost::scoped_array<Sample> mixdown (new Sample[cnt]);
+	boost::scoped_array<float>  gain (new float[cnt]);
+
+	bool ok = true;
+
+	for (uint32_t chn = 0; chn < n_chans && ok; ++chn) {
+		if (_playlist.read (buf.get (), mixdown.get (), gain.get (), r.from, cnt, chn) != cnt) {
+			ok = false;
+			break;
+		}
+
+		Glib::Threads::Mutex::Lock lm (_lock);
+		if (!_enabled || chn >= _sf.size ()) {
+			ok = false;
+			break;
+		}
+		if (sf_seek (_sf[chn], r.from, SEEK_SET) != r.from || sf_writef_float (_sf[chn], buf.get (), cnt) != cnt) {
+			ok = false;
+			break;
+		}
+	}
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	_busy.remove (r);
+
+	if (!ok && _enabled) {
+		if (++_failures < max_attempts) {
+			/* try again later */
+			_dirty.push_front (r);
+			_last_change = g_get_monotonic_time ();
+			return Later;
+		}
+		/* keep reading the playlist for this range until it is modified */
+		warning << string_compose (_("Cannot render samples %2 to %3 of playlist %1, reading them from the playlist instead"),
+		                           _playlist.name (), r.from, r.to) << endmsg;
+		_failed.push_back (r);
+		_failures = 0;
+	} else if (ok) {
+		_failures = 0;
+	}
+
+	if (!_enabled || _dirty.empty ()) {
+		DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("Playlist %1 render cache complete\n", _playlist.name ()));
+		_queued = false;
+		return Done;
+	}
+
+	return More;
+}
+
+void
+PlaylistRenderCache::queue ()
+{
+	boost::shared_ptr<AudioPlaylist> pl;
+
+	try {
+		pl = boost::dynamic_pointer_cast<AudioPlaylist> (_playlist.shared_from_this ());
+	} catch (boost::bad_weak_ptr const&) {
+		/* playlist is being constructed or destroyed */
+		return;
+	}
+
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		if (_queued || !_enabled) {
+			return;
+		}
+		_queued = true;
+	}
+
+	Glib::Threads::Mutex::Lock lq (render_queue_lock);
+	render_queue.push_back (boost::weak_ptr<AudioPlaylist> (pl));
+	PlaylistsToRender.broadcast ();
+}
+
+static void
+render_cache_work ()
+{
+	pthread_set_name ("PlaylistRender");
+	PlaylistRenderCache::work ();
+}
+
+void
+PlaylistRenderCache::init ()
+{
+	Glib::Threads::Thread::create (sigc::ptr_fun (render_cache_work));
+}
+
+void
+PlaylistRenderCache::work ()
+{
+	while (true) {
+		render_queue_lock.lock ();
+
+	  wait:
+		if (render_queue.empty ()) {
+			PlaylistsToRender.wait (render_queue_lock);
+		}
+
+		if (render_queue.empty ()) {
+			goto wait;
+		}
+
+		boost::shared_ptr<AudioPlaylist> pl (render_queue.front ().lock ());
+		render_queue.pop_front ();
+		render_queue_lock.unlock ();
+
+		if (!pl) {
+			continue;
+		}
+
+		RenderResult rv;
+		{
+			Glib::Threads::Mutex::Lock lm (render_active_lock);
+			rv = pl->render_cache ().render ();
+		}
+
+		if (rv == Done) {
+			continue;
+		}
+
+		/* round-robin, one chunk per playlist at a time */
+		render_queue_lock.lock ();
+		render_queue.push_back (boost::weak_ptr<AudioPlaylist> (pl));
+		const bool all_unsettled = rv == Later && render_queue.size () == 1;
+		render_queue_lock.unlock ();
+
+		pl.reset ();
+
+		if (rv == Later) {
+			Glib::usleep (all_unsettled ? settle_time / 4 : 10000);
+		}
+	}
+}
+
+void
+PlaylistRenderCache::flush ()
+{
+	Glib::Threads::Mutex::Lock lq (render_queue_lock);
+	Glib::Threads::Mutex::Lock la (render_active_lock);
+	render_queue.clear ();
+}
@@ -59,6 +59,7 @@
 #include "ardour/plugin.h"
 #include "ardour/plugin_manager.h"
 #include "ardour/port.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/session.h"
 #include "ardour/types.h"
 
@@ -421,6 +422,16 @@ Plugin::connect_and_run (BufferSet& bufs,
 	return 0;
 }
 
+samplecnt_t
+Plugin::signal_tailtime () const
+{
+	const samplecnt_t tail = plugin_tailtime ();
+	if (tail >= 0) {
+		return tail;
+	}
+	return Config->get_plugin_default_tail () * _session.sample_rate ();
+}
+
 void
 Plugin::realtime_handle_transport_stopped ()
 {
@@ -35,14 +35,18 @@
 #include "ardour/audio_buffer.h"
 #include "ardour/automation_list.h"
 #include "ardour/buffer_set.h"
+#include "ardour/dB.h"
 #include "ardour/debug.h"
 #include "ardour/event_type_map.h"
 #include "ardour/ladspa_plugin.h"
 #include "ardour/luaproc.h"
 #include "ardour/lv2_plugin.h"
+#include "ardour/midi_buffer.h"
 #include "ardour/plugin.h"
 #include "ardour/plugin_insert.h"
 #include "ardour/port.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/runtime_functions.h"
 
 #ifdef WINDOWS_VST_SUPPORT
 #include "ardour/windows_vst_plugin.h"
@@ -91,6 +95,13 @@ PluginInsert::PluginInsert (Session& s, boost::shared_ptr<Plugin> plug)
 	, _bypass_port (UINT32_MAX)
 	, _inverted_bypass_enable (false)
 	, _stat_reset (0)
+	, _sleeping (false)
+	, _sleep_rolling (false)
+	, _silent_samples (0)
+	, _sleep_tail (-1)
+	, _wake_up (0)
+	, _run_cycles (0)
+	, _sleep_cycles (0)
 {
 	/* the first is the master */
 
@@ -589,6 +600,8 @@ PluginInsert::parameter_changed_externally (uint32_t which, float val)
 		pc->catch_up_with_external_value (val);
 	}
 
+	wake_up ();
+
 	/* Second propagation: tell all plugins except the first to
 	   update the value of this parameter. For sane plugin APIs,
 	   there are no other plugins, so this is a no-op in those
@@ -674,9 +687,12 @@ void
 PluginInsert::activate ()
 {
 	_timing_stats.reset ();
+	_sleeping = false;
+	_silent_samples = 0;
 	for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
 		(*i)->activate ();
 	}
+	update_sleep_tail ();
 
 	Processor::activate ();
 	/* when setting state e.g ProcessorBox::paste_processor_state ()
@@ -698,6 +714,8 @@ void
 PluginInsert::deactivate ()
 {
 	_timing_stats.reset ();
+	_sleeping = false;
+	_silent_samples = 0;
 	Processor::deactivate ();
 
 	for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
@@ -910,6 +928,7 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 	bufs.set_count(ChanCount::max(bufs.count(), _configured_out));
 
 	if (with_auto) {
+		const bool sample_accurate = sample_accurate_automation ();
 		boost::shared_ptr<ControlList> cl = _automated_controls.reader ();
 		for (ControlList::const_iterator ci = cl->begin(); ci != cl->end(); ++ci) {
 			AutomationControl& c = *(ci->get());
@@ -922,10 +941,15 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 				if (valid) {
 					c.set_value_unchecked(val);
 				}
-#if 0
-				/* 2. VST3: events between now and end. */
-				assert (_plugins.front()->requires_fixed_sized_buffers());
-				samplepos_t now = start;
+				if (!sample_accurate || end <= start || clist->parameter().type() != PluginAutomation) {
+					continue;
+				}
+				/* 2. Plugins that accept timestamped parameter changes
+				 * get all events between now and end, as well as the value
+				 * at cycle-end, instead of splitting the cycle.
+				 */
+				const uint32_t id = clist->parameter().id();
+				double now = start;
 				while (true) {
 					Evoral::ControlEvent next_event (end, 0.0f);
 					find_next_ac_event (*ci, now, end, next_event);
@@ -933,23 +957,23 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 						break;
 					}
 					now = next_event.when;
-					const float val = c.list()->rt_safe_eval (now, valid);
+					val = clist->rt_safe_eval (now, valid);
 					if (valid) {
+						sampleoffset_t when = std::min<sampleoffset_t> (floor ((now - start) / speed), nframes - 1);
 						for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
-							(*i)->set_parameter (clist->parameter().id(), val, now - start);
+							(*i)->set_parameter (id, val, when);
 						}
 					}
 				}
-#endif
-#if 0
 				/* 3. set value at cycle-end */
-				val = c.list()->rt_safe_eval (end, valid);
-				if (valid) {
-					for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
-						(*i)->set_parameter (clist->parameter().id(), val, end - start);
+				if (nframes > 1) {
+					val = clist->rt_safe_eval (start + (nframes - 1) * speed, valid);
+					if (valid) {
+						for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
+							(*i)->set_parameter (id, val, nframes - 1);
+						}
 					}
 				}
-#endif
 			}
 		}
 	}
@@ -1267,6 +1291,33 @@ PluginInsert::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sa
 
 	if (g_atomic_int_compare_and_exchange (&_stat_reset, 1, 0)) {
 		_timing_stats.reset ();
+		g_atomic_int_set (&_run_cycles, 0);
+		g_atomic_int_set (&_sleep_cycles, 0);
+	}
+
+	/* The input has to be inspected before the plugin runs (in-place) */
+	const bool silent_input = _active && _pending_active
+		&& Config->get_plugin_sleep_on_silence ()
+		&& g_atomic_int_get (&_sleep_tail) >= 0
+		&& _signal_analysis_collect_nsamples_max == 0
+		&& input_is_silent (bufs, nframes);
+
+	/* wake up on parameter changes, locate or transport start/stop */
+	const bool rolling = _session.transport_rolling ();
+	const bool wake = g_atomic_int_compare_and_exchange (&_wake_up, 1, 0) || rolling != _sleep_rolling;
+	_sleep_rolling = rolling;
+
+	if (!silent_input || wake) {
+		_sleeping = false;
+		_silent_samples = 0;
+	}
+
+	if (_sleeping) {
+		/* skip processing until the input is no longer silent */
+		automation_run (start_sample, nframes, true); // evaluate automation only
+		silence_outputs (bufs, nframes);
+		g_atomic_int_inc (&_sleep_cycles);
+		return;
 	}
 
 	if (_pending_active) {
@@ -1292,6 +1343,22 @@ PluginInsert::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sa
 #else
 		_timing_stats.update ();
 #endif
+		g_atomic_int_inc (&_run_cycles);
+
+		if (silent_input) {
+			/* sleep once the tail has decayed, and the output has been
+			 * silent for at least the plugin's latency and tail.
+			 */
+			if (output_is_silent (bufs, nframes)) {
+				_silent_samples += nframes;
+				if (_silent_samples - _plugin_signal_latency > g_atomic_int_get (&_sleep_tail)) {
+					_sleeping = true;
+					_delaybuffers.flush ();
+				}
+			} else {
+				_silent_samples = 0;
+			}
+		}
 
 	} else {
 		_timing_stats.reset ();
@@ -1309,6 +1376,74 @@ PluginInsert::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sa
 	 */
 }
 
+bool
+PluginInsert::input_is_silent (BufferSet& bufs, pframes_t nframes) const
+{
+	const ChanCount in = ChanCount::min (bufs.count (), _configured_internal);
+	if (in.n_total () == 0) {
+		/* generators are never asleep */
+		return false;
+	}
+	for (uint32_t i = 0; i < in.n_audio (); ++i) {
+		if (compute_peak (bufs.get_audio (i).data (), nframes, 0) > GAIN_COEFF_SMALL) {
+			return false;
+		}
+	}
+	for (uint32_t i = 0; i < in.n_midi (); ++i) {
+		if (!bufs.get_midi (i).empty ()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool
+PluginInsert::output_is_silent (BufferSet& bufs, pframes_t nframes) const
+{
+	const ChanCount out = ChanCount::min (bufs.count (), _configured_out);
+	for (uint32_t i = 0; i < out.n_audio (); ++i) {
+		if (compute_peak (bufs.get_audio (i).data (), nframes, 0) > GAIN_COEFF_SMALL) {
+			return false;
+		}
+	}
+	for (uint32_t i = 0; i < out.n_midi (); ++i) {
+		if (!bufs.get_midi (i).empty ()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/** cache the plugin's tail, Plugin::signal_tailtime () is not realtime safe */
+void
+PluginInsert::update_sleep_tail ()
+{
+	if (_plugins.empty () || is_instrument ()) {
+		/* instruments may produce sound without input (arpeggiator, LFO) */
+		g_atomic_int_set (&_sleep_tail, -1);
+		return;
+	}
+	const samplecnt_t tail = _plugins.front ()->signal_tailtime ();
+	g_atomic_int_set (&_sleep_tail, std::min<samplecnt_t> (tail, G_MAXINT));
+}
+
+void
+PluginInsert::silence_outputs (BufferSet& bufs, pframes_t nframes) const
+{
+	bufs.set_count (ChanCount::max (bufs.count (), _configured_out));
+	for (DataType::iterator t = DataType::begin (); t != DataType::end (); ++t) {
+		for (uint32_t out = 0; out < _configured_out.get (*t); ++out) {
+			bufs.get_available (*t, out).silence (nframes);
+		}
+	}
+}
+
+bool
+PluginInsert::sample_accurate_automation () const
+{
+	return _plugins.front()->sample_accurate_parameters () && Config->get_sample_accurate_plugin_automation ();
+}
+
 void
 PluginInsert::automate_and_run (BufferSet& bufs, samplepos_t start, samplepos_t end, double speed, pframes_t nframes)
 {
@@ -1333,6 +1468,31 @@ PluginInsert::automate_and_run (BufferSet& bufs, samplepos_t start, samplepos_t
 		return;
 	}
 
+	if (sample_accurate_automation ()) {
+		/* automation events are passed to the plugin with a sample-offset,
+		 * the cycle only needs to be split at the loop-end.
+		 */
+		while (nframes) {
+			samplecnt_t cnt = nframes;
+			if (_loop_location) {
+				const samplepos_t loop_end = _loop_location->end ();
+				if (start < loop_end && end > loop_end) {
+					cnt = min ((samplecnt_t) ceil ((loop_end - start) / speed), (samplecnt_t) nframes);
+				}
+			}
+			assert (cnt > 0);
+
+			connect_and_run (bufs, start, start + cnt * speed, speed, cnt, offset, true);
+
+			nframes -= cnt;
+			offset += cnt;
+			start += cnt * speed;
+
+			map_loop_range (start, end);
+		}
+		return;
+	}
+
 	while (nframes) {
 
 		samplecnt_t cnt = min ((samplecnt_t) ceil (fabs (next_event.when - start)), (samplecnt_t) nframes);
@@ -3034,6 +3194,11 @@ PluginInsert::PluginControl::actually_set_value (double user_val, PBD::Controlla
 {
 	/* FIXME: probably should be taking out some lock here.. */
 
+	if (user_val != user_double ()) {
+		/* unchanged automation playback does not keep the plugin awake */
+		_plugin->wake_up ();
+	}
+
 	for (Plugins::iterator i = _plugin->_plugins.begin(); i != _plugin->_plugins.end(); ++i) {
 		(*i)->set_parameter (_list->parameter().id(), user_val, 0);
 	}
@@ -3297,6 +3462,7 @@ PluginInsert::load_preset (ARDOUR::Plugin::PresetRecord pr)
 void
 PluginInsert::realtime_handle_transport_stopped ()
 {
+	wake_up ();
 	for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
 		(*i)->realtime_handle_transport_stopped ();
 	}
@@ -3305,11 +3471,21 @@ PluginInsert::realtime_handle_transport_stopped ()
 void
 PluginInsert::realtime_locate (bool for_loop_end)
 {
+	wake_up ();
 	for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
 		(*i)->realtime_locate (for_loop_end);
 	}
 }
 
+void
+PluginInsert::set_output_latency (samplecnt_t cnt)
+{
+	Processor::set_output_latency (cnt);
+	/* called by Route::update_signal_latency () after a latency change,
+	 * in non-realtime context, the tail may change with the latency */
+	update_sleep_tail ();
+}
+
 void
 PluginInsert::monitoring_changed ()
 {
@@ -3377,6 +3553,14 @@ PluginInsert::clear_stats ()
 	g_atomic_int_set (&_stat_reset, 1);
 }
 
+double
+PluginInsert::sleep_ratio () const
+{
+	const gint slept = g_atomic_int_get (&_sleep_cycles);
+	const gint total = slept + g_atomic_int_get (&_run_cycles);
+	return total > 0 ? slept / (double) total : 0;
+}
+
 std::ostream& operator<<(std::ostream& o, const ARDOUR::PluginInsert::Match& m)
 {
 	switch (m.method) {
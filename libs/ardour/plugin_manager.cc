@@ -95,6 +95,7 @@
 #include "ardour/lv2_plugin.h"
 #include "ardour/plugin.h"
 #include "ardour/plugin_manager.h"
+#include "ardour/plugin_scan_pool.h"
 #include "ardour/rc_configuration.h"
 
 #include "ardour/search_paths.h"
@@ -170,6 +171,7 @@ PluginManager::PluginManager ()
 	, _lua_plugin_info(0)
 	, _cancel_scan(false)
 	, _cancel_timeout(false)
+	, _scan_index ("plugin_index.xml")
 {
 	char* s;
 	string lrdf_path;
@@ -426,6 +428,8 @@ PluginManager::refresh (bool cache_only)
 	DEBUG_TRACE (DEBUG::PluginManager, "PluginManager::refresh\n");
 	_cancel_scan = false;
 
+	_scan_index.load ();
+
 	BootMessage (_("Scanning LADSPA Plugins"));
 	ladspa_refresh ();
 	BootMessage (_("Scanning Lua DSP Processors"));
@@ -543,6 +547,8 @@ PluginManager::refresh (bool cache_only)
 		}
 	}
 
+	_scan_index.save ();
+
 	BootMessage (_("Plugin Scan Complete..."));
 	PluginListChanged (); /* EMIT SIGNAL */
 	PluginScanMessage(X_("closeme"), "", false);
@@ -669,6 +675,11 @@ PluginManager::clear_vst_cache ()
 			::g_unlink(i->c_str());
 		}
 	}
+	_scan_index.load ();
+	_scan_index.clear (Windows_VST);
+	_scan_index.clear (LXVST);
+	_scan_index.clear (MacVST);
+	_scan_index.save ();
 #endif
 }
 
@@ -1135,9 +1146,15 @@ PluginManager::windows_vst_discover_from_path (string path, bool cache_only)
 
 	find_files_matching_filter (plugin_objects, path, windows_vst_filter, 0, false, true, true);
 
+	std::set<std::string> scanned;
+	if (!cache_only && !cancelled ()) {
+		vst2_parallel_scan (_("VST"), plugin_objects, scanned);
+	}
+
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x) {
-		ARDOUR::PluginScanMessage(_("VST"), *x, !cache_only && !cancelled());
-		windows_vst_discover (*x, cache_only || cancelled());
+		bool const co = cache_only || cancelled() || scanned.find (*x) != scanned.end ();
+		ARDOUR::PluginScanMessage(_("VST"), *x, !co);
+		windows_vst_discover (*x, co);
 	}
 
 	if (Config->get_verbose_plugin_scan()) {
@@ -1228,6 +1245,7 @@ PluginManager::windows_vst_discover (string path, bool cache_only)
 	// .err file scanner output etc.
 
 	if (finfos->empty()) {
+		_scan_index.remove (path);
 		DEBUG_TRACE (DEBUG::PluginManager, string_compose ("Cannot get Windows VST information from '%1'\n", path));
 		if (Config->get_verbose_plugin_scan()) {
 			info << _(" -> Cannot get Windows VST information, plugin ignored.") << endmsg;
@@ -1281,11 +1299,73 @@ PluginManager::windows_vst_discover (string path, bool cache_only)
 	}
 
 	vstfx_free_info_list (finfos);
+	_scan_index.update (path, Windows_VST);
 	return discovered > 0 ? 0 : -1;
 }
 
 #endif // WINDOWS_VST_SUPPORT
 
+#if (defined WINDOWS_VST_SUPPORT || defined LXVST_SUPPORT)
+
+static void vst2_scan_aborted (std::string const& dllpath)
+{
+	vstfx_scan_aborted (dllpath.c_str ());
+}
+
+static void vst2_scan_timed_out (std::string const& dllpath)
+{
+	vstfx_scan_timed_out (dllpath.c_str ());
+}
+
+/** run the external scanner app concurrently for all plugins that
+ * were added or modified since the last scan. The subsequent serial
+ * discovery then only has to read the resulting cache files.
+ */
+void
+PluginManager::vst2_parallel_scan (std::string const& type, vector<string> const& plugin_objects, std::set<std::string>& scanned)
+{
+	if (scanner_bin_path.empty ()) {
+		return;
+	}
+
+	PluginScanPool pool (scanner_bin_path, type);
+	pool.aborted   = &vst2_scan_aborted;
+	pool.timed_out = &vst2_scan_timed_out;
+
+	for (vector<string>::const_iterator x = plugin_objects.begin(); x != plugin_objects.end (); ++x) {
+		if (_scan_index.unchanged (*x)) {
+			continue;
+		}
+		if (_scan_index.stale (*x)) {
+			/* modified, the mtime of the cache is not sufficient to tell */
+			pool.add (*x, std::vector<std::string> (1, "-f"));
+		} else if (vstfx_needs_scan (x->c_str ())) {
+			pool.add (*x);
+		} else {
+			continue;
+		}
+		/* no need to re-try in-line, even if the scan fails or times out */
+		scanned.insert (*x);
+	}
+
+	if (pool.n_queued () == 0) {
+		return;
+	}
+
+	DEBUG_TRACE (DEBUG::PluginManager, string_compose ("%1: scanning %2 plugins using %3 processes\n", type, pool.n_queued (), pool.n_jobs ()));
+	_cancel_timeout = false;
+	pool.run ();
+
+	/* concurrent scanner processes may race updating the shared blacklist file.
+	 * Now that all of them terminated, remove plugins that were scanned successfully.
+	 */
+	for (std::set<std::string>::const_iterator x = scanned.begin (); x != scanned.end (); ++x) {
+		vstfx_scan_completed (x->c_str ());
+	}
+}
+
+#endif
+
 #ifdef MACVST_SUPPORT
 void
 PluginManager::mac_vst_refresh (bool cache_only)
@@ -1455,9 +1535,15 @@ PluginManager::lxvst_discover_from_path (string path, bool cache_only)
 
 	find_files_matching_filter (plugin_objects, Config->get_plugin_path_lxvst(), lxvst_filter, 0, false, true, true);
 
+	std::set<std::string> scanned;
+	if (!cache_only && !cancelled ()) {
+		vst2_parallel_scan (_("LXVST"), plugin_objects, scanned);
+	}
+
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x) {
-		ARDOUR::PluginScanMessage(_("LXVST"), *x, !cache_only && !cancelled());
-		lxvst_discover (*x, cache_only || cancelled());
+		bool const co = cache_only || cancelled() || scanned.find (*x) != scanned.end ();
+		ARDOUR::PluginScanMessage(_("LXVST"), *x, !co);
+		lxvst_discover (*x, co);
 	}
 
 	return ret;
@@ -1473,6 +1559,7 @@ PluginManager::lxvst_discover (string path, bool cache_only)
 			cache_only ? VST_SCAN_CACHE_ONLY : VST_SCAN_USE_APP);
 
 	if (finfos->empty()) {
+		_scan_index.remove (path);
 		DEBUG_TRACE (DEBUG::PluginManager, string_compose ("Cannot get Linux VST information from '%1'\n", path));
 		return -1;
 	}
@@ -1523,6 +1610,7 @@ PluginManager::lxvst_discover (string path, bool cache_only)
 	}
 
 	vstfx_free_info_list (finfos);
+	_scan_index.update (path, LXVST);
 	return discovered > 0 ? 0 : -1;
 }
 
@@ -1538,6 +1626,9 @@ PluginManager::clear_vst3_cache ()
 	for (vector<string>::iterator i = v3i_files.begin(); i != v3i_files.end (); ++i) {
 		::g_unlink(i->c_str());
 	}
+	_scan_index.load ();
+	_scan_index.clear (VST3);
+	_scan_index.save ();
 #endif
 }
 
@@ -1608,6 +1699,25 @@ static bool vst3_is_blacklisted (string const& module_path)
 	return bl.find (module_path + "\n") != string::npos;
 }
 
+static void vst3_scan_aborted (string const& bundle_path)
+{
+	/* may be partially written */
+	std::string module_path = module_path_vst3 (bundle_path);
+	if (!module_path.empty ()) {
+		g_unlink (vst3_cache_file (module_path).c_str ());
+		vst3_whitelist (module_path);
+	}
+}
+
+static void vst3_scan_timed_out (string const& bundle_path)
+{
+	/* may be partially written, the module remains blacklisted */
+	std::string module_path = module_path_vst3 (bundle_path);
+	if (!module_path.empty ()) {
+		g_unlink (vst3_cache_file (module_path).c_str ());
+	}
+}
+
 static bool vst3_filter (const string& str, void*)
 {
 	return str[0] != '.' && (str.length() > 4 && str.find (".vst3") == (str.length() - 5));
@@ -1652,9 +1762,54 @@ PluginManager::vst3_discover_from_path (string const& path, bool cache_only)
 
 	find_paths_matching_filter (plugin_objects, paths, vst3_filter, 0, false, true, true);
 
+	std::set<std::string> scanned;
+
+	if (!cache_only && !cancelled () && !vst3_scanner_bin_path.empty ()) {
+		/* run the scanner app concurrently for all new or modified bundles,
+		 * vst3_discover() below will then only read the cache files.
+		 */
+		PluginScanPool pool (vst3_scanner_bin_path, _("VST3"));
+		pool.aborted   = &vst3_scan_aborted;
+		pool.timed_out = &vst3_scan_timed_out;
+
+		for (vector<string>::iterator i = plugin_objects.begin(); i != plugin_objects.end (); ++i) {
+			string module_path = module_path_vst3 (*i);
+			if (module_path.empty () || _scan_index.unchanged (module_path)) {
+				continue;
+			}
+			if (!_scan_index.stale (module_path) && !vst3_valid_cache_file (module_path).empty ()) {
+				continue;
+			}
+			if (vst3_is_blacklisted (module_path)) {
+				continue;
+			}
+			vst3_blacklist (module_path);
+			std::vector<std::string> args;
+			args.push_back ("-q");
+			args.push_back ("-f");
+			pool.add (*i, args);
+			scanned.insert (*i);
+		}
+
+		if (pool.n_queued () > 0) {
+			DEBUG_TRACE (DEBUG::PluginManager, string_compose ("VST3: scanning %1 bundles using %2 processes\n", pool.n_queued (), pool.n_jobs ()));
+			_cancel_timeout = false;
+			pool.run ();
+		}
+
+		/* all scanners have terminated, whitelist modules that produced a cache-file */
+		for (std::set<std::string>::const_iterator i = scanned.begin (); i != scanned.end (); ++i) {
+			string module_path = module_path_vst3 (*i);
+			if (!vst3_valid_cache_file (module_path).empty ()) {
+				vst3_whitelist (module_path);
+			}
+		}
+	}
+
 	for (vector<string>::iterator i = plugin_objects.begin(); i != plugin_objects.end (); ++i) {
-		ARDOUR::PluginScanMessage(_("VST3"), *i, !(cache_only || cancelled()));
-		vst3_discover (*i, cache_only || cancelled ());
+		bool const co = cache_only || cancelled () || scanned.find (*i) != scanned.end ();
+		ARDOUR::PluginScanMessage(_("VST3"), *i, !co);
+		vst3_discover (*i, co);
 	}
 
 	return cancelled() ? -1 : 0;
@@ -1695,7 +1850,12 @@ PluginManager::vst3_discover (string const& path, bool cache_only)
 		return -1;
 	}
 
-	if (vst3_is_blacklisted (module_path)) {
+	/* modules that are unchanged since the last successful scan
+	 * cannot have been blacklisted since.
+	 */
+	bool const indexed = _scan_index.unchanged (module_path);
+
+	if (!indexed && vst3_is_blacklisted (module_path)) {
 		return -1;
 	}
 
@@ -1711,6 +1871,7 @@ PluginManager::vst3_discover (string const& path, bool cache_only)
 		}
 
 		vst3_whitelist (module_path);
+		_scan_index.update (module_path, VST3);
 		return 0;
 	}
 
@@ -1765,7 +1926,10 @@ PluginManager::vst3_discover (string const& path, bool cache_only)
 		return -1;
 	}
 
-	vst3_whitelist (module_path);
+	if (!indexed) {
+		vst3_whitelist (module_path);
+		_scan_index.update (module_path, VST3);
+	}
 
 	for (XMLNodeConstIterator i = tree.root()->children().begin(); i != tree.root()->children().end(); ++i) {
 		try {
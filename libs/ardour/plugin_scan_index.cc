@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <glib.h>
+#include <glibmm/fileutils.h>
+#include <glibmm/miscutils.h>
+
+#include "pbd/error.h"
+#include "pbd/gstdio_compat.h"
+#include "pbd/xml++.h"
+
+#include "ardour/filesystem_paths.h"
+#include "ardour/plugin_scan_index.h"
+#include "ardour/types_convert.h"
+
+#include "pbd/i18n.h"
+
+using namespace ARDOUR;
+using namespace PBD;
+
+PluginScanIndex::PluginScanIndex (std::string const& name)
+	: _path (Glib::build_filename (user_cache_directory (), name))
+	, _dirty (false)
+{
+}
+
+bool
+PluginScanIndex::stat_entry (std::string const& path, Entry& e)
+{
+	GStatBuf sb;
+	if (g_stat (path.c_str (), &sb) != 0) {
+		return false;
+	}
+	e.mtime = sb.st_mtime;
+	e.size  = sb.st_size;
+	return true;
+}
+
+bool
+PluginScanIndex::load ()
+{
+	_entries.clear ();
+	_dirty = false;
+
+	if (!Glib::file_test (_path, Glib::FILE_TEST_EXISTS)) {
+		return true;
+	}
+
+	XMLTree tree;
+	if (!tree.read (_path)) {
+		warning << string_compose (_("Cannot parse plugin scan index '%1'"), _path) << endmsg;
+		return false;
+	}
+
+	int version = 0;
+	if (!tree.root ()->get_property (X_("version"), version) || version != 2) {
+		/* unknown format, start over */
+		_dirty = true;
+		return false;
+	}
+
+	for (XMLNodeConstIterator i = tree.root ()->children ().begin (); i != tree.root ()->children ().end (); ++i) {
+		std::string path;
+		Entry       e;
+		if (!(*i)->get_property (X_("path"), path) ||
+		    !(*i)->get_property (X_("type"), e.type) ||
+		    !(*i)->get_property (X_("mtime"), e.mtime) ||
+		    !(*i)->get_property (X_("size"), e.size)) {
+			continue;
+		}
+		_entries[path] = e;
+	}
+	return true;
+}
+
+bool
+PluginScanIndex::save ()
+{
+	if (!_dirty) {
+		return true;
+	}
+
+	XMLNode* root = new XMLNode (X_("PluginScanIndex"));
+	root->set_property (X_("version"), 2);
+
+	for (EntryMap::const_iterator i = _entries.begin (); i != _entries.end (); ++i) {
+		XMLNode* node = root->add_child (X_("Module"));
+		node->set_property (X_("path"), i->first);
+		node->set_property (X_("type"), i->second.type);
+		node->set_property (X_("mtime"), i->second.mtime);
+		node->set_property (X_("size"), i->second.size);
+	}
+
+	XMLTree tree;
+	tree.set_root (root);
+	if (!tree.write (_path)) {
+		error << string_compose (_("Could not save plugin scan index to %1"), _path) << endmsg;
+		return false;
+	}
+	_dirty = false;
+	return true;
+}
+
+void
+PluginScanIndex::clear (PluginType type)
+{
+	for (EntryMap::iterator i = _entries.begin (); i != _entries.end ();) {
+		if (i->second.type == type) {
+			_entries.erase (i++);
+			_dirty = true;
+		} else {
+			++i;
+		}
+	}
+}
+
+bool
+PluginScanIndex::unchanged (std::string const& path) const
+{
+	EntryMap::const_iterator i = _entries.find (path);
+	if (i == _entries.end ()) {
+		return false;
+	}
+	Entry e;
+	if (!stat_entry (path, e)) {
+		return false;
+	}
+	return e == i->second;
+}
+
+bool
+PluginScanIndex::stale (std::string const& path) const
+{
+	EntryMap::const_iterator i = _entries.find (path);
+	if (i == _entries.end ()) {
+		return false;
+	}
+	Entry e;
+	if (!stat_entry (path, e)) {
+		return true;
+	}
+	return !(e == i->second);
+}
+
+void
+PluginScanIndex::update (std::string const& path, PluginType type)
+{
+	Entry e;
+	if (!stat_entry (path, e)) {
+		remove (path);
+		return;
+	}
+	e.type = type;
+	EntryMap::iterator i = _entries.find (path);
+	if (i != _entries.end () && i->second == e && i->second.type == type) {
+		return;
+	}
+	_entries[path] = e;
+	_dirty = true;
+}
+
+void
+PluginScanIndex::remove (std::string const& path)
+{
+	if (_entries.erase (path) > 0) {
+		_dirty = true;
+	}
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <glibmm/timer.h>
+
+#include "pbd/compose.h"
+#include "pbd/cpus.h"
+#include "pbd/error.h"
+
+#include "ardour/ardour.h"
+#include "ardour/debug.h"
+#include "ardour/plugin_manager.h"
+#include "ardour/plugin_scan_pool.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/system_exec.h"
+
+#include "pbd/i18n.h"
+
+using namespace ARDOUR;
+using namespace PBD;
+
+uint32_t
+PluginScanPool::default_concurrency ()
+{
+	uint32_t n = Config->get_plugin_scan_jobs ();
+	if (n == 0) {
+		n = hardware_concurrency ();
+	}
+	return std::max<uint32_t> (1, n);
+}
+
+PluginScanPool::PluginScanPool (std::string const& scanner_bin, std::string const& type, uint32_t n_jobs)
+	: _scanner_bin (scanner_bin)
+	, _type (type)
+	, _n_jobs (n_jobs > 0 ? n_jobs : default_concurrency ())
+	, _n_failed (0)
+{
+}
+
+PluginScanPool::~PluginScanPool ()
+{
+	for (std::list<Job*>::iterator i = _active.begin (); i != _active.end (); ++i) {
+		finish (*i, Aborted);
+	}
+	for (std::list<Job*>::iterator i = _queue.begin (); i != _queue.end (); ++i) {
+		delete *i;
+	}
+}
+
+void
+PluginScanPool::add (std::string const& bundle_path, std::vector<std::string> const& args)
+{
+	_queue.push_back (new Job (bundle_path, args));
+}
+
+void
+PluginScanPool::scanner_log (std::string msg, std::string bundle_path)
+{
+	PBD::info << string_compose ("%1: %2", bundle_path, msg) << endmsg;
+}
+
+bool
+PluginScanPool::start (Job* job)
+{
+	char** argp = (char**) calloc (job->args.size () + 3, sizeof (char*));
+	size_t n    = 0;
+	argp[n++]   = strdup (_scanner_bin.c_str ());
+	for (std::vector<std::string>::const_iterator i = job->args.begin (); i != job->args.end (); ++i) {
+		argp[n++] = strdup (i->c_str ());
+	}
+	argp[n++] = strdup (job->bundle_path.c_str ());
+	argp[n]   = 0;
+
+	DEBUG_TRACE (DEBUG::PluginManager, string_compose ("ScanPool: start scanner for '%1' (%2 active)\n", job->bundle_path, _active.size ()));
+
+	job->exec = new ARDOUR::SystemExec (_scanner_bin, argp);
+	job->exec->ReadStdout.connect_same_thread (job->log_connection, boost::bind (&PluginScanPool::scanner_log, _1, job->bundle_path));
+
+	if (job->exec->start (ARDOUR::SystemExec::MergeWithStdin)) {
+		PBD::error << string_compose (_("Cannot launch plugin scanner app '%1': %2"), _scanner_bin, strerror (errno)) << endmsg;
+		return false;
+	}
+
+	job->timeout = Config->get_vst_scan_timeout (); // deciseconds
+	ARDOUR::PluginScanMessage (_type, job->bundle_path, true);
+	return true;
+}
+
+void
+PluginScanPool::finish (Job* job, Result result)
+{
+	if (job->exec) {
+		job->exec->terminate ();
+	}
+	job->log_connection.disconnect ();
+	delete job->exec;
+
+	switch (result) {
+		case Completed:
+			break;
+		case Aborted:
+			++_n_failed;
+			if (aborted) {
+				aborted (job->bundle_path);
+			}
+			break;
+		case TimedOut:
+			++_n_failed;
+			if (timed_out) {
+				timed_out (job->bundle_path);
+			}
+			break;
+	}
+	delete job;
+}
+
+size_t
+PluginScanPool::run ()
+{
+	PluginManager& pm (PluginManager::instance ());
+	bool const notime = Config->get_vst_scan_timeout () <= 0;
+	int ticks = 0;
+
+	_n_failed = 0;
+
+	while (!_queue.empty () || !_active.empty ()) {
+
+		/* fill up the pool */
+		while (!_queue.empty () && _active.size () < _n_jobs && !pm.cancelled ()) {
+			Job* job = _queue.front ();
+			_queue.pop_front ();
+			if (start (job)) {
+				_active.push_back (job);
+			} else {
+				finish (job, Aborted);
+			}
+		}
+
+		if (pm.cancelled ()) {
+			/* drop everything that was not started yet, terminate the rest */
+			for (std::list<Job*>::iterator i = _queue.begin (); i != _queue.end (); ++i) {
+				delete *i;
+			}
+			_queue.clear ();
+			for (std::list<Job*>::iterator i = _active.begin (); i != _active.end (); ++i) {
+				finish (*i, Aborted);
+			}
+			_active.clear ();
+			break;
+		}
+
+		ARDOUR::GUIIdle ();
+		Glib::usleep (100000);
+		++ticks;
+
+		int min_timeout = -1;
+
+		for (std::list<Job*>::iterator i = _active.begin (); i != _active.end ();) {
+			Job* job = *i;
+
+			if (!job->exec->is_running ()) {
+				DEBUG_TRACE (DEBUG::PluginManager, string_compose ("ScanPool: done '%1'\n", job->bundle_path));
+				finish (job, Completed);
+				i = _active.erase (i);
+				continue;
+			}
+
+			if (!notime && !pm.no_timeout ()) {
+				if (--job->timeout <= 0) {
+					PBD::warning << string_compose (_("Plugin scan timed out: '%1'"), job->bundle_path) << endmsg;
+					finish (job, TimedOut);
+					i = _active.erase (i);
+					continue;
+				}
+				if (min_timeout < 0 || job->timeout < min_timeout) {
+					min_timeout = job->timeout;
+				}
+			}
+			++i;
+		}
+
+		if (min_timeout >= 0 && ticks % 5 == 0) {
+			ARDOUR::PluginScanTimeout (min_timeout);
+		}
+	}
+
+	return _n_failed;
+}
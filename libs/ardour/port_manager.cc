@@ -30,6 +30,7 @@
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
 
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 #include "pbd/strsplit.h"
 #include "pbd/unwind.h"
@@ -58,8 +59,17 @@ PortManager::PortManager ()
 	: ports (new Ports)
 	, _port_remove_in_progress (false)
 	, _port_deletions_pending (8192) /* ick, arbitrary sizing */
+	, _cycle_ports (0)
+	, _batch_nframes (0)
 	, midi_info_dirty (true)
 {
+	/* task lists are bound once, RTTaskList::process() does not allocate */
+	const size_t n_batches = std::max<uint32_t> (1, hardware_concurrency ());
+	for (size_t b = 0; b < n_batches; ++b) {
+		_cycle_start_batches.push_back (boost::bind (&PortManager::cycle_start_batch, this, b));
+		_cycle_end_batches.push_back (boost::bind (&PortManager::cycle_end_batch, this, b));
+	}
+
 	load_midi_port_info ();
 }
 
@@ -779,41 +789,42 @@ PortManager::graph_order_callback ()
 	return 0;
 }
 
+bool
+PortManager::parallel_resampling (Session* s) const
+{
+	/* when speed == 1.0, the resampler copies data without processing
+	 * it, running all ports in sequence is more efficient.
+	 */
+	return s && s->rt_tasklist () && fabs (Port::speed_ratio ()) != 1.0;
+}
+
 void
 PortManager::cycle_start (pframes_t nframes, Session* s)
 {
 	Port::set_global_port_buffer_offset (0);
 	Port::set_cycle_samplecnt (nframes);
 
-	_cycle_ports = ports.reader ();
+	_cycle_ports = ports.rt_reader ();
 
-	/* TODO optimize
-	 *  - when speed == 1.0, the resampler copies data without processing
-	 *   it may (or may not) be more efficient to just run all in sequence.
-	 *
-	 *  - single sequential task for 'lightweight' tasks would make sense
-	 *    (run it in parallel with 'heavy' resampling.
-	 *    * output ports (sends_output()) only set a flag
-	 *    * midi-ports only scale event timestamps
-	 *
-	 *  - a threshold parallel vs searial processing may be appropriate.
-	 *    amount of work (how many connected ports are there, how
-	 *    many resamplers need to run) vs. available CPU cores and semaphore
-	 *    synchronization overhead.
+	/* With vari-speed, audio ports are resampled in parallel, batched
+	 * per worker (see ::cycle_start_batch). MIDI ports only scale event
+	 * timestamps, and use the backend's MIDI API: they are processed
+	 * in sequence by the calling thread.
 	 *
+	 * TODO optimize
 	 *  - input ports: it would make sense to resample each input only once
 	 *    (rather than resample into each ardour-owned input port).
 	 *    A single external source-port may be connected to many ardour
 	 *    input-ports. Currently re-sampling is per input.
 	 */
-	if (s && s->rt_tasklist () && fabs (Port::speed_ratio ()) != 1.0) {
-		RTTaskList::TaskList tl;
+	if (parallel_resampling (s)) {
 		for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
-			if (!(p->second->flags() & TransportSyncPort)) {
-				tl.push_back (boost::bind (&Port::cycle_start, p->second, nframes));
+			if (!(p->second->flags() & TransportSyncPort) && p->second->type () != DataType::AUDIO) {
+				p->second->cycle_start (nframes);
 			}
 		}
-		s->rt_tasklist()->process (tl);
+		_batch_nframes = nframes;
+		s->rt_tasklist()->process (_cycle_start_batches);
 	} else {
 		for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
 			if (!(p->second->flags() & TransportSyncPort)) {
@@ -823,18 +834,59 @@ PortManager::cycle_start (pframes_t nframes, Session* s)
 	}
 }
 
+/* Batch @a batch of N processes every N-th audio input and every N-th
+ * audio output port. Inputs and outputs are counted separately: inputs
+ * are resampled at cycle-start, outputs at cycle-end, so that either
+ * is spread evenly.
+ */
 void
-PortManager::cycle_end (pframes_t nframes, Session* s)
+PortManager::cycle_start_batch (size_t batch)
 {
-	// see optimzation note in ::cycle_start()
-	if (0 && s && s->rt_tasklist () && fabs (Port::speed_ratio ()) != 1.0) {
-		RTTaskList::TaskList tl;
+	const size_t n_batches = _cycle_start_batches.size ();
+	size_t n_in  = 0;
+	size_t n_out = 0;
+
+	for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
+		if ((p->second->flags() & TransportSyncPort) || p->second->type () != DataType::AUDIO) {
+			continue;
+		}
+		size_t n = p->second->sends_output () ? n_out++ : n_in++;
+		if (n % n_batches == batch) {
+			p->second->cycle_start (_batch_nframes);
+		}
+	}
+}
+
+void
+PortManager::cycle_end_batch (size_t batch)
+{
+	const size_t n_batches = _cycle_end_batches.size ();
+	size_t n_in  = 0;
+	size_t n_out = 0;
+
+	for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
+		if ((p->second->flags() & TransportSyncPort) || p->second->type () != DataType::AUDIO) {
+			continue;
+		}
+		size_t n = p->second->sends_output () ? n_out++ : n_in++;
+		if (n % n_batches == batch) {
+			p->second->cycle_end (_batch_nframes);
+		}
+	}
+}
+
+void
+PortManager::cycle_end_ports (pframes_t nframes, Session* s)
+{
+	// see note in ::cycle_start()
+	if (parallel_resampling (s)) {
 		for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
-			if (!(p->second->flags() & TransportSyncPort)) {
-				tl.push_back (boost::bind (&Port::cycle_end, p->second, nframes));
+			if (!(p->second->flags() & TransportSyncPort) && p->second->type () != DataType::AUDIO) {
+				p->second->cycle_end (nframes);
 			}
 		}
-		s->rt_tasklist()->process (tl);
+		_batch_nframes = nframes;
+		s->rt_tasklist()->process (_cycle_end_batches);
 	} else {
 		for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
 			if (!(p->second->flags() & TransportSyncPort)) {
@@ -842,6 +894,12 @@ PortManager::cycle_end (pframes_t nframes, Session* s)
 			}
 		}
 	}
+}
+
+void
+PortManager::cycle_end (pframes_t nframes, Session* s)
+{
+	cycle_end_ports (nframes, s);
 
 	for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
 		/* AudioEngine::split_cycle flushes buffers until Port::port_offset.
@@ -849,7 +907,7 @@ PortManager::cycle_end (pframes_t nframes, Session* s)
 		p->second->flush_buffers (nframes * Port::speed_ratio() - Port::port_offset ());
 	}
 
-	_cycle_ports.reset ();
+	_cycle_ports = 0;
 
 	/* we are done */
 }
@@ -935,22 +993,7 @@ PortManager::check_monitoring ()
 void
 PortManager::cycle_end_fade_out (gain_t base_gain, gain_t gain_step, pframes_t nframes, Session* s)
 {
-	// see optimzation note in ::cycle_start()
-	if (0 && s && s->rt_tasklist () && fabs (Port::speed_ratio ()) != 1.0) {
-		RTTaskList::TaskList tl;
-		for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
-			if (!(p->second->flags() & TransportSyncPort)) {
-				tl.push_back (boost::bind (&Port::cycle_end, p->second, nframes));
-			}
-		}
-		s->rt_tasklist()->process (tl);
-	} else {
-		for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
-			if (!(p->second->flags() & TransportSyncPort)) {
-				p->second->cycle_end (nframes);
-			}
-		}
-	}
+	cycle_end_ports (nframes, s);
 
 	for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
 		p->second->flush_buffers (nframes);
@@ -969,7 +1012,7 @@ PortManager::cycle_end_fade_out (gain_t base_gain, gain_t gain_step, pframes_t n
 			}
 		}
 	}
-	_cycle_ports.reset ();
+	_cycle_ports = 0;
 	/* we are done */
 }
 
@@ -117,6 +117,7 @@ Route::Route (Session& sess, string name, PresentationInfo::Flag flag, DataType
 	, _pending_process_reorder (0)
 	, _pending_listen_change (0)
 	, _pending_signals (0)
+	, _pending_latency_recompute (0)
 	, _meter_point (MeterPostFader)
 	, _pending_meter_point (MeterPostFader)
 	, _denormal_protection (false)
@@ -524,12 +525,16 @@ Route::process_output_buffers (BufferSet& bufs,
 			latency += (*i)->effective_latency ();
 		}
 
+		const int64_t t0 = g_get_monotonic_time ();
+
 		if (speed < 0) {
 			(*i)->run (bufs, start_sample + latency, end_sample + latency, pspeed, nframes, *i != _processors.back());
 		} else {
 			(*i)->run (bufs, start_sample - latency, end_sample - latency, pspeed, nframes, *i != _processors.back());
 		}
 
+		(*i)->dsp_histogram ().record (g_get_monotonic_time () - t0);
+
 		bufs.set_count ((*i)->output_streams());
 
 		if (re_inject_oob_data) {
@@ -1137,7 +1142,7 @@ Route::add_processors (const ProcessorList& others, boost::shared_ptr<Processor>
 				(*i)->activate ();
 			}
 
-			(*i)->ActiveChanged.connect_same_thread (*this, boost::bind (&Session::queue_latency_recompute, &_session));
+			(*i)->ActiveChanged.connect_same_thread (*this, boost::bind (&Session::route_latency_changed, &_session, weakroute ()));
 
 			boost::shared_ptr<Send> send;
 			if ((send = boost::dynamic_pointer_cast<Send> (*i))) {
@@ -1599,7 +1604,7 @@ Route::replace_processor (boost::shared_ptr<Processor> old, boost::shared_ptr<Pr
 			sub->enable (true);
 		}
 
-		sub->ActiveChanged.connect_same_thread (*sub, boost::bind (&Session::queue_latency_recompute, &_session));
+		sub->ActiveChanged.connect_same_thread (*sub, boost::bind (&Session::route_latency_changed, &_session, weakroute ()));
 	}
 
 	reset_instrument_info ();
@@ -3139,7 +3144,7 @@ Route::set_processor_state (const XMLNode& node, int version)
 		for (ProcessorList::const_iterator i = _processors.begin(); i != _processors.end(); ++i) {
 
 			(*i)->set_owner (this);
-			(*i)->ActiveChanged.connect_same_thread (**i, boost::bind (&Session::queue_latency_recompute, &_session));
+			(*i)->ActiveChanged.connect_same_thread (**i, boost::bind (&Session::route_latency_changed, &_session, weakroute ()));
 
 			boost::shared_ptr<PluginInsert> pi;
 
@@ -4263,6 +4268,8 @@ Route::add_export_point()
 samplecnt_t
 Route::update_signal_latency (bool apply_to_delayline, bool* delayline_update_needed)
 {
+	g_atomic_int_set (&_pending_latency_recompute, 0);
+
 	if (!active()) {
 		_signal_latency = 0;
 		/* mark all send are inactive, set internal-return "delay-out" to zero. */
@@ -4328,7 +4335,12 @@ Route::update_signal_latency (bool apply_to_delayline, bool* delayline_update_ne
 				/* set capture latency */
 				snd->output ()->set_private_port_latencies (capt_lat_in + l_in, false);
 				/* take send-target's playback latency into account */
-				snd->set_delay_out (snd->output ()->connected_latency (true));
+				samplecnt_t delay_out = snd->output ()->connected_latency (true);
+				if (snd->get_delay_out () != delay_out) {
+					snd->set_delay_out (delay_out);
+					/* _signal_latency depends on it, walk this route again */
+					queue_latency_recompute ();
+				}
 				/* InternalReturn::set_playback_offset() below, also calls set_delay_out() */
 			}
 		}
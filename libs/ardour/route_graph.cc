@@ -17,6 +17,9 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <vector>
+
 #include "ardour/route.h"
 #include "ardour/route_graph.h"
 #include "ardour/track.h"
@@ -118,6 +121,18 @@ GraphEdges::from (GraphVertex r) const
 	return i->second;
 }
 
+/** @return the vertices that feed `r' */
+set<GraphVertex>
+GraphEdges::to (GraphVertex r) const
+{
+	EdgeMap::const_iterator i = _to_from.find (r);
+	if (i == _to_from.end ()) {
+		return set<GraphVertex> ();
+	}
+
+	return i->second;
+}
+
 void
 GraphEdges::remove (GraphVertex from, GraphVertex to)
 {
@@ -177,6 +192,31 @@ GraphEdges::dump () const
 	}
 }
 
+bool
+GraphEdges::operator== (GraphEdges const& other) const
+{
+	if (_from_to != other._from_to || _from_to_with_sends.size () != other._from_to_with_sends.size ()) {
+		return false;
+	}
+
+	typedef EdgeMapWithSends::const_iterator Iter;
+
+	for (Iter i = _from_to_with_sends.begin (); i != _from_to_with_sends.end (); ++i) {
+		pair<Iter, Iter> r = other._from_to_with_sends.equal_range (i->first);
+		Iter j;
+		for (j = r.first; j != r.second; ++j) {
+			if (j->second == i->second) {
+				break;
+			}
+		}
+		if (j == r.second) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 /** Insert an edge into one of the EdgeMaps */
 void
 GraphEdges::insert (EdgeMap& e, GraphVertex a, GraphVertex b)
@@ -287,3 +327,187 @@ ARDOUR::topological_sort (
 
 	return sorted_routes;
 }
+
+namespace {
+
+/** Dynamic topological order of a graph, see
+ *  D. J. Pearce, P. H. J. Kelly, "A Dynamic Topological Sort Algorithm for
+ *  Directed Acyclic Graphs", ACM Journal of Experimental Algorithmics 11 (2006)
+ */
+class DynamicTopologicalOrder
+{
+public:
+	DynamicTopologicalOrder (size_t n)
+		: _succ (n)
+		, _pred (n)
+		, _ord (n)
+		, _visited (n, false)
+	{
+		for (size_t i = 0; i < n; ++i) {
+			_ord[i] = i;
+		}
+	}
+
+	void add_edge (size_t from, size_t to)
+	{
+		_succ[from].push_back (to);
+		_pred[to].push_back (from);
+	}
+
+	size_t ord (size_t v) const { return _ord[v]; }
+
+	/* add an edge that is not in the order yet
+	 * @return false if the edge introduces a cycle
+	 */
+	bool insert (size_t x, size_t y)
+	{
+		add_edge (x, y);
+
+		if (_ord[x] < _ord[y]) {
+			return true;
+		}
+
+		_delta_f.clear ();
+		_delta_b.clear ();
+
+		/* nodes reachable from y, that are currently ordered before x */
+		if (!dfs_f (y, _ord[x])) {
+			for (vector<size_t>::const_iterator i = _delta_f.begin (); i != _delta_f.end (); ++i) {
+				_visited[*i] = false;
+			}
+			_succ[x].pop_back ();
+			_pred[y].pop_back ();
+			return false;
+		}
+
+		/* nodes that reach x, that are currently ordered after y */
+		dfs_b (x, _ord[y]);
+
+		reorder ();
+		return true;
+	}
+
+private:
+	struct OrdCompare {
+		OrdCompare (vector<size_t> const& o) : ord (o) {}
+		bool operator() (size_t a, size_t b) const { return ord[a] < ord[b]; }
+		vector<size_t> const& ord;
+	};
+
+	bool dfs_f (size_t n, size_t ub)
+	{
+		_visited[n] = true;
+		_delta_f.push_back (n);
+		for (vector<size_t>::const_iterator w = _succ[n].begin (); w != _succ[n].end (); ++w) {
+			if (_ord[*w] == ub) {
+				return false;
+			}
+			if (!_visited[*w] && _ord[*w] < ub) {
+				if (!dfs_f (*w, ub)) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	void dfs_b (size_t n, size_t lb)
+	{
+		_visited[n] = true;
+		_delta_b.push_back (n);
+		for (vector<size_t>::const_iterator w = _pred[n].begin (); w != _pred[n].end (); ++w) {
+			if (!_visited[*w] && lb < _ord[*w]) {
+				dfs_b (*w, lb);
+			}
+		}
+	}
+
+	/* move the nodes that reach x before the nodes reachable from y,
+	 * re-using the positions occupied by both sets */
+	void reorder ()
+	{
+		std::sort (_delta_b.begin (), _delta_b.end (), OrdCompare (_ord));
+		std::sort (_delta_f.begin (), _delta_f.end (), OrdCompare (_ord));
+
+		vector<size_t> l (_delta_b);
+		l.insert (l.end (), _delta_f.begin (), _delta_f.end ());
+
+		vector<size_t> r;
+		for (vector<size_t>::const_iterator i = l.begin (); i != l.end (); ++i) {
+			_visited[*i] = false;
+			r.push_back (_ord[*i]);
+		}
+		std::sort (r.begin (), r.end ());
+
+		for (size_t i = 0; i < l.size (); ++i) {
+			_ord[l[i]] = r[i];
+		}
+	}
+
+	vector<vector<size_t> > _succ;
+	vector<vector<size_t> > _pred;
+	vector<size_t>          _ord;
+	vector<bool>            _visited;
+	vector<size_t>          _delta_f;
+	vector<size_t>          _delta_b;
+};
+
+}
+
+/** Update the order of a list of routes, that is topologically sorted for
+ *  all but a few of the given edges. Only the routes between the ends of a
+ *  violating edge are moved, the relative order of all others is retained.
+ *  @return Sorted list of routes, or 0 if the graph contains cycles (feedback loops).
+ */
+boost::shared_ptr<RouteList>
+ARDOUR::incremental_topological_sort (
+	boost::shared_ptr<RouteList> routes,
+	GraphEdges const& edges
+	)
+{
+	const size_t n = routes->size ();
+
+	vector<GraphVertex> vertex;
+	map<GraphVertex, size_t> index;
+
+	for (RouteList::const_iterator i = routes->begin (); i != routes->end (); ++i) {
+		index[*i] = vertex.size ();
+		vertex.push_back (*i);
+	}
+
+	if (index.size () != n) {
+		/* duplicate entries */
+		return boost::shared_ptr<RouteList> ();
+	}
+
+	DynamicTopologicalOrder dto (n);
+	vector<pair<size_t, size_t> > violating;
+
+	for (size_t i = 0; i < n; ++i) {
+		set<GraphVertex> e = edges.from (vertex[i]);
+		for (set<GraphVertex>::const_iterator j = e.begin (); j != e.end (); ++j) {
+			map<GraphVertex, size_t>::const_iterator k = index.find (*j);
+			if (k == index.end ()) {
+				continue;
+			}
+			if (i < k->second) {
+				dto.add_edge (i, k->second);
+			} else {
+				violating.push_back (make_pair (i, k->second));
+			}
+		}
+	}
+
+	for (vector<pair<size_t, size_t> >::const_iterator i = violating.begin (); i != violating.end (); ++i) {
+		if (!dto.insert (i->first, i->second)) {
+			return boost::shared_ptr<RouteList> ();
+		}
+	}
+
+	vector<GraphVertex> sorted (n);
+	for (size_t i = 0; i < n; ++i) {
+		sorted[dto.ord (i)] = vertex[i];
+	}
+
+	return boost::shared_ptr<RouteList> (new RouteList (sorted.begin (), sorted.end ()));
+}
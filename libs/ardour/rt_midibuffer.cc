@@ -32,6 +32,8 @@
 #include "ardour/midi_state_tracker.h"
 #include "ardour/rt_midibuffer.h"
 
+#include "pbd/i18n.h"
+
 using namespace std;
 using namespace ARDOUR;
 using namespace PBD;
@@ -43,6 +45,7 @@ RTMidiBuffer::RTMidiBuffer ()
 	, _reversed (false)
 	, _pool_size (0)
 	, _pool_capacity (0)
+	, _pool_unused (0)
 	, _pool (0)
 {
 }
@@ -166,7 +169,7 @@ RTMidiBuffer::dump (uint32_t cnt)
 
 			/* more than 3 bytes ... indirect */
 
-			uint32_t offset = item->offset & ~(1<<(CHAR_BIT-1));
+			uint32_t offset = blob_offset (*item);
 			Blob* blob = reinterpret_cast<Blob*> (&_pool[offset]);
 
 			size = blob->size;
@@ -201,36 +204,51 @@ RTMidiBuffer::write (TimeType time, Evoral::EventType /*type*/, uint32_t size, c
 
 	_data[_size].timestamp = time;
 
+	if (!store (_data[_size], size, buf)) {
+		error << string_compose (_("MIDI playback buffer: no space left to store a %1 byte event"), size) << endmsg;
+		return 0;
+	}
+
+	++_size;
+
+	return size;
+}
+
+bool
+RTMidiBuffer::store (Item& item, uint32_t size, const uint8_t* buf)
+{
 	if (size > 3) {
 
-		uint32_t off = store_blob (size, buf);
+		uint32_t offset;
+
+		if (!store_blob (size, buf, offset)) {
+			return false;
+		}
 
-		/* non-zero MSbit indicates that the data (more than 3 bytes) is not inline */
-		_data[_size].offset = (off | (1<<(CHAR_BIT-1)));
+		/* non-zero bytes[0] indicates that the data (more than 3 bytes) is not inline */
+		set_blob_offset (item, offset);
 
 	} else {
 
 		assert ((int) size == Evoral::midi_event_size (buf[0]));
 
 		/* zero MSbit indicates that the data (up to 3 bytes) is inline */
-		_data[_size].bytes[0] = 0;
+		item.bytes[0] = 0;
 
 		switch (size) {
 		case 3:
-			_data[_size].bytes[3] = buf[2];
+			item.bytes[3] = buf[2];
 			/* fallthru */
 		case 2:
-			_data[_size].bytes[2] = buf[1];
+			item.bytes[2] = buf[1];
 			/* fallthru */
 		case 1:
-			_data[_size].bytes[1] = buf[0];
+			item.bytes[1] = buf[0];
 			break;
 		}
 	}
 
-	++_size;
-
-	return size;
+	return true;
 }
 
 /* These (non-matching) comparison arguments weren't supported prior to C99 !!!
@@ -324,7 +342,7 @@ RTMidiBuffer::read (MidiBuffer& dst, samplepos_t start, samplepos_t end, MidiSta
 
 			/* more than 3 bytes ... indirect */
 
-			uint32_t offset = item->offset & ~(1<<(CHAR_BIT-1));
+			uint32_t offset = blob_offset (*item);
 			Blob* blob = reinterpret_cast<Blob*> (&_pool[offset]);
 
 			size = blob->size;
@@ -390,17 +408,29 @@ RTMidiBuffer::alloc_blob (uint32_t size)
 	return offset;
 }
 
-uint32_t
-RTMidiBuffer::store_blob (uint32_t size, uint8_t const * data)
+bool
+RTMidiBuffer::store_blob (uint32_t size, uint8_t const * data, uint32_t& offset)
 {
-	uint32_t offset = alloc_blob (size);
+	if (_pool_size >= max_blob_offset) {
+		/* the next blob's offset would not fit; reclaim spliced-out blobs first */
+		if (_pool_unused == 0) {
+			return false;
+		}
+		compact_pool ();
+		if (_pool_size >= max_blob_offset) {
+			return false;
+		}
+	}
+
+	/* the blob's size is stored in front of its data */
+	offset = alloc_blob (sizeof (size) + size);
 	uint8_t* addr = &_pool[offset];
 
 	*(reinterpret_cast<uint32_t*> (addr)) = size;
 	addr += sizeof (size);
 	memcpy (addr, data, size);
 
-	return offset;
+	return true;
 }
 
 void
@@ -410,6 +440,102 @@ RTMidiBuffer::clear ()
 	_size = 0;
 	/* free the entire current pool size, if any */
 	_pool_size = 0;
+	_pool_unused = 0;
 	/* rendering new data .. it will not be reversed */
 	_reversed = false;
 }
+
+void
+RTMidiBuffer::splice (TimeType start, TimeType end, Evoral::EventList<TimeType> const& events)
+{
+	assert (!_reversed);
+
+	Item foo;
+
+	foo.timestamp = start;
+	size_t const first = lower_bound (_data, _data + _size, foo, item_item_earlier) - _data;
+	foo.timestamp = end;
+	size_t const last = upper_bound (_data, _data + _size, foo, item_item_earlier) - _data;
+
+	/* blobs of the items that are replaced remain in the pool until it is compacted */
+
+	for (size_t i = first; i < last; ++i) {
+		if (_data[i].bytes[0]) {
+			uint32_t offset = blob_offset (_data[i]);
+			_pool_unused += reinterpret_cast<Blob*> (&_pool[offset])->size;
+		}
+	}
+
+	size_t const n_events = events.size ();
+	size_t const new_size = _size - (last - first) + n_events;
+
+	if (new_size > _capacity) {
+		resize (new_size + 1024);
+	}
+
+	/* move the tail into place, then fill the gap */
+
+	if (last < _size) {
+		memmove (&_data[first + n_events], &_data[last], (_size - last) * sizeof (Item));
+	}
+
+	_size = new_size;
+
+	/* the gap holds stale items until it is filled. Mark them inline, so
+	 * that a compaction triggered by store() does not follow them.
+	 */
+
+	for (size_t i = first; i < first + n_events; ++i) {
+		_data[i].bytes[0] = 0;
+	}
+
+	Item* item = &_data[first];
+	size_t dropped = 0;
+
+	for (Evoral::EventList<TimeType>::const_iterator e = events.begin(); e != events.end(); ++e) {
+		assert ((*e)->time() >= start && (*e)->time() <= end);
+		item->timestamp = (*e)->time();
+		if (!store (*item, (*e)->size(), (*e)->buffer())) {
+			++dropped;
+			continue;
+		}
+		++item;
+	}
+
+	if (dropped) {
+		error << string_compose (_("MIDI playback buffer: no space left to store %1 events"), dropped) << endmsg;
+		size_t const tail = first + n_events;
+		memmove (item, &_data[tail], (_size - tail) * sizeof (Item));
+		_size -= dropped;
+	}
+
+	if (_pool_unused > _pool_size / 2) {
+		compact_pool ();
+	}
+}
+
+void
+RTMidiBuffer::compact_pool ()
+{
+	uint8_t* old_pool = _pool;
+
+	_pool = 0;
+	_pool_size = 0;
+	_pool_unused = 0;
+
+	if (old_pool) {
+		cache_aligned_malloc ((void **) &_pool, (_pool_capacity * sizeof (Blob)));
+	}
+
+	for (size_t i = 0; i < _size; ++i) {
+		if (_data[i].bytes[0]) {
+			uint32_t offset = blob_offset (_data[i]);
+			Blob* blob = reinterpret_cast<Blob*> (&old_pool[offset]);
+			/* compacting never moves a blob to a higher offset, so this cannot fail */
+			store_blob (blob->size, blob->data, offset);
+			set_blob_offset (_data[i], offset);
+		}
+	}
+
+	cache_aligned_free (old_pool);
+}
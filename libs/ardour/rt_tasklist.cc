@@ -33,6 +33,8 @@ RTTaskList::RTTaskList ()
 	: _threads_active (0)
 	, _task_run_sem ("rt_task_run", 0)
 	, _task_end_sem ("rt_task_done", 0)
+	, _tasklist (0)
+	, _next_task (0)
 {
 	reset_thread_list ();
 }
@@ -86,7 +88,7 @@ RTTaskList::reset_thread_list ()
 	for (uint32_t i = 0; i < num_threads; ++i) {
 		pthread_t thread_id;
 		int rv = 1;
-		if (AudioEngine::instance()->is_realtime ()) {
+		if (AudioEngine::instance() && AudioEngine::instance()->is_realtime ()) {
 			rv = pbd_realtime_pthread_create (PBD_SCHED_FIFO, AudioEngine::instance()->client_real_time_priority(), PBD_RT_STACKSIZE_HELP, &thread_id, _thread_run, this);
 		}
 		if (rv) {
@@ -104,76 +106,57 @@ RTTaskList::reset_thread_list ()
 void
 RTTaskList::run ()
 {
-	Glib::Threads::Mutex::Lock tm (_tasklist_mutex, Glib::Threads::NOT_LOCK);
-	bool wait = true;
-
 	while (true) {
-		if (wait) {
-			_task_run_sem.wait ();
-		}
+		_task_run_sem.wait ();
 
 		if (0 == g_atomic_int_get (&_threads_active)) {
 			_task_end_sem.signal ();
 			break;
 		}
 
-		wait = false;
-
-		boost::function<void ()> to_run;
-		tm.acquire ();
-		if (!_tasklist.empty ()) {
-			to_run = _tasklist.front();
-			_tasklist.pop_front ();
-		}
-		tm.release ();
-
-		if (!to_run.empty ()) {
-			to_run ();
-			continue;
-		}
-
-		if (!wait) {
-			_task_end_sem.signal ();
-		}
-
-		wait = true;
+		run_tasks ();
+		_task_end_sem.signal ();
 	}
 }
 
 void
-RTTaskList::process (TaskList const& tl)
+RTTaskList::run_tasks ()
 {
-	Glib::Threads::Mutex::Lock pm (_process_mutex);
-	Glib::Threads::Mutex::Lock tm (_tasklist_mutex, Glib::Threads::NOT_LOCK);
-
-	tm.acquire ();
-	_tasklist = tl;
-	tm.release ();
-
-	process_tasklist ();
-
-	tm.acquire ();
-	_tasklist.clear ();
-	tm.release ();
+	/* claim tasks one at a time, until all are taken */
+	const gint n_tasks = _tasklist->size ();
+	gint i;
+	while ((i = g_atomic_int_add (&_next_task, 1)) < n_tasks) {
+		(*_tasklist)[i]();
+	}
 }
 
 void
-RTTaskList::process_tasklist ()
+RTTaskList::process (TaskList const& tl)
 {
-//	if (0 == g_atomic_int_get (&_threads_active) || _threads.size () == 0) {
+	Glib::Threads::Mutex::Lock pm (_process_mutex);
 
-		for (TaskList::iterator i = _tasklist.begin (); i != _tasklist.end(); ++i) {
+	if (tl.size () < 2 || 0 == g_atomic_int_get (&_threads_active) || _threads.size () == 0) {
+		for (TaskList::const_iterator i = tl.begin (); i != tl.end(); ++i) {
 			(*i)();
 		}
 		return;
-//	}
+	}
+
+	_tasklist = &tl;
+	g_atomic_int_set (&_next_task, 0);
 
-	uint32_t nt = std::min (_threads.size (), _tasklist.size ());
+	/* the calling thread processes tasks as well */
+	uint32_t nt = std::min (_threads.size (), tl.size () - 1);
 
 	for (uint32_t i = 0; i < nt; ++i) {
 		_task_run_sem.signal ();
 	}
+
+	run_tasks ();
+
 	for (uint32_t i = 0; i < nt; ++i) {
 		_task_end_sem.wait ();
 	}
+
+	_tasklist = 0;
 }
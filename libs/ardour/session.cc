@@ -62,6 +62,7 @@
 #include "ardour/amp.h"
 #include "ardour/analyser.h"
 #include "ardour/async_midi_port.h"
+#include "ardour/audio_block_cache.h"
 #include "ardour/audio_buffer.h"
 #include "ardour/audio_port.h"
 #include "ardour/audio_track.h"
@@ -91,6 +92,7 @@
 #include "ardour/operations.h"
 #include "ardour/playlist.h"
 #include "ardour/playlist_factory.h"
+#include "ardour/playlist_render_cache.h"
 #include "ardour/plugin.h"
 #include "ardour/plugin_insert.h"
 #include "ardour/process_thread.h"
@@ -238,6 +240,8 @@ Session::Session (AudioEngine &eng,
 	, _last_roll_location (0)
 	, _last_roll_or_reversal_location (0)
 	, _last_record_location (0)
+	, _cue_positions_dirty (1)
+	, _cue_return_location (-1)
 	, pending_auto_loop (false)
 	, _mempool ("Session", 3145728)
 	, lua (lua_newstate (&PBD::ReallocPool::lalloc, &_mempool))
@@ -251,6 +255,7 @@ Session::Session (AudioEngine &eng,
 	, _rt_emit_pending (false)
 	, _ac_thread_active (0)
 	, _latency_recompute_pending (0)
+	, _latency_recompute_all (0)
 	, step_speed (0)
 	, outbound_mtc_timecode_frame (0)
 	, next_quarter_frame_to_send (-1)
@@ -317,6 +322,8 @@ Session::Session (AudioEngine &eng,
 	,  _speakers (new Speakers)
 	, _ignore_route_processor_changes (0)
 	, _ignored_a_processor_change (0)
+	, _ignore_graph_reorders (0)
+	, _ignored_a_graph_reorder (0)
 	, midi_clock (0)
 	, _scene_changer (0)
 	, _midi_ports (0)
@@ -334,8 +341,11 @@ Session::Session (AudioEngine &eng,
 	pthread_mutex_init (&_auto_connect_mutex, 0);
 	pthread_cond_init (&_auto_connect_cond, 0);
 
+	_latency_callback_scope[0] = _latency_callback_scope[1] = LatencyCallbackIdle;
+
 	init_name_id_counter (1); // reset for new sessions, start at 1
 	VCA::set_next_vca_number (1); // reset for new sessions, start at 1
+	AudioBlockCache::resume (); // read-ahead was stopped when the previous session was closed
 
 	pre_engine_init (fullpath); // sets _is_new
 
@@ -565,6 +575,7 @@ Session::destroy ()
 	remove_pending_capture_state ();
 
 	Analyser::flush ();
+	PlaylistRenderCache::flush ();
 
 	_state_of_the_state = StateOfTheState (CannotSave | Deletion);
 
@@ -640,6 +651,9 @@ Session::destroy ()
 	delete _butler;
 	_butler = 0;
 
+	/* no more reads, stop decoding ahead before sources are dropped */
+	AudioBlockCache::flush ();
+
 	delete _all_route_group;
 
 	DEBUG_TRACE (DEBUG::Destruction, "delete route groups\n");
@@ -1510,6 +1524,8 @@ Session::auto_punch_changed (Location* location)
 void
 Session::auto_loop_changed (Location* location)
 {
+	g_atomic_int_set (&_cue_positions_dirty, 1);
+
 	if (!location) {
 		return;
 	}
@@ -1633,6 +1649,7 @@ Session::set_auto_loop_location (Location* location)
 		auto_loop_location_changed (0);
 	}
 
+	g_atomic_int_set (&_cue_positions_dirty, 1);
 	set_dirty();
 
 	if (location == 0) {
@@ -1672,9 +1689,77 @@ Session::set_auto_loop_location (Location* location)
 void
 Session::update_marks (Location*)
 {
+	g_atomic_int_set (&_cue_positions_dirty, 1);
 	set_dirty ();
 }
 
+/** Called from the butler thread, tell DiskReaders which positions
+ * are likely locate targets.
+ */
+void
+Session::update_cue_positions ()
+{
+	if (Config->get_cue_buffer_seconds () <= 0) {
+		if (_cue_return_location != -1) {
+			_cue_return_location = -1;
+			DiskReader::set_cue_positions (std::vector<samplepos_t> ());
+		}
+		g_atomic_int_set (&_cue_positions_dirty, 1);
+		return;
+	}
+
+	/* _last_roll_location is set by the process thread */
+	const samplepos_t last_roll = _last_roll_location.load ();
+	if (!g_atomic_int_compare_and_exchange (&_cue_positions_dirty, 1, 0) && _cue_return_location == last_roll) {
+		return;
+	}
+
+	_cue_return_location = last_roll;
+	_locations->apply (*this, &Session::set_cue_positions);
+}
+
+struct CuePositionSorter {
+	CuePositionSorter (samplepos_t p) : pos (p) {}
+	bool operator() (samplepos_t a, samplepos_t b) const {
+		return ::llabs (a - pos) < ::llabs (b - pos);
+	}
+	samplepos_t pos;
+};
+
+void
+Session::set_cue_positions (const Locations::LocationList& locations)
+{
+	/* at most this many markers, closest to the playhead */
+	const size_t max_markers = 16;
+
+	std::vector<samplepos_t> marks;
+	for (Locations::LocationList::const_iterator i = locations.begin(); i != locations.end(); ++i) {
+		if ((*i)->is_mark () && !(*i)->is_hidden () && !(*i)->is_xrun ()) {
+			marks.push_back ((*i)->start ());
+		}
+	}
+
+	if (marks.size () > max_markers) {
+		CuePositionSorter cmp (_transport_sample);
+		std::nth_element (marks.begin (), marks.begin () + max_markers, marks.end (), cmp);
+		marks.resize (max_markers);
+	}
+
+	std::vector<samplepos_t> pos;
+	pos.push_back (_cue_return_location);
+
+	Location* loop = _locations->auto_loop_location ();
+	if (loop) {
+		pos.push_back (loop->start ());
+	}
+
+	pos.insert (pos.end (), marks.begin (), marks.end ());
+	std::sort (pos.begin (), pos.end ());
+	pos.erase (std::unique (pos.begin (), pos.end ()), pos.end ());
+
+	DiskReader::set_cue_positions (pos);
+}
+
 void
 Session::update_skips (Location* loc, bool consolidate)
 {
@@ -1812,6 +1897,7 @@ Session::location_added (Location *location)
 		update_skips (location, true);
 	}
 
+	g_atomic_int_set (&_cue_positions_dirty, 1);
 	set_dirty ();
 }
 
@@ -1840,6 +1926,7 @@ Session::location_removed (Location *location)
 		update_skips (location, false);
 	}
 
+	g_atomic_int_set (&_cue_positions_dirty, 1);
 	set_dirty ();
 }
 
@@ -2213,28 +2300,20 @@ Session::resort_routes ()
 void
 Session::resort_routes_using (boost::shared_ptr<RouteList> r)
 {
+	const int64_t start = g_get_monotonic_time ();
+
 	/* We are going to build a directed graph of our routes;
 	   this is where the edges of that graph are put.
 	*/
 
 	GraphEdges edges;
 
-	/* Go through all routes doing two things:
-	 *
-	 * 1. Collect the edges of the route graph.  Each of these edges
-	 *    is a pair of routes, one of which directly feeds the other
-	 *    either by a JACK connection or by an internal send.
-	 *
-	 * 2. Begin the process of making routes aware of which other
-	 *    routes directly or indirectly feed them.  This information
-	 *    is used by the solo code.
+	/* Collect the edges of the route graph.  Each of these edges
+	 * is a pair of routes, one of which directly feeds the other
+	 * either by a JACK connection or by an internal send.
 	 */
 
 	for (RouteList::iterator i = r->begin(); i != r->end(); ++i) {
-
-		/* Clear out the route's list of direct or indirect feeds */
-		(*i)->clear_fed_by ();
-
 		for (RouteList::iterator j = r->begin(); j != r->end(); ++j) {
 
 			bool via_sends_only = false;
@@ -2243,16 +2322,63 @@ Session::resort_routes_using (boost::shared_ptr<RouteList> r)
 			   connections and internal sends.
 			*/
 			if ((*j)->direct_feeds_according_to_reality (*i, &via_sends_only)) {
-				/* add the edge to the graph (part #1) */
 				edges.add (*j, *i, via_sends_only);
-				/* tell the route (for part #2) */
+			}
+		}
+	}
+
+	/* Unless routes were added or removed, r is in the order of the
+	 * last successful sort.
+	 */
+	bool same_routes = r->size () == _current_route_order.size ();
+	if (same_routes) {
+		std::vector<boost::weak_ptr<Route> >::const_iterator o = _current_route_order.begin ();
+		for (RouteList::const_iterator i = r->begin(); i != r->end(); ++i, ++o) {
+			if (o->lock () != *i) {
+				same_routes = false;
+				break;
+			}
+		}
+	}
+
+	if (same_routes && edges == _current_route_graph) {
+		/* nothing changed, the graph and the routes' fed-by lists are valid */
+		DEBUG_TRACE (DEBUG::Graph, string_compose ("Route graph unchanged, %1 routes, check took %2 us\n", r->size (), g_get_monotonic_time () - start));
+		return;
+	}
+
+	/* Begin the process of making routes aware of which other
+	 * routes directly or indirectly feed them.  This information
+	 * is used by the solo code.
+	 */
+	for (RouteList::iterator i = r->begin(); i != r->end(); ++i) {
+
+		/* Clear out the route's list of direct or indirect feeds */
+		(*i)->clear_fed_by ();
+
+		for (RouteList::iterator j = r->begin(); j != r->end(); ++j) {
+			bool via_sends_only = false;
+			if (edges.has (*j, *i, &via_sends_only)) {
 				(*i)->add_fed_by (*j, via_sends_only);
 			}
 		}
 	}
 
-	/* Attempt a topological sort of the route graph */
-	boost::shared_ptr<RouteList> sorted_routes = topological_sort (r, edges);
+	/* Attempt a topological sort of the route graph. If only connections
+	 * changed, the current order is retained as far as possible, and only
+	 * routes between the ends of a new connection are moved.
+	 */
+	boost::shared_ptr<RouteList> sorted_routes;
+
+	if (same_routes) {
+		sorted_routes = incremental_topological_sort (r, edges);
+	}
+
+	const bool incremental = (bool) sorted_routes;
+
+	if (!sorted_routes) {
+		sorted_routes = topological_sort (r, edges);
+	}
 
 	if (sorted_routes) {
 		/* We got a satisfactory topological sort, so there is no feedback;
@@ -2276,12 +2402,15 @@ Session::resort_routes_using (boost::shared_ptr<RouteList> r)
 
 		*r = *sorted_routes;
 
+		_current_route_order.assign (r->begin (), r->end ());
+
 #ifndef NDEBUG
 		DEBUG_TRACE (DEBUG::Graph, "Routes resorted, order follows:\n");
 		for (RouteList::iterator i = r->begin(); i != r->end(); ++i) {
 			DEBUG_TRACE (DEBUG::Graph, string_compose ("\t%1 presentation order %2\n", (*i)->name(), (*i)->presentation_info().order()));
 		}
 #endif
+		DEBUG_TRACE (DEBUG::Graph, string_compose ("%1 resort of %2 routes took %3 us\n", incremental ? "Incremental" : "Full", r->size (), g_get_monotonic_time () - start));
 
 		SuccessfulGraphSort (); /* EMIT SIGNAL */
 
@@ -2295,6 +2424,8 @@ Session::resort_routes_using (boost::shared_ptr<RouteList> r)
 		   as it was before.
 		*/
 
+		_current_route_order.clear ();
+
 		FeedbackDetected (); /* EMIT SIGNAL */
 	}
 
@@ -3166,7 +3297,7 @@ Session::add_routes_inner (RouteList& new_routes, bool input_auto_connect, bool
 			r->mute_control()->Changed.connect_same_thread (*this, boost::bind (&Session::route_mute_changed, this));
 
 			r->processors_changed.connect_same_thread (*this, boost::bind (&Session::route_processors_changed, this, _1));
-			r->processor_latency_changed.connect_same_thread (*this, boost::bind (&Session::queue_latency_recompute, this));
+			r->processor_latency_changed.connect_same_thread (*this, boost::bind (&Session::route_latency_changed, this, wpr));
 
 			if (r->is_master()) {
 				_master_out = r;
@@ -3345,6 +3476,9 @@ Session::globally_add_internal_sends (boost::shared_ptr<Route> dest, Placement p
 void
 Session::add_internal_sends (boost::shared_ptr<Route> dest, Placement p, boost::shared_ptr<RouteList> senders)
 {
+	ProcessorChangeBlocker pcb (this);
+	GraphReorderBlocker grb (this);
+
 	for (RouteList::iterator i = senders->begin(); i != senders->end(); ++i) {
 		add_internal_send (dest, (*i)->before_processor_for_placement (p), *i);
 	}
@@ -5324,6 +5458,21 @@ Session::graph_reordered (bool called_from_backend)
 		return;
 	}
 
+	if (g_atomic_int_get (&_ignore_graph_reorders) > 0) {
+		/* handled once the last GraphReorderBlocker goes out of scope */
+		g_atomic_int_set (&_ignored_a_graph_reorder, 1);
+		if (g_atomic_int_get (&_ignore_graph_reorders) > 0) {
+			return;
+		}
+		/* the last blocker was released meanwhile, and may or may not
+		 * have seen the flag. Whoever resets it does the reorder, with
+		 * its own called_from_backend.
+		 */
+		if (!g_atomic_int_compare_and_exchange (&_ignored_a_graph_reorder, 1, 0)) {
+			return;
+		}
+	}
+
 	resort_routes ();
 
 	/* force all diskstreams to update their capture offset values to
@@ -6082,6 +6231,97 @@ Session::plot_process_graph (std::string const& file_name) const {
 	return _process_graph ? _process_graph->plot (file_name) : false;
 }
 
+PBD::TimingHistogram*
+Session::process_graph_dsp_histogram () const
+{
+	return _process_graph ? &_process_graph->dsp_histogram () : 0;
+}
+
+PBD::TimingHistogram*
+Session::process_graph_wait_histogram () const
+{
+	return _process_graph ? &_process_graph->wait_histogram () : 0;
+}
+
+static void
+dsp_profile_line (std::ostream& os, std::string const& indent, std::string const& kind, std::string const& name, PBD::TimingHistogram const& h, uint64_t budget)
+{
+	os << indent << kind << " \"" << name << "\""
+	   << " count=" << h.count ()
+	   << " avg=" << (uint64_t) h.avg ()
+	   << " p50=" << h.percentile (.5)
+	   << " p99=" << h.percentile (.99)
+	   << " max=" << h.max ()
+	   << " over_budget=" << h.count_above (budget)
+	   << "\n";
+
+	/* non-empty bins: [lower, upper) usec: count */
+	os << indent << "  bins";
+	for (int i = 0; i < PBD::TimingHistogram::n_bins; ++i) {
+		if (h.bin (i) > 0) {
+			os << " " << PBD::TimingHistogram::bin_lower (i) << "-" << PBD::TimingHistogram::bin_upper (i) << ":" << h.bin (i);
+		}
+	}
+	os << "\n";
+}
+
+bool
+Session::write_dsp_profile (std::string const& file_name) const
+{
+	const pframes_t bs     = get_block_size ();
+	const uint64_t  budget = (uint64_t) bs * 1000000 / std::max<samplecnt_t> (1, sample_rate ());
+
+	std::stringstream ss;
+	ss << "# " << PROGRAM_NAME << " DSP profile, all times in usec\n";
+	ss << "# cycle: " << bs << " samples @ " << sample_rate () << " Hz, budget: " << budget << " usec\n";
+
+	if (_process_graph) {
+		dsp_profile_line (ss, "", "graph", name (), _process_graph->dsp_histogram (), budget);
+		dsp_profile_line (ss, "", "graph-wait", name (), _process_graph->wait_histogram (), budget);
+	}
+
+	dsp_profile_line (ss, "", "latency", "compensation", _latency_compensation_histogram, budget);
+	dsp_profile_line (ss, "", "latency", "engine-callback", _latency_callback_histogram, budget);
+
+	boost::shared_ptr<RouteList> rl = routes.reader ();
+	for (RouteList::const_iterator i = rl->begin (); i != rl->end (); ++i) {
+		dsp_profile_line (ss, "", "route", (*i)->name (), (*i)->dsp_histogram (), budget);
+		boost::shared_ptr<Processor> p;
+		for (uint32_t n = 0; (p = (*i)->nth_processor (n)); ++n) {
+			dsp_profile_line (ss, "  ", "processor", p->display_name (), p->dsp_histogram (), budget);
+		}
+	}
+
+	GError *err = NULL;
+	if (!g_file_set_contents (file_name.c_str(), ss.str().c_str(), -1, &err)) {
+		if (err) {
+			error << string_compose (_("Could not write DSP profile to file (%1)"), err->message) << endmsg;
+			g_error_free (err);
+		}
+		return false;
+	}
+	return true;
+}
+
+void
+Session::reset_dsp_profile ()
+{
+	if (_process_graph) {
+		_process_graph->dsp_histogram ().request_reset ();
+		_process_graph->wait_histogram ().request_reset ();
+	}
+	_latency_compensation_histogram.request_reset ();
+	_latency_callback_histogram.request_reset ();
+	boost::shared_ptr<RouteList> rl = routes.reader ();
+	for (RouteList::const_iterator i = rl->begin (); i != rl->end (); ++i) {
+		(*i)->dsp_histogram ().request_reset ();
+		boost::shared_ptr<Processor> p;
+		for (uint32_t n = 0; (p = (*i)->nth_processor (n)); ++n) {
+			p->dsp_histogram ().request_reset ();
+		}
+	}
+}
+
 void
 Session::add_automation_list(AutomationList *al)
 {
@@ -6543,56 +6783,129 @@ Session::send_latency_compensation_change ()
 }
 
 bool
-Session::update_route_latency (bool playback, bool apply_to_delayline, bool* delayline_update_needed)
+Session::update_route_latency (bool playback, bool apply_to_delayline, bool* delayline_update_needed, RouteList const* subset, std::set<GraphVertex>* changed_routes)
 {
 	/* apply_to_delayline can no be called concurrently with processing
 	 * caller must hold process lock when apply_to_delayline == true */
 	assert (!apply_to_delayline || !AudioEngine::instance()->process_lock().trylock());
 
-	DEBUG_TRACE (DEBUG::LatencyCompensation , string_compose ("update_route_latency: %1 apply_to_delayline? %2)\n", (playback ? "PLAYBACK" : "CAPTURE"), (apply_to_delayline ? "yes" : "no")));
+	DEBUG_TRACE (DEBUG::LatencyCompensation , string_compose ("update_route_latency: %1 apply_to_delayline? %2 subset? %3)\n", (playback ? "PLAYBACK" : "CAPTURE"), (apply_to_delayline ? "yes" : "no"), (subset ? "yes" : "no")));
+
+#ifndef NDEBUG
+	int64_t t_start = g_get_monotonic_time ();
+#endif
 
 	/* Note: RouteList is process-graph sorted */
 	boost::shared_ptr<RouteList> r = routes.reader ();
 
-	if (playback) {
-		/* reverse the list so that we work backwards from the last route to run to the first,
-		 * this is not needed, but can help to reduce the iterations for aux-sends.
-		 */
-		RouteList* rl = routes.reader().get();
-		r.reset (new RouteList (*rl));
-		reverse (r->begin(), r->end());
-	}
+	RouteList walk (subset ? *subset : *r);
 
 	bool changed = false;
 	int bailout = 0;
-restart:
-	_send_latency_changes = 0;
-	_worst_route_latency = 0;
+	size_t n_walked = 0;
 
-	for (RouteList::iterator i = r->begin(); i != r->end(); ++i) {
-		// if (!(*i)->active()) { continue ; } // TODO
-		samplecnt_t l;
-		if ((*i)->signal_latency () != (l = (*i)->update_signal_latency (apply_to_delayline, delayline_update_needed))) {
-			changed = true;
+	while (!walk.empty ()) {
+
+		if (playback) {
+			/* reverse the list so that we work backwards from the last route to run to the first,
+			 * this is not needed, but can help to reduce the iterations for aux-sends.
+			 */
+			walk.reverse ();
 		}
-		_worst_route_latency = std::max (l, _worst_route_latency);
-	}
 
-	if (_send_latency_changes > 0) {
-		/* One extra iteration might be needed since we allow u level of aux-sends.
+		_send_latency_changes = 0;
+
+		for (RouteList::iterator i = walk.begin(); i != walk.end(); ++i) {
+			// if (!(*i)->active()) { continue ; } // TODO
+			if ((*i)->signal_latency () != (*i)->update_signal_latency (apply_to_delayline, delayline_update_needed)) {
+				changed = true;
+				if (changed_routes) {
+					changed_routes->insert (*i);
+				}
+			}
+		}
+
+		n_walked += walk.size ();
+		walk.clear ();
+
+		/* The latency of sends depends on the bus they feed
+		 * (InternalReturn::set_playback_offset), which queues the
+		 * sending route for another update. Only those routes and
+		 * the routes they feed are walked again.
+		 *
+		 * One extra iteration might be needed since we allow u level of aux-sends.
 		 * Except mixbus that allows up to 3 (aux-sends, sends to mixbusses 1-8, sends to mixbusses 9-12,
 		 * and then there's JACK */
-		if (++bailout < 5) {
-			cerr << "restarting Session::update_latency. # of send changes: " << _send_latency_changes << " iteration: " << bailout << endl;
-			goto restart;
+		routes_affected_by_latency_change (*r, walk);
+
+		if (walk.empty () || ++bailout >= 5) {
+			break;
 		}
+
+		DEBUG_TRACE (DEBUG::LatencyCompensation, string_compose ("update_route_latency: %1 send change(s), iteration %2 re-walks %3 route(s)\n", _send_latency_changes, bailout, walk.size ()));
 	}
 
-	DEBUG_TRACE (DEBUG::LatencyCompensation , string_compose ("update_route_latency: worst proc latency: %1 (changed? %2) recursions: %3\n", _worst_route_latency, (changed ? "yes" : "no"), bailout));
+	/* routes that were not walked retain their latency */
+	_worst_route_latency = 0;
+	for (RouteList::const_iterator i = r->begin(); i != r->end(); ++i) {
+		_worst_route_latency = std::max ((*i)->signal_latency (), _worst_route_latency);
+	}
+
+	DEBUG_TRACE (DEBUG::LatencyCompensation , string_compose ("update_route_latency: worst proc latency: %1 (changed? %2) recursions: %3 walked %4 routes (%5 in session) in %6 us\n",
+				_worst_route_latency, (changed ? "yes" : "no"), bailout, n_walked, r->size (), g_get_monotonic_time () - t_start));
 
 	return changed;
 }
 
+/** Collect routes that have been queued for a latency update
+ * (Route::queue_latency_recompute), along with all routes that
+ * they feed, directly or indirectly. The result is in process order.
+ */
+void
+Session::routes_affected_by_latency_change (RouteList const& rl, RouteList& affected) const
+{
+	std::set<GraphVertex> queued;
+
+	for (RouteList::const_iterator i = rl.begin(); i != rl.end(); ++i) {
+		if ((*i)->latency_recompute_queued ()) {
+			queued.insert (*i);
+		}
+	}
+
+	routes_connected_to (rl, queued, false, affected);
+}
+
+/** Collect the given routes along with all routes that they feed
+ * (or that feed them, if \p upstream is true), directly or indirectly.
+ * The result is in process order.
+ */
+void
+Session::routes_connected_to (RouteList const& rl, std::set<GraphVertex> const& seeds, bool upstream, RouteList& result) const
+{
+	if (seeds.empty ()) {
+		return;
+	}
+
+	std::set<GraphVertex> to_walk (seeds);
+	std::list<GraphVertex> queue (seeds.begin (), seeds.end ());
+
+	while (!queue.empty ()) {
+		std::set<GraphVertex> next = upstream ? _current_route_graph.to (queue.front ()) : _current_route_graph.from (queue.front ());
+		queue.pop_front ();
+		for (std::set<GraphVertex>::const_iterator i = next.begin(); i != next.end(); ++i) {
+			if (to_walk.insert (*i).second) {
+				queue.push_back (*i);
+			}
+		}
+	}
+
+	for (RouteList::const_iterator i = rl.begin(); i != rl.end(); ++i) {
+		if (to_walk.find (*i) != to_walk.end ()) {
+			result.push_back (*i);
+		}
+	}
+}
+
 void
 Session::update_latency (bool playback)
 {
@@ -6652,18 +6965,44 @@ Session::update_latency (bool playback)
 		return;
 	}
 
+	const int64_t t_start = g_get_monotonic_time ();
+
 	/* Note; RouteList is sorted as process-graph */
 	boost::shared_ptr<RouteList> r = routes.reader ();
 
-	if (playback) {
-		/* reverse the list so that we work backwards from the last route to run to the first */
-		RouteList* rl = routes.reader().get();
-		r.reset (new RouteList (*rl));
-		reverse (r->begin(), r->end());
+	/* If this callback follows an incremental update_latency_compensation (),
+	 * only routes connected to those whose latency changed need to be visited:
+	 * upstream for playback latency, downstream for capture latency.
+	 */
+	RouteList subset;
+	bool incremental = false;
+	{
+		Glib::Threads::Mutex::Lock lx (_update_latency_lock);
+		incremental = _latency_callback_scope[playback] == LatencyCallbackChanged;
+		if (incremental) {
+			routes_connected_to (*r, _latency_changed_routes, playback, subset);
+		}
+		_latency_callback_scope[playback] = LatencyCallbackIdle;
+		if (_latency_callback_scope[!playback] != LatencyCallbackChanged) {
+			_latency_changed_routes.clear ();
+		}
 	}
-	for (RouteList::iterator i = r->begin(); i != r->end(); ++i) {
-		samplecnt_t latency = (*i)->set_private_port_latencies (playback);
-		(*i)->set_public_port_latencies (latency, playback);
+
+	RouteList const& rl (incremental ? subset : *r);
+
+	DEBUG_TRACE (DEBUG::LatencyCompensation, string_compose ("Engine latency callback: update %1 of %2 route(s)\n", rl.size (), r->size ()));
+
+	if (playback) {
+		/* work backwards from the last route to run to the first */
+		for (RouteList::const_reverse_iterator i = rl.rbegin(); i != rl.rend(); ++i) {
+			samplecnt_t latency = (*i)->set_private_port_latencies (playback);
+			(*i)->set_public_port_latencies (latency, playback);
+		}
+	} else {
+		for (RouteList::const_iterator i = rl.begin(); i != rl.end(); ++i) {
+			samplecnt_t latency = (*i)->set_private_port_latencies (playback);
+			(*i)->set_public_port_latencies (latency, playback);
+		}
 	}
 
 	if (playback) {
@@ -6678,7 +7017,7 @@ Session::update_latency (bool playback)
 		/* prevent any concurrent latency updates */
 		Glib::Threads::Mutex::Lock lx (_update_latency_lock);
 		set_worst_output_latency ();
-		update_route_latency (true, /*apply_to_delayline*/ true, NULL);
+		update_route_latency (true, /*apply_to_delayline*/ true, NULL, incremental ? &subset : 0);
 
 		/* relese before emiting signals */
 		lm.release ();
@@ -6688,10 +7027,12 @@ Session::update_latency (bool playback)
 		lm.release ();
 		Glib::Threads::Mutex::Lock lx (_update_latency_lock);
 		set_worst_input_latency ();
-		update_route_latency (false, false, NULL);
+		update_route_latency (false, false, NULL, incremental ? &subset : 0);
 	}
 
-	DEBUG_TRACE (DEBUG::LatencyCompensation, "Engine latency callback: DONE\n");
+	_latency_callback_histogram.record (g_get_monotonic_time () - t_start);
+
+	DEBUG_TRACE (DEBUG::LatencyCompensation, string_compose ("Engine latency callback: DONE in %1 us\n", g_get_monotonic_time () - t_start));
 	LatencyUpdated (playback); /* EMIT SIGNAL */
 }
 
@@ -6742,7 +7083,7 @@ Session::set_worst_input_latency ()
 }
 
 void
-Session::update_latency_compensation (bool force_whole_graph, bool called_from_backend)
+Session::update_latency_compensation (bool force_whole_graph, bool called_from_backend, bool incremental)
 {
 	/* Called to update Ardour's internal latency values and compensation
 	 * planning. Typically case is from within ::graph_reordered()
@@ -6764,13 +7105,42 @@ Session::update_latency_compensation (bool force_whole_graph, bool called_from_b
 		return;
 	}
 
-	DEBUG_TRACE (DEBUG::LatencyCompensation, string_compose ("update_latency_compensation%1.\n", (force_whole_graph ? " of whole graph" : "")));
+	DEBUG_TRACE (DEBUG::LatencyCompensation, string_compose ("update_latency_compensation%1%2.\n", (force_whole_graph ? " of whole graph" : ""), (incremental ? " (incremental)" : "")));
 
+	const int64_t t_start = g_get_monotonic_time ();
+
+	incremental = incremental && !force_whole_graph;
+
+	RouteList subset;
+	if (incremental) {
+		routes_affected_by_latency_change (*routes.reader (), subset);
+	}
+
+	std::set<GraphVertex> changed_routes;
 	bool delayline_update_needed = false;
-	bool some_track_latency_changed = update_route_latency (false, false, &delayline_update_needed);
+	bool some_track_latency_changed = update_route_latency (false, false, &delayline_update_needed, incremental ? &subset : 0, &changed_routes);
+
+	/* the engine callback is timed separately, see update_latency () */
+	_latency_compensation_histogram.record (g_get_monotonic_time () - t_start);
 
 	if (some_track_latency_changed || force_whole_graph)  {
 
+		if (!called_from_backend) {
+			/* let the engine latency callback know which routes changed */
+			for (int playback = 0; playback < 2; ++playback) {
+				if (!incremental) {
+					_latency_callback_scope[playback] = LatencyCallbackAll;
+				} else if (_latency_callback_scope[playback] != LatencyCallbackAll) {
+					_latency_callback_scope[playback] = LatencyCallbackChanged;
+				}
+			}
+			if (incremental) {
+				_latency_changed_routes.insert (changed_routes.begin (), changed_routes.end ());
+			} else {
+				_latency_changed_routes.clear ();
+			}
+		}
+
 		/* cannot hold lock while engine initiates a full latency callback */
 
 		lx.release ();
@@ -6813,7 +7183,7 @@ Session::update_latency_compensation (bool force_whole_graph, bool called_from_b
 			(*i)->apply_latency_compensation ();
 		}
 	}
-	DEBUG_TRACE (DEBUG::LatencyCompensation, "update_latency_compensation: complete\n");
+	DEBUG_TRACE (DEBUG::LatencyCompensation, string_compose ("update_latency_compensation: complete in %1 us\n", g_get_monotonic_time () - t_start));
 }
 
 const std::string
@@ -6926,6 +7296,20 @@ Session::auto_connect_thread_wakeup ()
 void
 Session::queue_latency_recompute ()
 {
+	g_atomic_int_set (&_latency_recompute_all, 1);
+	g_atomic_int_inc (&_latency_recompute_pending);
+	auto_connect_thread_wakeup ();
+}
+
+void
+Session::route_latency_changed (boost::weak_ptr<Route> wr)
+{
+	/* may be called from the realtime thread (PluginInsert::latency_changed) */
+	boost::shared_ptr<Route> r (wr.lock ());
+	if (!r) {
+		return;
+	}
+	r->queue_latency_recompute ();
 	g_atomic_int_inc (&_latency_recompute_pending);
 	auto_connect_thread_wakeup ();
 }
@@ -7100,6 +7484,8 @@ Session::auto_connect_thread_run ()
 			 *   graph_order_callback() -> resort_routes() -> direct_feeds_according_to_reality () -> backend::connected_to()
 			 * Ardour::IO uses the process-lock to avoid concurrency, too
 			 */
+			/* resort once, after releasing the process-lock */
+			GraphReorderBlocker grb (this);
 			Glib::Threads::Mutex::Lock lm (AudioEngine::instance()->process_lock ());
 
 			while (!_auto_connect_queue.empty ()) {
@@ -7121,7 +7507,9 @@ Session::auto_connect_thread_run ()
 			 * modifies the capture-offset, which can be a problem.
 			 */
 			while (g_atomic_int_and (&_latency_recompute_pending, 0)) {
-				update_latency_compensation (false, false);
+				/* only walk the routes that changed, unless the whole graph was queued */
+				const bool incremental = !g_atomic_int_and (&_latency_recompute_all, 0);
+				update_latency_compensation (false, false, incremental);
 				if (g_atomic_int_get (&_latency_recompute_pending)) {
 					Glib::usleep (1000);
 				}
@@ -105,7 +105,7 @@ Session::process (pframes_t nframes)
 	bool one_or_more_routes_declicking = false;
 	{
 		ProcessorChangeBlocker pcb (this);
-		boost::shared_ptr<RouteList> r = routes.reader ();
+		RouteList* r = routes.rt_reader ();
 		for (RouteList::const_iterator i = r->begin(); i != r->end(); ++i) {
 			if ((*i)->apply_processor_changes_rt()) {
 				_rt_emit_pending = true;
@@ -168,7 +168,7 @@ Session::no_roll (pframes_t nframes)
 
 	samplepos_t end_sample = _transport_sample + floor (nframes * _transport_speed);
 	int ret = 0;
-	boost::shared_ptr<RouteList> r = routes.reader ();
+	RouteList* r = routes.rt_reader ();
 
 	if (_click_io) {
 		_click_io->silence (nframes);
@@ -211,7 +211,7 @@ Session::no_roll (pframes_t nframes)
 int
 Session::process_routes (pframes_t nframes, bool& need_butler)
 {
-	boost::shared_ptr<RouteList> r = routes.reader ();
+	RouteList* r = routes.rt_reader ();
 
 	const samplepos_t start_sample = _transport_sample;
 	const samplepos_t end_sample = _transport_sample + floor (nframes * _transport_speed);
@@ -303,7 +303,7 @@ Session::compute_audible_delta (samplepos_t& pos_and_delta) const
 samplecnt_t
 Session::calc_preroll_subcycle (samplecnt_t ns) const
 {
-	boost::shared_ptr<RouteList> r = routes.reader ();
+	RouteList* r = routes.rt_reader ();
 	for (RouteList::const_iterator i = r->begin(); i != r->end(); ++i) {
 		samplecnt_t route_offset = (*i)->playback_latency ();
 		if (_remaining_latency_preroll > route_offset + ns) {
@@ -701,7 +701,7 @@ void
 Session::process_audition (pframes_t nframes)
 {
 	SessionEvent* ev;
-	boost::shared_ptr<RouteList> r = routes.reader ();
+	RouteList* r = routes.rt_reader ();
 
 	for (RouteList::iterator i = r->begin(); i != r->end(); ++i) {
 		if (!(*i)->is_auditioner()) {
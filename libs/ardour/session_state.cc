@@ -3950,7 +3950,7 @@ Session::restore_history (string snapshot_name)
 				boost::shared_ptr<MidiSource> midi_source =
 					boost::dynamic_pointer_cast<MidiSource, Source>(source_by_id(id));
 				if (midi_source) {
-					ut->add_command (new MidiModel::NoteDiffCommand(midi_source->model(), *n));
+					ut->add_command (new MidiModel::NoteDiffCommand(midi_source->ensure_model(), *n));
 				} else {
 					error << _("Failed to downcast MidiSource for NoteDiffCommand") << endmsg;
 				}
@@ -3961,7 +3961,7 @@ Session::restore_history (string snapshot_name)
 				boost::shared_ptr<MidiSource> midi_source =
 					boost::dynamic_pointer_cast<MidiSource, Source>(source_by_id(id));
 				if (midi_source) {
-					ut->add_command (new MidiModel::SysExDiffCommand (midi_source->model(), *n));
+					ut->add_command (new MidiModel::SysExDiffCommand (midi_source->ensure_model(), *n));
 				} else {
 					error << _("Failed to downcast MidiSource for SysExDiffCommand") << endmsg;
 				}
@@ -3972,7 +3972,7 @@ Session::restore_history (string snapshot_name)
 				boost::shared_ptr<MidiSource> midi_source =
 					boost::dynamic_pointer_cast<MidiSource, Source>(source_by_id(id));
 				if (midi_source) {
-					ut->add_command (new MidiModel::PatchChangeDiffCommand (midi_source->model(), *n));
+					ut->add_command (new MidiModel::PatchChangeDiffCommand (midi_source->ensure_model(), *n));
 				} else {
 					error << _("Failed to downcast MidiSource for PatchChangeDiffCommand") << endmsg;
 				}
@@ -351,7 +351,8 @@ Session::locate (samplepos_t target_sample, bool with_roll, bool with_flush, boo
 		send_mmc_locate (_transport_sample);
 	}
 
-	_last_roll_location = _last_roll_or_reversal_location =  _transport_sample;
+	_last_roll_or_reversal_location = _transport_sample;
+	_last_roll_location.store (_transport_sample);
 
 	Located (); /* EMIT SIGNAL */
 }
@@ -362,7 +363,8 @@ Session::post_locate ()
 	if (transport_master_is_external() && !synced_to_engine()) {
 		const samplepos_t current_master_position = TransportMasterManager::instance().get_current_position_in_process_context();
 		if (abs (current_master_position - _transport_sample) > TransportMasterManager::instance().current()->resolution()) {
-			_last_roll_location = _last_roll_or_reversal_location =  _transport_sample;
+			_last_roll_or_reversal_location = _transport_sample;
+			_last_roll_location.store (_transport_sample);
 		}
 	}
 }
@@ -560,7 +562,7 @@ Session::start_transport ()
 	ENSURE_PROCESS_THREAD;
 	DEBUG_TRACE (DEBUG::Transport, "start_transport\n");
 
-	_last_roll_location = _transport_sample;
+	_last_roll_location.store (_transport_sample);
 	_last_roll_or_reversal_location = _transport_sample;
 	if (!have_looped && !_exporting) {
 		_remaining_latency_preroll = worst_latency_preroll_buffer_size_ceil ();
@@ -1320,6 +1322,9 @@ Session::non_realtime_locate ()
 
 	_scene_changer->locate (_transport_sample);
 
+	/* markers close to the playhead changed */
+	g_atomic_int_set (&_cue_positions_dirty, 1);
+
 	/* XXX: it would be nice to generate the new clicks here (in the non-RT thread)
 	   rather than clearing them so that the RT thread has to spend time constructing
 	   them (in Session::click).
@@ -1334,7 +1339,7 @@ Session::select_playhead_priority_target (samplepos_t& jump_to)
 		return false;
 	}
 
-	jump_to = _last_roll_location;
+	jump_to = _last_roll_location.load ();
 	return jump_to >= 0;
 }
 
@@ -1464,7 +1469,7 @@ Session::non_realtime_stop (bool abort, int on_entry, bool& finished)
 				 * auto-return enabled
 				 */
 
-				_transport_sample = _last_roll_location;
+				_transport_sample = _last_roll_location.load ();
 				do_locate = true;
 
 			}
@@ -42,6 +42,7 @@
 
 #include "evoral/Control.h"
 #include "evoral/SMF.h"
+#include "evoral/SMFMap.h"
 
 #include "ardour/debug.h"
 #include "ardour/midi_channel_filter.h"
@@ -215,6 +216,35 @@ SMFSource::close ()
 	/* nothing to do: file descriptor is never kept open */
 }
 
+/** Map the file for read_unlocked(), unless that has been done already.
+ * Must be called with the source lock held.
+ * @return false if the file cannot be mapped
+ */
+bool
+SMFSource::map_file () const
+{
+	if (_map) {
+		return true;
+	}
+
+	_map.reset (new Evoral::SMFMap);
+
+	if (_map->open (_path) || _map->num_tracks () < 1) {
+		_map.reset ();
+		return false;
+	}
+
+	DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF %1 mapped for playback\n", name()));
+	return true;
+}
+
+void
+SMFSource::unmap_file () const
+{
+	_map_reader.reset ();
+	_map.reset ();
+}
+
 extern PBD::Timing minsert;
 
 /** All stamps in audio samples */
@@ -238,10 +268,23 @@ SMFSource::read_unlocked (const Lock&                    lock,
 
 	DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF read_unlocked: start %1 duration %2\n", start, duration));
 
+	/* Unless libsmf holds the data (while writing, or after the file was
+	 * parsed to load the model), stream the events from the mapped file.
+	 */
+	const bool mapped = !Evoral::SMF::loaded () && map_file ();
+
+	if (!mapped && _map) {
+		unmap_file ();
+		_smf_last_read_end = 0;
+	}
+
 	// Output parameters for read_event (which will allocate scratch in buffer as needed)
 	uint32_t ev_delta_t = 0;
 	uint32_t ev_size    = 0;
 	uint8_t* ev_buffer  = 0;
+	/* event data, in ev_buffer or in the mapped file */
+	uint8_t const* ev_data = 0;
+	std::vector<uint8_t> ev_copy;
 
 	size_t scratch_size = 0; // keep track of scratch to minimize reallocs
 
@@ -250,13 +293,22 @@ SMFSource::read_unlocked (const Lock&                    lock,
 	const uint64_t start_ticks = converter.from(start).to_ticks();
 	DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF read_unlocked: start in ticks %1\n", start_ticks));
 
-	if (_smf_last_read_end == 0 || start != _smf_last_read_end) {
+	if (_smf_last_read_end == 0 || start != _smf_last_read_end || (mapped && !_map_reader)) {
 		DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF read_unlocked: seek to %1\n", start));
-		Evoral::SMF::seek_to_start();
+		if (mapped) {
+			/* SMFSource always uses the first track, see Evoral::SMF::open */
+			_map_reader.reset (new Evoral::SMFMap::TrackReader (*_map, 1));
+		} else {
+			Evoral::SMF::seek_to_start();
+		}
 		while (time < start_ticks) {
 			gint ignored;
 
-			ret = read_event(&ev_delta_t, &ev_size, &ev_buffer, &ignored);
+			if (mapped) {
+				ret = _map_reader->read_event (&ev_delta_t, &ev_data, &ev_size, &ignored);
+			} else {
+				ret = read_event(&ev_delta_t, &ev_size, &ev_buffer, &ignored);
+			}
 			if (ret == -1) { // EOF
 				_smf_last_read_end = start + duration;
 				return duration;
@@ -273,7 +325,12 @@ SMFSource::read_unlocked (const Lock&                    lock,
 	while (true) {
 		gint ignored; /* XXX don't ignore note id's ??*/
 
-		ret = read_event(&ev_delta_t, &ev_size, &ev_buffer, &ignored);
+		if (mapped) {
+			ret = _map_reader->read_event (&ev_delta_t, &ev_data, &ev_size, &ignored);
+		} else {
+			ret = read_event(&ev_delta_t, &ev_size, &ev_buffer, &ignored);
+			ev_data = ev_buffer;
+		}
 		if (ret == -1) { // EOF
 			break;
 		}
@@ -286,7 +343,7 @@ SMFSource::read_unlocked (const Lock&                    lock,
 		}
 
 		DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF read_unlocked delta %1, time %2, buf[0] %3\n",
-								  ev_delta_t, time, ev_buffer[0]));
+								  ev_delta_t, time, ev_data[0]));
 
 		assert(time >= start_ticks);
 
@@ -300,10 +357,15 @@ SMFSource::read_unlocked (const Lock&                    lock,
 		}
 
 		if (ev_sample_time < start + duration) {
-			if (!filter || !filter->filter(ev_buffer, ev_size)) {
-				destination.write (ev_sample_time, Evoral::MIDI_EVENT, ev_size, ev_buffer);
+			if (mapped && filter) {
+				/* the filter may modify the event, the mapped file is read-only */
+				ev_copy.assign (ev_data, ev_data + ev_size);
+				ev_data = &ev_copy[0];
+			}
+			if (!filter || !filter->filter(const_cast<uint8_t*> (ev_data), ev_size)) {
+				destination.write (ev_sample_time, Evoral::MIDI_EVENT, ev_size, ev_data);
 				if (tracker) {
-					tracker->track(ev_buffer);
+					tracker->track(ev_data);
 				}
 			}
 		} else {
@@ -542,7 +604,9 @@ SMFSource::mark_streaming_midi_write_started (const Lock& lock, NoteMode mode)
 	}
 
 	MidiSource::mark_streaming_midi_write_started (lock, mode);
-	Evoral::SMF::begin_write ();
+	if (Evoral::SMF::begin_write ()) {
+		error << string_compose (_("cannot start writing to MIDI file %1"), _path) << endmsg;
+	}
 	_last_ev_time_beats  = Temporal::Beats();
 	_last_ev_time_samples = 0;
 }
@@ -639,6 +703,13 @@ SMFSource::load_model (const Glib::Threads::Mutex::Lock& lock, bool force_reload
 		_model->clear();
 	}
 
+	read_model (lock);
+}
+
+/** Fill the (empty) model from the file */
+void
+SMFSource::read_model (const Glib::Threads::Mutex::Lock& lock)
+{
 	invalidate(lock);
 
 	if (writable() && !_open) {
@@ -646,6 +717,14 @@ SMFSource::load_model (const Glib::Threads::Mutex::Lock& lock, bool force_reload
 	}
 
 	_model->start_write();
+
+	if (!Evoral::SMF::loaded () && load_model_mapped ()) {
+		_model->end_write (Evoral::Sequence<Temporal::Beats>::ResolveStuckNotes, _length_beats);
+		_model->set_edited (false);
+		invalidate(lock);
+		return;
+	}
+
 	Evoral::SMF::seek_to_start();
 
 	uint64_t time = 0; /* in SMF ticks */
@@ -738,6 +817,85 @@ SMFSource::load_model (const Glib::Threads::Mutex::Lock& lock, bool force_reload
 	free(buf);
 }
 
+/** Append all events of the file on disk to the model (which must be
+ * in write mode), reading them in place from a memory-mapped file.
+ * This is considerably faster than loading the file with libsmf, which
+ * allocates every event.
+ * @return false if the file cannot be mapped
+ */
+bool
+SMFSource::load_model_mapped ()
+{
+	Evoral::SMFMap map;
+
+	if (map.open (_path)) {
+		return false;
+	}
+
+	std::vector<Evoral::SMFMap::Event> events;
+	std::vector<uint8_t> scratch;
+
+	map.read_events (events, scratch);
+
+	DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF %1 load model from mapped file, %2 events\n", name(), events.size ()));
+
+	/* events are appended in time order, the model copies the data */
+	Evoral::Event<Temporal::Beats> ev (Evoral::MIDI_EVENT);
+
+	for (std::vector<Evoral::SMFMap::Event>::const_iterator i = events.begin (); i != events.end (); ++i) {
+		const Temporal::Beats event_time = Temporal::Beats::ticks_at_rate (i->time, map.ppqn ());
+
+		ev.set_buffer (i->size, const_cast<uint8_t*> (i->buffer), false);
+		ev.set_time (event_time);
+
+		_model->append (ev, i->id >= 0 ? i->id : Evoral::next_event_id ());
+
+		_length_beats = max (_length_beats, event_time);
+	}
+
+	ev.set_buffer (0, NULL, false);
+	return true;
+}
+
+void
+SMFSource::load_length (const Glib::Threads::Mutex::Lock& lock)
+{
+	if (_writing || _model || (writable() && !_open)) {
+		return;
+	}
+
+	Evoral::SMFMap map;
+
+	if (Evoral::SMF::loaded () || map.open (_path)) {
+		load_model (lock, true);
+		return;
+	}
+
+	/* same as load_model_mapped(): the time of the last MIDI event of all tracks */
+	uint64_t end = 0;
+
+	for (uint16_t t = 1; t <= map.num_tracks (); ++t) {
+		Evoral::SMFMap::TrackReader reader (map, t);
+		uint64_t       time = 0;
+		uint32_t       delta_t;
+		uint32_t       size;
+		uint8_t const* buf;
+		event_id_t     id;
+		int            ret;
+
+		while ((ret = reader.read_event (&delta_t, &buf, &size, &id)) >= 0) {
+			time += delta_t;
+			if (ret > 0) {
+				end = max (end, time);
+			}
+		}
+	}
+
+	_length_beats = max (_length_beats, Temporal::Beats::ticks_at_rate (end, map.ppqn ()));
+
+	DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF %1 length %2 beats, model not loaded\n", name(), _length_beats));
+}
+
 void
 SMFSource::destroy_model (const Glib::Threads::Mutex::Lock& lock)
 {
@@ -766,6 +924,7 @@ void
 SMFSource::set_path (const string& p)
 {
 	FileSource::set_path (p);
+	Evoral::SMF::set_file_path (p);
 }
 
 /** Ensure that this source has some file on disk, even if it's just a SMF header */
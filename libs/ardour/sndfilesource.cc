@@ -41,6 +41,9 @@
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
 
+#include <boost/bind.hpp>
+
+#include "ardour/audio_block_cache.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/sndfilesource.h"
 #include "ardour/sndfile_helpers.h"
@@ -458,6 +461,7 @@ SndFileSource::~SndFileSource ()
 {
 	close ();
 	delete _broadcast_info;
+	AudioBlockCache::drop (_path, _channel);
 }
 
 float
@@ -466,6 +470,19 @@ SndFileSource::sample_rate () const
 	return _info.samplerate;
 }
 
+samplecnt_t
+SndFileSource::read (Sample *dst, samplepos_t start, samplecnt_t cnt, int channel) const
+{
+	samplecnt_t ret = AudioFileSource::read (dst, start, cnt, channel);
+
+	/* queue read-ahead without holding the source's lock */
+	if (ret > 0 && use_block_cache ()) {
+		AudioBlockCache::read_ahead (*this, _path, _channel, _info.channels, start + ret,
+		                             boost::bind (&SndFileSource::decode_block, this, _1, _2, _3));
+	}
+	return ret;
+}
+
 samplecnt_t
 SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) const
 {
@@ -513,6 +530,20 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 		memset (dst+file_cnt, 0, sizeof (Sample) * delta);
 	}
 
+	if (file_cnt && use_block_cache ()) {
+		samplecnt_t ret = AudioBlockCache::read (_path, dst, start, file_cnt, _channel, _info.channels,
+		                                         boost::bind (&SndFileSource::decode_block, this, _1, _2, _3));
+		if (ret != file_cnt) {
+			error << string_compose(_("SndFileSource: @ %1 could not read %2 within %3 (len = %4, ret was %5)"), start, file_cnt, _name.val().substr (1), _length, ret) << endmsg;
+		}
+		if (_gain != 1.f) {
+			for (samplecnt_t i = 0; i < ret; ++i) {
+				dst[i] *= _gain;
+			}
+		}
+		return ret;
+	}
+
 	if (file_cnt) {
 
 		if (sf_seek (_sndfile, (sf_count_t) start, SEEK_SET|SFM_READ) != (sf_count_t) start) {
@@ -563,6 +594,36 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 	return nread;
 }
 
+bool
+SndFileSource::use_block_cache () const
+{
+	if (writable () || !AudioBlockCache::enabled ()) {
+		return false;
+	}
+	/* the OS page-cache is sufficient for mono PCM files. Compressed
+	 * files need to be decoded, and for multi-channel files all
+	 * channels are read for each channel's source.
+	 */
+	int const type = _info.format & SF_FORMAT_TYPEMASK;
+	return _info.channels > 1 || type == SF_FORMAT_FLAC || type == SF_FORMAT_OGG;
+}
+
+samplecnt_t
+SndFileSource::decode_block (Sample* dst, samplepos_t start, samplecnt_t cnt) const
+{
+	/* read-ahead may decode after the file was closed */
+	if (const_cast<SndFileSource*>(this)->open()) {
+		return 0;
+	}
+	if (sf_seek (_sndfile, (sf_count_t) start, SEEK_SET|SFM_READ) != (sf_count_t) start) {
+		char errbuf[256];
+		sf_error_str (0, errbuf, sizeof (errbuf) - 1);
+		error << string_compose(_("SndFileSource: could not seek to sample %1 within %2 (%3)"), start, _name.val().substr (1), errbuf) << endmsg;
+		return 0;
+	}
+	return sf_readf_float (_sndfile, dst, cnt);
+}
+
 samplecnt_t
 SndFileSource::write_unlocked (Sample *data, samplecnt_t cnt)
 {
@@ -809,5 +870,6 @@ SndFileSource::file_closed ()
 void
 SndFileSource::set_path (const string& p)
 {
+        AudioBlockCache::drop (_path, _channel);
         FileSource::set_path (p);
 }
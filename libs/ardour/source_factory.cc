@@ -35,6 +35,7 @@
 #include "ardour/midi_playlist.h"
 #include "ardour/midi_playlist_source.h"
 #include "ardour/mp3filesource.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/source.h"
 #include "ardour/source_factory.h"
 #include "ardour/sndfilesource.h"
@@ -216,7 +217,12 @@ SourceFactory::create (Session& s, const XMLNode& node, bool defer_peaks)
 		try {
 			boost::shared_ptr<SMFSource> src (new SMFSource (s, node));
 			Source::Lock lock(src->mutex());
-			src->load_model (lock, true);
+			if (Config->get_lazy_midi_models ()) {
+				/* play from disk, the model is loaded when needed */
+				src->load_length (lock);
+			} else {
+				src->load_model (lock, true);
+			}
 			BOOST_MARK_SOURCE (src);
 			src->check_for_analysis_data_on_disk ();
 			SourceCreated (src);
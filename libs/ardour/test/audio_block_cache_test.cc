@@ -0,0 +1,144 @@
+#include <vector>
+
+#include <boost/bind.hpp>
+
+#include "ardour/audio_block_cache.h"
+#include "ardour/rc_configuration.h"
+
+#include "audio_block_cache_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (AudioBlockCacheTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+static const samplecnt_t bs = AudioBlockCache::block_size;
+
+void
+AudioBlockCacheTest::setUp ()
+{
+	_length     = 10 * bs + 100;
+	_n_chn      = 2;
+	_decoded    = 0;
+	_cache_size = Config->get_decoded_audio_cache_size ();
+	Config->set_decoded_audio_cache_size (64);
+	AudioBlockCache::clear ();
+}
+
+void
+AudioBlockCacheTest::tearDown ()
+{
+	AudioBlockCache::clear ();
+	Config->set_decoded_audio_cache_size (_cache_size);
+}
+
+/* interleaved test-signal, unique for every sample and channel */
+samplecnt_t
+AudioBlockCacheTest::decode (Sample* dst, samplepos_t start, samplecnt_t cnt)
+{
+	++_decoded;
+	cnt = std::max<samplecnt_t> (0, std::min (cnt, _length - start));
+	for (samplecnt_t s = 0; s < cnt; ++s) {
+		for (uint32_t c = 0; c < _n_chn; ++c) {
+			dst[s * _n_chn + c] = (start + s) + c / 4.f;
+		}
+	}
+	return cnt;
+}
+
+void
+AudioBlockCacheTest::check (Sample const* buf, samplepos_t start, samplecnt_t cnt, uint32_t chn)
+{
+	for (samplecnt_t s = 0; s < cnt; ++s) {
+		CPPUNIT_ASSERT_EQUAL ((Sample) ((start + s) + chn / 4.f), buf[s]);
+	}
+}
+
+void
+AudioBlockCacheTest::readTest ()
+{
+	vector<Sample> buf (3 * bs);
+	AudioBlockCache::DecodeFunction df = boost::bind (&AudioBlockCacheTest::decode, this, _1, _2, _3);
+
+	/* read across block boundaries */
+	CPPUNIT_ASSERT_EQUAL (2 * bs, AudioBlockCache::read ("a", &buf[0], bs / 2, 2 * bs, 0, _n_chn, df));
+	check (&buf[0], bs / 2, 2 * bs, 0);
+	CPPUNIT_ASSERT_EQUAL (3, _decoded);
+
+	/* the same range again, and a sub-range are cached */
+	CPPUNIT_ASSERT_EQUAL (2 * bs, AudioBlockCache::read ("a", &buf[0], bs / 2, 2 * bs, 0, _n_chn, df));
+	check (&buf[0], bs / 2, 2 * bs, 0);
+	CPPUNIT_ASSERT_EQUAL (100, (int) AudioBlockCache::read ("a", &buf[0], bs + 7, 100, 0, _n_chn, df));
+	check (&buf[0], bs + 7, 100, 0);
+	CPPUNIT_ASSERT_EQUAL (3, _decoded);
+
+	/* short read at the end of the file */
+	CPPUNIT_ASSERT_EQUAL ((samplecnt_t) 150, AudioBlockCache::read ("a", &buf[0], _length - 150, bs, 0, _n_chn, df));
+	check (&buf[0], _length - 150, 150, 0);
+	CPPUNIT_ASSERT_EQUAL ((samplecnt_t) 0, AudioBlockCache::read ("a", &buf[0], _length, bs, 0, _n_chn, df));
+
+	/* different files do not share data */
+	_decoded = 0;
+	AudioBlockCache::read ("b", &buf[0], 0, 10, 0, _n_chn, df);
+	CPPUNIT_ASSERT_EQUAL (1, _decoded);
+
+	for (uint32_t c = 0; c < _n_chn; ++c) {
+		AudioBlockCache::drop ("a", c);
+		AudioBlockCache::drop ("b", c);
+	}
+	CPPUNIT_ASSERT_EQUAL ((size_t) 0, AudioBlockCache::size ());
+}
+
+void
+AudioBlockCacheTest::sharedChannelsTest ()
+{
+	vector<Sample> buf (bs);
+	AudioBlockCache::DecodeFunction df = boost::bind (&AudioBlockCacheTest::decode, this, _1, _2, _3);
+
+	AudioBlockCache::read ("a", &buf[0], 0, bs, 0, _n_chn, df);
+	check (&buf[0], 0, bs, 0);
+	CPPUNIT_ASSERT_EQUAL (1, _decoded);
+
+	/* the 2nd channel was decoded along with the first */
+	AudioBlockCache::read ("a", &buf[0], 0, bs, 1, _n_chn, df);
+	check (&buf[0], 0, bs, 1);
+	CPPUNIT_ASSERT_EQUAL (1, _decoded);
+	CPPUNIT_ASSERT_EQUAL ((size_t) (_n_chn * bs * sizeof (Sample)), AudioBlockCache::size ());
+
+	/* the source of the 1st channel is gone, the 2nd channel remains cached */
+	AudioBlockCache::drop ("a", 0);
+	CPPUNIT_ASSERT_EQUAL ((size_t) (bs * sizeof (Sample)), AudioBlockCache::size ());
+	AudioBlockCache::read ("a", &buf[0], 0, bs, 1, _n_chn, df);
+	check (&buf[0], 0, bs, 1);
+	CPPUNIT_ASSERT_EQUAL (1, _decoded);
+}
+
+void
+AudioBlockCacheTest::evictTest ()
+{
+	vector<Sample> buf (bs);
+	AudioBlockCache::DecodeFunction df = boost::bind (&AudioBlockCacheTest::decode, this, _1, _2, _3);
+
+	/* room for 4 blocks of 2 channels */
+	Config->set_decoded_audio_cache_size (1);
+	CPPUNIT_ASSERT_EQUAL ((samplecnt_t) 1048576, 8 * bs * (samplecnt_t) sizeof (Sample));
+
+	for (samplepos_t b = 0; b < 4; ++b) {
+		AudioBlockCache::read ("a", &buf[0], b * bs, bs, 0, _n_chn, df);
+	}
+	CPPUNIT_ASSERT_EQUAL (4, _decoded);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 1048576, AudioBlockCache::size ());
+
+	/* use the first block, then add a 5th block: the 2nd block is evicted */
+	AudioBlockCache::read ("a", &buf[0], 0, bs, 0, _n_chn, df);
+	AudioBlockCache::read ("a", &buf[0], 0, bs, 1, _n_chn, df);
+	AudioBlockCache::read ("a", &buf[0], 4 * bs, bs, 0, _n_chn, df);
+	CPPUNIT_ASSERT_EQUAL (5, _decoded);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 1048576, AudioBlockCache::size ());
+
+	AudioBlockCache::read ("a", &buf[0], 0, bs, 1, _n_chn, df);
+	CPPUNIT_ASSERT_EQUAL (5, _decoded);
+	AudioBlockCache::read ("a", &buf[0], bs, bs, 1, _n_chn, df);
+	check (&buf[0], bs, bs, 1);
+	CPPUNIT_ASSERT_EQUAL (6, _decoded);
+}
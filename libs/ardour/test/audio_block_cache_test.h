@@ -0,0 +1,30 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "ardour/types.h"
+
+class AudioBlockCacheTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (AudioBlockCacheTest);
+	CPPUNIT_TEST (readTest);
+	CPPUNIT_TEST (sharedChannelsTest);
+	CPPUNIT_TEST (evictTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void readTest ();
+	void sharedChannelsTest ();
+	void evictTest ();
+
+private:
+	ARDOUR::samplecnt_t decode (ARDOUR::Sample*, ARDOUR::samplepos_t, ARDOUR::samplecnt_t);
+	void check (ARDOUR::Sample const*, ARDOUR::samplepos_t, ARDOUR::samplecnt_t, uint32_t chn);
+
+	ARDOUR::samplecnt_t _length;
+	uint32_t            _n_chn;
+	int                 _decoded;
+	uint32_t            _cache_size;
+};
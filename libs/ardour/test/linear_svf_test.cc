@@ -0,0 +1,94 @@
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/* shared with the a-* plugins */
+#include "plugins/shared/linear_svf.h"
+
+#include "linear_svf_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (LinearSVFTest);
+
+using namespace std;
+
+static void
+setup_filters (struct linear_svf* f, uint32_t n_filters)
+{
+	/* a-EQ like: low-shelf, peaking EQs, high-shelf */
+	for (uint32_t j = 0; j < n_filters; ++j) {
+		const float gain = (rand () % 400) / 10.f - 20.f;
+		const float freq = 20 + rand () % 18000;
+		if (j == 0) {
+			linear_svf_set_lowshelf (&f[j], gain, 48000, freq, 0.7071068);
+		} else if (j == n_filters - 1) {
+			linear_svf_set_highshelf (&f[j], gain, 48000, freq, 0.7071068);
+		} else {
+			linear_svf_set_peq (&f[j], gain, 48000, freq, .1f + (rand () % 40) / 10.f);
+		}
+	}
+}
+
+static void
+compare (std::string const& name, linear_svf_cascade_fn fn)
+{
+	const uint32_t len = 8192;
+
+	for (uint32_t n_filters = 1; n_filters <= LINEAR_SVF_LANES; ++n_filters) {
+		struct linear_svf ref[LINEAR_SVF_LANES];
+		struct linear_svf vec[LINEAR_SVF_LANES];
+		memset (ref, 0, sizeof (ref));
+		memset (vec, 0, sizeof (vec));
+
+		vector<float> in (len);
+		vector<float> out_ref (len);
+		vector<float> out_vec (len);
+
+		srand (n_filters);
+		for (uint32_t i = 0; i < len; ++i) {
+			in[i] = 2.f * (rand () / (float)RAND_MAX - .5f);
+		}
+
+		uint32_t pos = 0;
+		uint32_t seed = 0;
+		while (pos < len) {
+			/* random block-size, including blocks shorter than the cascade */
+			uint32_t n_samples = std::min (len - pos, 1 + (uint32_t)(rand () % 130));
+
+			/* change parameters, keep filter state */
+			srand (++seed);
+			setup_filters (ref, n_filters);
+			srand (seed);
+			setup_filters (vec, n_filters);
+
+			linear_svf_cascade_ref (ref, n_filters, &in[pos], &out_ref[pos], n_samples);
+
+			/* in-place */
+			memcpy (&out_vec[pos], &in[pos], n_samples * sizeof (float));
+			fn (vec, n_filters, &out_vec[pos], &out_vec[pos], n_samples);
+
+			pos += n_samples;
+		}
+
+		CPPUNIT_ASSERT_MESSAGE (name + ": output differs", 0 == memcmp (&out_ref[0], &out_vec[0], len * sizeof (float)));
+		CPPUNIT_ASSERT_MESSAGE (name + ": state differs", 0 == memcmp (ref, vec, sizeof (ref)));
+	}
+}
+
+void
+LinearSVFTest::cascadeTest ()
+{
+	/* the vectorized cascade must be bit-identical to the scalar one */
+#ifdef LINEAR_SVF_SSE2
+	compare ("SSE2", linear_svf_cascade_sse2);
+#endif
+#ifdef LINEAR_SVF_AVX
+	if (__builtin_cpu_supports ("avx")) {
+		compare ("AVX", linear_svf_cascade_avx);
+	}
+#endif
+#ifdef LINEAR_SVF_NEON
+	compare ("NEON", linear_svf_cascade_neon);
+#endif
+	compare ("selected", linear_svf_cascade_select ());
+}
@@ -0,0 +1,12 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class LinearSVFTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (LinearSVFTest);
+	CPPUNIT_TEST (cascadeTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void cascadeTest ();
+};
@@ -1,8 +1,13 @@
 #include <list>
+#include <glib/gstdio.h>
 #include <glibmm.h>
 
 #include "ardour/audio_track.h"
 #include "ardour/audioengine.h"
+#include "ardour/buffer_set.h"
+#include "ardour/chan_mapping.h"
+#include "ardour/filesystem_paths.h"
+#include "ardour/luaproc.h"
 #include "ardour/luascripting.h"
 #include "ardour/lua_script_params.h"
 #include "ardour/plugin_manager.h"
@@ -103,3 +108,67 @@ LuaScriptTest::dsp_script_test ()
 		CPPUNIT_ASSERT_MESSAGE ((*i)->name, rv == 0);
 	}
 }
+
+static void
+run_dsp (boost::shared_ptr<LuaProc> lp)
+{
+	const pframes_t nframes = 256;
+	ChanCount in (DataType::AUDIO, 1);
+	ChanCount aux;
+	ChanCount out;
+	lp->match_variable_io (in, aux, out);
+	lp->reconfigure_io (in, aux, out);
+
+	BufferSet bufs;
+	bufs.ensure_buffers (ChanCount::max (in, out), nframes);
+	bufs.set_count (ChanCount::max (in, out));
+
+	for (int c = 0; c < 50; ++c) {
+		samplepos_t pos = c * nframes;
+		lp->connect_and_run (bufs, pos, pos + nframes, 1.0, ChanMapping (in), ChanMapping (out), nframes, 0);
+	}
+}
+
+void
+LuaScriptTest::dsp_arena_reload_test ()
+{
+	const std::string script =
+		"ardour { [\"type\"] = \"dsp\", name = \"Arena Test\" }\n"
+		"function dsp_ioconfig () return { { audio_in = 1, audio_out = 1 } } end\n"
+		"function dsp_run (ins, outs, n_samples)\n"
+		"  local t = {}\n"
+		"  for i = 1, 64 do t[i] = i end\n"
+		"end\n";
+
+	/* peaks are kept on disk, start without one */
+	const std::string cache = Glib::build_filename (user_cache_directory (), "lua_dsp_arena");
+	::g_unlink (cache.c_str ());
+
+	size_t used, peak, size, first_size, first_peak;
+
+	/* unknown script: all of the pool is locked */
+	boost::shared_ptr<LuaProc> lp (new LuaProc (_session->engine (), *_session, script));
+	run_dsp (lp);
+	lp->arena_usage (used, first_peak, first_size);
+	CPPUNIT_ASSERT (first_peak > 0);
+	CPPUNIT_ASSERT (first_peak < first_size);
+
+	/* saving the state records the peak */
+	delete &lp->get_state ();
+	lp.reset ();
+	CPPUNIT_ASSERT (Glib::file_test (cache, Glib::FILE_TEST_EXISTS));
+
+	/* a new instance, as on session load, uses the recorded peak (with headroom) */
+	lp.reset (new LuaProc (_session->engine (), *_session, script));
+	lp->arena_usage (used, peak, size);
+	CPPUNIT_ASSERT (size >= first_peak);
+	CPPUNIT_ASSERT (size < first_size || 2 * first_peak >= first_size);
+	lp.reset ();
+
+	/* nothing is kept in memory only: without the file, the whole pool is locked again */
+	::g_unlink (cache.c_str ());
+	lp.reset (new LuaProc (_session->engine (), *_session, script));
+	lp->arena_usage (used, peak, size);
+	CPPUNIT_ASSERT_EQUAL (first_size, size);
+	lp.reset ();
+}
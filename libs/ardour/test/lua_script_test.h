@@ -6,9 +6,11 @@ class LuaScriptTest : public TestNeedingSession
 	CPPUNIT_TEST_SUITE (LuaScriptTest);
 	CPPUNIT_TEST (session_script_test);
 	CPPUNIT_TEST (dsp_script_test);
+	CPPUNIT_TEST (dsp_arena_reload_test);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
 	void session_script_test ();
 	void dsp_script_test ();
+	void dsp_arena_reload_test ();
 };
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <vector>
+
+#include <glibmm/miscutils.h>
+
+#include "evoral/EventSink.h"
+#include "evoral/Note.h"
+
+#include "ardour/midi_model.h"
+#include "ardour/midi_region.h"
+#include "ardour/midi_source.h"
+#include "ardour/region_factory.h"
+#include "ardour/session.h"
+#include "ardour/source_factory.h"
+#include "ardour/tempo.h"
+
+#include "midi_region_render_test.h"
+#include "test_util.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MidiRegionRenderTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+namespace {
+
+struct RenderedEvent {
+	RenderedEvent (samplepos_t t, uint8_t s, uint8_t n) : time (t), status (s), note (n) {}
+
+	bool operator< (RenderedEvent const& other) const {
+		if (time != other.time) {
+			return time < other.time;
+		}
+		if (status != other.status) {
+			return status < other.status;
+		}
+		return note < other.note;
+	}
+
+	bool operator== (RenderedEvent const& other) const {
+		return time == other.time && status == other.status && note == other.note;
+	}
+
+	samplepos_t time;
+	uint8_t     status;
+	uint8_t     note;
+};
+
+/** records every event that is written, within the range or not */
+class RecordingSink : public Evoral::EventSink<samplepos_t>
+{
+public:
+	uint32_t write (samplepos_t time, Evoral::EventType, uint32_t size, const uint8_t* buf) {
+		events.push_back (RenderedEvent (time, buf[0], size > 1 ? buf[1] : 0));
+		return size;
+	}
+
+	vector<RenderedEvent> events;
+};
+
+/* one note per beat, each two beats long */
+const int n_notes = 1000;
+
+}
+
+void
+MidiRegionRenderTest::setUp ()
+{
+	TestNeedingSession::setUp ();
+
+	std::string const path = Glib::build_filename (new_test_output_dir (), "test.mid");
+	_source = boost::dynamic_pointer_cast<MidiSource> (SourceFactory::createWritable (DataType::MIDI, *_session, path, _session->sample_rate ()));
+	CPPUNIT_ASSERT (_source);
+
+	boost::shared_ptr<MidiModel> model = _source->ensure_model ();
+	CPPUNIT_ASSERT (model);
+
+	MidiModel::NoteDiffCommand* cmd = model->new_note_diff_command ("add notes");
+	for (int i = 0; i < n_notes; ++i) {
+		cmd->add (MidiModel::NotePtr (new Evoral::Note<Temporal::Beats> (0, Temporal::Beats (i), Temporal::Beats (2), 60 + (i % 12), 100)));
+	}
+	model->apply_command (*_session, cmd);
+
+	/* the region ends while the last two notes sound */
+	PBD::PropertyList plist;
+	plist.add (Properties::start, 0);
+	plist.add (Properties::length, _session->tempo_map ().sample_at_quarter_note (n_notes));
+	_region = boost::dynamic_pointer_cast<MidiRegion> (RegionFactory::create (_source, plist));
+	CPPUNIT_ASSERT (_region);
+}
+
+void
+MidiRegionRenderTest::tearDown ()
+{
+	_region.reset ();
+	_source.reset ();
+
+	TestNeedingSession::tearDown ();
+}
+
+/** render_range () must write the same events as render () does within the
+ * range, and no others: the work is bounded by the range, not the region.
+ */
+void
+MidiRegionRenderTest::check_range (double from_qn, double to_qn, size_t max_events)
+{
+	TempoMap& tmap (_session->tempo_map ());
+	Evoral::Range<samplepos_t> const range (tmap.sample_at_quarter_note (from_qn), tmap.sample_at_quarter_note (to_qn));
+
+	RecordingSink all;
+	_region->render (all, 0, Sustained, 0);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 2 * n_notes, all.events.size ());
+
+	vector<RenderedEvent> expected;
+	for (vector<RenderedEvent>::const_iterator i = all.events.begin (); i != all.events.end (); ++i) {
+		if (i->time >= range.from && i->time <= range.to) {
+			expected.push_back (*i);
+		}
+	}
+
+	RecordingSink ranged;
+	_region->render_range (ranged, 0, Sustained, 0, range);
+
+	CPPUNIT_ASSERT (ranged.events.size () <= max_events);
+	CPPUNIT_ASSERT_EQUAL (expected.size (), ranged.events.size ());
+
+	sort (expected.begin (), expected.end ());
+	sort (ranged.events.begin (), ranged.events.end ());
+	CPPUNIT_ASSERT (expected == ranged.events);
+}
+
+void
+MidiRegionRenderTest::rangeTest ()
+{
+	/* 10 notes start in the range. The note-offs of the notes sounding
+	 * at its start are included, the note-ons before it are not.
+	 */
+	check_range (500.5, 510.5, 20);
+}
+
+void
+MidiRegionRenderTest::regionEndTest ()
+{
+	/* notes sounding at the end of the region are resolved there */
+	check_range (n_notes - 3.5, n_notes + 1, 8);
+}
@@ -0,0 +1,28 @@
+#include "ardour/types.h"
+#include "test_needing_session.h"
+
+namespace ARDOUR {
+	class MidiRegion;
+	class MidiSource;
+}
+
+class MidiRegionRenderTest : public TestNeedingSession
+{
+	CPPUNIT_TEST_SUITE (MidiRegionRenderTest);
+	CPPUNIT_TEST (rangeTest);
+	CPPUNIT_TEST (regionEndTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void rangeTest ();
+	void regionEndTest ();
+
+private:
+	void check_range (double from_qn, double to_qn, size_t max_events);
+
+	boost::shared_ptr<ARDOUR::MidiSource> _source;
+	boost::shared_ptr<ARDOUR::MidiRegion> _region;
+};
@@ -0,0 +1,155 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <glib.h>
+
+#include "zita-convolver/zita-convolver.h"
+
+#include "pbd/cpus.h"
+#include "pbd/pthread_utils.h"
+
+#include "ardour/convolver.h"
+
+using namespace std;
+using namespace ArdourZita;
+
+/* Process-thread cost of 8 parallel true-stereo convolvers (2 in, 2 out,
+ * 4 IRs of 6 seconds) at 64 samples per cycle, 48kHz. Cycles are paced in
+ * realtime, and run with realtime priority if permitted:
+ *  - zita-convolver threads, one per partition size and convolver,
+ *    partitions up to 4 * 64 samples (previous ARDOUR::Convolution setup)
+ *  - the same with partitions up to 64 * 64 samples
+ *  - ARDOUR::DSP::ConvolutionPool, partitions up to 64 * 64 samples
+ *
+ * Usage: convolution [n-convolvers [n-pool-threads]]
+ */
+
+static const uint32_t rate      = 48000;
+static const uint32_t n_samples = 64;
+static const uint32_t ir_len    = 6 * rate;
+static const uint32_t n_cycles  = 20 * rate / n_samples;
+
+static void
+generate_ir (vector<float>& ir, uint32_t seed)
+{
+	srand (seed);
+	ir.resize (ir_len);
+	for (uint32_t i = 0; i < ir_len; ++i) {
+		/* -60dB after 6 sec */
+		ir[i] = (rand () / (float)RAND_MAX - .5f) * expf (-6.9f * i / ir_len);
+	}
+}
+
+static bool rt = false;
+
+static int
+worker_priority ()
+{
+	/* below the process thread, as ARDOUR::Convolution does */
+	return rt ? pbd_absolute_rt_priority (PBD_SCHED_FIFO, PBD_RT_PRI_PROC - 2) : 0;
+}
+
+static void
+bench (char const* name, uint32_t n_conv, uint32_t maxpart, Convsched* sched, vector<float>* irs)
+{
+	vector<Convproc*> conv;
+
+	for (uint32_t n = 0; n < n_conv; ++n) {
+		Convproc* cp = new Convproc;
+		cp->set_scheduler (sched);
+		int rv = cp->configure (2, 2, ir_len, n_samples, n_samples, maxpart, 0);
+		for (uint32_t c = 0; c < 4 && rv == 0; ++c) {
+			rv = cp->impdata_create (c / 2, c % 2, 1, &irs[c][0], 0, ir_len);
+		}
+		if (rv == 0) {
+			rv = cp->start_process (worker_priority (), rt ? PBD_SCHED_FIFO : SCHED_OTHER);
+		}
+		if (rv != 0) {
+			cerr << "ERROR: cannot configure convolver (" << rv << ")\n";
+			exit (EXIT_FAILURE);
+		}
+		conv.push_back (cp);
+	}
+
+	float    in[n_samples];
+	int64_t  t_max = 0;
+	int64_t  t_sum = 0;
+	uint32_t n_over = 0;
+
+	const int64_t budget = 1000000 * n_samples / rate;
+
+	int64_t next = g_get_monotonic_time ();
+
+	srand (0);
+	for (uint32_t i = 0; i < n_cycles; ++i) {
+		for (uint32_t s = 0; s < n_samples; ++s) {
+			in[s] = rand () / (float)RAND_MAX - .5f;
+		}
+
+		int64_t start = g_get_monotonic_time ();
+		for (vector<Convproc*>::const_iterator c = conv.begin (); c != conv.end (); ++c) {
+			memcpy ((*c)->inpdata (0), in, sizeof (in));
+			memcpy ((*c)->inpdata (1), in, sizeof (in));
+			(*c)->process (true);
+		}
+		int64_t elapsed = g_get_monotonic_time () - start;
+
+		t_sum += elapsed;
+		t_max  = max (t_max, elapsed);
+		if (elapsed > budget) {
+			++n_over;
+		}
+
+		/* late partitions run in the time between cycles */
+		next += budget;
+		int64_t remain = next - g_get_monotonic_time ();
+		if (remain > 0) {
+			g_usleep (remain);
+		}
+	}
+
+	for (vector<Convproc*>::const_iterator c = conv.begin (); c != conv.end (); ++c) {
+		(*c)->stop_process ();
+		(*c)->cleanup ();
+		delete *c;
+	}
+
+	cout << setw (24) << left << name << right
+	     << " avg: " << setw (7) << fixed << setprecision (1) << t_sum / (double)n_cycles << " us"
+	     << " max: " << setw (6) << t_max << " us"
+	     << " over budget (" << budget << " us): " << n_over << " / " << n_cycles << " cycles\n";
+}
+
+int
+main (int argc, char* argv[])
+{
+	uint32_t n_conv    = argc > 1 ? atoi (argv[1]) : 8;
+	uint32_t n_threads = argc > 2 ? atoi (argv[2]) : 0;
+
+	if (n_threads == 0) {
+		n_threads = max (1U, hardware_concurrency () - 1);
+	}
+
+	rt = 0 == pbd_set_thread_priority (pthread_self (), PBD_SCHED_FIFO, PBD_RT_PRI_PROC);
+
+	vector<float> irs[4];
+	for (uint32_t c = 0; c < 4; ++c) {
+		generate_ir (irs[c], c + 1);
+	}
+
+	cout << n_conv << " true-stereo convolvers, " << ir_len / (float)rate << " sec IR, "
+	     << n_samples << " samples/cycle, " << n_threads << " pool threads per partition size"
+	     << (rt ? ", realtime\n" : "\n");
+
+	bench ("zita threads, 256", n_conv, 4 * n_samples, 0, irs);
+	bench ("zita threads, 4096", n_conv, 64 * n_samples, 0, irs);
+
+	ARDOUR::DSP::ConvolutionPool pool (n_threads, rt, worker_priority ());
+	bench ("ConvolutionPool, 4096", n_conv, 64 * n_samples, &pool, irs);
+
+	return 0;
+}
@@ -0,0 +1,159 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <vector>
+
+#include <glib.h>
+#include <glibmm/threadpool.h>
+#include <sigc++/bind.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include "pbd/cpus.h"
+
+#include "audiographer/process_context.h"
+#include "audiographer/sink.h"
+#include "audiographer/general/sample_format_converter.h"
+#include "audiographer/general/threader.h"
+#include "audiographer/general/threader_pool.h"
+
+using namespace std;
+using namespace AudioGrapher;
+
+/* Fan-out of export chunks to 1, 16 and 128 outputs (stems), each
+ * converting to 16bit with triangular dither, as done by the export
+ * graph for every file format.
+ *
+ *  - serial: all outputs run in the calling thread
+ *  - glib:   one Glib::ThreadPool task per output and chunk (the
+ *            previous Threader implementation)
+ *  - pool:   AudioGrapher::Threader with a persistent ThreaderPool
+ *
+ * Usage: export_threader [threads [chunks]]
+ */
+
+static const samplecnt_t chunk_size = 4086; // see ExportGraphBuilder::Intermediate
+static const ChannelCount channels  = 2;
+
+class NullSink : public Sink<int16_t>
+{
+  public:
+	NullSink () : sum (0) {}
+	void process (ProcessContext<int16_t> const& c)
+	{
+		sum += c.data ()[0] + c.data ()[c.samples () - 1];
+	}
+	using Sink<int16_t>::process;
+	int64_t sum;
+};
+
+typedef boost::shared_ptr<SampleFormatConverter<int16_t> > ConverterPtr;
+
+/* the previous Threader, a task per output and chunk */
+class GlibFanOut
+{
+  public:
+	GlibFanOut (Glib::ThreadPool& pool, vector<ConverterPtr>& outputs)
+		: _pool (pool)
+		, _outputs (outputs)
+		, _readers (0)
+	{}
+
+	void process (ProcessContext<float> const& c)
+	{
+		_mutex.lock ();
+		g_atomic_int_add (&_readers, _outputs.size ());
+		for (unsigned int i = 0; i < _outputs.size (); ++i) {
+			_pool.push (sigc::bind (sigc::mem_fun (this, &GlibFanOut::process_output), c, i));
+		}
+		while (g_atomic_int_get (&_readers) != 0) {
+			_cond.wait_until (_mutex, g_get_monotonic_time () + 500 * G_TIME_SPAN_MILLISECOND);
+		}
+		_mutex.unlock ();
+	}
+
+  private:
+	void process_output (ProcessContext<float> const& c, unsigned int i)
+	{
+		_outputs[i]->process (c);
+		if (g_atomic_int_dec_and_test (&_readers)) {
+			_cond.signal ();
+		}
+	}
+
+	Glib::ThreadPool&     _pool;
+	vector<ConverterPtr>& _outputs;
+	Glib::Threads::Mutex  _mutex;
+	Glib::Threads::Cond   _cond;
+	gint                  _readers;
+};
+
+int
+main (int argc, char* argv[])
+{
+	unsigned int n_threads = argc > 1 ? atoi (argv[1]) : 0;
+	int          n_chunks  = argc > 2 ? atoi (argv[2]) : 500;
+
+	if (n_threads == 0) {
+		n_threads = hardware_concurrency ();
+	}
+	if (n_chunks <= 0) {
+		cerr << "Usage: " << argv[0] << " [threads [chunks]]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	vector<float> data (chunk_size);
+	for (samplecnt_t i = 0; i < chunk_size; ++i) {
+		data[i] = g_random_double_range (-1, 1);
+	}
+	ProcessContext<float> c (&data[0], chunk_size, channels);
+
+	Glib::ThreadPool glib_pool (n_threads);
+	ThreaderPool     threader_pool (n_threads);
+
+	cout << n_threads << " threads, " << n_chunks << " chunks of " << chunk_size << " samples\n"
+	     << "outputs  serial [us]  glib [us]  pool [us]  (per chunk)\n";
+
+	const unsigned int n_outputs[] = { 1, 16, 128 };
+
+	for (size_t n = 0; n < sizeof (n_outputs) / sizeof (n_outputs[0]); ++n) {
+		vector<ConverterPtr> outputs;
+
+		Threader<float> threader (threader_pool);
+		GlibFanOut      glib_fan_out (glib_pool, outputs);
+
+		for (unsigned int i = 0; i < n_outputs[n]; ++i) {
+			ConverterPtr sfc (new SampleFormatConverter<int16_t> (channels));
+			sfc->init (chunk_size, D_Tri, 16);
+			sfc->add_output (boost::shared_ptr<NullSink> (new NullSink));
+			outputs.push_back (sfc);
+			threader.add_output (sfc);
+		}
+
+		int64_t t0 = g_get_monotonic_time ();
+		for (int i = 0; i < n_chunks; ++i) {
+			for (vector<ConverterPtr>::iterator o = outputs.begin (); o != outputs.end (); ++o) {
+				(*o)->process (c);
+			}
+		}
+		int64_t t1 = g_get_monotonic_time ();
+		for (int i = 0; i < n_chunks; ++i) {
+			glib_fan_out.process (c);
+		}
+		int64_t t2 = g_get_monotonic_time ();
+		for (int i = 0; i < n_chunks; ++i) {
+			threader.process (c);
+		}
+		int64_t t3 = g_get_monotonic_time ();
+
+		cout << setw (7) << n_outputs[n]
+		     << fixed << setprecision (1)
+		     << setw (13) << (t1 - t0) / (double) n_chunks
+		     << setw (11) << (t2 - t1) / (double) n_chunks
+		     << setw (11) << (t3 - t2) / (double) n_chunks
+		     << "\n";
+	}
+
+	glib_pool.shutdown ();
+	return 0;
+}
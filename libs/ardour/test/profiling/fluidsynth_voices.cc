@@ -0,0 +1,162 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <glib.h>
+
+#include "fluidsynth.h"
+
+#include "pbd/cpus.h"
+
+using namespace std;
+
+/* Render time of the bundled fluidsynth against polyphony, with voices
+ * rendered by the calling thread only, and in parallel by additional
+ * mixer threads ("synth.cpu-cores").
+ *
+ * The SoundFont is generated: a single looped sample, every voice uses
+ * the 4th order interpolation and the resonant low-pass filter.
+ *
+ * Usage: fluidsynth_voices [max-polyphony [cpu-cores]]
+ */
+
+static const int rate       = 48000;
+static const int block_size = 256;
+static const int n_blocks   = 4 * rate / block_size;
+
+static fluid_sample_t* sample = 0;
+
+static const char* sf_name (fluid_sfont_t*) { return "bench"; }
+static const char* preset_name (fluid_preset_t*) { return "bench"; }
+static int  preset_bank (fluid_preset_t*) { return 0; }
+static int  preset_num (fluid_preset_t*) { return 0; }
+static void preset_free (fluid_preset_t* p) { delete_fluid_preset (p); }
+static void sf_iter_start (fluid_sfont_t*) {}
+static fluid_preset_t* sf_iter_next (fluid_sfont_t*) { return 0; }
+
+static int
+preset_noteon (fluid_preset_t*, fluid_synth_t* synth, int chan, int key, int vel)
+{
+	fluid_voice_t* v = fluid_synth_alloc_voice (synth, sample, chan, key, vel);
+	if (!v) {
+		return FLUID_FAILED;
+	}
+	fluid_voice_gen_set (v, GEN_SAMPLEMODE, 1); /* loop continuously */
+	fluid_voice_gen_set (v, GEN_FILTERFC, 8000 + 30 * (key % 64));
+	fluid_voice_gen_set (v, GEN_FILTERQ, 60);
+	fluid_synth_start_voice (synth, v);
+	return FLUID_OK;
+}
+
+static fluid_preset_t* sf_get_preset (fluid_sfont_t* sf, int, int)
+{
+	/* the same preset for every bank and program, including drums */
+	return new_fluid_preset (sf, preset_name, preset_bank, preset_num, preset_noteon, preset_free);
+}
+
+static int sf_free (fluid_sfont_t* sf)
+{
+	delete_fluid_sfont (sf);
+	return 0;
+}
+
+static void
+generate_sample ()
+{
+	/* one second of a band-limited sawtooth (110Hz), looped */
+	vector<short> data (rate);
+	for (int i = 0; i < rate; ++i) {
+		double s = 0;
+		for (int h = 1; h < 40; ++h) {
+			s += sin (2 * M_PI * 110 * h * i / rate) / h;
+		}
+		data[i] = 16000 * s / 2;
+	}
+
+	sample = new_fluid_sample ();
+	fluid_sample_set_sound_data (sample, &data[0], NULL, rate, rate, 1);
+	fluid_sample_set_loop (sample, 0, rate);
+	fluid_sample_set_pitch (sample, 45, 0);
+}
+
+static double
+bench (int n_voices, int n_cores)
+{
+	fluid_settings_t* settings = new_fluid_settings ();
+	fluid_settings_setnum (settings, "synth.sample-rate", rate);
+	fluid_settings_setint (settings, "synth.threadsafe-api", 0);
+	fluid_settings_setint (settings, "synth.polyphony", n_voices);
+	if (fluid_settings_setint (settings, "synth.cpu-cores", n_cores) != FLUID_OK) {
+		cerr << "ERROR: cannot use " << n_cores << " cpu-cores\n";
+		exit (EXIT_FAILURE);
+	}
+
+	fluid_synth_t* synth = new_fluid_synth (settings);
+	fluid_synth_set_reverb_on (synth, 0);
+	fluid_synth_set_chorus_on (synth, 0);
+
+	fluid_sfont_t* sf = new_fluid_sfont (sf_name, sf_get_preset, sf_iter_start, sf_iter_next, sf_free);
+	int sf_id = fluid_synth_add_sfont (synth, sf);
+
+	for (int c = 0; c < 16; ++c) {
+		fluid_synth_program_select (synth, c, sf_id, 0, 0);
+	}
+	for (int i = 0; i < n_voices; ++i) {
+		fluid_synth_noteon (synth, i % 16, 24 + (i / 16) % 72 + i % 5, 100);
+	}
+
+	float l[block_size];
+	float r[block_size];
+
+	/* start all voices */
+	fluid_synth_write_float (synth, block_size, l, 0, 1, r, 0, 1);
+
+	if (fluid_synth_get_active_voice_count (synth) != n_voices) {
+		cerr << "ERROR: " << fluid_synth_get_active_voice_count (synth) << " of " << n_voices << " voices are active\n";
+		exit (EXIT_FAILURE);
+	}
+
+	int64_t start = g_get_monotonic_time ();
+	for (int i = 0; i < n_blocks; ++i) {
+		fluid_synth_write_float (synth, block_size, l, 0, 1, r, 0, 1);
+	}
+	int64_t elapsed = g_get_monotonic_time () - start;
+
+	delete_fluid_synth (synth);
+	delete_fluid_settings (settings);
+
+	return elapsed / (double) n_blocks;
+}
+
+int
+main (int argc, char* argv[])
+{
+	int max_voices = argc > 1 ? atoi (argv[1]) : 512;
+	int n_cores    = argc > 2 ? atoi (argv[2]) : 0;
+
+	if (n_cores <= 0) {
+		n_cores = std::min (4U, hardware_concurrency ());
+	}
+
+	generate_sample ();
+
+	const double budget = 1e6 * block_size / rate;
+
+	cout << block_size << " samples/block, budget " << fixed << setprecision (0) << budget << " us\n"
+	     << "voices  1 core [us]  " << n_cores << " cores [us]\n";
+
+	for (int n_voices = 16; n_voices <= max_voices; n_voices *= 2) {
+		double t1 = bench (n_voices, 1);
+		double tn = bench (n_voices, n_cores);
+		cout << setw (6) << n_voices
+		     << fixed << setprecision (1)
+		     << setw (13) << t1
+		     << setw (13) << tn
+		     << "  (" << setprecision (2) << t1 / tn << "x)\n";
+	}
+
+	delete_fluid_sample (sample);
+	return 0;
+}
@@ -0,0 +1,157 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <vector>
+
+#include <glib.h>
+#include <glibmm/fileutils.h>
+
+#include "pbd/failed_constructor.h"
+
+#include "ardour/ardour.h"
+#include "ardour/audioengine.h"
+#include "ardour/buffer_set.h"
+#include "ardour/chan_mapping.h"
+#include "ardour/luaproc.h"
+#include "ardour/luascripting.h"
+#include "ardour/session.h"
+#include "ardour/session_event.h"
+
+#include "test_util.h"
+
+using namespace std;
+using namespace ARDOUR;
+
+/* Instantiation time, memory pool usage and process time of LuaProc
+ * instances of the bundled DSP scripts (share/scripts).
+ *
+ * The first instance of a script compiles it, later instances load the
+ * cached bytecode into a pool that is sized from the high-water-mark
+ * of the first one.
+ *
+ * Usage: lua_dsp [instances-per-script [samples-per-cycle]]
+ */
+
+static const char* localedir = LOCALEDIR;
+
+typedef vector<boost::shared_ptr<LuaProc> > LuaProcList;
+
+static double
+run (LuaProcList& procs, pframes_t nframes)
+{
+	const int n_cycles = 100;
+
+	BufferSet bufs;
+	vector<ChanMapping> in_map;
+	vector<ChanMapping> out_map;
+
+	ChanCount max_chn (DataType::AUDIO, 2);
+	max_chn.set (DataType::MIDI, 1);
+
+	for (LuaProcList::iterator p = procs.begin (); p != procs.end (); ++p) {
+		ChanCount in (DataType::AUDIO, 2);
+		ChanCount aux;
+		ChanCount out;
+		in.set (DataType::MIDI, 1);
+		(*p)->match_variable_io (in, aux, out);
+		(*p)->reconfigure_io (in, aux, out);
+		in_map.push_back (ChanMapping (in));
+		out_map.push_back (ChanMapping (out));
+		max_chn = ChanCount::max (max_chn, ChanCount::max (in, out));
+	}
+
+	bufs.ensure_buffers (max_chn, nframes);
+	bufs.set_count (max_chn);
+
+	int64_t start = g_get_monotonic_time ();
+	for (int c = 0; c < n_cycles; ++c) {
+		for (size_t i = 0; i < procs.size (); ++i) {
+			samplepos_t pos = c * nframes;
+			procs[i]->connect_and_run (bufs, pos, pos + nframes, 1.0, in_map[i], out_map[i], nframes, 0);
+		}
+	}
+	return (g_get_monotonic_time () - start) / (double) n_cycles;
+}
+
+int
+main (int argc, char* argv[])
+{
+	int       n_instances = argc > 1 ? atoi (argv[1]) : 100;
+	pframes_t nframes     = argc > 2 ? atoi (argv[2]) : 256;
+
+	if (n_instances < 2 || nframes == 0) {
+		cerr << "Usage: " << argv[0] << " [instances-per-script [samples-per-cycle]]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	ARDOUR::init (false, true, localedir);
+	create_and_start_dummy_backend ();
+
+	Session* session = load_session ("../libs/ardour/test/profiling/sessions/1region", "1region");
+	SessionEvent::create_per_thread_pool ("lua_dsp", 512);
+
+	LuaScriptList& scripts (LuaScripting::instance ().scripts (LuaScriptInfo::DSP));
+	if (scripts.empty ()) {
+		cerr << "No Lua DSP scripts found, check ARDOUR_DATA_PATH\n";
+		exit (EXIT_FAILURE);
+	}
+
+	cout << n_instances << " instances per script, " << nframes << " samples/cycle\n"
+	     << setw (28) << left << "script" << right
+	     << "  first [ms]  next [ms]  pool [kB]  peak [kB]  run [us]\n";
+
+	for (LuaScriptList::const_iterator s = scripts.begin (); s != scripts.end (); ++s) {
+		string script;
+		try {
+			script = Glib::file_get_contents ((*s)->path);
+		} catch (Glib::FileError const&) {
+			continue;
+		}
+
+		LuaProcList procs;
+		int64_t t0 = g_get_monotonic_time ();
+		int64_t t1 = t0;
+
+		try {
+			for (int i = 0; i < n_instances; ++i) {
+				procs.push_back (boost::shared_ptr<LuaProc> (new LuaProc (session->engine (), *session, script)));
+				if (i == 0) {
+					t1 = g_get_monotonic_time ();
+				}
+			}
+		} catch (failed_constructor&) {
+			cout << setw (28) << left << (*s)->name << right << "  failed to instantiate\n";
+			continue;
+		}
+		int64_t t2 = g_get_monotonic_time ();
+
+		double t_run = run (procs, nframes);
+
+		size_t used, peak, size;
+		size_t max_peak = 0;
+		for (LuaProcList::const_iterator p = procs.begin (); p != procs.end (); ++p) {
+			(*p)->arena_usage (used, peak, size);
+			max_peak = max (max_peak, peak);
+		}
+
+		cout << setw (28) << left << (*s)->name.substr (0, 28) << right
+		     << fixed << setprecision (2)
+		     << setw (12) << (t1 - t0) / 1e3
+		     << setw (11) << (t2 - t1) / (1e3 * (n_instances - 1))
+		     << setprecision (0)
+		     << setw (11) << size / 1024.
+		     << setw (11) << max_peak / 1024.
+		     << setprecision (1)
+		     << setw (10) << t_run << "\n";
+
+		for (LuaProcList::iterator p = procs.begin (); p != procs.end (); ++p) {
+			(*p)->drop_references ();
+		}
+	}
+
+	AudioEngine::instance ()->remove_session ();
+	delete session;
+	stop_and_destroy_backend ();
+	ARDOUR::cleanup ();
+	return 0;
+}
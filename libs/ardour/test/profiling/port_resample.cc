@@ -0,0 +1,186 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <glib.h>
+#include <boost/bind.hpp>
+
+#include "zita-resampler/vmresampler.h"
+
+#include "pbd/cpus.h"
+
+#include "ardour/ardour.h"
+#include "ardour/port.h"
+#include "ardour/rt_tasklist.h"
+
+using namespace std;
+using namespace ARDOUR;
+
+/* Cycle time of vari-speed port resampling against the number of ports,
+ * processed in sequence and in parallel batches on an RTTaskList,
+ * the same way as PortManager::cycle_start / cycle_end do.
+ *
+ * Every simulated port is an externally connected audio input and
+ * output (one resampler for each direction), see AudioPort.
+ *
+ * Usage: port_resample [speed [samples-per-cycle]]
+ */
+
+static const char* localedir = LOCALEDIR;
+
+struct SimPort {
+	SimPort (pframes_t max_cycle)
+		: data (max_cycle)
+		, engine_in (max_cycle)
+		, engine_out (max_cycle)
+	{
+		src_in.setup (Port::resampler_quality ());
+		src_in.set_rrfilt (10);
+		src_out.setup (Port::resampler_quality ());
+		src_out.set_rrfilt (10);
+		for (size_t i = 0; i < engine_in.size (); ++i) {
+			engine_in[i] = sinf (i * .01f);
+		}
+	}
+
+	static void resample (ArdourZita::VMResampler& src, float* in, pframes_t n_in, float* out, pframes_t n_out)
+	{
+		src.inp_data  = in;
+		src.inp_count = n_in;
+		src.out_count = n_out;
+		src.set_rratio (n_out / (double)n_in);
+		src.out_data  = out;
+		src.process ();
+		while (src.out_count > 0) {
+			*src.out_data = src.out_data[-1];
+			++src.out_data;
+			--src.out_count;
+		}
+	}
+
+	void cycle_start (pframes_t nframes, pframes_t cycle_nframes) {
+		resample (src_in, &engine_in[0], nframes, &data[0], cycle_nframes);
+	}
+
+	void cycle_end (pframes_t nframes, pframes_t cycle_nframes) {
+		resample (src_out, &data[0], cycle_nframes, &engine_out[0], nframes);
+	}
+
+	vector<float>           data;
+	vector<float>           engine_in;
+	vector<float>           engine_out;
+	ArdourZita::VMResampler src_in;
+	ArdourZita::VMResampler src_out;
+};
+
+class SimPortManager {
+public:
+	SimPortManager (size_t n_ports, pframes_t max_cycle)
+		: _nframes (0)
+		, _cycle_nframes (0)
+	{
+		for (size_t i = 0; i < n_ports; ++i) {
+			_ports.push_back (new SimPort (max_cycle));
+		}
+		const size_t n_batches = max<uint32_t> (1, hardware_concurrency ());
+		for (size_t b = 0; b < n_batches; ++b) {
+			_start_batches.push_back (boost::bind (&SimPortManager::cycle_start_batch, this, b));
+			_end_batches.push_back (boost::bind (&SimPortManager::cycle_end_batch, this, b));
+		}
+	}
+
+	~SimPortManager () {
+		for (vector<SimPort*>::iterator p = _ports.begin (); p != _ports.end (); ++p) {
+			delete *p;
+		}
+	}
+
+	void cycle (pframes_t nframes, pframes_t cycle_nframes, RTTaskList* tl) {
+		_nframes       = nframes;
+		_cycle_nframes = cycle_nframes;
+		if (tl) {
+			tl->process (_start_batches);
+			tl->process (_end_batches);
+		} else {
+			for (vector<SimPort*>::iterator p = _ports.begin (); p != _ports.end (); ++p) {
+				(*p)->cycle_start (_nframes, _cycle_nframes);
+			}
+			for (vector<SimPort*>::iterator p = _ports.begin (); p != _ports.end (); ++p) {
+				(*p)->cycle_end (_nframes, _cycle_nframes);
+			}
+		}
+	}
+
+private:
+	void cycle_start_batch (size_t batch) {
+		for (size_t i = batch; i < _ports.size (); i += _start_batches.size ()) {
+			_ports[i]->cycle_start (_nframes, _cycle_nframes);
+		}
+	}
+
+	void cycle_end_batch (size_t batch) {
+		for (size_t i = batch; i < _ports.size (); i += _end_batches.size ()) {
+			_ports[i]->cycle_end (_nframes, _cycle_nframes);
+		}
+	}
+
+	vector<SimPort*>     _ports;
+	RTTaskList::TaskList _start_batches;
+	RTTaskList::TaskList _end_batches;
+	pframes_t            _nframes;
+	pframes_t            _cycle_nframes;
+};
+
+static double
+bench (size_t n_ports, pframes_t nframes, double speed, RTTaskList* tl)
+{
+	const pframes_t cycle_nframes = floor (nframes * speed);
+	const int n_cycles = 2000;
+
+	SimPortManager pm (n_ports, cycle_nframes + 1);
+
+	for (int i = 0; i < 100; ++i) {
+		pm.cycle (nframes, cycle_nframes, tl);
+	}
+
+	int64_t start = g_get_monotonic_time ();
+	for (int i = 0; i < n_cycles; ++i) {
+		pm.cycle (nframes, cycle_nframes, tl);
+	}
+	return (g_get_monotonic_time () - start) / (double) n_cycles;
+}
+
+int
+main (int argc, char* argv[])
+{
+	double    speed   = argc > 1 ? atof (argv[1]) : 1.5;
+	pframes_t nframes = argc > 2 ? atoi (argv[2]) : 256;
+
+	if (speed <= 0 || nframes == 0) {
+		cerr << "Usage: " << argv[0] << " [speed [samples-per-cycle]]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	ARDOUR::init (false, true, localedir);
+
+	RTTaskList tl;
+
+	cout << "speed " << speed << ", " << nframes << " samples/cycle, "
+	     << tl.n_threads () << " worker threads\n"
+	     << " ports   serial [us]  parallel [us]\n";
+
+	for (size_t n_ports = 8; n_ports <= 512; n_ports *= 2) {
+		double t_serial   = bench (n_ports, nframes, speed, 0);
+		double t_parallel = bench (n_ports, nframes, speed, &tl);
+		cout << setw (6) << n_ports
+		     << fixed << setprecision (1)
+		     << setw (13) << t_serial
+		     << setw (15) << t_parallel
+		     << "  (" << setprecision (2) << t_serial / t_parallel << "x)\n";
+	}
+
+	ARDOUR::cleanup ();
+	return 0;
+}
@@ -0,0 +1,92 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include <glib.h>
+
+#include "pbd/signals.h"
+
+using namespace std;
+
+/* Cost of emitting a PBD::Signal (same-thread slots) as the number of
+ * connected slots grows. Prints the time per emission, and per slot.
+ */
+
+static int64_t counter = 0;
+
+static void
+receiver0 ()
+{
+	++counter;
+}
+
+static void
+receiver1 (int v)
+{
+	counter += v;
+}
+
+template<typename S, typename F, typename E>
+static void
+bench (char const* name, size_t n_slots, int n_emit, F slot, E emit)
+{
+	S signal;
+	PBD::ScopedConnectionList connections;
+
+	for (size_t i = 0; i < n_slots; ++i) {
+		signal.connect_same_thread (connections, slot);
+	}
+
+	/* warm up */
+	for (int i = 0; i < 1000; ++i) {
+		emit (signal);
+	}
+
+	counter = 0;
+	int64_t start = g_get_monotonic_time ();
+	for (int i = 0; i < n_emit; ++i) {
+		emit (signal);
+	}
+	int64_t elapsed = g_get_monotonic_time () - start;
+
+	if (counter != (int64_t) (n_slots * n_emit)) {
+		cerr << "ERROR: " << name << " called " << counter << " slots, expected " << n_slots * n_emit << "\n";
+		exit (EXIT_FAILURE);
+	}
+
+	double ns_per_emit = 1000. * elapsed / n_emit;
+	cout << setw (8) << name
+	     << setw (6) << n_slots << " slots: "
+	     << setw (10) << fixed << setprecision (1) << ns_per_emit << " ns/emit";
+	if (n_slots > 0) {
+		cout << setw (10) << fixed << setprecision (1) << ns_per_emit / n_slots << " ns/slot";
+	}
+	cout << "\n";
+}
+
+static void emit0 (PBD::Signal0<void>& s) { s (); }
+static void emit1 (PBD::Signal1<void, int>& s) { s (1); }
+
+int
+main (int argc, char* argv[])
+{
+	int n_emit = 200000;
+	if (argc > 1) {
+		n_emit = atoi (argv[1]);
+	}
+	if (n_emit <= 0) {
+		cerr << argv[0] << ": [emissions]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	size_t const n_slots[] = { 0, 1, 4, 16, 64, 256 };
+
+	for (size_t i = 0; i < sizeof (n_slots) / sizeof (n_slots[0]); ++i) {
+		bench<PBD::Signal0<void> > ("Signal0", n_slots[i], n_emit, &receiver0, &emit0);
+	}
+	for (size_t i = 0; i < sizeof (n_slots) / sizeof (n_slots[0]); ++i) {
+		bench<PBD::Signal1<void, int> > ("Signal1", n_slots[i], n_emit, &receiver1, &emit1);
+	}
+
+	return 0;
+}
@@ -0,0 +1,199 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstdio>
+#include <list>
+#include <vector>
+
+#include <glib.h>
+#include <glibmm/fileutils.h>
+#include <glibmm/miscutils.h>
+
+#include "pbd/file_utils.h"
+
+#include "temporal/beats.h"
+
+#include "evoral/Event.h"
+#include "evoral/SMF.h"
+#include "evoral/SMFMap.h"
+
+using namespace std;
+
+/* Time to read all events of Standard MIDI Files, as done when loading
+ * a MidiModel: with libsmf (Evoral::SMF::read_event, one Evoral::Event
+ * allocated per event, then sorted), and in place from a memory-mapped
+ * file (Evoral::SMFMap::read_events).
+ *
+ * Without arguments a large type 1 file is generated, half the tracks
+ * use running status.
+ */
+
+typedef Evoral::Event<Temporal::Beats> BeatsEvent;
+
+static bool
+compare_events (BeatsEvent const* a, BeatsEvent const* b)
+{
+	return a->time () < b->time ();
+}
+
+static void
+put_be32 (vector<uint8_t>& d, uint32_t v)
+{
+	d.push_back (v >> 24); d.push_back (v >> 16); d.push_back (v >> 8); d.push_back (v);
+}
+
+static string
+generate_smf (int n_tracks, int n_notes)
+{
+	vector<uint8_t> d;
+	const uint8_t header[] = { 'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 1 };
+	d.insert (d.end (), header, header + sizeof (header));
+	d.push_back (n_tracks >> 8); d.push_back (n_tracks);
+	d.push_back (1920 >> 8); d.push_back (1920 & 0xff);
+
+	srand (0);
+
+	for (int t = 0; t < n_tracks; ++t) {
+		vector<uint8_t> trk;
+		const bool running = t & 1;
+		const uint8_t chn = t & 0xf;
+		for (int n = 0; n < n_notes; ++n) {
+			const uint8_t note = 24 + rand () % 72;
+			/* note on, delta 120 ticks */
+			trk.push_back (0x80 | 0); trk.push_back (120);
+			if (!running || n == 0) {
+				trk.push_back (0x90 | chn);
+			}
+			trk.push_back (note); trk.push_back (1 + rand () % 126);
+			/* note off as note on with velocity 0, delta 240 ticks */
+			trk.push_back (0x81); trk.push_back (0x70);
+			if (!running) {
+				trk.push_back (0x90 | chn);
+			}
+			trk.push_back (note); trk.push_back (0);
+		}
+		const uint8_t eot[] = { 0x00, 0xff, 0x2f, 0x00 };
+		trk.insert (trk.end (), eot, eot + sizeof (eot));
+
+		const uint8_t mtrk[] = { 'M', 'T', 'r', 'k' };
+		d.insert (d.end (), mtrk, mtrk + 4);
+		put_be32 (d, trk.size ());
+		d.insert (d.end (), trk.begin (), trk.end ());
+	}
+
+	string dir  = PBD::tmp_writable_directory (PACKAGE, "smf_load");
+	string path = Glib::build_filename (dir, "large.mid");
+	Glib::file_set_contents (path, (const char*) &d[0], d.size ());
+	return path;
+}
+
+static size_t
+load_libsmf (string const& path)
+{
+	Evoral::SMF smf;
+	if (smf.open (path)) {
+		cerr << "ERROR: cannot open " << path << "\n";
+		exit (EXIT_FAILURE);
+	}
+
+	list<BeatsEvent*> events;
+
+	uint32_t delta_t = 0;
+	uint32_t size    = 0;
+	uint8_t* buf     = NULL;
+	Evoral::event_id_t id;
+
+	for (uint16_t t = 1; t <= smf.num_tracks (); ++t) {
+		if (smf.seek_to_track (t)) {
+			continue;
+		}
+		uint64_t time = 0;
+		int ret;
+		while ((ret = smf.read_event (&delta_t, &size, &buf, &id)) >= 0) {
+			time += delta_t;
+			if (ret > 0) {
+				events.push_back (new BeatsEvent (Evoral::MIDI_EVENT, Temporal::Beats::ticks_at_rate (time, smf.ppqn ()), size, buf, true));
+			}
+		}
+	}
+	free (buf);
+
+	events.sort (compare_events);
+
+	size_t n = events.size ();
+	for (list<BeatsEvent*>::iterator i = events.begin (); i != events.end (); ++i) {
+		delete *i;
+	}
+	return n;
+}
+
+static size_t
+load_mapped (string const& path)
+{
+	Evoral::SMFMap map;
+	if (map.open (path)) {
+		cerr << "ERROR: cannot map " << path << "\n";
+		exit (EXIT_FAILURE);
+	}
+
+	vector<Evoral::SMFMap::Event> events;
+	vector<uint8_t> scratch;
+	map.read_events (events, scratch);
+
+	/* what SMFSource::load_model_mapped passes to the model */
+	BeatsEvent ev (Evoral::MIDI_EVENT);
+	uint64_t sum = 0;
+	for (vector<Evoral::SMFMap::Event>::const_iterator i = events.begin (); i != events.end (); ++i) {
+		ev.set_buffer (i->size, const_cast<uint8_t*> (i->buffer), false);
+		ev.set_time (Temporal::Beats::ticks_at_rate (i->time, map.ppqn ()));
+		sum += ev.buffer ()[0];
+	}
+	ev.set_buffer (0, NULL, false);
+
+	return sum > 0 ? events.size () : 0;
+}
+
+template<typename F>
+static double
+bench (F load, string const& path, int n_iter, size_t& n_events)
+{
+	n_events = load (path); /* warm up, page cache */
+	int64_t start = g_get_monotonic_time ();
+	for (int i = 0; i < n_iter; ++i) {
+		load (path);
+	}
+	return (g_get_monotonic_time () - start) / (1000. * n_iter);
+}
+
+int
+main (int argc, char* argv[])
+{
+	vector<string> files;
+	for (int i = 1; i < argc; ++i) {
+		files.push_back (argv[i]);
+	}
+	if (files.empty ()) {
+		files.push_back (generate_smf (32, 20000));
+	}
+
+	const int n_iter = 5;
+
+	for (vector<string>::const_iterator f = files.begin (); f != files.end (); ++f) {
+		size_t n_smf;
+		size_t n_map;
+		double t_smf = bench (&load_libsmf, *f, n_iter, n_smf);
+		double t_map = bench (&load_mapped, *f, n_iter, n_map);
+
+		if (n_smf != n_map) {
+			cerr << "ERROR: " << *f << ": libsmf read " << n_smf << " events, mapped " << n_map << "\n";
+			exit (EXIT_FAILURE);
+		}
+
+		cout << Glib::path_get_basename (*f) << ": " << n_smf << " events\n"
+		     << "  libsmf: " << setw (9) << fixed << setprecision (2) << t_smf << " ms\n"
+		     << "  mapped: " << setw (9) << fixed << setprecision (2) << t_map << " ms"
+		     << "  (" << setprecision (1) << t_smf / t_map << "x)\n";
+	}
+
+	return 0;
+}
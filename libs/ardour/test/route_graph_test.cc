@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <sstream>
+
+#include "ardour/route.h"
+#include "ardour/route_graph.h"
+
+#include "route_graph_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (RouteGraphTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+static boost::shared_ptr<RouteList>
+create_routes (Session& s, int n)
+{
+	boost::shared_ptr<RouteList> rl (new RouteList);
+	for (int i = 0; i < n; ++i) {
+		stringstream ss;
+		ss << "bus" << i;
+		boost::shared_ptr<Route> r (new Route (s, ss.str (), PresentationInfo::AudioBus, DataType::AUDIO));
+		CPPUNIT_ASSERT (r->init () == 0);
+		rl->push_back (r);
+	}
+	return rl;
+}
+
+static int
+position (boost::shared_ptr<RouteList> rl, GraphVertex v)
+{
+	return distance (rl->begin (), find (rl->begin (), rl->end (), v));
+}
+
+static void
+check_order (boost::shared_ptr<RouteList> rl, vector<GraphVertex> const& r, vector<pair<int, int> > const& edges)
+{
+	CPPUNIT_ASSERT_EQUAL (r.size (), rl->size ());
+	for (vector<pair<int, int> >::const_iterator e = edges.begin (); e != edges.end (); ++e) {
+		CPPUNIT_ASSERT (position (rl, r[e->first]) < position (rl, r[e->second]));
+	}
+}
+
+void
+RouteGraphTest::edgesTest ()
+{
+	boost::shared_ptr<RouteList> rl = create_routes (*_session, 3);
+	vector<GraphVertex> r (rl->begin (), rl->end ());
+
+	GraphEdges a;
+	GraphEdges b;
+	CPPUNIT_ASSERT (a == b);
+
+	a.add (r[0], r[1], false);
+	a.add (r[1], r[2], true);
+	CPPUNIT_ASSERT (a != b);
+
+	b.add (r[1], r[2], true);
+	b.add (r[0], r[1], false);
+	CPPUNIT_ASSERT (a == b);
+
+	/* same connections, but not via sends only */
+	b.add (r[1], r[2], false);
+	CPPUNIT_ASSERT (a != b);
+
+	b.remove (r[1], r[2]);
+	CPPUNIT_ASSERT (a != b);
+}
+
+void
+RouteGraphTest::incrementalTest ()
+{
+	boost::shared_ptr<RouteList> rl = create_routes (*_session, 8);
+	vector<GraphVertex> r (rl->begin (), rl->end ());
+
+	vector<pair<int, int> > e;
+	e.push_back (make_pair (0, 4));
+	e.push_back (make_pair (1, 4));
+	e.push_back (make_pair (4, 6));
+	e.push_back (make_pair (2, 7));
+
+	GraphEdges edges;
+	for (vector<pair<int, int> >::const_iterator i = e.begin (); i != e.end (); ++i) {
+		edges.add (r[i->first], r[i->second], false);
+	}
+
+	/* the current order is valid, nothing is moved */
+	boost::shared_ptr<RouteList> sorted = incremental_topological_sort (rl, edges);
+	CPPUNIT_ASSERT (sorted);
+	CPPUNIT_ASSERT (*sorted == *rl);
+
+	/* new connections against the current order */
+	e.push_back (make_pair (6, 1));
+	e.push_back (make_pair (5, 0));
+	edges.add (r[6], r[1], false);
+	edges.add (r[5], r[0], true);
+
+	sorted = incremental_topological_sort (rl, edges);
+	CPPUNIT_ASSERT (sorted);
+	check_order (sorted, r, e);
+
+	/* routes that are not affected keep their relative order */
+	CPPUNIT_ASSERT (position (sorted, r[2]) < position (sorted, r[3]));
+	CPPUNIT_ASSERT (position (sorted, r[3]) < position (sorted, r[7]));
+
+	/* same result as a complete sort */
+	boost::shared_ptr<RouteList> full = topological_sort (rl, edges);
+	CPPUNIT_ASSERT (full);
+	check_order (full, r, e);
+}
+
+void
+RouteGraphTest::feedbackTest ()
+{
+	boost::shared_ptr<RouteList> rl = create_routes (*_session, 4);
+	vector<GraphVertex> r (rl->begin (), rl->end ());
+
+	GraphEdges edges;
+	edges.add (r[0], r[1], false);
+	edges.add (r[1], r[2], false);
+	CPPUNIT_ASSERT (incremental_topological_sort (rl, edges));
+
+	edges.add (r[2], r[0], false);
+	CPPUNIT_ASSERT (!incremental_topological_sort (rl, edges));
+	CPPUNIT_ASSERT (!topological_sort (rl, edges));
+}
@@ -0,0 +1,15 @@
+#include "test_needing_session.h"
+
+class RouteGraphTest : public TestNeedingSession
+{
+	CPPUNIT_TEST_SUITE (RouteGraphTest);
+	CPPUNIT_TEST (edgesTest);
+	CPPUNIT_TEST (incrementalTest);
+	CPPUNIT_TEST (feedbackTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void edgesTest ();
+	void incrementalTest ();
+	void feedbackTest ();
+};
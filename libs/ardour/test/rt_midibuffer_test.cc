@@ -0,0 +1,169 @@
+#include "evoral/EventList.h"
+
+#include "ardour/midi_buffer.h"
+#include "ardour/midi_state_tracker.h"
+#include "ardour/rt_midibuffer.h"
+
+#include "rt_midibuffer_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (RTMidiBufferTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+static void
+write_note (RTMidiBuffer& rtm, samplepos_t on, samplepos_t off, uint8_t note)
+{
+	uint8_t buf[3] = { 0x90, note, 0x40 };
+	rtm.write (on, Evoral::MIDI_EVENT, 3, buf);
+	buf[0] = 0x80;
+	rtm.write (off, Evoral::MIDI_EVENT, 3, buf);
+}
+
+static void
+read_all (RTMidiBuffer& rtm, vector<samplepos_t>& times, vector<uint8_t>& notes)
+{
+	MidiBuffer buf (1024);
+	MidiStateTracker tracker;
+
+	rtm.read (buf, 0, 100000, tracker);
+
+	for (MidiBuffer::iterator i = buf.begin (); i != buf.end (); ++i) {
+		times.push_back ((*i).time ());
+		notes.push_back ((*i).buffer ()[1]);
+	}
+}
+
+void
+RTMidiBufferTest::spliceTest ()
+{
+	RTMidiBuffer rtm;
+
+	write_note (rtm, 0, 100, 60);
+	write_note (rtm, 200, 300, 62);
+	write_note (rtm, 400, 500, 64);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 6, rtm.size ());
+
+	/* replace the 2nd note with two notes */
+	Evoral::EventList<samplepos_t> evl;
+	uint8_t on[3]  = { 0x90, 70, 0x40 };
+	uint8_t off[3] = { 0x80, 70, 0x40 };
+	evl.write (150, Evoral::MIDI_EVENT, 3, on);
+	evl.write (250, Evoral::MIDI_EVENT, 3, off);
+	on[1] = off[1] = 72;
+	evl.write (260, Evoral::MIDI_EVENT, 3, on);
+	evl.write (350, Evoral::MIDI_EVENT, 3, off);
+
+	rtm.splice (150, 350, evl);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 8, rtm.size ());
+
+	vector<samplepos_t> times;
+	vector<uint8_t>     notes;
+	read_all (rtm, times, notes);
+
+	samplepos_t const expected_times[] = { 0, 100, 150, 250, 260, 350, 400, 500 };
+	uint8_t const     expected_notes[] = { 60, 60, 70, 70, 72, 72, 64, 64 };
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 8, times.size ());
+	for (size_t i = 0; i < 8; ++i) {
+		CPPUNIT_ASSERT_EQUAL (expected_times[i], times[i]);
+		CPPUNIT_ASSERT_EQUAL (expected_notes[i], notes[i]);
+	}
+
+	/* remove everything from the first note-off to the last note-on (inclusive) */
+	Evoral::EventList<samplepos_t> empty;
+	rtm.splice (100, 400, empty);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 2, rtm.size ());
+
+	for (Evoral::EventList<samplepos_t>::iterator e = evl.begin (); e != evl.end (); ++e) {
+		delete *e;
+	}
+}
+
+void
+RTMidiBufferTest::spliceSysExTest ()
+{
+	RTMidiBuffer rtm;
+
+	uint8_t sysex[6] = { 0xf0, 0x7e, 0x7f, 0x09, 0x01, 0xf7 };
+
+	for (int i = 0; i < 64; ++i) {
+		sysex[4] = i;
+		rtm.write (i * 10, Evoral::MIDI_EVENT, sizeof (sysex), sysex);
+	}
+
+	/* repeatedly replace the middle, until the pool is compacted */
+	for (int n = 0; n < 16; ++n) {
+		Evoral::EventList<samplepos_t> evl;
+		for (int i = 16; i < 48; ++i) {
+			sysex[4] = i;
+			evl.write (i * 10, Evoral::MIDI_EVENT, sizeof (sysex), sysex);
+		}
+		rtm.splice (160, 470, evl);
+		for (Evoral::EventList<samplepos_t>::iterator e = evl.begin (); e != evl.end (); ++e) {
+			delete *e;
+		}
+	}
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 64, rtm.size ());
+
+	MidiBuffer buf (4096);
+	MidiStateTracker tracker;
+	rtm.read (buf, 0, 1000, tracker);
+
+	int i = 0;
+	for (MidiBuffer::iterator e = buf.begin (); e != buf.end (); ++e, ++i) {
+		CPPUNIT_ASSERT_EQUAL ((samplepos_t) (i * 10), (samplepos_t) (*e).time ());
+		CPPUNIT_ASSERT_EQUAL ((uint32_t) sizeof (sysex), (*e).size ());
+		CPPUNIT_ASSERT_EQUAL ((uint8_t) i, (*e).buffer ()[4]);
+	}
+	CPPUNIT_ASSERT_EQUAL (64, i);
+}
+
+void
+RTMidiBufferTest::blobOffsetLimitTest ()
+{
+	RTMidiBuffer rtm;
+
+	/* 1 MiB SysEx messages: blob offsets are limited to 24 bits, so
+	 * only 16 fit into the pool
+	 */
+	vector<uint8_t> sysex (1 << 20, 0x01);
+	sysex.front () = 0xf0;
+	sysex.back () = 0xf7;
+
+	uint32_t written = 0;
+	for (int i = 0; i < 20; ++i) {
+		sysex[1] = i;
+		if (rtm.write (i * 10, Evoral::MIDI_EVENT, sysex.size (), &sysex[0])) {
+			++written;
+		}
+	}
+
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 16, written);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 16, rtm.size ());
+
+	/* replacing the events reclaims the spliced-out blobs */
+	Evoral::EventList<samplepos_t> evl;
+	for (int i = 4; i < 8; ++i) {
+		sysex[1] = 100 + i;
+		evl.write (i * 10, Evoral::MIDI_EVENT, sysex.size (), &sysex[0]);
+	}
+	rtm.splice (40, 70, evl);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 16, rtm.size ());
+
+	for (Evoral::EventList<samplepos_t>::iterator e = evl.begin (); e != evl.end (); ++e) {
+		delete *e;
+	}
+
+	MidiBuffer buf (32 << 20);
+	MidiStateTracker tracker;
+	rtm.read (buf, 0, 1000, tracker);
+
+	int i = 0;
+	for (MidiBuffer::iterator e = buf.begin (); e != buf.end (); ++e, ++i) {
+		CPPUNIT_ASSERT_EQUAL ((samplepos_t) (i * 10), (samplepos_t) (*e).time ());
+		CPPUNIT_ASSERT_EQUAL ((uint8_t) ((i >= 4 && i < 8) ? 100 + i : i), (*e).buffer ()[1]);
+	}
+	CPPUNIT_ASSERT_EQUAL (16, i);
+}
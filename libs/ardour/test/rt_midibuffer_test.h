@@ -0,0 +1,16 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class RTMidiBufferTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (RTMidiBufferTest);
+	CPPUNIT_TEST (spliceTest);
+	CPPUNIT_TEST (spliceSysExTest);
+	CPPUNIT_TEST (blobOffsetLimitTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void spliceTest ();
+	void spliceSysExTest ();
+	void blobOffsetLimitTest ();
+};
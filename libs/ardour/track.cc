@@ -499,6 +499,12 @@ Track::do_refill ()
 	return _disk_reader->do_refill ();
 }
 
+int
+Track::refill_cues ()
+{
+	return _disk_reader->refill_cues ();
+}
+
 int
 Track::do_flush (RunContext c, bool force)
 {
@@ -460,7 +460,11 @@ tresult
 Vst3ParamValueQueue::addPoint (int32 sampleOffset, Vst::ParamValue value, int32& index)
 {
 	int32 dest_index = (int32)_values.size ();
-	for (uint32 i = 0; i < _values.size (); ++i) {
+
+	/* automation events are queued in order, skip the search */
+	const bool append = _values.empty () || _values.back ().sampleOffset < sampleOffset;
+
+	for (uint32 i = 0; !append && i < _values.size (); ++i) {
 		if (_values[i].sampleOffset == sampleOffset) {
 			_values[i].value = value;
 			index = i;
@@ -471,6 +475,18 @@ Vst3ParamValueQueue::addPoint (int32 sampleOffset, Vst::ParamValue value, int32&
 		}
 	}
 
+	if (_values.size () >= (size_t) maxNumPoints) {
+		/* do not allocate in the process thread,
+		 * replace the last point, if this one is later.
+		 */
+		if (dest_index < (int32)_values.size ()) {
+			return kResultFalse;
+		}
+		index = dest_index - 1;
+		_values[index] = Value (value, sampleOffset);
+		return kResultTrue;
+	}
+
 	Value v (value, sampleOffset);
 	if (dest_index == (int32)_values.size ()) {
 		_values.push_back (v);
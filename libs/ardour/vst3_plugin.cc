@@ -565,6 +565,16 @@ VST3Plugin::plugin_latency () const
 	return _plug->plugin_latency ();
 }
 
+samplecnt_t
+VST3Plugin::plugin_tailtime () const
+{
+	const uint32_t tail = _plug->plugin_tailtime ();
+	if (tail == Vst::kInfiniteTail) {
+		return max_samplecnt;
+	}
+	return tail;
+}
+
 void
 VST3Plugin::add_slave (boost::shared_ptr<Plugin> p, bool rt)
 {
@@ -1514,6 +1524,13 @@ VST3PI::plugin_latency ()
 	return _plugin_latency.value ();
 }
 
+uint32_t
+VST3PI::plugin_tailtime ()
+{
+	/* the tail may depend on parameters (e.g. reverb size), do not cache it */
+	return _processor->getTailSamples ();
+}
+
 void
 VST3PI::set_owner (SessionObject* o)
 {
@@ -1111,6 +1111,54 @@ vstfx_free_info_list (vector<VSTInfo *> *infos)
 	delete infos;
 }
 
+static bool
+vstfx_infofile_is_current (const char* dllpath)
+{
+	GStatBuf dllstat;
+	GStatBuf fsistat;
+	string const path = vstfx_infofile_path (dllpath);
+	if (g_stat (dllpath, &dllstat) == 0 && g_stat (path.c_str (), &fsistat) == 0) {
+		/* cache file is not older than the plugin */
+		return dllstat.st_mtime <= fsistat.st_mtime;
+	}
+	return false;
+}
+
+bool
+vstfx_needs_scan (const char* dllpath)
+{
+	if (vst_is_blacklisted (dllpath)) {
+		return false;
+	}
+	return !vstfx_infofile_is_current (dllpath);
+}
+
+void
+vstfx_scan_completed (const char* dllpath)
+{
+	if (vstfx_infofile_is_current (dllpath) && vst_is_blacklisted (dllpath)) {
+		vstfx_un_blacklist (dllpath);
+	}
+}
+
+void
+vstfx_scan_aborted (const char* dllpath)
+{
+	/* remove info file (might be incomplete) */
+	vstfx_remove_infofile (dllpath);
+	/* remove temporary blacklist file (scan incomplete) */
+	vstfx_un_blacklist (dllpath);
+}
+
+void
+vstfx_scan_timed_out (const char* dllpath)
+{
+	/* remove info file (might be incomplete), the scanner
+	 * blacklisted the plugin before loading it.
+	 */
+	vstfx_remove_infofile (dllpath);
+}
+
 #ifdef LXVST_SUPPORT
 vector<VSTInfo *> *
 vstfx_get_info_lx (char* dllpath, enum VSTScanMode mode)
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2010-2011 Fons Adriaensen <fons@linuxaudio.org>
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef AUDIOGRAPHER_LOUDNESS_DSP_H
+#define AUDIOGRAPHER_LOUDNESS_DSP_H
+
+#include <vector>
+
+#include "audiographer/visibility.h"
+#include "audiographer/types.h"
+
+namespace AudioGrapher
+{
+
+/** EBU R128 loudness meter (ITU-R BS.1770).
+  *
+  * Momentary, short-term and integrated loudness and loudness range,
+  * after Fons Adriaensen's Ebu_r128_proc. The K-weighting filters of
+  * up to four channels run side by side, using SSE where available.
+  *
+  * Integrated loudness and range are updated once a second.
+  * Apart from init(), all methods are realtime safe.
+  */
+class LIBAUDIOGRAPHER_API LoudnessDsp
+{
+  public:
+	LoudnessDsp ();
+	~LoudnessDsp ();
+
+	/** Set the channel count and sample-rate, and reset the meter. Not RT safe.
+	  * Channels are weighted by position, in SMPTE order (L, R, C, LFE, Ls, Rs, ..),
+	  * the LFE is excluded. 4 channels are L, R, Ls, Rs, and 5 are L, R, C, Ls, Rs.
+	  */
+	void init (unsigned int channels, float sample_rate);
+
+	void reset ();
+	void integr_reset ();
+	void integr_start () { _integr = true; }
+	void integr_pause () { _integr = false; }
+
+	/** Process \a n_samples per channel of interleaved data */
+	void process (float const* data, samplecnt_t n_samples);
+	/** Process \a n_samples of non-interleaved data, one buffer per channel */
+	void process (float const* const* data, samplecnt_t n_samples);
+
+	unsigned int n_channels () const { return _nchan; }
+
+	float loudness_M () const     { return _loudness_M; }
+	float max_loudness_M () const { return _maxloudn_M; }
+	float loudness_S () const     { return _loudness_S; }
+	float max_loudness_S () const { return _maxloudn_S; }
+	float integrated () const     { return _integrated; }
+	float integ_thr () const      { return _integ_thr; }
+	float range_min () const      { return _range_min; }
+	float range_max () const      { return _range_max; }
+	float range_thr () const      { return _range_thr; }
+
+	float loudness_range () const { return _range_max - _range_min; }
+
+	/** Short-term loudness histogram, 0.1 LU bins, bin 700 is 0 LUFS */
+	int const* histogram_S () const { return _hist_S.bins (); }
+	int const* histogram_M () const { return _hist_M.bins (); }
+	int hist_S_count () const { return _hist_S.count (); }
+	int hist_M_count () const { return _hist_M.count (); }
+
+	static const int histogram_size = 751;
+
+  private:
+	class Histogram
+	{
+	  public:
+		Histogram ();
+		void reset ();
+		void addpoint (float v);
+		void calc_integ (float* vi, float* th) const;
+		void calc_range (float* v0, float* v1, float* th) const;
+		int const* bins () const { return _histc; }
+		int count () const { return _count; }
+
+	  private:
+		float integrate (int ind) const;
+
+		int _histc[histogram_size];
+		int _count;
+		int _error;
+
+		static float _bin_power[100];
+	};
+
+	struct Filter {
+		Filter () { reset (); }
+		void reset () { z1 = z2 = z3 = z4 = 0; }
+		float z1, z2, z3, z4;
+	};
+
+	void  run (samplecnt_t n_samples);
+	float addfrags (int nfrag) const;
+	void  detect_init (float fsamp);
+	float detect_process (samplecnt_t n_samples);
+	float detect_channel (unsigned int c, samplecnt_t n_samples);
+#if defined(__SSE__)
+	void  detect_channels_sse (unsigned int c, samplecnt_t n_samples, float* sj);
+#endif
+
+	bool         _integr;
+	unsigned int _nchan;
+	float        _fsamp;
+	int          _fragm;    // fragment size, 1/20 second
+	int          _frcnt;    // samples remaining in current fragment
+	float        _frpwr;    // power accumulated for current fragment
+	float        _power[64];
+	int          _wrind;
+	int          _div1;     // M period counter, 200 ms
+	int          _div2;     // S period counter, 1s
+	float        _loudness_M;
+	float        _maxloudn_M;
+	float        _loudness_S;
+	float        _maxloudn_S;
+	float        _integrated;
+	float        _integ_thr;
+	float        _range_min;
+	float        _range_max;
+	float        _range_thr;
+
+	float _a0, _a1, _a2;
+	float _b1, _b2;
+	float _c3, _c4;
+
+	std::vector<float const*> _ipp;
+	unsigned int              _stride;
+	std::vector<Filter>       _fst;
+	std::vector<float>        _chan_gain;
+
+	Histogram _hist_M;
+	Histogram _hist_S;
+};
+
+/** True-peak meter, 4x oversampling (ITU-R BS.1770 Annex 2).
+  *
+  * Interpolates using a 48 tap windowed sinc per phase, four outputs at
+  * a time using SSE where available.
+  */
+class LIBAUDIOGRAPHER_API TruePeakDsp
+{
+  public:
+	TruePeakDsp ();
+
+	/** Clear the history and the peak */
+	void reset ();
+
+	/** Process \a n_samples, every \a stride sample of \a data.
+	  * @return the linear true-peak of the given samples
+	  */
+	float process (float const* data, samplecnt_t n_samples, unsigned int stride = 1);
+
+	/** Linear true-peak since the last reset */
+	float peak () const { return _peak; }
+
+  private:
+	static const int taps  = 48;
+	static const int block = 256;
+
+	float _coeff[3][taps]; // phases 1/4, 2/4, 3/4, reversed
+	float _buf[taps - 1 + block];
+	float _peak;
+};
+
+} // namespace
+
+#endif // AUDIOGRAPHER_LOUDNESS_DSP_H
@@ -21,11 +21,10 @@
 
 #include <vector>
 
-#include <vamp-hostsdk/PluginLoader.h>
-
 #include "audiographer/visibility.h"
 #include "audiographer/sink.h"
 #include "audiographer/routines.h"
+#include "audiographer/general/loudness_dsp.h"
 #include "audiographer/utils/listed_source.h"
 
 namespace AudioGrapher
@@ -49,14 +48,14 @@ class LIBAUDIOGRAPHER_API LoudnessReader : public ListedSource<float>, public Si
 	using Sink<float>::process;
 
   protected:
-	Vamp::Plugin*              _ebur_plugin;
-	std::vector<Vamp::Plugin*> _dbtp_plugins;
+	LoudnessDsp              _ebur;
+	bool                     _use_ebur; // mono and stereo only
+	std::vector<TruePeakDsp> _dbtp;
 
 	float        _sample_rate;
 	unsigned int _channels;
 	samplecnt_t   _bufsize;
 	samplecnt_t   _pos;
-	float*       _bufs[2];
 };
 
 } // namespace
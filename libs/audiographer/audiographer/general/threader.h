@@ -1,9 +1,7 @@
 #ifndef AUDIOGRAPHER_THREADER_H
 #define AUDIOGRAPHER_THREADER_H
 
-#include <glibmm/threadpool.h>
-#include <glibmm/timeval.h>
-#include <sigc++/slot.h>
+#include <glibmm/threads.h>
 #include <boost/format.hpp>
 
 #include <glib.h>
@@ -14,6 +12,7 @@
 #include "audiographer/source.h"
 #include "audiographer/sink.h"
 #include "audiographer/exception.h"
+#include "audiographer/general/threader_pool.h"
 
 namespace AudioGrapher
 {
@@ -33,7 +32,7 @@ class /*LIBAUDIOGRAPHER_API*/ ThreaderException : public Exception
 
 /// Class for distributing processing across several threads
 template <typename T = DefaultSampleType>
-class /*LIBAUDIOGRAPHER_API*/ Threader : public Source<T>, public Sink<T>
+class /*LIBAUDIOGRAPHER_API*/ Threader : public Source<T>, public Sink<T>, private ThreaderPool::Job
 {
   private:
 	typedef std::vector<typename Source<T>::SinkPtr> OutputVec;
@@ -42,13 +41,11 @@ class /*LIBAUDIOGRAPHER_API*/ Threader : public Source<T>, public Sink<T>
 
 	/** Constructor
 	  * \n RT safe
-	  * \param thread_pool a thread pool from which all tasks are scheduled
-	  * \param wait_timeout_milliseconds maximum time allowed for threads to use in processing
+	  * \param thread_pool a thread pool which runs the outputs, it may be shared by several Threaders
 	  */
-	Threader (Glib::ThreadPool & thread_pool, long wait_timeout_milliseconds = 500)
+	Threader (ThreaderPool & thread_pool)
 	  : thread_pool (thread_pool)
-	  , readers (0)
-	  , wait_timeout (wait_timeout_milliseconds)
+	  , context (0)
 	{ }
 
 	virtual ~Threader () {}
@@ -65,63 +62,40 @@ class /*LIBAUDIOGRAPHER_API*/ Threader : public Source<T>, public Sink<T>
 		outputs.erase (new_end, outputs.end());
 	}
 
-	/// Processes context concurrently by scheduling each output separately to the given thread pool
+	/// Processes context concurrently by running each output separately in the given thread pool
 	void process (ProcessContext<T> const & c)
 	{
-		wait_mutex.lock();
-
 		exception.reset();
 
-		unsigned int outs = outputs.size();
-		g_atomic_int_add (&readers, outs);
-		for (unsigned int i = 0; i < outs; ++i) {
-			thread_pool.push (sigc::bind (sigc::mem_fun (this, &Threader::process_output), c, i));
-		}
+		context = &c;
+		thread_pool.run (*this, outputs.size());
+		context = 0;
 
-		wait();
+		if (exception) {
+			throw *exception;
+		}
 	}
 
 	using Sink<T>::process;
 
   private:
 
-	void wait()
-	{
-		while (g_atomic_int_get (&readers) != 0) {
-			gint64 end_time = g_get_monotonic_time () + (wait_timeout * G_TIME_SPAN_MILLISECOND);
-			wait_cond.wait_until(wait_mutex, end_time);
-		}
-
-		wait_mutex.unlock();
-
-		if (exception) {
-			throw *exception;
-		}
-	}
-
-	void process_output(ProcessContext<T> const & c, unsigned int output)
+	void run_task (unsigned int output)
 	{
 		try {
-			outputs[output]->process (c);
+			outputs[output]->process (*context);
 		} catch (std::exception const & e) {
 			// Only first exception will be passed on
 			exception_mutex.lock();
 			if(!exception) { exception.reset (new ThreaderException (*this, e)); }
 			exception_mutex.unlock();
 		}
-
-		if (g_atomic_int_dec_and_test (&readers)) {
-			wait_cond.signal();
-		}
 	}
 
 	OutputVec outputs;
 
-	Glib::ThreadPool & thread_pool;
-        Glib::Threads::Mutex wait_mutex;
-        Glib::Threads::Cond  wait_cond;
-	gint        readers;
-	long        wait_timeout;
+	ThreaderPool & thread_pool;
+	ProcessContext<T> const * context;
 
         Glib::Threads::Mutex exception_mutex;
 	boost::shared_ptr<ThreaderException> exception;
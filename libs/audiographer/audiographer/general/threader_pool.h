@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef AUDIOGRAPHER_THREADER_POOL_H
+#define AUDIOGRAPHER_THREADER_POOL_H
+
+#include <vector>
+
+#include <glib.h>
+#include <glibmm/threads.h>
+
+#include "audiographer/visibility.h"
+
+namespace AudioGrapher
+{
+
+/** Persistent worker threads, used by Threader to process its outputs.
+  *
+  * A job is split into a number of tasks, which are claimed by the
+  * workers and by the calling thread. Workers and the caller spin for
+  * a short while before blocking, so that consecutive chunks of an
+  * export do not have to wake up threads every time.
+  */
+class LIBAUDIOGRAPHER_API ThreaderPool
+{
+  public:
+	/// A set of tasks to run concurrently
+	class Job
+	{
+	  public:
+		virtual ~Job () {}
+		/// Runs task \a n of the job, must not throw
+		virtual void run_task (unsigned int n) = 0;
+	};
+
+	/** Constructor
+	  * \param n_threads total number of threads including the calling thread.
+	  * Worker threads are started when they are first needed.
+	  */
+	ThreaderPool (unsigned int n_threads);
+	~ThreaderPool ();
+
+	/** Runs tasks 0 .. \a n_tasks - 1 of \a job and returns when all of them have completed.
+	  * If the pool is busy (e.g. nested Threaders), all tasks are run by the calling thread.
+	  * \n RT safe, once the worker threads are running.
+	  */
+	void run (Job& job, unsigned int n_tasks);
+
+  private:
+	void start_threads ();
+	void worker ();
+	bool claim (unsigned int& task);
+	void task_done ();
+	bool have_work () const;
+
+	unsigned int                        _n_threads;
+	std::vector<Glib::Threads::Thread*> _threads;
+
+	gint _running; // atomic, set while a job is run, by any thread
+	Job* _job;
+	gint _tasks;   // atomic, number of tasks and next task to claim
+	gint _pending; // atomic, number of tasks that have not yet completed
+	gint _quit;    // atomic
+
+	gint                 _sleeping; // atomic, number of blocked workers
+	Glib::Threads::Mutex _wake_lock;
+	Glib::Threads::Cond  _wake_cond;
+
+	gint                 _caller_waiting; // atomic
+	Glib::Threads::Mutex _done_lock;
+	Glib::Threads::Cond  _done_cond;
+};
+
+} // namespace
+
+#endif //AUDIOGRAPHER_THREADER_POOL_H
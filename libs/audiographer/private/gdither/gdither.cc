@@ -20,6 +20,14 @@
 #include "gdither_types_internal.h"
 #include "gdither.h"
 
+/* gdither_runf_interleaved() produces the same output as gdither_runf(),
+ * only as long as the compiler does not re-associate floating point math */
+#if defined(__clang__)
+#pragma float_control(precise, on)
+#elif defined(__GNUC__)
+#pragma GCC optimize ("no-fast-math")
+#endif
+
 /* this monstrosity is necessary to get access to lrintf() and random().
    whoever is writing the glibc headers <cmath> and <cstdlib> should be
    hauled off to a programmer re-education camp. for the rest of
@@ -43,6 +51,7 @@
 #endif
 
 #include <assert.h>
+#include <string.h>
 #include <sys/types.h>
 
 /* Lipshitz's minimally audible FIR, only really works for 46kHz-ish signals */
@@ -61,14 +70,21 @@ static const float shaped_bs[] = { 2.033f, -2.165f, 1.959f, -1.590f, 0.6149f };
 #define MIN_S24  -8388608
 #define SCALE_S24 8388608.0f
 
-inline static float gdither_noise ()
+/* linear congruential generator, one state per channel */
+#define GDITHER_RND_A 196314165U
+#define GDITHER_RND_C 907633515U
+#define GDITHER_RND_SCALE 2.3283064365387e-10f
+
+inline static float gdither_noise (uint32_t *rnd)
 {
-	static uint32_t rnd = 23232323;
-	rnd = (rnd * 196314165) + 907633515;
+	*rnd = (*rnd * GDITHER_RND_A) + GDITHER_RND_C;
 
-	return rnd * 2.3283064365387e-10f;
+	return *rnd * GDITHER_RND_SCALE;
 }
 
+/* samples per channel processed at a time by gdither_runf_interleaved() */
+#define GDITHER_BLOCK 256
+
 GDither gdither_new(GDitherType type, uint32_t channels,
 
 		    GDitherSize bit_depth, int dither_depth)
@@ -141,6 +157,14 @@ GDither gdither_new(GDitherType type, uint32_t channels,
 	break;
     }
 
+    /* Independent noise for each channel, that does not depend on the order
+     * in which channels are processed */
+    s->rnd_state = (uint32_t *) calloc(channels, sizeof(uint32_t));
+    for (uint32_t c = 0; c < channels; ++c) {
+	s->rnd_state[c] = 23232323U + c * 2654435761U;
+    }
+    s->dither_buf = (float *) calloc(GDITHER_BLOCK * channels, sizeof(float));
+
     switch (type) {
     case GDitherNone:
     case GDitherRect:
@@ -167,6 +191,8 @@ void gdither_free(GDither s)
     if (s) {
 	free(s->tri_state);
 	free(s->shaped_state);
+	free(s->rnd_state);
+	free(s->dither_buf);
 	free(s);
     }
 }
@@ -179,7 +205,7 @@ inline static void gdither_innner_loop(const GDitherType dt,
 
     GDitherShapedState *ss, float const *x, void *y, const int clamp_u,
 
-    const int clamp_l)
+    const int clamp_l, uint32_t *rnd)
 {
     uint32_t pos, i;
     uint8_t *o8 = (uint8_t*) y;
@@ -196,10 +222,10 @@ inline static void gdither_innner_loop(const GDitherType dt,
 	case GDitherNone:
 	    break;
 	case GDitherRect:
-	    tmp -= gdither_noise ();
+	    tmp -= gdither_noise (rnd);
 	    break;
 	case GDitherTri:
-	    r = gdither_noise () - 0.5f;
+	    r = gdither_noise (rnd) - 0.5f;
 	    tmp -= r - ts[channel];
 	    ts[channel] = r;
 	    break;
@@ -209,7 +235,7 @@ inline static void gdither_innner_loop(const GDitherType dt,
 	    ideal = tmp;
 
 	    /* Run FIR and add white noise */
-	    ss->buffer[ss->phase] = gdither_noise () * 0.5f;
+	    ss->buffer[ss->phase] = gdither_noise (rnd) * 0.5f;
 	    tmp += ss->buffer[ss->phase] * shaped_bs[0]
 		   + ss->buffer[(ss->phase - 1) & GDITHER_SH_BUF_MASK]
 		     * shaped_bs[1]
@@ -256,7 +282,7 @@ inline static void gdither_innner_loop_fp(const GDitherType dt,
 
     GDitherShapedState *ss, float const *x, void *y, const int clamp_u,
 
-    const int clamp_l)
+    const int clamp_l, uint32_t *rnd)
 {
     uint32_t pos, i;
     float *oflt = (float*) y;
@@ -272,10 +298,10 @@ inline static void gdither_innner_loop_fp(const GDitherType dt,
 	case GDitherNone:
 	    break;
 	case GDitherRect:
-	    tmp -= gdither_noise ();
+	    tmp -= gdither_noise (rnd);
 	    break;
 	case GDitherTri:
-	    r = gdither_noise () - 0.5f;
+	    r = gdither_noise (rnd) - 0.5f;
 	    tmp -= r - ts[channel];
 	    ts[channel] = r;
 	    break;
@@ -285,7 +311,7 @@ inline static void gdither_innner_loop_fp(const GDitherType dt,
 	    ideal = tmp;
 
 	    /* Run FIR and add white noise */
-	    ss->buffer[ss->phase] = gdither_noise () * 0.5f;
+	    ss->buffer[ss->phase] = gdither_noise (rnd) * 0.5f;
 	    tmp += ss->buffer[ss->phase] * shaped_bs[0]
 		   + ss->buffer[(ss->phase - 1) & GDITHER_SH_BUF_MASK]
 		     * shaped_bs[1]
@@ -367,11 +393,14 @@ void gdither_runf(GDither s, uint32_t channel, uint32_t length,
     float tmp;
     int64_t clamped;
     GDitherShapedState *ss = NULL;
+    uint32_t *rnd;
 
     if (!s || channel >= s->channels) {
 	return;
     }
 
+    rnd = s->rnd_state + channel;
+
     if (s->shaped_state) {
 	ss = s->shaped_state + channel;
     }
@@ -403,22 +432,22 @@ void gdither_runf(GDither s, uint32_t channel, uint32_t length,
 	case GDitherNone:
 	    gdither_innner_loop(GDitherNone, s->channels, 128.0f, SCALE_U8,
 				1, 8, channel, length, NULL, NULL, x, y,
-				MAX_U8, MIN_U8);
+				MAX_U8, MIN_U8, rnd);
 	    break;
 	case GDitherRect:
 	    gdither_innner_loop(GDitherRect, s->channels, 128.0f, SCALE_U8,
 				1, 8, channel, length, NULL, NULL, x, y,
-				MAX_U8, MIN_U8);
+				MAX_U8, MIN_U8, rnd);
 	    break;
 	case GDitherTri:
 	    gdither_innner_loop(GDitherTri, s->channels, 128.0f, SCALE_U8,
 				1, 8, channel, length, s->tri_state,
-				NULL, x, y, MAX_U8, MIN_U8);
+				NULL, x, y, MAX_U8, MIN_U8, rnd);
 	    break;
 	case GDitherShaped:
 	    gdither_innner_loop(GDitherShaped, s->channels, 128.0f, SCALE_U8,
 			        1, 8, channel, length, NULL,
-				ss, x, y, MAX_U8, MIN_U8);
+				ss, x, y, MAX_U8, MIN_U8, rnd);
 	    break;
 	}
     } else if (s->bit_depth == 16 && s->dither_depth == 16) {
@@ -426,22 +455,22 @@ void gdither_runf(GDither s, uint32_t channel, uint32_t length,
 	case GDitherNone:
 	    gdither_innner_loop(GDitherNone, s->channels, 0.0f, SCALE_S16,
 				1, 16, channel, length, NULL, NULL, x, y,
-				MAX_S16, MIN_S16);
+				MAX_S16, MIN_S16, rnd);
 	    break;
 	case GDitherRect:
 	    gdither_innner_loop(GDitherRect, s->channels, 0.0f, SCALE_S16,
 				1, 16, channel, length, NULL, NULL, x, y,
-				MAX_S16, MIN_S16);
+				MAX_S16, MIN_S16, rnd);
 	    break;
 	case GDitherTri:
 	    gdither_innner_loop(GDitherTri, s->channels, 0.0f, SCALE_S16,
 				1, 16, channel, length, s->tri_state,
-				NULL, x, y, MAX_S16, MIN_S16);
+				NULL, x, y, MAX_S16, MIN_S16, rnd);
 	    break;
 	case GDitherShaped:
 	    gdither_innner_loop(GDitherShaped, s->channels, 0.0f,
 				SCALE_S16, 1, 16, channel, length, NULL,
-				ss, x, y, MAX_S16, MIN_S16);
+				ss, x, y, MAX_S16, MIN_S16, rnd);
 	    break;
 	}
     } else if (s->bit_depth == 32 && s->dither_depth == 24) {
@@ -449,34 +478,284 @@ void gdither_runf(GDither s, uint32_t channel, uint32_t length,
 	case GDitherNone:
 	    gdither_innner_loop(GDitherNone, s->channels, 0.0f, SCALE_S24,
 				256, 32, channel, length, NULL, NULL, x,
-				y, MAX_S24, MIN_S24);
+				y, MAX_S24, MIN_S24, rnd);
 	    break;
 	case GDitherRect:
 	    gdither_innner_loop(GDitherRect, s->channels, 0.0f, SCALE_S24,
 				256, 32, channel, length, NULL, NULL, x,
-				y, MAX_S24, MIN_S24);
+				y, MAX_S24, MIN_S24, rnd);
 	    break;
 	case GDitherTri:
 	    gdither_innner_loop(GDitherTri, s->channels, 0.0f, SCALE_S24,
 				256, 32, channel, length, s->tri_state,
-				NULL, x, y, MAX_S24, MIN_S24);
+				NULL, x, y, MAX_S24, MIN_S24, rnd);
 	    break;
 	case GDitherShaped:
 	    gdither_innner_loop(GDitherShaped, s->channels, 0.0f, SCALE_S24,
 				256, 32, channel, length,
-				NULL, ss, x, y, MAX_S24, MIN_S24);
+				NULL, ss, x, y, MAX_S24, MIN_S24, rnd);
 	    break;
 	}
     } else if (s->bit_depth == GDitherFloat || s->bit_depth == GDitherDouble) {
 	gdither_innner_loop_fp(s->type, s->channels, s->bias, s->scale,
 			    s->post_scale_fp, s->bit_depth, channel, length,
-			    s->tri_state, ss, x, y, s->clamp_u, s->clamp_l);
+			    s->tri_state, ss, x, y, s->clamp_u, s->clamp_l, rnd);
     } else {
 	/* no special case handling, just process it from the struct */
 
 	gdither_innner_loop(s->type, s->channels, s->bias, s->scale,
 			    s->post_scale, s->bit_depth, channel,
 			    length, s->tri_state, ss, x, y, s->clamp_u,
-			    s->clamp_l);
+			    s->clamp_l, rnd);
+    }
+}
+
+#if defined(__SSE2__) && (defined(__x86_64__) || defined(__SSE2_MATH__))
+#define GDITHER_SSE 1
+#include <emmintrin.h>
+
+/* exact uint32 to float conversion, the same rounding as a scalar cast */
+static inline __m128 gdither_u32_to_float(__m128i u)
+{
+    const __m128 hi = _mm_cvtepi32_ps(_mm_srli_epi32(u, 16));
+    const __m128 lo = _mm_cvtepi32_ps(_mm_and_si128(u, _mm_set1_epi32(0xffff)));
+    return _mm_add_ps(_mm_mul_ps(hi, _mm_set1_ps(65536.0f)), lo);
+}
+
+/* a * x + c, modulo 2^32 */
+static inline __m128i gdither_lcg_sse(__m128i x, __m128i a, __m128i c)
+{
+    const __m128i even = _mm_mul_epu32(x, a);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), _mm_srli_epi64(a, 32));
+    const __m128i r = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+					 _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    return _mm_add_epi32(r, c);
+}
+#endif
+
+/* Dither noise of one channel for gdither_runf_interleaved(), d[pos] is
+ * what gdither_innner_loop() subtracts (Rect, Tri) or adds (Shaped) at pos.
+ * Advances the channel's generator and dither state by length samples.
+ */
+static void gdither_channel_noise(GDither s, uint32_t channel,
+				  uint32_t length, float *d)
+{
+    /* room for the Tri and Shaped history in front of the noise */
+    float nbuf[GDITHER_BLOCK + 4];
+    float *n = nbuf + 4;
+    uint32_t *rnd = s->rnd_state + channel;
+    uint32_t pos = 0;
+    int i;
+
+#ifdef GDITHER_SSE
+    /* four consecutive states of the generator at a time,
+     * x[k + m] = a_m * x[k] + c_m */
+    const uint32_t a2 = GDITHER_RND_A * GDITHER_RND_A;
+    const uint32_t a3 = a2 * GDITHER_RND_A;
+    const uint32_t a4 = a3 * GDITHER_RND_A;
+    const uint32_t c2 = GDITHER_RND_C * GDITHER_RND_A + GDITHER_RND_C;
+    const uint32_t c3 = c2 * GDITHER_RND_A + GDITHER_RND_C;
+    const uint32_t c4 = c3 * GDITHER_RND_A + GDITHER_RND_C;
+    const __m128i va4 = _mm_set1_epi32((int)a4);
+    const __m128i vc4 = _mm_set1_epi32((int)c4);
+    const __m128 vscale = _mm_set1_ps(GDITHER_RND_SCALE);
+    const uint32_t r = *rnd;
+    __m128i v = _mm_setr_epi32((int)(r * GDITHER_RND_A + GDITHER_RND_C), (int)(r * a2 + c2),
+			       (int)(r * a3 + c3), (int)(r * a4 + c4));
+
+    for (; pos + 4 <= length; pos += 4) {
+	_mm_storeu_ps(n + pos, _mm_mul_ps(gdither_u32_to_float(v), vscale));
+	*rnd = (uint32_t)_mm_cvtsi128_si32(_mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 3)));
+	v = gdither_lcg_sse(v, va4, vc4);
+    }
+#endif
+
+    for (; pos < length; pos++) {
+	n[pos] = gdither_noise(rnd);
+    }
+
+    switch (s->type) {
+    case GDitherNone:
+	break;
+    case GDitherRect:
+	memcpy(d, n, length * sizeof(float));
+	break;
+    case GDitherTri:
+	n[-1] = s->tri_state[channel];
+	for (pos = 0; pos < length; pos++) {
+	    n[pos] = n[pos] - 0.5f;
+	}
+	for (i = 0; i < (int)length; i++) {
+	    d[i] = n[i] - n[i - 1];
+	}
+	s->tri_state[channel] = n[length - 1];
+	break;
+    case GDitherShaped:
+	{
+	    GDitherShapedState *ss = s->shaped_state + channel;
+	    uint32_t phase = (ss->phase + length) & GDITHER_SH_BUF_MASK;
+	    int k;
+
+	    for (k = 1; k <= 4; k++) {
+		n[-k] = ss->buffer[(ss->phase - k) & GDITHER_SH_BUF_MASK];
+	    }
+	    for (pos = 0; pos < length; pos++) {
+		n[pos] = n[pos] * 0.5f;
+	    }
+	    for (i = 0; i < (int)length; i++) {
+		d[i] = n[i] * shaped_bs[0] + n[i - 1] * shaped_bs[1]
+		       + n[i - 2] * shaped_bs[2] + n[i - 3] * shaped_bs[3]
+		       + n[i - 4] * shaped_bs[4];
+	    }
+	    /* the last error is stored by the caller, at buffer[phase] */
+	    for (k = 1; k < GDITHER_SH_BUF_SIZE && (int)length - k >= -4; k++) {
+		ss->buffer[(phase - k) & GDITHER_SH_BUF_MASK] = n[(int)length - k];
+	    }
+	    ss->phase = phase;
+	}
+	break;
+    }
+}
+
+void gdither_runf_interleaved(GDither s, uint32_t length,
+			      float const *x, void *y)
+{
+    uint32_t c, pos, i;
+
+    if (!s) {
+	return;
+    }
+
+    const uint32_t channels = s->channels;
+
+    if (s->bit_depth != GDither8bit && s->bit_depth != GDither16bit
+	&& s->bit_depth != GDither32bit) {
+	for (c = 0; c < channels; c++) {
+	    gdither_runf(s, c, length, x, y);
+	}
+	return;
+    }
+
+    /* same parameters as gdither_runf() */
+    const float scale = s->scale;
+    const float bias = (s->bit_depth == 8 && s->dither_depth == 8) ? 128.0f : s->bias;
+    const int clamp_u = s->clamp_u;
+    const int clamp_l = s->clamp_l;
+    const uint32_t post_scale = s->post_scale;
+    const GDitherType dt = s->type;
+
+    int post_shift = 0;
+    while ((1U << post_shift) < post_scale) {
+	post_shift++;
+    }
+
+    float *dither = s->dither_buf;
+    float cd[GDITHER_BLOCK];
+
+    for (pos = 0; pos < length; pos += GDITHER_BLOCK) {
+	const uint32_t len = (length - pos) < GDITHER_BLOCK ? (length - pos) : GDITHER_BLOCK;
+	const uint32_t n = len * channels;
+	float const *xb = x + pos * channels;
+
+	/* dither noise, interleaved */
+	if (dt != GDitherNone) {
+	    for (c = 0; c < channels; c++) {
+		gdither_channel_noise(s, c, len, cd);
+		for (i = 0; i < len; i++) {
+		    dither[i * channels + c] = cd[i];
+		}
+	    }
+	}
+
+	/* scale, dither, clamp, round and pack */
+	i = 0;
+
+#ifdef GDITHER_SSE
+	{
+	    const __m128 vscale = _mm_set1_ps(scale);
+	    const __m128 vbias = _mm_set1_ps(bias);
+	    const __m128 vlo = _mm_set1_ps((float)clamp_l);
+	    const __m128 vhi = _mm_set1_ps((float)clamp_u);
+	    const __m128 vabs = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+	    /* lrintf() returns LONG_MIN if the value does not fit */
+	    const __m128 vlong = _mm_set1_ps((float)(1UL << (sizeof(long) * 8 - 1)));
+	    const __m128i vshift = _mm_cvtsi32_si128(post_shift);
+
+	    for (; i + 4 <= n; i += 4) {
+		__m128 tmp = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(xb + i), vscale), vbias);
+		if (dt == GDitherRect || dt == GDitherTri) {
+		    tmp = _mm_sub_ps(tmp, _mm_loadu_ps(dither + i));
+		} else if (dt == GDitherShaped) {
+		    tmp = _mm_add_ps(tmp, _mm_loadu_ps(dither + i));
+		}
+
+		/* NaN and values beyond the range of long clamp to the lower bound */
+		const __m128 invalid = _mm_cmpnlt_ps(_mm_and_ps(tmp, vabs), vlong);
+		__m128 clamped = _mm_min_ps(_mm_max_ps(tmp, vlo), vhi);
+		clamped = _mm_or_ps(_mm_and_ps(invalid, vlo), _mm_andnot_ps(invalid, clamped));
+
+		__m128i q = _mm_sll_epi32(_mm_cvtps_epi32(clamped), vshift);
+
+		switch (s->bit_depth) {
+		case GDither8bit:
+		    {
+			q = _mm_and_si128(q, _mm_set1_epi32(0xff));
+			q = _mm_packs_epi32(q, q);
+			q = _mm_packus_epi16(q, q);
+			int32_t p = _mm_cvtsi128_si32(q);
+			memcpy((uint8_t *)y + pos * channels + i, &p, 4);
+		    }
+		    break;
+		case GDither16bit:
+		    /* truncate, like the scalar cast */
+		    q = _mm_srai_epi32(_mm_slli_epi32(q, 16), 16);
+		    _mm_storel_epi64((__m128i *)((int16_t *)y + pos * channels + i), _mm_packs_epi32(q, q));
+		    break;
+		case GDither32bit:
+		    _mm_storeu_si128((__m128i *)((int32_t *)y + pos * channels + i), q);
+		    break;
+		}
+	    }
+	}
+#endif
+
+	for (; i < n; i++) {
+	    float tmp = xb[i] * scale + bias;
+	    if (dt == GDitherRect || dt == GDitherTri) {
+		tmp -= dither[i];
+	    } else if (dt == GDitherShaped) {
+		tmp += dither[i];
+	    }
+
+	    int64_t clamped = lrintf(tmp);
+	    if (clamped > clamp_u) {
+		clamped = clamp_u;
+	    } else if (clamped < clamp_l) {
+		clamped = clamp_l;
+	    }
+
+	    switch (s->bit_depth) {
+	    case GDither8bit:
+		((uint8_t *)y)[pos * channels + i] = (uint8_t)(clamped * post_scale);
+		break;
+	    case GDither16bit:
+		((int16_t *)y)[pos * channels + i] = (int16_t)(clamped * post_scale);
+		break;
+	    case GDither32bit:
+		((int32_t *)y)[pos * channels + i] = (int32_t)(clamped * post_scale);
+		break;
+	    }
+	}
+
+	/* the error of the last sample, see gdither_innner_loop() */
+	if (dt == GDitherShaped) {
+	    for (c = 0; c < channels; c++) {
+		GDitherShapedState *ss = s->shaped_state + c;
+		i = (len - 1) * channels + c;
+		const float ideal = xb[i] * scale + bias;
+		const float tmp = ideal + dither[i];
+		ss->buffer[ss->phase] = (float)lrintf(tmp) - ideal;
+	    }
+	}
     }
 }
@@ -81,6 +81,15 @@ void gdither_free(GDither s);
 void gdither_runf(GDither s, uint32_t channel, uint32_t length,
 		   float const *x, void *y);
 
+/* Applies dithering to all channels of an interleaved signal.
+ *
+ * length is the number of samples per channel. The result is identical to
+ * calling gdither_runf() for every channel, but the scale, dither, clamp and
+ * pack stages are vectorised where possible.
+ */
+void gdither_runf_interleaved(GDither s, uint32_t length,
+		   float const *x, void *y);
+
 /* see gdither_runf, vut input argument is double format */
 void gdither_run(GDither s, uint32_t channel, uint32_t length,
 		   double const *x, void *y);
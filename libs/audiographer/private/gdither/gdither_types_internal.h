@@ -66,6 +66,8 @@ typedef struct GDither_s {
     int   clamp_l;
     float *tri_state;
     GDitherShapedState *shaped_state;
+    uint32_t *rnd_state;
+    float *dither_buf;
 } *GDither;
 
 #ifdef __cplusplus
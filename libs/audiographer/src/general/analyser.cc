@@ -126,9 +126,6 @@ Analyser::process (ProcessContext<float> const & ctx)
 		for (unsigned int c = 0; c < _channels; ++c) {
 			const float v = *d;
 			if (fabsf(v) > _result.peak) { _result.peak = fabsf(v); }
-			if (c < _result.n_channels) {
-				_bufs[c][s] = v;
-			}
 			const unsigned int cc = c & cmask;
 			if (_result.peaks[cc][pbin].min > v) { _result.peaks[cc][pbin].min = *d; }
 			if (_result.peaks[cc][pbin].max < v) { _result.peaks[cc][pbin].max = *d; }
@@ -139,21 +136,21 @@ Analyser::process (ProcessContext<float> const & ctx)
 
 	for (; s < _bufsize; ++s) {
 		_fft_data_in[s] = 0;
-		for (unsigned int c = 0; c < _result.n_channels; ++c) {
-			_bufs[c][s] = 0.f;
-		}
 	}
 
-	if (_ebur_plugin) {
-		_ebur_plugin->process (_bufs, Vamp::RealTime::fromSeconds ((double) _pos / _sample_rate));
+	if (_use_ebur) {
+		_ebur.process (ctx.data (), n_samples);
 	}
 
+	/* true-peak, and the location of peaks above -1dBTP in chunks of 48 samples */
 	float const * const data = ctx.data ();
-	for (unsigned int c = 0; c < _channels && c < _dbtp_plugins.size (); ++c) {
-		for (s = 0; s < n_samples; ++s) {
-			_bufs[0][s] = data[s * _channels + c];
+	for (unsigned int c = 0; c < _channels; ++c) {
+		for (s = 0; s < n_samples; s += 48) {
+			const samplecnt_t n = std::min<samplecnt_t> (48, n_samples - s);
+			if (_dbtp[c].process (data + s * _channels + c, n, _channels) >= .89125 /* -1dBTP */) {
+				_result.truepeakpos[c & cmask].insert ((_pos + s + n) / _spp);
+			}
 		}
-		_dbtp_plugins.at(c)->process (_bufs, Vamp::RealTime::fromSeconds ((double) _pos / _sample_rate));
 	}
 
 	fftwf_execute (_fft_plan);
@@ -231,39 +228,24 @@ Analyser::result ()
 		}
 	}
 
-	if (_ebur_plugin) {
-		Vamp::Plugin::FeatureSet features = _ebur_plugin->getRemainingFeatures ();
-		if (!features.empty () && features.size () == 3) {
-			_result.integrated_loudness    = features[0][0].values[0];
-			_result.max_loudness_short     = features[0][1].values[0];
-			_result.max_loudness_momentary = features[0][2].values[0];
-
-			_result.loudness_range = features[1][0].values[0];
-			assert (features[2][0].values.size () == 540);
-			for (int i = 0; i < 540; ++i) {
-				_result.loudness_hist[i] = features[2][0].values[i];
-				if (_result.loudness_hist[i] > _result.loudness_hist_max) {
-					_result.loudness_hist_max = _result.loudness_hist[i]; }
-			}
-			_result.have_loudness = true;
+	if (_use_ebur) {
+		_result.integrated_loudness    = _ebur.integrated ();
+		_result.max_loudness_short     = _ebur.max_loudness_S ();
+		_result.max_loudness_momentary = _ebur.max_loudness_M ();
+
+		_result.loudness_range = _ebur.loudness_range ();
+		int const* hist_S = _ebur.histogram_S ();
+		for (int i = 0; i < 540; ++i) {
+			_result.loudness_hist[i] = hist_S[i + 110];
+			if (_result.loudness_hist[i] > _result.loudness_hist_max) {
+				_result.loudness_hist_max = _result.loudness_hist[i]; }
 		}
+		_result.have_loudness = true;
 	}
 
-	const unsigned cmask = _result.n_channels - 1; // [0, 1]
-	for (unsigned int c = 0; c < _channels && c < _dbtp_plugins.size (); ++c) {
-		Vamp::Plugin::FeatureSet features = _dbtp_plugins.at(c)->getRemainingFeatures ();
-		if (!features.empty () && features.size () == 2) {
-			_result.have_dbtp = true;
-			float p = features[0][0].values[0];
-			if (p > _result.truepeak) { _result.truepeak = p; }
-
-			for (std::vector<float>::const_iterator i = features[1][0].values.begin();
-					i != features[1][0].values.end(); ++i) {
-				const samplecnt_t pk = (*i) / _spp;
-				const unsigned int cc = c & cmask;
-				_result.truepeakpos[cc].insert (pk);
-			}
-		}
+	for (unsigned int c = 0; c < _channels; ++c) {
+		_result.have_dbtp = true;
+		if (_dbtp[c].peak () > _result.truepeak) { _result.truepeak = _dbtp[c].peak (); }
 	}
 
 	return ARDOUR::ExportAnalysisPtr (new ARDOUR::ExportAnalysis (_result));
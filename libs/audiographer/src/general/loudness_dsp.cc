@@ -0,0 +1,593 @@
+/*
+ * Copyright (C) 2010-2011 Fons Adriaensen <fons@linuxaudio.org>
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+#include "audiographer/general/loudness_dsp.h"
+
+#ifdef COMPILER_MSVC
+#include <float.h>
+#define isfinite_local(val) (bool)_finite((double)val)
+#else
+#define isfinite_local std::isfinite
+#endif
+
+using namespace AudioGrapher;
+
+/* ****************************************************************************
+ * Loudness histogram
+ */
+
+float LoudnessDsp::Histogram::_bin_power[100] = { 0.0f };
+
+LoudnessDsp::Histogram::Histogram ()
+{
+	if (_bin_power[0] == 0) {
+		for (int i = 0; i < 100; ++i) {
+			_bin_power[i] = powf (10.0f, i / 100.0f);
+		}
+	}
+	reset ();
+}
+
+void
+LoudnessDsp::Histogram::reset ()
+{
+	memset (_histc, 0, sizeof (_histc));
+	_count = 0;
+	_error = 0;
+}
+
+void
+LoudnessDsp::Histogram::addpoint (float v)
+{
+	int k = (int) floorf (10 * v + 700.5f);
+	if (k < 0) {
+		return;
+	}
+	if (k > histogram_size - 1) {
+		k = histogram_size - 1;
+		++_error;
+	}
+	++_histc[k];
+	++_count;
+}
+
+float
+LoudnessDsp::Histogram::integrate (int i) const
+{
+	int   j = i % 100;
+	int   n = 0;
+	float s = 0;
+
+	while (i < histogram_size) {
+		const int k = _histc[i++];
+		n += k;
+		s += k * _bin_power[j++];
+		if (j == 100) {
+			j = 0;
+			s /= 10.0f;
+		}
+	}
+	return s / n;
+}
+
+void
+LoudnessDsp::Histogram::calc_integ (float* vi, float* th) const
+{
+	if (_count < 50) {
+		*vi = -200.0f;
+		return;
+	}
+
+	float s = integrate (0);
+	/* relative gate, -10 dB below the result of the first integration */
+	if (th) {
+		*th = 10 * log10f (s) - 10.0f;
+	}
+	int k = (int) (floorf (100 * log10f (s) + 0.5f)) + 600;
+	if (k < 0) {
+		k = 0;
+	}
+	s = integrate (k);
+	*vi = 10 * log10f (s);
+}
+
+void
+LoudnessDsp::Histogram::calc_range (float* v0, float* v1, float* th) const
+{
+	int   i, j, k, n;
+	float a, b, s;
+
+	if (_count < 20) {
+		*v0 = -200.0f;
+		*v1 = -200.0f;
+		return;
+	}
+
+	s = integrate (0);
+	if (th) {
+		*th = 10 * log10f (s) - 20.0f;
+	}
+	k = (int) (floorf (100 * log10f (s) + 0.5)) + 500;
+	if (k < 0) {
+		k = 0;
+	}
+	for (i = k, n = 0; i < histogram_size; ++i) {
+		n += _histc[i];
+	}
+	a = 0.10f * n;
+	b = 0.95f * n;
+	for (i = k, s = 0; s < a; ++i) {
+		s += _histc[i];
+	}
+	for (j = histogram_size - 1, s = n; s > b; --j) {
+		s -= _histc[j];
+	}
+	*v0 = (i - 701) / 10.0f;
+	*v1 = (j - 699) / 10.0f;
+}
+
+/* ****************************************************************************
+ * R128 loudness
+ */
+
+LoudnessDsp::LoudnessDsp ()
+	: _integr (false)
+	, _nchan (0)
+	, _fsamp (0)
+	, _fragm (0)
+	, _stride (1)
+{
+	reset ();
+}
+
+LoudnessDsp::~LoudnessDsp ()
+{
+}
+
+void
+LoudnessDsp::init (unsigned int channels, float sample_rate)
+{
+	_nchan = channels;
+	_fsamp = sample_rate;
+	_fragm = (int) sample_rate / 20;
+
+	_ipp.assign (_nchan, 0);
+	_fst.assign (_nchan, Filter ());
+
+	/* ITU-R BS.1770-4 channel weights. Mono is played on both speakers.
+	 * Otherwise channels are assumed to be in SMPTE order: L, R, C, LFE,
+	 * Ls, Rs followed by rear, height or other channels (weighted 1.0).
+	 * Without LFE: 4 channels are L, R, Ls, Rs, 5 channels L, R, C, Ls, Rs.
+	 * Surround channels get +1.5 dB, the LFE is not measured.
+	 */
+	_chan_gain.assign (_nchan, 1.0f);
+	switch (_nchan) {
+		case 1:
+			_chan_gain[0] = 2.0f;
+			break;
+		case 2:
+		case 3:
+			break;
+		case 4:
+			_chan_gain[2] = _chan_gain[3] = 1.41f;
+			break;
+		case 5:
+			_chan_gain[3] = _chan_gain[4] = 1.41f;
+			break;
+		default:
+			_chan_gain[3] = 0.0f;
+			_chan_gain[4] = _chan_gain[5] = 1.41f;
+			break;
+	}
+
+	detect_init (_fsamp);
+	reset ();
+}
+
+void
+LoudnessDsp::reset ()
+{
+	_integr = false;
+	_frcnt  = _fragm;
+	_frpwr  = 1e-30f;
+	_wrind  = 0;
+	_loudness_M = -200.0f;
+	_loudness_S = -200.0f;
+	memset (_power, 0, sizeof (_power));
+	integr_reset ();
+	for (std::vector<Filter>::iterator i = _fst.begin (); i != _fst.end (); ++i) {
+		i->reset ();
+	}
+}
+
+void
+LoudnessDsp::integr_reset ()
+{
+	_hist_M.reset ();
+	_hist_S.reset ();
+	_maxloudn_M = -200.0f;
+	_maxloudn_S = -200.0f;
+	_integrated = -200.0f;
+	_integ_thr  = -200.0f;
+	_range_min  = -200.0f;
+	_range_max  = -200.0f;
+	_range_thr  = -200.0f;
+	_div1 = _div2 = 0;
+}
+
+void
+LoudnessDsp::process (float const* data, samplecnt_t n_samples)
+{
+	for (unsigned int c = 0; c < _nchan; ++c) {
+		_ipp[c] = data + c;
+	}
+	_stride = _nchan;
+	run (n_samples);
+}
+
+void
+LoudnessDsp::process (float const* const* data, samplecnt_t n_samples)
+{
+	for (unsigned int c = 0; c < _nchan; ++c) {
+		_ipp[c] = data[c];
+	}
+	_stride = 1;
+	run (n_samples);
+}
+
+void
+LoudnessDsp::run (samplecnt_t n_samples)
+{
+	if (_nchan == 0 || _fragm == 0) {
+		return;
+	}
+
+	while (n_samples > 0) {
+		const int k = (_frcnt < n_samples) ? _frcnt : n_samples;
+
+		_frpwr += detect_process (k);
+		_frcnt -= k;
+
+		if (_frcnt == 0) {
+			_power[_wrind++] = _frpwr / _fragm;
+			_frcnt = _fragm;
+			_frpwr = 1e-30f;
+			_wrind &= 63;
+			_loudness_M = addfrags (8);
+			_loudness_S = addfrags (60);
+			if (!isfinite_local (_loudness_M) || _loudness_M < -200.f) {
+				_loudness_M = -200.0f;
+			}
+			if (!isfinite_local (_loudness_S) || _loudness_S < -200.f) {
+				_loudness_S = -200.0f;
+			}
+			if (_loudness_M > _maxloudn_M) {
+				_maxloudn_M = _loudness_M;
+			}
+			if (_loudness_S > _maxloudn_S) {
+				_maxloudn_S = _loudness_S;
+			}
+			if (_integr) {
+				if (++_div1 == 2) {
+					_hist_M.addpoint (_loudness_M);
+					_div1 = 0;
+				}
+				if (++_div2 == 10) {
+					_hist_S.addpoint (_loudness_S);
+					_div2 = 0;
+					_hist_M.calc_integ (&_integrated, &_integ_thr);
+					_hist_S.calc_range (&_range_min, &_range_max, &_range_thr);
+				}
+			}
+		}
+
+		for (unsigned int c = 0; c < _nchan; ++c) {
+			_ipp[c] += k * _stride;
+		}
+		n_samples -= k;
+	}
+}
+
+float
+LoudnessDsp::addfrags (int nfrag) const
+{
+	float s = 0;
+	const int k = (_wrind - nfrag) & 63;
+	for (int i = 0; i < nfrag; ++i) {
+		s += _power[(i + k) & 63];
+	}
+	return -0.6976f + 10 * log10f (s / nfrag);
+}
+
+void
+LoudnessDsp::detect_init (float fsamp)
+{
+	float a, b, c, d, r, u1, u2, w1, w2;
+
+	r = 1 / tan (4712.3890f / fsamp);
+	w1 = r / 1.12201f;
+	w2 = r * 1.12201f;
+	u1 = u2 = 1.4085f + 210.0f / fsamp;
+	a = u1 * w1;
+	b = w1 * w1;
+	c = u2 * w2;
+	d = w2 * w2;
+	r = 1 + a + b;
+	_a0 = (1 + c + d) / r;
+	_a1 = (2 - 2 * d) / r;
+	_a2 = (1 - c + d) / r;
+	_b1 = (2 - 2 * b) / r;
+	_b2 = (1 - a + b) / r;
+	r = 48.0f / fsamp;
+	a = 4.9886075f * r;
+	b = 6.2298014f * r * r;
+	r = 1 + a + b;
+	a *= 2 / r;
+	b *= 4 / r;
+	_c3 = a + b;
+	_c4 = b;
+	r = 1.004995f / r;
+	_a0 *= r;
+	_a1 *= r;
+	_a2 *= r;
+}
+
+/** K-weighted power of a single channel */
+float
+LoudnessDsp::detect_channel (unsigned int c, samplecnt_t n_samples)
+{
+	Filter&            S = _fst[c];
+	float const*       p = _ipp[c];
+	const unsigned int s = _stride;
+
+	float z1 = S.z1;
+	float z2 = S.z2;
+	float z3 = S.z3;
+	float z4 = S.z4;
+	float sj = 0;
+
+	for (samplecnt_t j = 0; j < n_samples; ++j) {
+		const float x = p[j * s] - _b1 * z1 - _b2 * z2 + 1e-15f;
+		const float y = _a0 * x + _a1 * z1 + _a2 * z2 - _c3 * z3 - _c4 * z4;
+		z2 = z1;
+		z1 = x;
+		z4 += z3;
+		z3 += y;
+		sj += y * y;
+	}
+
+	S.z1 = !isfinite_local (z1) ? 0 : z1;
+	S.z2 = !isfinite_local (z2) ? 0 : z2;
+	S.z3 = !isfinite_local (z3) ? 0 : z3;
+	S.z4 = !isfinite_local (z4) ? 0 : z4;
+	return sj;
+}
+
+#if defined(__SSE__)
+/** K-weighted power of four channels c .. c + 3 at once, one per SSE lane.
+ * Lanes beyond the last channel repeat it, and are ignored.
+ */
+void
+LoudnessDsp::detect_channels_sse (unsigned int c, samplecnt_t n_samples, float* sj)
+{
+	const unsigned int n = std::min (4U, _nchan - c);
+	const unsigned int s = _stride;
+
+	float const* p[4];
+	float        z[4][4];
+
+	for (unsigned int i = 0; i < 4; ++i) {
+		const unsigned int cc = c + std::min (i, n - 1);
+		p[i] = _ipp[cc];
+		z[0][i] = _fst[cc].z1;
+		z[1][i] = _fst[cc].z2;
+		z[2][i] = _fst[cc].z3;
+		z[3][i] = _fst[cc].z4;
+	}
+
+	const __m128 a0 = _mm_set1_ps (_a0);
+	const __m128 a1 = _mm_set1_ps (_a1);
+	const __m128 a2 = _mm_set1_ps (_a2);
+	const __m128 b1 = _mm_set1_ps (_b1);
+	const __m128 b2 = _mm_set1_ps (_b2);
+	const __m128 c3 = _mm_set1_ps (_c3);
+	const __m128 c4 = _mm_set1_ps (_c4);
+	const __m128 dn = _mm_set1_ps (1e-15f);
+
+	__m128 z1 = _mm_loadu_ps (z[0]);
+	__m128 z2 = _mm_loadu_ps (z[1]);
+	__m128 z3 = _mm_loadu_ps (z[2]);
+	__m128 z4 = _mm_loadu_ps (z[3]);
+	__m128 acc = _mm_setzero_ps ();
+
+	/* interleaved, consecutive channels */
+	const bool contiguous = s >= 4 && n == 4 && p[1] == p[0] + 1 && p[2] == p[0] + 2 && p[3] == p[0] + 3;
+
+	for (samplecnt_t j = 0; j < n_samples; ++j) {
+		__m128 x;
+		if (contiguous) {
+			x = _mm_loadu_ps (p[0] + j * s);
+		} else {
+			x = _mm_setr_ps (p[0][j * s], p[1][j * s], p[2][j * s], p[3][j * s]);
+		}
+		/* same order of operations as detect_channel () */
+		x = _mm_add_ps (_mm_sub_ps (_mm_sub_ps (x, _mm_mul_ps (b1, z1)), _mm_mul_ps (b2, z2)), dn);
+		__m128 y = _mm_add_ps (_mm_mul_ps (a0, x), _mm_mul_ps (a1, z1));
+		y = _mm_add_ps (y, _mm_mul_ps (a2, z2));
+		y = _mm_sub_ps (y, _mm_mul_ps (c3, z3));
+		y = _mm_sub_ps (y, _mm_mul_ps (c4, z4));
+		z2 = z1;
+		z1 = x;
+		z4 = _mm_add_ps (z4, z3);
+		z3 = _mm_add_ps (z3, y);
+		acc = _mm_add_ps (acc, _mm_mul_ps (y, y));
+	}
+
+	_mm_storeu_ps (z[0], z1);
+	_mm_storeu_ps (z[1], z2);
+	_mm_storeu_ps (z[2], z3);
+	_mm_storeu_ps (z[3], z4);
+	_mm_storeu_ps (sj, acc);
+
+	for (unsigned int i = 0; i < n; ++i) {
+		Filter& S = _fst[c + i];
+		S.z1 = !isfinite_local (z[0][i]) ? 0 : z[0][i];
+		S.z2 = !isfinite_local (z[1][i]) ? 0 : z[1][i];
+		S.z3 = !isfinite_local (z[2][i]) ? 0 : z[2][i];
+		S.z4 = !isfinite_local (z[3][i]) ? 0 : z[3][i];
+	}
+}
+#endif
+
+float
+LoudnessDsp::detect_process (samplecnt_t n_samples)
+{
+	float si = 0;
+
+#if defined(__SSE__)
+	if (_nchan > 1) {
+		float sj[4];
+		for (unsigned int c = 0; c < _nchan; c += 4) {
+			detect_channels_sse (c, n_samples, sj);
+			for (unsigned int i = 0; i < 4 && c + i < _nchan; ++i) {
+				si += _chan_gain[c + i] * sj[i];
+			}
+		}
+		return si;
+	}
+#endif
+
+	for (unsigned int c = 0; c < _nchan; ++c) {
+		si += _chan_gain[c] * detect_channel (c, n_samples);
+	}
+	return si;
+}
+
+/* ****************************************************************************
+ * True peak
+ */
+
+static double
+sinc (double x)
+{
+	x = fabs (x);
+	if (x < 1e-6) {
+		return 1.0;
+	}
+	x *= M_PI;
+	return sin (x) / x;
+}
+
+static double
+wind (double x)
+{
+	x = fabs (x);
+	if (x >= 1.0) {
+		return 0.0f;
+	}
+	x *= M_PI;
+	return 0.384 + 0.500 * cos (x) + 0.116 * cos (2 * x);
+}
+
+TruePeakDsp::TruePeakDsp ()
+{
+	/* The same interpolation filter as zita-resampler with hlen = 24,
+	 * used by the dBTP Vamp plugin. Output n of phase p is at
+	 * sample n - taps/2 + p/4, _buf[n .. n + taps - 1] are the inputs
+	 * n - taps + 1 .. n.
+	 */
+	const int hl = taps / 2;
+	for (int p = 1; p < 4; ++p) {
+		for (int j = 0; j < taps; ++j) {
+			const double d = j + 1 - hl - p / 4.0;
+			_coeff[p - 1][j] = (float) (sinc (d) * wind (d / hl));
+		}
+	}
+	reset ();
+}
+
+void
+TruePeakDsp::reset ()
+{
+	memset (_buf, 0, sizeof (_buf));
+	_peak = 0;
+}
+
+float
+TruePeakDsp::process (float const* data, samplecnt_t n_samples, unsigned int stride)
+{
+	float pk = 0;
+
+	while (n_samples > 0) {
+		const int n = std::min<samplecnt_t> (n_samples, block);
+		float* const in = _buf + taps - 1;
+
+		/* phase 0, the samples themselves */
+		for (int i = 0; i < n; ++i) {
+			in[i] = data[i * stride];
+			pk = std::max (pk, fabsf (in[i]));
+		}
+
+		int i = 0;
+#if defined(__SSE__)
+		/* four consecutive outputs of each phase at a time */
+		const __m128 sign = _mm_set1_ps (-0.0f);
+		__m128 vpk = _mm_setzero_ps ();
+		for (; i + 4 <= n; i += 4) {
+			for (int p = 0; p < 3; ++p) {
+				float const* const c = _coeff[p];
+				__m128 acc = _mm_setzero_ps ();
+				for (int j = 0; j < taps; ++j) {
+					acc = _mm_add_ps (acc, _mm_mul_ps (_mm_set1_ps (c[j]), _mm_loadu_ps (_buf + i + j)));
+				}
+				vpk = _mm_max_ps (vpk, _mm_andnot_ps (sign, acc));
+			}
+		}
+		float v[4];
+		_mm_storeu_ps (v, vpk);
+		pk = std::max (pk, std::max (std::max (v[0], v[1]), std::max (v[2], v[3])));
+#endif
+		for (; i < n; ++i) {
+			for (int p = 0; p < 3; ++p) {
+				float const* const c = _coeff[p];
+				float acc = 0;
+				for (int j = 0; j < taps; ++j) {
+					acc += c[j] * _buf[i + j];
+				}
+				pk = std::max (pk, fabsf (acc));
+			}
+		}
+
+		memmove (_buf, _buf + n, (taps - 1) * sizeof (float));
+
+		data += n * stride;
+		n_samples -= n;
+	}
+
+	_peak = std::max (_peak, pk);
+	return pk;
+}
@@ -138,11 +138,9 @@ SampleFormatConverter<TOut>::process (ProcessContext<float> const & c_in)
 
 	check_sample_and_channel_count (c_in.samples (), c_in.channels ());
 
-	/* Do conversion */
+	/* Do conversion, all channels at once */
 
-	for (uint32_t chn = 0; chn < c_in.channels(); ++chn) {
-		gdither_runf (dither, chn, c_in.samples_per_channel (), data, data_out);
-	}
+	gdither_runf_interleaved (dither, c_in.samples_per_channel (), data, data_out);
 
 	/* Write forward */
 
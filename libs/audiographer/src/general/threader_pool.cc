@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+
+#include <sigc++/functors/mem_fun.h>
+
+#include "audiographer/general/threader_pool.h"
+
+namespace AudioGrapher
+{
+
+/* iterations to busy-wait before blocking, roughly 10-50 usec */
+static const int spin_count = 2048;
+
+/* _tasks holds the number of tasks of the current job in the upper and the
+ * next task to claim in the lower 16 bits. A single compare-and-exchange
+ * claims a task, and can only succeed for the current job.
+ */
+static const unsigned int max_tasks = 0x7fff;
+
+static inline unsigned int task_next (gint t) { return t & 0xffff; }
+static inline unsigned int task_end (gint t) { return (t >> 16) & 0xffff; }
+
+static inline void
+spin_pause ()
+{
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	__asm__ __volatile__ ("pause" ::: "memory");
+#endif
+}
+
+ThreaderPool::ThreaderPool (unsigned int n_threads)
+	: _n_threads (std::max (1U, n_threads))
+	, _running (0)
+	, _job (0)
+	, _tasks (0)
+	, _pending (0)
+	, _quit (0)
+	, _sleeping (0)
+	, _caller_waiting (0)
+{
+}
+
+ThreaderPool::~ThreaderPool ()
+{
+	g_atomic_int_set (&_quit, 1);
+	{
+		Glib::Threads::Mutex::Lock lm (_wake_lock);
+		_wake_cond.broadcast ();
+	}
+	for (std::vector<Glib::Threads::Thread*>::const_iterator i = _threads.begin (); i != _threads.end (); ++i) {
+		(*i)->join ();
+	}
+}
+
+void
+ThreaderPool::start_threads ()
+{
+	while (_threads.size () + 1 < _n_threads) {
+		try {
+			_threads.push_back (Glib::Threads::Thread::create (sigc::mem_fun (*this, &ThreaderPool::worker)));
+		} catch (Glib::Threads::ThreadError const&) {
+			/* continue with the threads we have */
+			_n_threads = _threads.size () + 1;
+		}
+	}
+}
+
+bool
+ThreaderPool::have_work () const
+{
+	gint t = g_atomic_int_get (const_cast<gint*> (&_tasks));
+	return task_next (t) < task_end (t);
+}
+
+bool
+ThreaderPool::claim (unsigned int& task)
+{
+	while (true) {
+		gint t = g_atomic_int_get (&_tasks);
+		if (task_next (t) >= task_end (t)) {
+			return false;
+		}
+		if (g_atomic_int_compare_and_exchange (&_tasks, t, t + 1)) {
+			task = task_next (t);
+			return true;
+		}
+	}
+}
+
+void
+ThreaderPool::task_done ()
+{
+	if (g_atomic_int_dec_and_test (&_pending) && g_atomic_int_get (&_caller_waiting)) {
+		Glib::Threads::Mutex::Lock lm (_done_lock);
+		_done_cond.signal ();
+	}
+}
+
+void
+ThreaderPool::run (Job& job, unsigned int n_tasks)
+{
+	if (n_tasks == 0) {
+		return;
+	}
+
+	/* a nested run () is called from a task of the running job, either
+	 * by a worker or by the thread that owns the job. A flag rather
+	 * than a mutex, since the latter would try-lock a mutex it holds.
+	 */
+	if (n_tasks == 1 || n_tasks > max_tasks || _n_threads == 1 || !g_atomic_int_compare_and_exchange (&_running, 0, 1)) {
+		for (unsigned int i = 0; i < n_tasks; ++i) {
+			job.run_task (i);
+		}
+		return;
+	}
+
+	start_threads ();
+
+	/* all tasks of the previous job have been claimed and completed */
+	_job = &job;
+	g_atomic_int_set (&_pending, n_tasks);
+	g_atomic_int_set (&_tasks, n_tasks << 16);
+
+	if (g_atomic_int_get (&_sleeping) > 0) {
+		Glib::Threads::Mutex::Lock lm (_wake_lock);
+		_wake_cond.broadcast ();
+	}
+
+	unsigned int task;
+	while (claim (task)) {
+		job.run_task (task);
+		task_done ();
+	}
+
+	for (int i = 0; i < spin_count && g_atomic_int_get (&_pending) > 0; ++i) {
+		spin_pause ();
+	}
+
+	if (g_atomic_int_get (&_pending) > 0) {
+		g_atomic_int_set (&_caller_waiting, 1);
+		Glib::Threads::Mutex::Lock lm (_done_lock);
+		while (g_atomic_int_get (&_pending) > 0) {
+			_done_cond.wait (_done_lock);
+		}
+		g_atomic_int_set (&_caller_waiting, 0);
+	}
+
+	g_atomic_int_set (&_running, 0);
+}
+
+void
+ThreaderPool::worker ()
+{
+	while (!g_atomic_int_get (&_quit)) {
+		unsigned int task;
+		if (claim (task)) {
+			_job->run_task (task);
+			task_done ();
+			continue;
+		}
+
+		int i;
+		for (i = 0; i < spin_count; ++i) {
+			if (have_work () || g_atomic_int_get (&_quit)) {
+				break;
+			}
+			spin_pause ();
+		}
+
+		if (i < spin_count) {
+			continue;
+		}
+
+		Glib::Threads::Mutex::Lock lm (_wake_lock);
+		g_atomic_int_inc (&_sleeping);
+		while (!have_work () && !g_atomic_int_get (&_quit)) {
+			_wake_cond.wait (_wake_lock);
+		}
+		g_atomic_int_add (&_sleeping, -1);
+	}
+}
+
+} // namespace
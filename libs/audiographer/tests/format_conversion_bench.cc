@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <stdint.h>
+#include <glib.h>
+
+#include "private/gdither/gdither.h"
+
+using namespace std;
+
+/* Throughput of the export sample-format conversion, per channel
+ * (gdither_runf) and interleaved (gdither_runf_interleaved).
+ *
+ * Usage: format-conversion-bench [channels [chunks]]
+ */
+
+static const uint32_t chunk_size = 8192; // samples per channel
+
+template<typename T>
+static void
+bench (GDitherType type, GDitherSize size, char const* name, uint32_t channels, int n_chunks, vector<float> const& data)
+{
+	vector<T> out (chunk_size * channels);
+
+	GDither ref = gdither_new (type, channels, size, 0);
+	GDither vec = gdither_new (type, channels, size, 0);
+
+	int64_t t0 = g_get_monotonic_time ();
+	for (int i = 0; i < n_chunks; ++i) {
+		for (uint32_t c = 0; c < channels; ++c) {
+			gdither_runf (ref, c, chunk_size, &data[0], &out[0]);
+		}
+	}
+	int64_t t1 = g_get_monotonic_time ();
+	for (int i = 0; i < n_chunks; ++i) {
+		gdither_runf_interleaved (vec, chunk_size, &data[0], &out[0]);
+	}
+	int64_t t2 = g_get_monotonic_time ();
+
+	gdither_free (ref);
+	gdither_free (vec);
+
+	/* million samples per second */
+	const double n_samples = (double) chunk_size * channels * n_chunks;
+	cout << setw (10) << name
+	     << fixed << setprecision (1)
+	     << setw (16) << n_samples / max<int64_t> (1, t1 - t0)
+	     << setw (16) << n_samples / max<int64_t> (1, t2 - t1)
+	     << "\n";
+}
+
+int
+main (int argc, char* argv[])
+{
+	uint32_t channels = argc > 1 ? atoi (argv[1]) : 2;
+	int      n_chunks = argc > 2 ? atoi (argv[2]) : 200;
+
+	if (channels == 0 || n_chunks <= 0) {
+		cerr << "Usage: " << argv[0] << " [channels [chunks]]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	vector<float> data (chunk_size * channels);
+	for (size_t i = 0; i < data.size (); ++i) {
+		data[i] = g_random_double_range (-1.1, 1.1);
+	}
+
+	char const* const type_names[] = { "none", "rect", "tri", "shaped" };
+	GDitherType const types[] = { GDitherNone, GDitherRect, GDitherTri, GDitherShaped };
+
+	for (size_t t = 0; t < sizeof (types) / sizeof (types[0]); ++t) {
+		cout << channels << " channels, " << type_names[t] << " dither\n"
+		     << "    format  per-chan [Ms/s]  interleaved [Ms/s]\n";
+		bench<uint8_t> (types[t], GDither8bit, "8bit", channels, n_chunks, data);
+		bench<int16_t> (types[t], GDither16bit, "16bit", channels, n_chunks, data);
+		bench<int32_t> (types[t], GDither32bit, "24bit", channels, n_chunks, data);
+	}
+
+	return 0;
+}
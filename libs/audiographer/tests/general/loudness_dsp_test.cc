@@ -0,0 +1,263 @@
+#include "tests/utils.h"
+
+#include <cmath>
+#include <vector>
+
+#include "audiographer/general/loudness_dsp.h"
+
+using namespace AudioGrapher;
+
+/* Conformance tests, using the signals and tolerances of the minimum
+ * requirements in EBU Tech 3341 (loudness, true-peak) and EBU Tech 3342
+ * (loudness range). Unless noted otherwise, signals are a stereo 1 kHz
+ * sine, levels are per channel.
+ */
+
+class LoudnessDspTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE (LoudnessDspTest);
+  CPPUNIT_TEST (testIntegrated);
+  CPPUNIT_TEST (testMomentaryShortTerm);
+  CPPUNIT_TEST (testLoudnessRange);
+  CPPUNIT_TEST (testChannels);
+  CPPUNIT_TEST (testTruePeak);
+  CPPUNIT_TEST_SUITE_END ();
+
+  public:
+	void setUp()
+	{
+		sample_rate = 48000;
+	}
+
+	void tearDown()
+	{
+	}
+
+	void testIntegrated()
+	{
+		// Tech 3341, cases 1 - 5
+		const Segment c1[] = { { -23, 20 } };
+		const Segment c2[] = { { -33, 20 } };
+		const Segment c3[] = { { -36, 10 }, { -23, 60 }, { -36, 10 } };
+		const Segment c4[] = { { -72, 10 }, { -36, 10 }, { -23, 60 }, { -36, 10 }, { -72, 10 } };
+		const Segment c5[] = { { -26, 20 }, { -20, 20.1 }, { -26, 20 } };
+
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, integrated (c1, 1), 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-33.0, integrated (c2, 1), 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, integrated (c3, 3), 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, integrated (c4, 5), 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, integrated (c5, 3), 0.1);
+
+		// non-interleaved input
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, integrated (c3, 3, 2, false), 0.1);
+
+		// Tech 3341, case 6: 5.0 channels, L, R at -28 dBFS, C at -24 dBFS, Ls, Rs at -30 dBFS
+		const Segment c6[] = { { -28, 20 } };
+		const float   c6_chan[] = { 0, 0, 4, -2, -2 };
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, integrated (c6, 1, 5, true, c6_chan), 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, integrated (c6, 1, 5, false, c6_chan), 0.1);
+	}
+
+	void testMomentaryShortTerm()
+	{
+		// Tech 3341, cases 1 and 2: M, S and I
+		const Segment c1[] = { { -23, 20 } };
+		const Segment c2[] = { { -33, 20 } };
+
+		LoudnessDsp ebu;
+		ebu.init (2, sample_rate);
+		ebu.integr_start ();
+		generate (ebu, c1, 1, 2, true);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, ebu.loudness_M (), 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, ebu.loudness_S (), 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, ebu.max_loudness_M (), 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, ebu.max_loudness_S (), 0.1);
+
+		ebu.init (2, sample_rate);
+		ebu.integr_start ();
+		generate (ebu, c2, 1, 2, true);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-33.0, ebu.loudness_M (), 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-33.0, ebu.loudness_S (), 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-33.0, ebu.integrated (), 0.1);
+
+		// Tech 3341, case 9: -20 dBFS for 1.34 s and -30 dBFS for 1.66 s,
+		// alternating. S is -23.0 LUFS, constant after 3 s
+		std::vector<Segment> c9;
+		for (int i = 0; i < 5; ++i) {
+			const Segment s[] = { { -20, 1.34 }, { -30, 1.66 } };
+			c9.insert (c9.end (), s, s + 2);
+		}
+		Range s9;
+		ebu.init (2, sample_rate);
+		generate (ebu, &c9[0], c9.size (), 2, true, 0, 3.0, 0, &s9);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, s9.lo, 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, s9.hi, 0.1);
+
+		// Tech 3341, case 12: -20 dBFS for 0.18 s and -30 dBFS for 0.22 s,
+		// alternating. M is -23.0 LUFS, constant after 1 s
+		std::vector<Segment> c12;
+		for (int i = 0; i < 20; ++i) {
+			const Segment s[] = { { -20, 0.18 }, { -30, 0.22 } };
+			c12.insert (c12.end (), s, s + 2);
+		}
+		Range m12;
+		ebu.init (2, sample_rate);
+		generate (ebu, &c12[0], c12.size (), 2, true, 0, 1.0, &m12, 0);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, m12.lo, 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, m12.hi, 0.1);
+	}
+
+	void testLoudnessRange()
+	{
+		// Tech 3342, cases 1 - 4
+		const Segment c1[] = { { -20, 20 }, { -30, 20 } };
+		const Segment c2[] = { { -20, 20 }, { -15, 20 } };
+		const Segment c3[] = { { -40, 20 }, { -20, 20 } };
+		const Segment c4[] = { { -50, 20 }, { -35, 20 }, { -20, 20 }, { -35, 20 }, { -50, 20 } };
+
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (10.0, loudness_range (c1, 2), 1.0);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (5.0, loudness_range (c2, 2), 1.0);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (20.0, loudness_range (c3, 2), 1.0);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (15.0, loudness_range (c4, 5), 1.0);
+	}
+
+	void testChannels()
+	{
+		const Segment c1[] = { { -23, 20 } };
+		// mono is counted twice, as if played on both speakers
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, integrated (c1, 1, 1), 0.1);
+
+		// Tech 3341, case 6 as 5.1 (L, R, C, LFE, Ls, Rs), the LFE at 0 dBFS is not measured
+		const Segment c6[] = { { -28, 20 } };
+		const float   c6_lfe[] = { 0, 0, 4, 28, -2, -2 };
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, integrated (c6, 1, 6, true, c6_lfe), 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, integrated (c6, 1, 6, false, c6_lfe), 0.1);
+
+		// 7.1 (L, R, C, LFE, Ls, Rs, Lrs, Rrs), rear channels are weighted 1.0:
+		// case 6 plus Lrs, Rrs at -28 dBFS
+		const float c6_71[] = { 0, 0, 4, 28, -2, -2, 0, 0 };
+		const double l71 = -28.0 + 10 * log10 ((4 + pow (10, 0.4) + 2 * 1.41 * pow (10, -0.2)) / 2);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (l71, integrated (c6, 1, 8, true, c6_71), 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (l71, integrated (c6, 1, 8, false, c6_71), 0.1);
+
+		// quad (L, R, Ls, Rs): case 6 without the centre channel
+		const float c6_quad[] = { 0, 0, -2, -2 };
+		const double lquad = -28.0 + 10 * log10 ((2 + 2 * 1.41 * pow (10, -0.2)) / 2);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (lquad, integrated (c6, 1, 4, true, c6_quad), 0.1);
+	}
+
+	void testTruePeak()
+	{
+		// Tech 3341, cases 15 - 19: -6.0 dBTP (+3.0 dBTP for case 19), -0.4 .. +0.2 dB
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-6.1, true_peak (sample_rate / 4, 0, 0.5), 0.3);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-6.1, true_peak (sample_rate / 4, 45, 0.5), 0.3);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-6.1, true_peak (sample_rate / 6, 60, 0.5), 0.3);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-6.1, true_peak (sample_rate / 8, 67.5, 0.5), 0.3);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (2.9, true_peak (sample_rate / 4, 45, 1.41), 0.3);
+	}
+
+  private:
+	struct Segment {
+		float  dbfs;
+		double seconds;
+	};
+
+	/* lowest and highest value of M or S */
+	struct Range {
+		Range () : lo (1000), hi (-1000) {}
+		void add (float v) { lo = std::min (lo, v); hi = std::max (hi, v); }
+		float lo;
+		float hi;
+	};
+
+	/* 1kHz sine, optionally with a per channel level offset [dB].
+	 * M and S are tracked from \a track_after seconds on.
+	 */
+	void generate (LoudnessDsp& ebu, Segment const* seg, size_t n_seg, unsigned int n_channels, bool interleaved,
+	               float const* chan_db = 0, double track_after = 0, Range* M = 0, Range* S = 0)
+	{
+		const samplecnt_t bufsize = 480;
+		std::vector<float> buf (bufsize * n_channels);
+		std::vector<float const*> bufs (n_channels);
+		std::vector<float> chan_gain (n_channels, 1.f);
+		for (unsigned int c = 0; c < n_channels; ++c) {
+			bufs[c] = &buf[c * bufsize];
+			if (chan_db) {
+				chan_gain[c] = powf (10.f, chan_db[c] / 20.f);
+			}
+		}
+
+		double phase = 0;
+		samplecnt_t pos = 0;
+
+		for (size_t i = 0; i < n_seg; ++i) {
+			const float gain = powf (10.f, seg[i].dbfs / 20.f);
+			samplecnt_t remain = lrint (seg[i].seconds * sample_rate);
+			while (remain > 0) {
+				const samplecnt_t n = std::min (remain, bufsize);
+				for (samplecnt_t s = 0; s < n; ++s) {
+					const float v = gain * sin (phase);
+					phase += 2 * M_PI * 1000 / sample_rate;
+					for (unsigned int c = 0; c < n_channels; ++c) {
+						if (interleaved) {
+							buf[s * n_channels + c] = v * chan_gain[c];
+						} else {
+							buf[c * bufsize + s] = v * chan_gain[c];
+						}
+					}
+				}
+				if (interleaved) {
+					ebu.process (&buf[0], n);
+				} else {
+					ebu.process (&bufs[0], n);
+				}
+				remain -= n;
+				pos += n;
+				if (pos >= track_after * sample_rate) {
+					if (M) { M->add (ebu.loudness_M ()); }
+					if (S) { S->add (ebu.loudness_S ()); }
+				}
+			}
+		}
+	}
+
+	float integrated (Segment const* seg, size_t n_seg, unsigned int n_channels = 2, bool interleaved = true, float const* chan_db = 0)
+	{
+		LoudnessDsp ebu;
+		ebu.init (n_channels, sample_rate);
+		ebu.integr_start ();
+		generate (ebu, seg, n_seg, n_channels, interleaved, chan_db);
+		return ebu.integrated ();
+	}
+
+	float loudness_range (Segment const* seg, size_t n_seg)
+	{
+		LoudnessDsp ebu;
+		ebu.init (2, sample_rate);
+		ebu.integr_start ();
+		generate (ebu, seg, n_seg, 2, true);
+		return ebu.loudness_range ();
+	}
+
+	float true_peak (double freq, double phase_deg, float gain)
+	{
+		std::vector<float> data ((size_t) sample_rate);
+		for (size_t i = 0; i < data.size (); ++i) {
+			data[i] = gain * sin (2 * M_PI * freq * i / sample_rate + phase_deg * M_PI / 180);
+		}
+
+		TruePeakDsp tp;
+		/* skip the onset of the sine, the interpolation filter rings */
+		tp.process (&data[0], 100);
+
+		float peak = 0;
+		for (size_t i = 100; i < data.size (); i += 997) {
+			peak = std::max (peak, tp.process (&data[i], std::min<size_t> (997, data.size () - i)));
+		}
+		return 20 * log10f (peak);
+	}
+
+	float sample_rate;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION (LoudnessDspTest);
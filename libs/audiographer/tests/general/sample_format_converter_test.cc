@@ -1,6 +1,7 @@
 #include "tests/utils.h"
 
 #include "audiographer/general/sample_format_converter.h"
+#include "private/gdither/gdither.h"
 
 using namespace AudioGrapher;
 
@@ -15,6 +16,7 @@ class SampleFormatConverterTest : public CppUnit::TestFixture
   CPPUNIT_TEST (testInt16);
   CPPUNIT_TEST (testUint8);
   CPPUNIT_TEST (testChannelCount);
+  CPPUNIT_TEST (testInterleavedDither);
   CPPUNIT_TEST_SUITE_END ();
 
   public:
@@ -204,8 +206,55 @@ class SampleFormatConverterTest : public CppUnit::TestFixture
 		CPPUNIT_ASSERT (TestUtils::array_filled(sink->get_array(), pc.samples()));
 	}
 
+	void testInterleavedDither()
+	{
+		// The vectorised path must produce exactly the same output as gdither_runf()
+		GDitherType const types[] = { GDitherNone, GDitherRect, GDitherTri, GDitherShaped };
+		for (size_t t = 0; t < sizeof (types) / sizeof (types[0]); ++t) {
+			check_interleaved<uint8_t> (types[t], GDither8bit, 8);
+			check_interleaved<int16_t> (types[t], GDither16bit, 16);
+			check_interleaved<int16_t> (types[t], GDither16bit, 12);
+			check_interleaved<int32_t> (types[t], GDither32bit, 24);
+		}
+	}
+
   private:
 
+	template<typename T>
+	void check_interleaved (GDitherType type, GDitherSize size, int depth)
+	{
+		unsigned int const channels[] = { 1, 2, 3, 5, 8, 64 };
+		samplecnt_t const lengths[] = { 1, 3, 4, 255, 256, 257, 1000 };
+
+		for (size_t c = 0; c < sizeof (channels) / sizeof (channels[0]); ++c) {
+			unsigned int const n_channels = channels[c];
+			GDither ref = gdither_new (type, n_channels, size, depth);
+			GDither vec = gdither_new (type, n_channels, size, depth);
+
+			// several consecutive calls, to also compare the dither state
+			for (size_t l = 0; l < sizeof (lengths) / sizeof (lengths[0]); ++l) {
+				samplecnt_t const n = lengths[l] * n_channels;
+				float * data = TestUtils::init_random_data (n, 3.0); // includes out of range values
+				data[n / 2] = 1e10f;
+				data[n - 1] = -1e10f;
+
+				std::vector<T> ref_out (n);
+				std::vector<T> vec_out (n);
+
+				for (unsigned int chn = 0; chn < n_channels; ++chn) {
+					gdither_runf (ref, chn, lengths[l], data, &ref_out[0]);
+				}
+				gdither_runf_interleaved (vec, lengths[l], data, &vec_out[0]);
+
+				delete [] data;
+				CPPUNIT_ASSERT (ref_out == vec_out);
+			}
+
+			gdither_free (ref);
+			gdither_free (vec);
+		}
+	}
+
 	float * random_data;
 	samplecnt_t samples;
 };
@@ -11,6 +11,8 @@ class ThreaderTest : public CppUnit::TestFixture
   CPPUNIT_TEST (testRemoveOutput);
   CPPUNIT_TEST (testClearOutputs);
   CPPUNIT_TEST (testExceptions);
+  CPPUNIT_TEST (testNested);
+  CPPUNIT_TEST (testRepeated);
   CPPUNIT_TEST_SUITE_END ();
 
   public:
@@ -22,7 +24,7 @@ class ThreaderTest : public CppUnit::TestFixture
 		zero_data = new float[samples];
 		memset (zero_data, 0, samples * sizeof(float));
 
-		thread_pool = new Glib::ThreadPool (3);
+		thread_pool = new ThreaderPool (3);
 		threader.reset (new Threader<float> (*thread_pool));
 
 		sink_a.reset (new VectorSink<float>());
@@ -40,7 +42,6 @@ class ThreaderTest : public CppUnit::TestFixture
 		delete [] random_data;
 		delete [] zero_data;
 
-		thread_pool->shutdown();
 		delete thread_pool;
 	}
 
@@ -134,8 +135,49 @@ class ThreaderTest : public CppUnit::TestFixture
 		CPPUNIT_ASSERT (TestUtils::array_equals(random_data, sink_e->get_array(), samples));
 	}
 
+	void testNested()
+	{
+		/* a Threader feeding another Threader using the same pool */
+		boost::shared_ptr<Threader<float> > inner (new Threader<float> (*thread_pool));
+		inner->add_output (sink_c);
+		inner->add_output (sink_d);
+
+		threader->add_output (sink_a);
+		threader->add_output (inner);
+		threader->add_output (sink_b);
+
+		ProcessContext<float> c (random_data, samples, 1);
+		threader->process (c);
+
+		CPPUNIT_ASSERT (TestUtils::array_equals(random_data, sink_a->get_array(), samples));
+		CPPUNIT_ASSERT (TestUtils::array_equals(random_data, sink_b->get_array(), samples));
+		CPPUNIT_ASSERT (TestUtils::array_equals(random_data, sink_c->get_array(), samples));
+		CPPUNIT_ASSERT (TestUtils::array_equals(random_data, sink_d->get_array(), samples));
+	}
+
+	void testRepeated()
+	{
+		/* many consecutive chunks, alternating data */
+		threader->add_output (sink_a);
+		threader->add_output (sink_b);
+		threader->add_output (sink_c);
+		threader->add_output (sink_d);
+		threader->add_output (sink_e);
+		threader->add_output (sink_f);
+
+		ProcessContext<float> c (random_data, samples, 1);
+		ProcessContext<float> zc (zero_data, samples, 1);
+
+		for (int i = 0; i < 1000; ++i) {
+			threader->process (zc);
+			threader->process (c);
+			CPPUNIT_ASSERT (TestUtils::array_equals(random_data, sink_a->get_array(), samples));
+			CPPUNIT_ASSERT (TestUtils::array_equals(random_data, sink_f->get_array(), samples));
+		}
+	}
+
   private:
-	Glib::ThreadPool * thread_pool;
+	ThreaderPool * thread_pool;
 
 	boost::shared_ptr<Threader<float> > threader;
 	boost::shared_ptr<VectorSink<float> > sink_a;
@@ -32,6 +32,7 @@
 
 #include "evoral/Event.h"
 #include "evoral/SMF.h"
+#include "evoral/SMFMap.h"
 #include "evoral/midi_util.h"
 
 #ifdef COMPILER_MSVC
@@ -47,6 +48,9 @@ SMF::SMF()
 	, _smf_track (0)
 	, _empty (true)
 	, _type0 (false)
+	, _file_track (1)
+	, _file_num_tracks (0)
+	, _file_ppqn (0)
 	{};
 
 SMF::~SMF()
@@ -58,14 +62,67 @@ uint16_t
 SMF::num_tracks() const
 {
 	Glib::Threads::Mutex::Lock lm (_smf_lock);
-	return _smf ? _smf->number_of_tracks : 0;
+	return _smf ? _smf->number_of_tracks : _file_num_tracks;
 }
 
 uint16_t
 SMF::ppqn() const
 {
 	Glib::Threads::Mutex::Lock lm (_smf_lock);
-	return _smf->ppqn;
+	return _smf ? _smf->ppqn : _file_ppqn;
+}
+
+bool
+SMF::loaded () const
+{
+	Glib::Threads::Mutex::Lock lm (_smf_lock);
+	return _smf != 0;
+}
+
+void
+SMF::set_file_path (std::string const& path)
+{
+	Glib::Threads::Mutex::Lock lm (_smf_lock);
+	if (!_file_path.empty ()) {
+		_file_path = path;
+	}
+}
+
+/** Parse the file with libsmf, if that has not been done yet.
+ * Must be called with _smf_lock held.
+ * \return true if _smf and _smf_track are valid
+ */
+bool
+SMF::load () const
+{
+	if (_smf) {
+		return _smf_track != 0;
+	}
+
+	if (_file_path.empty ()) {
+		return false;
+	}
+
+	SMFMap map;
+	if (map.open (_file_path)) {
+		return false;
+	}
+
+	/* libsmf only reads from the buffer */
+	_smf = smf_load_from_memory (const_cast<uint8_t*> (map.data ()), map.size ());
+	if (!_smf) {
+		return false;
+	}
+
+	smf_rewind (_smf);
+
+	_smf_track = smf_get_track_by_number (_smf, _file_track);
+	if (!_smf_track) {
+		return false;
+	}
+
+	_smf_track->next_event_number = (_smf_track->number_of_events == 0) ? 0 : 1;
+	return true;
 }
 
 /** Seek to the specified track (1-based indexing)
@@ -75,6 +132,9 @@ int
 SMF::seek_to_track(int track)
 {
 	Glib::Threads::Mutex::Lock lm (_smf_lock);
+	if (!load ()) {
+		return -1;
+	}
 	_smf_track = smf_get_track_by_number(_smf, track);
 	if (_smf_track != NULL) {
 		_smf_track->next_event_number = (_smf_track->number_of_events == 0) ? 0 : 1;
@@ -126,46 +186,39 @@ SMF::open(const std::string& path, int track)
 	assert(track >= 1);
 	if (_smf) {
 		smf_delete(_smf);
+		_smf = 0;
+		_smf_track = 0;
 	}
+	_file_path.clear ();
 
-	FILE* f = g_fopen(path.c_str(), "r");
-	if (f == 0) {
-		return -1;
-	} else if ((_smf = smf_load(f)) == 0) {
-		fclose(f);
+	/* Only check the header and track chunks here. libsmf parses the
+	 * file on demand, which is not needed to load the model (see SMFMap).
+	 */
+	SMFMap map;
+	if (map.open (path)) {
 		return -1;
-	} else if ((_smf_track = smf_get_track_by_number(_smf, track)) == 0) {
-		fclose(f);
+	} else if (track > map.num_tracks ()) {
 		return -2;
 	}
 
-	//cerr << "Track " << track << " # events: " << _smf_track->number_of_events << endl;
-	if (_smf_track->number_of_events == 0) {
-		_smf_track->next_event_number = 0;
-		_empty = true;
-	} else {
-		_smf_track->next_event_number = 1;
-		_empty = false;
-	}
+	_file_path       = path;
+	_file_track      = track;
+	_file_num_tracks = map.num_tracks ();
+	_file_ppqn       = map.ppqn ();
+	_empty           = map.track_is_empty (track);
 
-	fclose(f);
-
-	lm.release ();
-	if (_smf->format == 0 && _smf->number_of_tracks == 1 && !_empty) {
+	if (map.format () == 0 && map.num_tracks () == 1 && !_empty) {
 		// type-0 file: scan file for # of used channels.
+		SMFMap::TrackReader reader (map, 1);
 		int ret;
 		uint32_t delta_t = 0;
 		uint32_t size    = 0;
-		uint8_t* buf     = NULL;
+		uint8_t const* buf = NULL;
 		event_id_t event_id = 0;
-		seek_to_start();
-		while ((ret = read_event (&delta_t, &size, &buf, &event_id)) >= 0) {
+		while ((ret = reader.read_event (&delta_t, &buf, &size, &event_id)) >= 0) {
 			if (ret == 0) {
 				continue;
 			}
-			if (size == 0) {
-				break;
-			}
 			uint8_t type = buf[0] & 0xf0;
 			uint8_t chan = buf[0] & 0x0f;
 			if (type < 0x80 || type > 0xE0) {
@@ -173,9 +226,7 @@ SMF::open(const std::string& path, int track)
 			}
 			_type0channels.insert(chan);
 		}
-		free (buf);
 		_type0 = true;
-		seek_to_start();
 	}
 	return 0;
 }
@@ -196,6 +247,7 @@ SMF::create(const std::string& path, int track, uint16_t ppqn)
 	if (_smf) {
 		smf_delete(_smf);
 	}
+	_file_path.clear ();
 
 	_smf = smf_new();
 
@@ -252,16 +304,18 @@ SMF::close()
 		smf_delete(_smf);
 		_smf = 0;
 		_smf_track = 0;
-		_type0 = false;
-		_type0channels.clear ();
 	}
+	_file_path.clear ();
+	_file_num_tracks = 0;
+	_type0 = false;
+	_type0channels.clear ();
 }
 
 void
 SMF::seek_to_start() const
 {
 	Glib::Threads::Mutex::Lock lm (_smf_lock);
-	if (_smf_track) {
+	if (load ()) {
 		_smf_track->next_event_number = std::min(_smf_track->number_of_events, (size_t)1);
 	} else {
 		cerr << "WARNING: SMF seek_to_start() with no track" << endl;
@@ -297,6 +351,10 @@ SMF::read_event(uint32_t* delta_t, uint32_t* size, uint8_t** buf, event_id_t* no
 	assert(buf);
 	assert(note_id);
 
+	if (!load ()) {
+		return -1;
+	}
+
 	if ((event = smf_track_get_next_event(_smf_track)) != NULL) {
 
 		*delta_t = event->delta_time_pulses;
@@ -364,7 +422,7 @@ SMF::append_event_delta(uint32_t delta_t, uint32_t size, const uint8_t* buf, eve
 {
 	Glib::Threads::Mutex::Lock lm (_smf_lock);
 
-	if (size == 0) {
+	if (size == 0 || !load ()) {
 		return;
 	}
 
@@ -455,19 +513,28 @@ SMF::append_event_delta(uint32_t delta_t, uint32_t size, const uint8_t* buf, eve
 	_empty = false;
 }
 
-void
+/** Replace the current track by a new, empty one.
+ * \return 0 on success
+ */
+int
 SMF::begin_write()
 {
 	Glib::Threads::Mutex::Lock lm (_smf_lock);
 
-	assert(_smf_track);
+	if (!load ()) {
+		return -1;
+	}
+
 	smf_track_delete(_smf_track);
 
 	_smf_track = smf_track_new();
-	assert(_smf_track);
+	if (!_smf_track) {
+		return -1;
+	}
 
 	smf_add_track(_smf, _smf_track);
 	assert(_smf->number_of_tracks == 1);
+	return 0;
 }
 
 void
@@ -503,14 +570,14 @@ SMF::round_to_file_precision (double val) const
 void
 SMF::track_names(vector<string>& names) const
 {
-	if (!_smf) {
+	Glib::Threads::Mutex::Lock lm (_smf_lock);
+
+	if (!load ()) {
 		return;
 	}
 
 	names.clear ();
 
-	Glib::Threads::Mutex::Lock lm (_smf_lock);
-
 	for (uint16_t n = 0; n < _smf->number_of_tracks; ++n) {
 		smf_track_t* trk = smf_get_track_by_number (_smf, n+1);
 		if (!trk) {
@@ -528,14 +595,14 @@ SMF::track_names(vector<string>& names) const
 void
 SMF::instrument_names(vector<string>& names) const
 {
-	if (!_smf) {
+	Glib::Threads::Mutex::Lock lm (_smf_lock);
+
+	if (!load ()) {
 		return;
 	}
 
 	names.clear ();
 
-	Glib::Threads::Mutex::Lock lm (_smf_lock);
-
 	for (uint16_t n = 0; n < _smf->number_of_tracks; ++n) {
 		smf_track_t* trk = smf_get_track_by_number (_smf, n+1);
 		if (!trk) {
@@ -563,14 +630,20 @@ SMF::Tempo::Tempo (smf_tempo_t* smft)
 int
 SMF::num_tempos () const
 {
-	assert (_smf);
+	Glib::Threads::Mutex::Lock lm (_smf_lock);
+	if (!load ()) {
+		return 0;
+	}
 	return smf_get_tempo_count (_smf);
 }
 
 SMF::Tempo*
 SMF::nth_tempo (size_t n) const
 {
-	assert (_smf);
+	Glib::Threads::Mutex::Lock lm (_smf_lock);
+	if (!load ()) {
+		return 0;
+	}
 
 	smf_tempo_t* t = smf_get_tempo_by_number (_smf, n);
 	if (!t) {
@@ -0,0 +1,433 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fcntl.h>
+
+#ifdef PLATFORM_WINDOWS
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <glib.h>
+#include "pbd/gstdio_compat.h"
+
+#include "evoral/SMFMap.h"
+#include "evoral/midi_util.h"
+
+using namespace Evoral;
+
+static inline uint32_t
+read_be32 (uint8_t const* p)
+{
+	return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | p[3];
+}
+
+static inline uint16_t
+read_be16 (uint8_t const* p)
+{
+	return ((uint16_t) p[0] << 8) | p[1];
+}
+
+/** Read a variable length quantity of at most 4 bytes, advance @a pos.
+ * \return false if the VLQ is truncated or too long
+ */
+static inline bool
+read_vlq (uint8_t const*& pos, uint8_t const* end, uint32_t& value)
+{
+	value = 0;
+	for (int i = 0; i < 4; ++i) {
+		if (pos >= end) {
+			return false;
+		}
+		const uint8_t c = *pos++;
+		value = (value << 7) | (c & 0x7f);
+		if (!(c & 0x80)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/** Size of a non-SysEx, non-meta event including the status byte
+ * (same as libsmf's expected_message_length), or -1 if unsupported.
+ */
+static inline int
+message_length (uint8_t status)
+{
+	switch (status & 0xf0) {
+	case 0x80:
+	case 0x90:
+	case 0xa0:
+	case 0xb0:
+	case 0xe0:
+		return 3;
+	case 0xc0:
+	case 0xd0:
+		return 2;
+	default:
+		break;
+	}
+
+	switch (status) {
+	case 0xf2:
+		return 3;
+	case 0xf1:
+	case 0xf3:
+		return 2;
+	case 0xf6:
+	case 0xf8:
+	case 0xf9:
+	case 0xfa:
+	case 0xfb:
+	case 0xfc:
+	case 0xfe:
+		return 1;
+	default:
+		return -1;
+	}
+}
+
+SMFMap::SMFMap ()
+	: _data (0)
+	, _size (0)
+	, _format (0)
+	, _ppqn (0)
+{
+}
+
+SMFMap::~SMFMap ()
+{
+	close ();
+}
+
+int
+SMFMap::open (std::string const& path)
+{
+	close ();
+
+	GStatBuf statbuf;
+	if (::g_stat (path.c_str (), &statbuf) != 0 || statbuf.st_size < 14) {
+		return -1;
+	}
+
+	int fd = ::g_open (path.c_str (), O_RDONLY, 0444);
+	if (fd == -1) {
+		return -1;
+	}
+
+	_size = statbuf.st_size;
+
+#ifdef PLATFORM_WINDOWS
+	HANDLE file_handle = (HANDLE) _get_osfhandle (fd);
+	HANDLE map_handle  = CreateFileMapping (file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (map_handle == NULL) {
+		::close (fd);
+		return -1;
+	}
+	LPVOID view_handle = MapViewOfFile (map_handle, FILE_MAP_READ, 0, 0, _size);
+	CloseHandle (map_handle);
+	::close (fd);
+	if (view_handle == NULL) {
+		return -1;
+	}
+	_data = (uint8_t const*) view_handle;
+#else
+	void* addr = mmap (NULL, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+	/* the mapping remains valid after the file is closed */
+	::close (fd);
+	if (addr == MAP_FAILED) {
+		return -1;
+	}
+	_data = (uint8_t const*) addr;
+#ifdef POSIX_MADV_SEQUENTIAL
+	posix_madvise (addr, _size, POSIX_MADV_SEQUENTIAL);
+#endif
+#endif
+
+	if (parse_header ()) {
+		close ();
+		return -2;
+	}
+	return 0;
+}
+
+void
+SMFMap::close ()
+{
+	if (_data) {
+#ifdef PLATFORM_WINDOWS
+		UnmapViewOfFile (_data);
+#else
+		munmap (const_cast<uint8_t*> (_data), _size);
+#endif
+	}
+	_data   = 0;
+	_size   = 0;
+	_format = 0;
+	_ppqn   = 0;
+	_tracks.clear ();
+}
+
+int
+SMFMap::parse_header ()
+{
+	/* MThd chunk, length 6: format, number of tracks, division */
+	if (memcmp (_data, "MThd", 4) || read_be32 (_data + 4) != 6) {
+		return -1;
+	}
+
+	_format = read_be16 (_data + 8);
+	const uint16_t n_tracks = read_be16 (_data + 10);
+	const uint16_t division = read_be16 (_data + 12);
+
+	if (_format > 1 || n_tracks == 0) {
+		return -1;
+	}
+	if ((division & 0x8000) || division == 0) {
+		/* SMPTE timing */
+		return -1;
+	}
+	_ppqn = division;
+
+	/* like libsmf, stop at the first chunk that is not a track */
+	uint8_t const* const end = _data + _size;
+	uint8_t const* pos = _data + 14;
+
+	for (uint16_t i = 0; i < n_tracks; ++i) {
+		if (end - pos < 8) {
+			break;
+		}
+		if (!isalpha (pos[0]) || !isalpha (pos[1]) || !isalpha (pos[2]) || !isalpha (pos[3])) {
+			break;
+		}
+		if (memcmp (pos, "MTrk", 4)) {
+			break;
+		}
+		const uint32_t len = read_be32 (pos + 4);
+		uint8_t const* track_end = (size_t) (end - pos - 8) < len ? end : pos + 8 + len;
+		_tracks.push_back (Track (pos + 8, track_end));
+		pos = track_end;
+	}
+
+	return 0;
+}
+
+bool
+SMFMap::track_is_empty (uint16_t track) const
+{
+	if (track < 1 || track > _tracks.size ()) {
+		return true;
+	}
+	return _tracks[track - 1].begin == _tracks[track - 1].end;
+}
+
+SMFMap::TrackReader::TrackReader (SMFMap const& map, uint16_t track)
+	: _pos (0)
+	, _end (0)
+	, _status (0)
+{
+	if (track >= 1 && track <= map._tracks.size ()) {
+		_pos = map._tracks[track - 1].begin;
+		_end = map._tracks[track - 1].end;
+	}
+}
+
+int
+SMFMap::TrackReader::read_event (uint32_t* delta_t, uint8_t const** buf, uint32_t* size, event_id_t* note_id)
+{
+	if (_pos >= _end || !read_vlq (_pos, _end, *delta_t) || _pos >= _end) {
+		_pos = _end;
+		return -1;
+	}
+
+	bool running = false;
+	uint8_t status = *_pos;
+
+	if (status & 0x80) {
+		++_pos;
+	} else {
+		/* running status is not applicable to meta-events and SysEx */
+		status  = _status;
+		running = true;
+		if (!(status & 0x80) || status == 0xff || status == 0xf0 || status == 0xf7) {
+			_pos = _end;
+			return -1;
+		}
+	}
+
+	_status = status;
+
+	if (status == 0xff) {
+		uint32_t len;
+		if (_pos >= _end) {
+			return -1;
+		}
+		const uint8_t type = *_pos++;
+		if (!read_vlq (_pos, _end, len) || (size_t) (_end - _pos) < len || type == 0x2f) {
+			/* truncated, or End Of Track */
+			_pos = _end;
+			return -1;
+		}
+
+		*buf     = _pos;
+		*size    = len;
+		*note_id = -1;
+
+		if (type == 0x7f && len > 2 && _pos[0] == 0x99 && _pos[1] == 0x01) {
+			/* Sequencer-specific: Evoral Note ID */
+			uint8_t const* p = _pos + 2;
+			uint32_t id;
+			if (read_vlq (p, _pos + len, id)) {
+				*note_id = id;
+			}
+		}
+
+		_pos += len;
+		return 0;
+	}
+
+	if (status == 0xf0 || status == 0xf7) {
+		uint32_t len;
+		if (!read_vlq (_pos, _end, len) || len == 0 || (size_t) (_end - _pos) < len) {
+			_pos = _end;
+			return -1;
+		}
+		if (status == 0xf0) {
+			/* SysEx: the file stores the length instead of the status byte */
+			if (_pos[len - 1] != 0xf7) {
+				_pos = _end;
+				return -1;
+			}
+			_sysex.resize (len + 1);
+			_sysex[0] = 0xf0;
+			memcpy (&_sysex[1], _pos, len);
+			*buf  = &_sysex[0];
+			*size = len + 1;
+		} else {
+			/* escaped event, stored verbatim */
+			*buf  = _pos;
+			*size = len;
+		}
+		_pos += len;
+	} else {
+		const int n = message_length (status);
+		if (n < 0 || _end - _pos < n - 1) {
+			_pos = _end;
+			return -1;
+		}
+
+		if (running) {
+			_scratch[0] = status;
+			memcpy (&_scratch[1], _pos, n - 1);
+			*buf = _scratch;
+		} else {
+			*buf = _pos - 1;
+		}
+		*size = n;
+		_pos += n - 1;
+
+		if ((status & 0xf0) == 0x90 && (*buf)[2] == 0) {
+			/* normalize note on with velocity 0 to proper note off */
+			_scratch[0] = 0x80 | (status & 0x0f);
+			_scratch[1] = (*buf)[1];
+			_scratch[2] = 0x40;
+			*buf = _scratch;
+		}
+	}
+
+	if (!midi_event_is_valid (*buf, *size)) {
+		_pos = _end;
+		return -1;
+	}
+
+	return *size;
+}
+
+namespace {
+
+struct EventTimeCompare {
+	bool operator() (SMFMap::Event const& a, SMFMap::Event const& b) const {
+		return a.time < b.time;
+	}
+};
+
+}
+
+void
+SMFMap::read_events (std::vector<Event>& events, std::vector<uint8_t>& scratch) const
+{
+	events.clear ();
+	scratch.clear ();
+
+	/* an event takes at least 3 bytes in the file, except for running status */
+	events.reserve (_size / 3);
+
+	for (uint16_t t = 1; t <= num_tracks (); ++t) {
+		TrackReader reader (*this, t);
+
+		uint64_t       time     = 0;
+		uint32_t       delta_t  = 0;
+		uint32_t       size     = 0;
+		uint8_t const* buf      = 0;
+		event_id_t     event_id = -1;
+		event_id_t     note_id  = -1;
+		int            ret;
+
+		while ((ret = reader.read_event (&delta_t, &buf, &size, &event_id)) >= 0) {
+			time += delta_t;
+
+			if (ret == 0) {
+				/* event IDs must immediately precede the event they are for */
+				note_id = event_id;
+				continue;
+			}
+
+			Event ev;
+			ev.time = time;
+			ev.id   = note_id;
+			ev.size = size;
+
+			if (buf >= _data && buf < _data + _size) {
+				ev.buffer = buf;
+				ev.offset = 0;
+			} else {
+				ev.buffer = 0;
+				ev.offset = scratch.size ();
+				scratch.insert (scratch.end (), buf, buf + size);
+			}
+
+			events.push_back (ev);
+			note_id = -1;
+		}
+	}
+
+	/* scratch is complete, resolve its buffers */
+	for (std::vector<Event>::iterator i = events.begin (); i != events.end (); ++i) {
+		if (!i->buffer) {
+			i->buffer = &scratch[i->offset];
+		}
+	}
+
+	std::stable_sort (events.begin (), events.end (), EventTimeCompare ());
+}
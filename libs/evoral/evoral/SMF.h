@@ -24,6 +24,8 @@
 
 #include <glibmm/threads.h>
 #include <set>
+#include <string>
+#include <vector>
 
 #include "evoral/visibility.h"
 #include "evoral/types.h"
@@ -78,7 +80,7 @@ public:
 	uint16_t ppqn()       const;
 	bool     is_empty()   const { return _empty; }
 
-	void begin_write();
+	int  begin_write();
 	void append_event_delta(uint32_t delta_t, uint32_t size, const uint8_t* buf, event_id_t note_id);
 	void end_write(std::string const &);
 
@@ -118,12 +120,29 @@ public:
 
 	Tempo* nth_tempo (size_t n) const;
 
+	/** @return true if the file has been parsed by libsmf, and the
+	 * in-memory data may differ from the file on disk.
+	 * Otherwise the file can be read directly using SMFMap.
+	 */
+	bool loaded () const;
+
+	/** The file has been moved to @a path, read it from there when needed */
+	void set_file_path (std::string const& path);
+
   private:
-	smf_t*       _smf;
-	smf_track_t* _smf_track;
+	bool load () const;
+
+	mutable smf_t*       _smf;
+	mutable smf_track_t* _smf_track;
 	bool         _empty; ///< true iff file contains(non-empty) events
 	mutable Glib::Threads::Mutex _smf_lock;
 
+	/* file that is parsed on demand, see load() */
+	std::string _file_path;
+	int         _file_track;
+	uint16_t    _file_num_tracks;
+	uint16_t    _file_ppqn;
+
 	bool              _type0;
 	std::set<uint8_t> _type0channels;
 };
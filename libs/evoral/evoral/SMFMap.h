@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EVORAL_SMF_MAP_HPP
+#define EVORAL_SMF_MAP_HPP
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "evoral/visibility.h"
+#include "evoral/types.h"
+
+namespace Evoral {
+
+/** Read-only, memory-mapped Standard MIDI File.
+ *
+ * Only the header and the track chunk boundaries are parsed when the file
+ * is opened. Events are decoded in place while iterating over a track,
+ * without copying the file or allocating memory per event.
+ *
+ * The accepted subset and the event normalization match Evoral::SMF
+ * (which uses libsmf): format 0 and 1, PPQN timing, and Note-On with
+ * velocity 0 is reported as Note-Off.
+ */
+class LIBEVORAL_API SMFMap {
+public:
+	SMFMap ();
+	~SMFMap ();
+
+	/** Map the file at @a path.
+	 * \return  0 on success
+	 *         -1 if the file cannot be opened or mapped
+	 *         -2 if the file is not a supported SMF
+	 */
+	int  open (std::string const& path);
+	void close ();
+
+	uint8_t const* data () const { return _data; }
+	size_t         size () const { return _size; }
+
+	uint16_t format ()     const { return _format; }
+	uint16_t ppqn ()       const { return _ppqn; }
+	uint16_t num_tracks () const { return _tracks.size (); }
+
+	/** @return true if track @a track (1-based) does not contain any events */
+	bool track_is_empty (uint16_t track) const;
+
+	/** Sequential reader for one track of a mapped file.
+	 * The file must remain mapped while the reader is used.
+	 */
+	class LIBEVORAL_API TrackReader {
+	public:
+		TrackReader (SMFMap const&, uint16_t track);
+
+		/** Read the next event.
+		 *
+		 * @a buf is set to point to the event data. That is either inside
+		 * the mapped file, or, for running status, Note-On normalization
+		 * and SysEx, inside the reader; it remains valid until the next call.
+		 *
+		 * Meta-events set @a buf and @a size to their payload, and @a note_id
+		 * to the Evoral Note ID they carry, or -1.
+		 *
+		 * \return event size (including status byte) for MIDI events,
+		 * 0 for meta-events, or -1 at the end of the track. Corrupt or
+		 * invalid data also ends the track.
+		 */
+		int read_event (uint32_t* delta_t, uint8_t const** buf, uint32_t* size, event_id_t* note_id);
+
+	private:
+		uint8_t const*       _pos;
+		uint8_t const*       _end;
+		uint8_t              _status;
+		uint8_t              _scratch[3];
+		std::vector<uint8_t> _sysex;
+	};
+
+	/** A MIDI event of a mapped file, see read_events() */
+	struct Event {
+		uint64_t       time;   ///< absolute time in ticks, see ppqn()
+		event_id_t     id;     ///< Evoral Note ID or -1
+		uint32_t       size;
+		uint8_t const* buffer;
+		uint32_t       offset; ///< offset in scratch, if buffer is not inside the file
+	};
+
+	/** Collect the MIDI events of all tracks, sorted by time. Events at
+	 * the same time remain in track- and file-order.
+	 *
+	 * Event data that is not available verbatim in the file is copied to
+	 * @a scratch. Event buffers remain valid until the file is unmapped or
+	 * @a scratch is modified.
+	 */
+	void read_events (std::vector<Event>& events, std::vector<uint8_t>& scratch) const;
+
+private:
+	struct Track {
+		Track (uint8_t const* b, uint8_t const* e) : begin (b), end (e) {}
+		uint8_t const* begin;
+		uint8_t const* end;
+	};
+
+	int parse_header ();
+
+	uint8_t const*     _data;
+	size_t             _size;
+	uint16_t           _format;
+	uint16_t           _ppqn;
+	std::vector<Track> _tracks;
+};
+
+} // namespace Evoral
+
+#endif // EVORAL_SMF_MAP_HPP
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cstring>
+
 #include "SMFTest.h"
 
 #include <glibmm/fileutils.h>
@@ -5,6 +8,8 @@
 
 #include "pbd/file_utils.h"
 
+#include "evoral/SMFMap.h"
+
 using namespace std;
 
 CPPUNIT_TEST_SUITE_REGISTRATION( SMFTest );
@@ -100,11 +105,15 @@ SMFTest::writeTest ()
 	smf.open(testdata_path);
 	CPPUNIT_ASSERT(!smf.is_empty());
 
+	/* there is nothing to write to before open() or create() */
+	TestSMF unopened;
+	CPPUNIT_ASSERT (unopened.begin_write() != 0);
+
 	TestSMF out;
 	const string output_dir_path = PBD::tmp_writable_directory (PACKAGE, "writeTest");
 	const string new_file_path   = Glib::build_filename (output_dir_path, "TakeFiveCopy.mid");
 	CPPUNIT_ASSERT_EQUAL (0, out.create(new_file_path, 1, 1920));
-	out.begin_write();
+	CPPUNIT_ASSERT_EQUAL (0, out.begin_write());
 
 	uint32_t delta_t = 0;
 	uint32_t size    = 0;
@@ -117,3 +126,127 @@ SMFTest::writeTest ()
 
 	// TODO: Check files are actually equivalent
 }
+
+typedef std::pair<uint64_t, std::vector<uint8_t> > TimedEvent;
+
+struct CompareTime {
+	bool operator() (TimedEvent const& a, TimedEvent const& b) const {
+		return a.first < b.first;
+	}
+};
+
+/** read all MIDI events of all tracks using libsmf, in the order SMFMap::read_events() uses */
+static void
+read_smf_events (TestSMF& smf, std::vector<TimedEvent>& events)
+{
+	for (uint16_t t = 1; t <= smf.num_tracks (); ++t) {
+		CPPUNIT_ASSERT_EQUAL (0, smf.seek_to_track (t));
+
+		uint64_t time    = 0;
+		uint32_t delta_t = 0;
+		uint32_t size    = 0;
+		uint8_t* buf     = NULL;
+		int ret;
+		while ((ret = smf.read_event (&delta_t, &size, &buf)) >= 0) {
+			time += delta_t;
+			if (ret > 0) {
+				events.push_back (make_pair (time, std::vector<uint8_t> (buf, buf + size)));
+			}
+		}
+		free (buf);
+	}
+
+	std::stable_sort (events.begin (), events.end (), CompareTime ());
+}
+
+static void
+compare_mapped (std::string const& path)
+{
+	TestSMF smf;
+	CPPUNIT_ASSERT_EQUAL (0, smf.open (path));
+
+	std::vector<TimedEvent> expected;
+	read_smf_events (smf, expected);
+
+	SMFMap map;
+	CPPUNIT_ASSERT_EQUAL (0, map.open (path));
+	CPPUNIT_ASSERT_EQUAL (smf.ppqn (), map.ppqn ());
+	CPPUNIT_ASSERT_EQUAL (smf.num_tracks (), map.num_tracks ());
+
+	std::vector<SMFMap::Event> events;
+	std::vector<uint8_t> scratch;
+	map.read_events (events, scratch);
+
+	CPPUNIT_ASSERT_EQUAL (expected.size (), events.size ());
+	for (size_t i = 0; i < events.size (); ++i) {
+		CPPUNIT_ASSERT_EQUAL (expected[i].first, events[i].time);
+		CPPUNIT_ASSERT_EQUAL ((uint32_t) expected[i].second.size (), events[i].size);
+		CPPUNIT_ASSERT (!memcmp (&expected[i].second[0], events[i].buffer, events[i].size));
+	}
+}
+
+void
+SMFTest::mappedReadTest ()
+{
+	string testdata_path;
+	CPPUNIT_ASSERT (find_file (test_search_path (), "TakeFive.mid", testdata_path));
+
+	compare_mapped (testdata_path);
+
+	TestSMF smf;
+	smf.open (testdata_path);
+	/* SMFMap only parses the header, libsmf is not needed to open the file */
+	CPPUNIT_ASSERT (!smf.loaded ());
+	CPPUNIT_ASSERT (!smf.is_empty ());
+	CPPUNIT_ASSERT_EQUAL ((uint16_t)1, smf.num_tracks ());
+}
+
+void
+SMFTest::mappedRunningStatusTest ()
+{
+	/* type 1 file with two tracks, running status, Note-On with
+	 * velocity 0, SysEx, a note ID meta-event and simultaneous events.
+	 */
+	static const uint8_t data[] = {
+		'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 1, 0, 2, 0x01, 0xe0,
+		'M', 'T', 'r', 'k', 0, 0, 0, 32,
+		0x00, 0xff, 0x7f, 0x03, 0x99, 0x01, 0x2a,             // note ID 42
+		0x00, 0x90, 0x3c, 0x64,                               // note on
+		0x60, 0x3e, 0x64,                                     // running status
+		0x81, 0x00, 0x3c, 0x00,                               // note on, velocity 0
+		0x00, 0x3e, 0x00,
+		0x00, 0xf0, 0x04, 0x7e, 0x7f, 0x09, 0xf7,             // sysex
+		0x00, 0xff, 0x2f, 0x00,
+		'M', 'T', 'r', 'k', 0, 0, 0, 15,
+		0x60, 0xb1, 0x07, 0x40,                               // same time as 2nd note on
+		0x00, 0x0a, 0x20,                                     // running status
+		0x83, 0x40, 0xc1, 0x05,
+		0x00, 0xff, 0x2f, 0x00,
+	};
+
+	const string output_dir_path = PBD::tmp_writable_directory (PACKAGE, "mappedRunningStatusTest");
+	const string path = Glib::build_filename (output_dir_path, "RunningStatus.mid");
+	Glib::file_set_contents (path, (const char*) data, sizeof (data));
+
+	compare_mapped (path);
+
+	SMFMap map;
+	CPPUNIT_ASSERT_EQUAL (0, map.open (path));
+
+	std::vector<SMFMap::Event> events;
+	std::vector<uint8_t> scratch;
+	map.read_events (events, scratch);
+
+	CPPUNIT_ASSERT_EQUAL (size_t (8), events.size ());
+	CPPUNIT_ASSERT_EQUAL ((event_id_t) 42, events[0].id);
+	CPPUNIT_ASSERT_EQUAL ((event_id_t) -1, events[1].id);
+	/* track order is preserved for simultaneous events */
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 0x60, events[1].time);
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 0x90, events[1].buffer[0]);
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 0xb1, events[2].buffer[0]);
+	/* normalized Note-Off */
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 0x80, events[4].buffer[0]);
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 0x40, events[4].buffer[2]);
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 5, events[6].size);
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 0xf0, events[6].buffer[0]);
+}
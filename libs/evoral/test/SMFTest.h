@@ -57,6 +57,8 @@ class SMFTest : public CppUnit::TestFixture
 	CPPUNIT_TEST(createNewFileTest);
 	CPPUNIT_TEST(takeFiveTest);
 	CPPUNIT_TEST(writeTest);
+	CPPUNIT_TEST(mappedReadTest);
+	CPPUNIT_TEST(mappedRunningStatusTest);
 	CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -77,6 +79,8 @@ public:
 	void createNewFileTest();
 	void takeFiveTest();
 	void writeTest();
+	void mappedReadTest();
+	void mappedRunningStatusTest();
 
 private:
 	DummyTypeMap*     type_map;
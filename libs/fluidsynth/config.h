@@ -143,6 +143,9 @@
 /* Define to 1 if you have the <getopt.h> header file. */
 /* #undef HAVE_GETOPT_H */
 
+/* Define to enable multi-core rendering of voices ("synth.cpu-cores") */
+#define ENABLE_MIXER_THREADS 1
+
 /* Define to enable JACK driver */
 /* #undef JACK_SUPPORT */
 
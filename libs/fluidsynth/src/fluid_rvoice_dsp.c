@@ -216,6 +216,128 @@ fluid_rvoice_dsp_interpolate_linear(fluid_rvoice_dsp_t *voice, fluid_real_t *FLU
     return (dsp_i);
 }
 
+#if !defined(WITH_FLOAT) && (defined(__x86_64__) || defined(_M_X64) || defined(__SSE2_MATH__))
+/* SSE2 is part of the x86_64 baseline, fluid_real_t is double */
+#include <emmintrin.h>
+#define FLUID_DSP_SSE2 1
+#endif
+
+/* max. number of source samples covered by one fluid_rvoice_dsp_4th_order_seq16() call */
+#define FLUID_DSP_SEQ_MAX_SPAN (4 * FLUID_BUFSIZE)
+
+/* Interpolate the sequence of sample points with 4th order interpolation,
+ * for 16 bit samples (no data24).
+ *
+ * The phase and amplitude are advanced one sample at a time exactly as in
+ * fluid_rvoice_dsp_interpolate_4th_order(), collecting the source index,
+ * table row and amplitude of each output sample. The source samples are
+ * converted to floating point once, and two output samples are then
+ * interpolated at a time in SIMD lanes. Every lane performs the same
+ * operations in the same order as the generic loop, the result is identical.
+ *
+ * Returns the updated dsp_i.
+ */
+static FLUID_INLINE unsigned int
+fluid_rvoice_dsp_4th_order_seq16(const short int *FLUID_RESTRICT dsp_data,
+                                 fluid_phase_t *dsp_phase, fluid_phase_t dsp_phase_incr,
+                                 fluid_real_t *dsp_amp, fluid_real_t dsp_amp_incr,
+                                 unsigned int end_index,
+                                 fluid_real_t *FLUID_RESTRICT dsp_buf, unsigned int dsp_i)
+{
+    unsigned int idx[FLUID_BUFSIZE];
+    unsigned int row[FLUID_BUFSIZE];
+    fluid_real_t amp[FLUID_BUFSIZE];
+    fluid_real_t src[FLUID_DSP_SEQ_MAX_SPAN + 4];
+    fluid_phase_t phase = *dsp_phase;
+    fluid_real_t a = *dsp_amp;
+    unsigned int i, n = 0, first, span;
+
+    if(fluid_phase_index(phase) > end_index)
+    {
+        return dsp_i;
+    }
+
+    first = fluid_phase_index(phase) - 1;
+
+    for(; dsp_i + n < FLUID_BUFSIZE && fluid_phase_index(phase) <= end_index; n++)
+    {
+        idx[n] = fluid_phase_index(phase) - first;
+        row[n] = fluid_phase_fract_to_tablerow(phase);
+        amp[n] = a;
+
+        /* stop at high pitch, where few output samples span many source samples */
+        if(idx[n] > FLUID_DSP_SEQ_MAX_SPAN)
+        {
+            break;
+        }
+
+        fluid_phase_incr(phase, dsp_phase_incr);
+        a += dsp_amp_incr;
+    }
+
+    if(n < 2)
+    {
+        /* leave it to the generic loop */
+        return dsp_i;
+    }
+
+    /* same as fluid_rvoice_get_float_sample() without data24 */
+    span = idx[n - 1] + 3;
+
+    for(i = 0; i < span; i++)
+    {
+        src[i] = (fluid_real_t)(dsp_data[first + i] * 256);
+    }
+
+    i = 0;
+#ifdef FLUID_DSP_SSE2
+
+    for(; i + 1 < n; i += 2)
+    {
+        const fluid_real_t *c0 = interp_coeff[row[i]];
+        const fluid_real_t *c1 = interp_coeff[row[i + 1]];
+        const fluid_real_t *s0 = &src[idx[i] - 1];
+        const fluid_real_t *s1 = &src[idx[i + 1] - 1];
+
+        /* lane 0: output sample i, lane 1: output sample i + 1 */
+        const __m128d c0_01 = _mm_loadu_pd(&c0[0]);
+        const __m128d c0_23 = _mm_loadu_pd(&c0[2]);
+        const __m128d c1_01 = _mm_loadu_pd(&c1[0]);
+        const __m128d c1_23 = _mm_loadu_pd(&c1[2]);
+        const __m128d s0_01 = _mm_loadu_pd(&s0[0]);
+        const __m128d s0_23 = _mm_loadu_pd(&s0[2]);
+        const __m128d s1_01 = _mm_loadu_pd(&s1[0]);
+        const __m128d s1_23 = _mm_loadu_pd(&s1[2]);
+
+        __m128d acc;
+        acc = _mm_mul_pd(_mm_unpacklo_pd(c0_01, c1_01), _mm_unpacklo_pd(s0_01, s1_01));
+        acc = _mm_add_pd(acc, _mm_mul_pd(_mm_unpackhi_pd(c0_01, c1_01), _mm_unpackhi_pd(s0_01, s1_01)));
+        acc = _mm_add_pd(acc, _mm_mul_pd(_mm_unpacklo_pd(c0_23, c1_23), _mm_unpacklo_pd(s0_23, s1_23)));
+        acc = _mm_add_pd(acc, _mm_mul_pd(_mm_unpackhi_pd(c0_23, c1_23), _mm_unpackhi_pd(s0_23, s1_23)));
+
+        _mm_storeu_pd(&dsp_buf[dsp_i + i], _mm_mul_pd(_mm_loadu_pd(&amp[i]), acc));
+    }
+
+#endif
+
+    for(; i < n; i++)
+    {
+        const fluid_real_t *coeffs = interp_coeff[row[i]];
+        const fluid_real_t *s = &src[idx[i] - 1];
+
+        dsp_buf[dsp_i + i] = amp[i] *
+                             (coeffs[0] * s[0]
+                              + coeffs[1] * s[1]
+                              + coeffs[2] * s[2]
+                              + coeffs[3] * s[3]);
+    }
+
+    *dsp_phase = phase;
+    *dsp_amp = a;
+
+    return dsp_i + n;
+}
+
 /* 4th order (cubic) interpolation.
  * Returns number of samples processed (usually FLUID_BUFSIZE but could be
  * smaller if end of sample occurs).
@@ -285,6 +407,13 @@ fluid_rvoice_dsp_interpolate_4th_order(fluid_rvoice_dsp_t *voice, fluid_real_t *
         }
 
         /* interpolate the sequence of sample points */
+        if(dsp_data24 == NULL)
+        {
+            dsp_i = fluid_rvoice_dsp_4th_order_seq16(dsp_data, &dsp_phase, dsp_phase_incr,
+                    &dsp_amp, dsp_amp_incr, end_index, dsp_buf, dsp_i);
+            dsp_phase_index = fluid_phase_index(dsp_phase);
+        }
+
         for(; dsp_i < FLUID_BUFSIZE && dsp_phase_index <= end_index; dsp_i++)
         {
             coeffs = interp_coeff[fluid_phase_fract_to_tablerow(dsp_phase)];
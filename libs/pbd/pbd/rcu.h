@@ -24,6 +24,7 @@
 #include "glibmm/threads.h"
 
 #include <list>
+#include <vector>
 
 #include "pbd/libpbd_visibility.h"
 
@@ -201,6 +202,171 @@ private:
 	std::list<boost::shared_ptr<T> > m_dead_wood;
 };
 
+namespace PBD {
+
+/** Grace-period tracking for EpochRCUManager.
+ *
+ * Realtime threads that read EpochRCUManager values via rt_reader() are
+ * registered once, and mark their read-side sections, usually one
+ * process cycle, with enter() and leave(). Both are a single atomic
+ * store: no locks and no atomic read-modify-write.
+ *
+ * Old values are retire()d by writers and deleted as soon as every
+ * registered thread has either left its read-side section or entered
+ * a new one since the value was retired.
+ */
+class LIBPBD_API RCUEpoch
+{
+public:
+	/** register the calling thread as a reader, not realtime safe. */
+	static void register_thread ();
+	static void unregister_thread ();
+
+	/** start a read-side section. Sections must not nest. */
+	static void enter ();
+	/** end a read-side section, after this the thread must not use
+	 * any pointer previously returned by rt_reader().
+	 */
+	static void leave ();
+
+	/** queue @a p to be deleted by calling @a deleter once no registered
+	 * reader can reference it anymore. This never calls any deleter.
+	 * Not realtime safe.
+	 */
+	static void retire (void* p, void (*deleter) (void*));
+
+	/** delete retired objects that can no longer be referenced.
+	 * Called periodically by the butler. Not realtime safe, and must not
+	 * be called with any RCU write lock held.
+	 */
+	static void reclaim ();
+
+	/** wait until every other registered reader has left the read-side
+	 * section it was in when this was called, then delete all objects
+	 * retired so far (unless the calling thread is itself in a section).
+	 * Used by EpochRCUManager::flush(). Not realtime safe, and must not be
+	 * called with any RCU write lock held, or a lock a reader may wait for.
+	 */
+	static void synchronize ();
+
+	/** number of retired objects that are waiting to be deleted */
+	static size_t n_retired ();
+
+	class ReadSection {
+	public:
+		ReadSection () { enter (); }
+		~ReadSection () { leave (); }
+	};
+
+private:
+	struct Retired {
+		Retired (void* p, void (*d) (void*), gint e) : ptr (p), deleter (d), epoch (e) {}
+		void* ptr;
+		void (*deleter) (void*);
+		gint  epoch;
+	};
+
+	static void collect (std::vector<Retired>&);
+	static gint oldest_active (gint const* ignore);
+	static void release_slot (void*);
+
+	static const int max_readers = 64;
+
+	static gint                      _epoch;
+	static gint                      _slots[max_readers];
+	static bool                      _slot_used[max_readers];
+	static Glib::Threads::Private<gint> _thread_slot;
+	static Glib::Threads::Mutex      _lock;
+	static std::list<Retired>        _retired;
+};
+
+} /* namespace PBD */
+
+/** EpochRCUManager implements the RCUManager interface using grace periods
+   (see PBD::RCUEpoch) instead of reference counts to free old values.
+
+   In addition to reader(), it offers rt_reader() which returns a plain
+   pointer. It does not touch any reference count, and the pointer remains
+   valid until the calling thread's current read-side section ends
+   (for process threads: until the end of the current process cycle).
+   rt_reader() must only be used by threads in a read-side section, or
+   by threads whose work is bounded by such a section (e.g. graph
+   threads, which finish before the process callback returns).
+
+   Writers are serialized by a mutex, as with SerializedRCUManager. Old
+   values are not freed by update(), but by a later RCUEpoch::reclaim()
+   once no reader can use them anymore, or by flush(), which waits for
+   readers to leave their current section and frees them synchronously.
+*/
+template<class T>
+class /*LIBPBD_API*/ EpochRCUManager : public RCUManager<T>
+{
+public:
+	EpochRCUManager (T* new_rcu_value)
+		: RCUManager<T> (new_rcu_value)
+		, current_write_old (0)
+	{
+	}
+
+	T* rt_reader () const {
+		return ((boost::shared_ptr<T> *) g_atomic_pointer_get (&RCUManager<T>::x.gptr))->get ();
+	}
+
+	boost::shared_ptr<T> write_copy ()
+	{
+		m_lock.lock();
+
+		current_write_old = RCUManager<T>::x.m_rcu_value;
+
+		boost::shared_ptr<T> new_copy (new T(**current_write_old));
+
+		return new_copy;
+
+		/* notice that the write lock is still held: update() MUST
+		   be called or we will cause another writer to stall.
+		*/
+	}
+
+	bool update (boost::shared_ptr<T> new_value)
+	{
+		/* we still hold the write lock - other writers are locked out */
+
+		boost::shared_ptr<T>* new_spp = new boost::shared_ptr<T> (new_value);
+		boost::shared_ptr<T>* old_spp = current_write_old;
+
+		bool ret = g_atomic_pointer_compare_and_exchange (&RCUManager<T>::x.gptr,
+								  (gpointer) old_spp,
+								  (gpointer) new_spp);
+
+		m_lock.unlock();
+
+		if (ret) {
+			/* rt_reader() users may still use the old value. It is
+			 * deleted by a later flush() or RCUEpoch::reclaim(), never
+			 * here: deleting it may need this or another manager's
+			 * write lock (e.g. ~IO unregisters ports).
+			 */
+			PBD::RCUEpoch::retire (old_spp, &EpochRCUManager<T>::drop);
+		} else {
+			delete new_spp;
+		}
+
+		return ret;
+	}
+
+	void flush () {
+		PBD::RCUEpoch::synchronize ();
+	}
+
+private:
+	static void drop (void* p) {
+		delete static_cast<boost::shared_ptr<T>*> (p);
+	}
+
+	Glib::Threads::Mutex  m_lock;
+	boost::shared_ptr<T>* current_write_old;
+};
+
 /** RCUWriter is a convenience object that implements write_copy/update via
    lifetime management. Creating the object obtains a writable copy, which can
    be obtained via the get_copy() method; deleting the object will update
@@ -26,11 +26,13 @@
 
 #include <list>
 #include <map>
+#include <vector>
 
 #ifdef nil
 #undef nil
 #endif
 
+#include <glib.h>
 #include <glibmm/threads.h>
 
 #include <boost/noncopyable.hpp>
@@ -39,6 +41,7 @@
 #include <boost/function.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include "pbd/libpbd_visibility.h"
 #include "pbd/event_loop.h"
@@ -56,6 +59,46 @@ namespace PBD {
 
 class LIBPBD_API Connection;
 
+/** Immutable, reference-counted snapshot of a signal's slots.
+ *
+ * Readers (signal emission) share the current snapshot. Every reader holds
+ * a reference to the array it got, so a writer never has to wait for
+ * readers: a replaced array is freed when its last reader is done.
+ *
+ * Writers (connect, disconnect) only invalidate the snapshot. It is rebuilt
+ * by the next emission, so connecting many slots is not quadratic.
+ * Rebuilding must be serialized by the caller.
+ */
+template <typename T>
+class /*LIBPBD_API*/ SlotSnapshot : public boost::noncopyable
+{
+public:
+	/** @return the current snapshot, or an empty pointer if it must be rebuilt.
+	 * This does not block on writers, it holds one of boost's
+	 * pooled spinlocks while copying the pointer.
+	 */
+	boost::shared_ptr<T const> reader () const
+	{
+		return boost::atomic_load (&_ptr);
+	}
+
+	void publish (boost::shared_ptr<T const> const& t)
+	{
+		boost::atomic_store (&_ptr, t);
+	}
+
+	/** @return the previous snapshot, for the caller to release
+	 * after dropping its lock.
+	 */
+	boost::shared_ptr<T const> invalidate ()
+	{
+		return boost::atomic_exchange (&_ptr, boost::shared_ptr<T const> ());
+	}
+
+private:
+	boost::shared_ptr<T const> _ptr;
+};
+
 class LIBPBD_API SignalBase
 {
 public:
@@ -80,7 +123,7 @@ protected:
 class LIBPBD_API Connection : public boost::enable_shared_from_this<Connection>
 {
 public:
-	Connection (SignalBase* b, PBD::EventLoop::InvalidationRecord* ir) : _signal (b), _invalidation_record (ir)
+	Connection (SignalBase* b, PBD::EventLoop::InvalidationRecord* ir) : _signal (b), _invalidation_record (ir), _connected (1)
 	{
 		if (_invalidation_record) {
 			_invalidation_record->ref ();
@@ -90,12 +133,19 @@ public:
 	void disconnect ()
 	{
 		Glib::Threads::Mutex::Lock lm (_mutex);
+		g_atomic_int_set (&_connected, 0);
 		if (_signal) {
 			_signal->disconnect (shared_from_this ());
 			_signal = 0;
 		}
 	}
 
+	/** lock-free check, used during emission */
+	bool connected () const
+	{
+		return g_atomic_int_get (&_connected) != 0;
+	}
+
 	void disconnected ()
 	{
 		if (_invalidation_record) {
@@ -106,6 +156,7 @@ public:
 	void signal_going_away ()
 	{
 		Glib::Threads::Mutex::Lock lm (_mutex);
+		g_atomic_int_set (&_connected, 0);
 		if (_invalidation_record) {
 			_invalidation_record->unref ();
 		}
@@ -116,6 +167,7 @@ private:
         Glib::Threads::Mutex _mutex;
 	SignalBase* _signal;
 	PBD::EventLoop::InvalidationRecord* _invalidation_record;
+	mutable gint _connected;
 };
 
 template<typename R>
@@ -104,6 +104,12 @@ def signal(f, n, v):
 	/** The slots that this signal will call on emission */
 	typedef std::map<boost::shared_ptr<Connection>, slot_function_type> Slots;
 	Slots _slots;
+
+	/** Immutable copy of _slots used for emission. It is dropped on
+	 *  connect and disconnect, and rebuilt by the next emission.
+	 */
+	typedef std::vector<std::pair<boost::shared_ptr<Connection>, slot_function_type> > SlotArray;
+	SlotSnapshot<SlotArray> _snapshot;
 """, file=f)
 
     print("public:", file=f)
@@ -230,30 +236,28 @@ def signal(f, n, v):
     else:
         print("\ttypename C::result_type operator() (%s)" % comma_separated(Anan), file=f)
     print("\t{", file=f)
-    print("\t\t/* First, take a copy of our list of slots as it is now */", file=f)
+    print("\t\t/* First, take a reference to our slots as they are now. The array is", file=f)
+    print("\t\t * immutable, so this neither copies nor allocates, unless the slots", file=f)
+    print("\t\t * changed since the last emission.", file=f)
+    print("\t\t */", file=f)
     print("", file=f)
-    print("\t\tSlots s;", file=f)
-    print("\t\t{", file=f)
-    print("\t\t\tGlib::Threads::Mutex::Lock lm (_mutex);", file=f)
-    print("\t\t\ts = _slots;", file=f)
+    print("\t\tboost::shared_ptr<SlotArray const> s (_snapshot.reader ());", file=f)
+    print("\t\tif (!s) {", file=f)
+    print("\t\t\ts = slot_array ();", file=f)
     print("\t\t}", file=f)
     print("", file=f)
     if not v:
         print("\t\tstd::list<R> r;", file=f)
-    print("\t\tfor (%sSlots::const_iterator i = s.begin(); i != s.end(); ++i) {" % typename, file=f)
+        print("\t\tC c;", file=f)
+        print("", file=f)
+    print("\t\tfor (%sSlotArray::const_iterator i = s->begin(); i != s->end(); ++i) {" % typename, file=f)
     print("""
 			/* We may have just called a slot, and this may have resulted in
-			   disconnection of other slots from us.  The list copy means that
-			   this won't cause any problems with invalidated iterators, but we
-			   must check to see if the slot we are about to call is still on the list.
+			   disconnection of other slots from us.  The array is not modified
+			   by that, but we must check to see if the slot we are about to
+			   call is still connected.
 			*/
-			bool still_there = false;
-			{
-				Glib::Threads::Mutex::Lock lm (_mutex);
-				still_there = _slots.find (i->first) != _slots.end ();
-			}
-
-			if (still_there) {""", file=f)
+			if (i->first->connected ()) {""", file=f)
     if v:
         print("\t\t\t\t(i->second)(%s);" % comma_separated(an), file=f)
     else:
@@ -263,7 +267,6 @@ def signal(f, n, v):
     print("", file=f)
     if not v:
         print("\t\t/* Call our combiner to do whatever is required to the result values */", file=f)
-        print("\t\tC c;", file=f)
         print("\t\treturn c (r.begin(), r.end());", file=f)
     print("\t}", file=f)
 
@@ -290,11 +293,25 @@ def signal(f, n, v):
     print("\tfriend class Connection;", file=f)
 
     print("""
+	/* (re)build the snapshot after the slots changed */
+	boost::shared_ptr<SlotArray const> slot_array ()
+	{
+		Glib::Threads::Mutex::Lock lm (_mutex);
+		boost::shared_ptr<SlotArray const> s (_snapshot.reader ());
+		if (!s) {
+			s.reset (new SlotArray (_slots.begin (), _slots.end ()));
+			_snapshot.publish (s);
+		}
+		return s;
+	}
+
 	boost::shared_ptr<Connection> _connect (PBD::EventLoop::InvalidationRecord* ir, slot_function_type f)
 	{
 		boost::shared_ptr<Connection> c (new Connection (this, ir));
+		boost::shared_ptr<SlotArray const> old; // released after the lock
 		Glib::Threads::Mutex::Lock lm (_mutex);
 		_slots[c] = f;
+		old = _snapshot.invalidate ();
 #ifdef DEBUG_PBD_SIGNAL_CONNECTIONS
                 if (_debug_connection) {
                         std::cerr << "+++++++ CONNECT " << this << " size now " << _slots.size() << std::endl;
@@ -307,10 +324,12 @@ def signal(f, n, v):
     print("""
 	void disconnect (boost::shared_ptr<Connection> c)
 	{
+		boost::shared_ptr<SlotArray const> old; // released after the lock
 		{
 			Glib::Threads::Mutex::Lock lm (_mutex);
-    			_slots.erase (c);
-    		}
+			_slots.erase (c);
+			old = _snapshot.invalidate ();
+		}
 		c->disconnected ();
 #ifdef DEBUG_PBD_SIGNAL_CONNECTIONS
                	if (_debug_connection) {
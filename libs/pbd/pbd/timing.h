@@ -28,6 +28,8 @@
 #include <string>
 #include <vector>
 
+#include <boost/atomic.hpp>
+
 #include "pbd/libpbd_visibility.h"
 
 #ifdef COMPILER_MSVC
@@ -194,6 +196,65 @@ private:
 	double   _vs;
 };
 
+/**
+ * Histogram of elapsed times, for always-on DSP profiling.
+ *
+ * Bins are log-scaled with 4 bins per octave (25% .. 50% resolution),
+ * from 1 usec up to about 30 sec.
+ *
+ * All counters are atomic, record() does not lock (except for the 64bit
+ * total on platforms that lack 64bit atomics, where boost::atomic falls
+ * back to a spinlock). Several threads may record concurrently, any thread
+ * may read, and request a reset, which is performed by the next record().
+ */
+class LIBPBD_API TimingHistogram
+{
+public:
+	static const int n_bins = 96;
+
+	TimingHistogram ();
+
+	/** add an elapsed time in microseconds (writer only) */
+	void record (uint64_t usec);
+
+	/** clear all data, at the next call to record() */
+	void request_reset () { g_atomic_int_set (&_reset, 1); }
+
+	uint64_t count () const { return (guint) g_atomic_int_get (&_count); }
+	uint64_t max () const { return (guint) g_atomic_int_get (&_max); }
+	/** sum of all recorded times in usec */
+	uint64_t total () const { return _total.load (); }
+	double   avg () const;
+
+	uint64_t bin (int i) const { return (guint) g_atomic_int_get (&_bins[i]); }
+
+	/** @return elapsed time in usec, below which @a p (0..1) of all values are */
+	uint64_t percentile (double p) const;
+
+	/** @return number of values that are larger or equal to @a usec.
+	 * Values in the bin that contains @a usec are assumed to be evenly
+	 * distributed, that bin only contributes the share above @a usec.
+	 */
+	uint64_t count_above (uint64_t usec) const;
+
+	/** one line summary: count, avg, 50%, 99%, max */
+	std::string summary () const;
+
+	static int      bin_index (uint64_t usec);
+	static uint64_t bin_lower (int i);
+	static uint64_t bin_upper (int i) { return bin_lower (i + 1); }
+
+private:
+	void reset ();
+
+	mutable gint _bins[n_bins];
+	mutable gint _count;
+	mutable gint _max;
+	mutable gint _reset;
+
+	boost::atomic<uint64_t> _total;
+};
+
 class LIBPBD_API TimingData
 {
 public:
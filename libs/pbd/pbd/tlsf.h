@@ -29,7 +29,11 @@ namespace PBD {
 class LIBPBD_API TLSF
 {
 public:
-	TLSF (std::string name, size_t bytes);
+	/** @param bytes size of the pool
+	 * @param resident prefault and lock the complete pool in memory,
+	 * otherwise only the part requested with make_resident()
+	 */
+	TLSF (std::string name, size_t bytes, bool resident = true);
 	~TLSF ();
 
 	void set_name (const std::string& n) { _name = n; }
@@ -44,12 +48,22 @@ public:
 
 	void free (void* ptr) { _free (ptr); }
 
+	/** prefault and lock the first \p bytes of the pool in memory.
+	 * Allocations are served from the start of the pool; pages beyond
+	 * are faulted in when they are first used. Not realtime safe,
+	 * must not be called concurrently with allocations.
+	 */
+	void make_resident (size_t bytes);
+
+	/** @return bytes currently in use, including allocator overhead */
 	size_t get_used_size () const;
+	/** @return high-water-mark of get_used_size() */
 	size_t get_max_size () const;
 
 private:
 	std::string _name;
 	char*_mp;
+	size_t _size;
 
 	void* _malloc (size_t);
 	void* _realloc (void *, size_t);
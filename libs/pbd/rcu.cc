@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <glibmm/timer.h>
+
+#include "pbd/compose.h"
+#include "pbd/error.h"
+#include "pbd/rcu.h"
+
+#include "pbd/i18n.h"
+
+using namespace PBD;
+
+const int                    RCUEpoch::max_readers;
+
+/* 0 is reserved for "not in a read-side section" */
+gint                         RCUEpoch::_epoch = 1;
+gint                         RCUEpoch::_slots[RCUEpoch::max_readers];
+bool                         RCUEpoch::_slot_used[RCUEpoch::max_readers];
+Glib::Threads::Private<gint> RCUEpoch::_thread_slot (&RCUEpoch::release_slot);
+Glib::Threads::Mutex         RCUEpoch::_lock;
+std::list<RCUEpoch::Retired> RCUEpoch::_retired;
+
+void
+RCUEpoch::register_thread ()
+{
+	if (_thread_slot.get ()) {
+		return;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	for (int i = 0; i < max_readers; ++i) {
+		if (!_slot_used[i]) {
+			_slot_used[i] = true;
+			g_atomic_int_set (&_slots[i], 0);
+			_thread_slot.set (&_slots[i]);
+			return;
+		}
+	}
+
+	error << string_compose (_("RCU: cannot register more than %1 reader threads"), max_readers) << endmsg;
+}
+
+void
+RCUEpoch::unregister_thread ()
+{
+	gint* s = _thread_slot.get ();
+	if (s) {
+		release_slot (s);
+		_thread_slot.set (0);
+	}
+}
+
+void
+RCUEpoch::release_slot (void* p)
+{
+	gint* s = static_cast<gint*> (p);
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+	g_atomic_int_set (s, 0);
+	_slot_used[s - _slots] = false;
+}
+
+void
+RCUEpoch::enter ()
+{
+	gint* s = _thread_slot.get ();
+	if (s) {
+		g_atomic_int_set (s, g_atomic_int_get (&_epoch));
+	}
+}
+
+void
+RCUEpoch::leave ()
+{
+	gint* s = _thread_slot.get ();
+	if (s) {
+		g_atomic_int_set (s, 0);
+	}
+}
+
+void
+RCUEpoch::retire (void* p, void (*deleter) (void*))
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	/* the new value is already published. Readers that enter a
+	 * section from now on see the new epoch, and cannot get hold of @a p.
+	 */
+	gint e = g_atomic_int_add (&_epoch, 1) + 1;
+	_retired.push_back (Retired (p, deleter, e));
+}
+
+void
+RCUEpoch::reclaim ()
+{
+	std::vector<Retired> dead;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		collect (dead);
+	}
+
+	/* deleters may trigger further updates, call them without holding the lock */
+	for (std::vector<Retired>::const_iterator i = dead.begin (); i != dead.end (); ++i) {
+		i->deleter (i->ptr);
+	}
+}
+
+void
+RCUEpoch::synchronize ()
+{
+	/* everything retired so far has an epoch <= target */
+	const gint target = g_atomic_int_get (&_epoch);
+
+	/* a reader that is in a section may be using the calling
+	 * thread's pointers, but never waits for them. Only skip
+	 * the calling thread itself.
+	 */
+	gint const* self = _thread_slot.get ();
+
+	while (true) {
+		{
+			Glib::Threads::Mutex::Lock lm (_lock);
+			if (oldest_active (self) >= target) {
+				break;
+			}
+		}
+		/* a read-side section lasts at most one process cycle */
+		Glib::usleep (500);
+	}
+
+	reclaim ();
+}
+
+size_t
+RCUEpoch::n_retired ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	return _retired.size ();
+}
+
+gint
+RCUEpoch::oldest_active (gint const* ignore)
+{
+	/* called with _lock held. Find the oldest epoch that a reader
+	 * may still be using.
+	 */
+	gint oldest = G_MAXINT;
+
+	for (int i = 0; i < max_readers; ++i) {
+		if (!_slot_used[i] || &_slots[i] == ignore) {
+			continue;
+		}
+		gint e = g_atomic_int_get (&_slots[i]);
+		if (e != 0 && e < oldest) {
+			oldest = e;
+		}
+	}
+
+	return oldest;
+}
+
+void
+RCUEpoch::collect (std::vector<Retired>& dead)
+{
+	/* called with _lock held. Everything retired up to the oldest
+	 * epoch in use is unreachable.
+	 */
+	const gint oldest = oldest_active (0);
+
+	while (!_retired.empty () && _retired.front ().epoch <= oldest) {
+		dead.push_back (_retired.front ());
+		_retired.pop_front ();
+	}
+}
@@ -0,0 +1,207 @@
+#include <glib.h>
+#include <glibmm/threads.h>
+#include <glibmm/timer.h>
+
+#include "rcu_test.h"
+#include "pbd/rcu.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (RCUTest);
+
+using namespace PBD;
+
+namespace {
+
+struct Tracked {
+	Tracked (int v) : value (v) { ++alive; }
+	Tracked (Tracked const& other) : value (other.value) { ++alive; }
+	~Tracked () { --alive; }
+
+	int value;
+	static int alive;
+};
+
+int Tracked::alive = 0;
+
+/* deleting an instance updates another manager, like ~IO unregisters ports */
+struct WritesOnDelete {
+	WritesOnDelete (EpochRCUManager<Tracked>* m) : target (m) {}
+	~WritesOnDelete () {
+		RCUWriter<Tracked> writer (*target);
+		++writer.get_copy ()->value;
+	}
+
+	EpochRCUManager<Tracked>* target;
+};
+
+struct SectionState {
+	SectionState (EpochRCUManager<Tracked>* m) : manager (m), entered (0), seen (0), left (0) {}
+
+	EpochRCUManager<Tracked>* manager;
+	gint entered;
+	gint seen;
+	gint left;
+};
+
+/* stay in a read-side section until the value read at its start was retired */
+void
+section_reader (SectionState* s)
+{
+	RCUEpoch::register_thread ();
+	RCUEpoch::enter ();
+
+	Tracked* p = s->manager->rt_reader ();
+	g_atomic_int_set (&s->entered, 1);
+
+	while (RCUEpoch::n_retired () == 0) {
+		Glib::Threads::Thread::yield ();
+	}
+	Glib::usleep (20000);
+
+	g_atomic_int_set (&s->seen, p->value);
+	g_atomic_int_set (&s->left, 1);
+
+	RCUEpoch::leave ();
+	RCUEpoch::unregister_thread ();
+}
+
+}
+
+void
+RCUTest::testEpochUnregistered ()
+{
+	/* updates only retire old values. Without any reader in a read-side
+	 * section, they are all freed by the next flush.
+	 */
+	{
+		EpochRCUManager<Tracked> m (new Tracked (1));
+		CPPUNIT_ASSERT_EQUAL (1, Tracked::alive);
+
+		for (int i = 2; i < 10; ++i) {
+			RCUWriter<Tracked> writer (m);
+			writer.get_copy ()->value = i;
+		}
+
+		CPPUNIT_ASSERT_EQUAL (9, m.rt_reader ()->value);
+		CPPUNIT_ASSERT_EQUAL ((size_t) 8, RCUEpoch::n_retired ());
+		CPPUNIT_ASSERT_EQUAL (9, Tracked::alive);
+
+		m.flush ();
+		CPPUNIT_ASSERT_EQUAL ((size_t) 0, RCUEpoch::n_retired ());
+		CPPUNIT_ASSERT_EQUAL (1, Tracked::alive);
+	}
+	CPPUNIT_ASSERT_EQUAL (0, Tracked::alive);
+}
+
+void
+RCUTest::testEpochReadSection ()
+{
+	RCUEpoch::register_thread ();
+
+	{
+		EpochRCUManager<Tracked> m (new Tracked (1));
+
+		RCUEpoch::enter ();
+		Tracked* p = m.rt_reader ();
+
+		{
+			RCUWriter<Tracked> writer (m);
+			writer.get_copy ()->value = 2;
+		}
+
+		/* the reader is still in its section, the old value must survive */
+		CPPUNIT_ASSERT_EQUAL (2, m.rt_reader ()->value);
+		CPPUNIT_ASSERT_EQUAL ((size_t) 1, RCUEpoch::n_retired ());
+		CPPUNIT_ASSERT_EQUAL (2, Tracked::alive);
+		CPPUNIT_ASSERT_EQUAL (1, p->value);
+
+		RCUEpoch::reclaim ();
+		CPPUNIT_ASSERT_EQUAL ((size_t) 1, RCUEpoch::n_retired ());
+
+		RCUEpoch::leave ();
+
+		/* a new section only sees the new value, the old one can go */
+		{
+			RCUEpoch::ReadSection rs;
+			CPPUNIT_ASSERT_EQUAL (2, m.rt_reader ()->value);
+			m.flush ();
+			CPPUNIT_ASSERT_EQUAL ((size_t) 0, RCUEpoch::n_retired ());
+			CPPUNIT_ASSERT_EQUAL (1, Tracked::alive);
+		}
+	}
+	CPPUNIT_ASSERT_EQUAL (0, Tracked::alive);
+
+	RCUEpoch::unregister_thread ();
+}
+
+void
+RCUTest::testEpochNestedUpdate ()
+{
+	RCUEpoch::register_thread ();
+
+	{
+		EpochRCUManager<Tracked> target (new Tracked (0));
+		EpochRCUManager<WritesOnDelete> m (new WritesOnDelete (&target));
+
+		/* keep the old value of @a m alive until target is updated */
+		RCUEpoch::enter ();
+
+		{
+			RCUWriter<WritesOnDelete> writer (m);
+		}
+
+		RCUEpoch::leave ();
+
+		/* the update must not delete the old value of @a m while the
+		 * write lock of @a target is held.
+		 */
+		{
+			RCUWriter<Tracked> writer (target);
+			writer.get_copy ()->value = 10;
+		}
+
+		CPPUNIT_ASSERT_EQUAL (10, target.rt_reader ()->value);
+
+		/* deleting the old value of @a m updates @a target once more */
+		target.flush ();
+		CPPUNIT_ASSERT_EQUAL (11, target.rt_reader ()->value);
+
+		target.flush ();
+		CPPUNIT_ASSERT_EQUAL ((size_t) 0, RCUEpoch::n_retired ());
+	}
+
+	RCUEpoch::reclaim ();
+	RCUEpoch::unregister_thread ();
+}
+
+void
+RCUTest::testEpochFlushWaits ()
+{
+	/* flush() must free old values synchronously, after waiting for
+	 * readers in a section, e.g. before a Session is deleted.
+	 */
+	{
+		EpochRCUManager<Tracked> m (new Tracked (1));
+		SectionState s (&m);
+
+		Glib::Threads::Thread* t = Glib::Threads::Thread::create (sigc::bind (sigc::ptr_fun (&section_reader), &s));
+
+		while (!g_atomic_int_get (&s.entered)) {
+			Glib::Threads::Thread::yield ();
+		}
+
+		{
+			RCUWriter<Tracked> writer (m);
+			writer.get_copy ()->value = 2;
+		}
+
+		m.flush ();
+
+		CPPUNIT_ASSERT_EQUAL (1, g_atomic_int_get (&s.left));
+		CPPUNIT_ASSERT_EQUAL (1, g_atomic_int_get (&s.seen));
+		CPPUNIT_ASSERT_EQUAL ((size_t) 0, RCUEpoch::n_retired ());
+		CPPUNIT_ASSERT_EQUAL (1, Tracked::alive);
+
+		t->join ();
+	}
+	CPPUNIT_ASSERT_EQUAL (0, Tracked::alive);
+}
@@ -0,0 +1,18 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class RCUTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (RCUTest);
+	CPPUNIT_TEST (testEpochUnregistered);
+	CPPUNIT_TEST (testEpochReadSection);
+	CPPUNIT_TEST (testEpochNestedUpdate);
+	CPPUNIT_TEST (testEpochFlushWaits);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void testEpochUnregistered ();
+	void testEpochReadSection ();
+	void testEpochNestedUpdate ();
+	void testEpochFlushWaits ();
+};
@@ -1,4 +1,9 @@
+#include <algorithm>
+#include <vector>
+
+#include <glib.h>
 #include <glibmm/thread.h>
+#include <glibmm/threads.h>
 
 #include "signals_test.h"
 #include "pbd/signals.h"
@@ -89,3 +94,150 @@ SignalsTest::testScopedConnectionList ()
 
 	CPPUNIT_ASSERT_EQUAL (1, N);
 }
+
+static PBD::ScopedConnection second;
+static std::vector<int> calls;
+
+void
+disconnect_second ()
+{
+	calls.push_back (1);
+	second.disconnect ();
+}
+
+void
+log_second ()
+{
+	calls.push_back (2);
+}
+
+void
+SignalsTest::testDisconnectDuringEmission ()
+{
+	/* slots are called from a snapshot, a slot that is disconnected
+	 * by an earlier slot in the same emission must not be called
+	 */
+	Emitter* e = new Emitter;
+	PBD::ScopedConnection first;
+	e->Fred.connect_same_thread (first, boost::bind (&disconnect_second));
+	e->Fred.connect_same_thread (second, boost::bind (&log_second));
+
+	calls.clear ();
+	e->emit ();
+
+	/* emission order follows the connection's address, either slot can be first */
+	std::vector<int> expected;
+	if (calls.size () == 2) {
+		expected.push_back (2);
+	}
+	expected.push_back (1);
+	CPPUNIT_ASSERT (calls == expected);
+
+	calls.clear ();
+	e->emit ();
+	e->emit ();
+	CPPUNIT_ASSERT (calls == std::vector<int> (2, 1));
+
+	delete e;
+}
+
+/* one emitter thread, slots are connected and disconnected by the main thread */
+
+static const int n_concurrent = 64;
+
+struct ConcurrentState {
+	ConcurrentState () : connected (0), connecting (0), disconnected (0), disconnecting (0), done (0), n_emissions (0), errors (0) {}
+
+	Emitter e;
+	gint    connected;     // slots [0, connected) are connected
+	gint    connecting;    // slots [connecting, ..) were not connected yet
+	gint    disconnected;  // slots [0, disconnected) are disconnected
+	gint    disconnecting; // slots [disconnecting, ..) were not disconnected yet
+	gint    done;
+	gint    n_emissions;
+	gint    errors;
+
+	std::vector<bool> seen; // written by the emitter thread only
+};
+
+static void
+concurrent_slot (ConcurrentState* cs, int id)
+{
+	cs->seen[id] = true;
+}
+
+static void
+concurrent_emitter (ConcurrentState* cs)
+{
+	cs->seen.resize (n_concurrent);
+
+	while (!g_atomic_int_get (&cs->done)) {
+		std::fill (cs->seen.begin (), cs->seen.end (), false);
+
+		const int c_min = g_atomic_int_get (&cs->connected);
+		const int d_min = g_atomic_int_get (&cs->disconnected);
+		cs->e.emit ();
+		const int c_max = g_atomic_int_get (&cs->connecting);
+		const int d_max = g_atomic_int_get (&cs->disconnecting);
+
+		/* slots are connected and disconnected in order. All slots that
+		 * were connected before and not disconnected until after the
+		 * emission must be called, none that was disconnected before or
+		 * connected after it. A slot that is disconnected during the
+		 * emission may or may not be called.
+		 */
+		int hi = 0;
+		for (int i = 0; i < n_concurrent; ++i) {
+			if (cs->seen[i]) {
+				hi = i + 1;
+			}
+		}
+		bool ok = hi <= c_max;
+		for (int i = 0; i < n_concurrent; ++i) {
+			if (i < d_min && cs->seen[i]) {
+				ok = false;
+			}
+			if (i >= d_max && i < std::max (hi, c_min) && !cs->seen[i]) {
+				ok = false;
+			}
+		}
+		if (!ok) {
+			g_atomic_int_inc (&cs->errors);
+		}
+		g_atomic_int_inc (&cs->n_emissions);
+	}
+}
+
+void
+SignalsTest::testConcurrentEmission ()
+{
+	ConcurrentState cs;
+	PBD::ScopedConnection connections[n_concurrent];
+
+	Glib::Threads::Thread* t = Glib::Threads::Thread::create (sigc::bind (sigc::ptr_fun (&concurrent_emitter), &cs));
+
+	for (int i = 0; i < n_concurrent; ++i) {
+		g_atomic_int_inc (&cs.connecting);
+		cs.e.Fred.connect_same_thread (connections[i], boost::bind (&concurrent_slot, &cs, i));
+		g_atomic_int_inc (&cs.connected);
+		/* let the emitter catch up */
+		for (int n = g_atomic_int_get (&cs.n_emissions); g_atomic_int_get (&cs.n_emissions) < n + 2;) {
+			Glib::Threads::Thread::yield ();
+		}
+	}
+
+	for (int i = 0; i < n_concurrent; ++i) {
+		g_atomic_int_inc (&cs.disconnecting);
+		connections[i].disconnect ();
+		g_atomic_int_inc (&cs.disconnected);
+		for (int n = g_atomic_int_get (&cs.n_emissions); g_atomic_int_get (&cs.n_emissions) < n + 2;) {
+			Glib::Threads::Thread::yield ();
+		}
+	}
+
+	g_atomic_int_set (&cs.done, 1);
+	t->join ();
+
+	CPPUNIT_ASSERT (g_atomic_int_get (&cs.n_emissions) >= 4 * n_concurrent);
+	CPPUNIT_ASSERT_EQUAL (0, (int) g_atomic_int_get (&cs.errors));
+}
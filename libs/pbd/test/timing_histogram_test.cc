@@ -0,0 +1,64 @@
+#include "timing_histogram_test.h"
+#include "pbd/timing.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (TimingHistogramTest);
+
+using namespace PBD;
+
+void
+TimingHistogramTest::testBins ()
+{
+	/* every value falls into the bin covering it, bins are contiguous */
+	for (uint64_t v = 0; v < 100000; ++v) {
+		int i = TimingHistogram::bin_index (v);
+		CPPUNIT_ASSERT (TimingHistogram::bin_lower (i) <= v);
+		CPPUNIT_ASSERT (v < TimingHistogram::bin_upper (i));
+	}
+	for (int i = 0; i < TimingHistogram::n_bins - 1; ++i) {
+		CPPUNIT_ASSERT_EQUAL (TimingHistogram::bin_upper (i), TimingHistogram::bin_lower (i + 1));
+	}
+	/* huge values are clamped to the last bin */
+	CPPUNIT_ASSERT_EQUAL (TimingHistogram::n_bins - 1, TimingHistogram::bin_index ((uint64_t)1 << 40));
+}
+
+void
+TimingHistogramTest::testStats ()
+{
+	TimingHistogram h;
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)0, h.count ());
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)0, h.percentile (.5));
+
+	for (uint64_t v = 1; v <= 100; ++v) {
+		h.record (v);
+	}
+
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)100, h.count ());
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)100, h.max ());
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)5050, h.total ());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (50.5, h.avg (), 1e-9);
+
+	/* percentiles are reported as upper bin bound (25% resolution) */
+	uint64_t p50 = h.percentile (.5);
+	CPPUNIT_ASSERT (p50 >= 50 && p50 <= 64);
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)100, h.percentile (1.0));
+
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)100 - 63, h.count_above (64));
+	/* 70 is inside the [64, 80) bin, only the share above it is counted */
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)100 - 69, h.count_above (70));
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)1, h.count_above (100));
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)0, h.count_above (101));
+}
+
+void
+TimingHistogramTest::testReset ()
+{
+	TimingHistogram h;
+	h.record (10);
+	h.record (20);
+	h.request_reset ();
+	/* reset is deferred to the writer */
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)2, h.count ());
+	h.record (5);
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)1, h.count ());
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)5, h.max ());
+}
@@ -0,0 +1,16 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class TimingHistogramTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (TimingHistogramTest);
+	CPPUNIT_TEST (testBins);
+	CPPUNIT_TEST (testStats);
+	CPPUNIT_TEST (testReset);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void testBins ();
+	void testStats ();
+	void testReset ();
+};
@@ -0,0 +1,95 @@
+#include <string.h>
+#include <stdlib.h>
+#include "tlsf_test.h"
+#include "pbd/tlsf.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (TLSFTest);
+
+using namespace std;
+
+TLSFTest::TLSFTest ()
+{
+}
+
+void
+TLSFTest::testBasic ()
+{
+	::srand (0);
+	PBD::TLSF *m = new PBD::TLSF ("TestPool", 256 * 1024);
+	const size_t initial = m->get_used_size ();
+
+	for (int l = 0; l < 256 * 1024; ++l) {
+		void *x[32];
+		size_t s[32];
+		int cnt = ::rand() % 32;
+		for (int i = 0; i < cnt; ++i) {
+			s[i] = ::rand() % 1024;
+			x[i] = m->malloc (s[i]);
+		}
+		for (int i = 0; i < cnt; ++i) {
+			if (x[i]) {
+				memset (x[i], 0xa5, s[i]);
+			}
+		}
+		for (int i = 0; i < cnt; ++i) {
+			m->free (x[i]);
+		}
+	}
+	CPPUNIT_ASSERT_EQUAL (initial, m->get_used_size ());
+	delete (m);
+}
+
+void
+TLSFTest::testHighWaterMark ()
+{
+	PBD::TLSF *m = new PBD::TLSF ("TestPool", 256 * 1024);
+	const size_t initial = m->get_used_size ();
+	CPPUNIT_ASSERT_EQUAL (initial, m->get_max_size ());
+
+	void* a = m->malloc (16384);
+	void* b = m->malloc (16384);
+	CPPUNIT_ASSERT (a && b);
+	CPPUNIT_ASSERT (m->get_used_size () >= initial + 32768);
+
+	const size_t peak = m->get_used_size ();
+	CPPUNIT_ASSERT_EQUAL (peak, m->get_max_size ());
+
+	/* grow in place or move, the peak may only increase */
+	b = m->realloc (b, 32768);
+	CPPUNIT_ASSERT (b);
+	CPPUNIT_ASSERT (m->get_max_size () >= initial + 49152);
+
+	const size_t max = m->get_max_size ();
+	m->free (a);
+	m->free (b);
+	CPPUNIT_ASSERT_EQUAL (initial, m->get_used_size ());
+	CPPUNIT_ASSERT_EQUAL (max, m->get_max_size ());
+	delete (m);
+}
+
+void
+TLSFTest::testResident ()
+{
+	PBD::TLSF *m = new PBD::TLSF ("TestPool", 1024 * 1024, false);
+
+	char* a = (char*) m->malloc (16384);
+	CPPUNIT_ASSERT (a);
+	memset (a, 0xa5, 16384);
+
+	/* making (part of) a pool in use resident does not modify it */
+	m->make_resident (64 * 1024);
+	for (int i = 0; i < 16384; ++i) {
+		CPPUNIT_ASSERT_EQUAL ((char) 0xa5, a[i]);
+	}
+
+	/* all of the pool remains usable */
+	char* b = (char*) m->malloc (768 * 1024);
+	CPPUNIT_ASSERT (b);
+	memset (b, 0x5a, 768 * 1024);
+
+	m->make_resident (2 * 1024 * 1024); // clamped to the pool size
+
+	m->free (a);
+	m->free (b);
+	delete (m);
+}
@@ -0,0 +1,19 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class TLSFTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (TLSFTest);
+	CPPUNIT_TEST (testBasic);
+	CPPUNIT_TEST (testHighWaterMark);
+	CPPUNIT_TEST (testResident);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	TLSFTest ();
+	void testBasic ();
+	void testHighWaterMark ();
+	void testResident ();
+
+private:
+};
@@ -64,4 +64,122 @@ timing_summary (const std::vector<uint64_t>& values)
 	return oss.str();
 }
 
+TimingHistogram::TimingHistogram ()
+{
+	reset ();
+	g_atomic_int_set (&_reset, 0);
+}
+
+void
+TimingHistogram::reset ()
+{
+	for (int i = 0; i < n_bins; ++i) {
+		g_atomic_int_set (&_bins[i], 0);
+	}
+	g_atomic_int_set (&_count, 0);
+	g_atomic_int_set (&_max, 0);
+	_total.store (0);
+}
+
+int
+TimingHistogram::bin_index (uint64_t usec)
+{
+	if (usec < 4) {
+		return usec;
+	}
+	/* octave and the 2 bits below the most significant one */
+	int msb = 63;
+	while (!(usec & ((uint64_t)1 << msb))) {
+		--msb;
+	}
+	int const sub = (usec >> (msb - 2)) & 3;
+	return std::min (n_bins - 1, 4 * (msb - 1) + sub);
+}
+
+uint64_t
+TimingHistogram::bin_lower (int i)
+{
+	if (i < 4) {
+		return i;
+	}
+	int const msb = i / 4 + 1;
+	int const sub = i % 4;
+	return (uint64_t)(4 + sub) << (msb - 2);
+}
+
+void
+TimingHistogram::record (uint64_t usec)
+{
+	if (g_atomic_int_compare_and_exchange (&_reset, 1, 0)) {
+		reset ();
+	}
+	g_atomic_int_inc (&_bins[bin_index (usec)]);
+	g_atomic_int_inc (&_count);
+	gint const val = std::min<uint64_t> (usec, G_MAXINT);
+	gint       cur = g_atomic_int_get (&_max);
+	while (val > cur && !g_atomic_int_compare_and_exchange (&_max, cur, val)) {
+		cur = g_atomic_int_get (&_max);
+	}
+	_total.fetch_add (usec, boost::memory_order_relaxed);
+}
+
+double
+TimingHistogram::avg () const
+{
+	uint64_t const n = count ();
+	return n > 0 ? total () / (double) n : 0;
+}
+
+uint64_t
+TimingHistogram::percentile (double p) const
+{
+	uint64_t const n = count ();
+	if (n == 0) {
+		return 0;
+	}
+	uint64_t const target = ceil (n * std::max (0.0, std::min (1.0, p)));
+	uint64_t       sum    = 0;
+	for (int i = 0; i < n_bins; ++i) {
+		sum += bin (i);
+		if (sum >= target) {
+			return std::min (bin_upper (i), max ());
+		}
+	}
+	return max ();
+}
+
+uint64_t
+TimingHistogram::count_above (uint64_t usec) const
+{
+	if (usec > max ()) {
+		return 0;
+	}
+	int const b   = bin_index (usec);
+	uint64_t  sum = 0;
+	for (int i = b + 1; i < n_bins; ++i) {
+		sum += bin (i);
+	}
+	/* the last bin is open-ended, count all of it */
+	if (b == n_bins - 1 || usec <= bin_lower (b)) {
+		return sum + bin (b);
+	}
+	/* no value in the bin is larger than max () */
+	uint64_t const lower = bin_lower (b);
+	uint64_t const upper = std::min (bin_upper (b), max () + 1);
+	return sum + (bin (b) * (upper - usec) + (upper - lower) / 2) / (upper - lower);
+}
+
+std::string
+TimingHistogram::summary () const
+{
+	std::ostringstream oss;
+	oss << "Count: " << count ()
+	    << " Avg: " << (uint64_t) avg ()
+	    << " 50%: " << percentile (.5)
+	    << " 99%: " << percentile (.99)
+	    << " Max: " << max ()
+	    << " (usecs)";
+	return oss.str ();
+}
+
 } // namespace PBD
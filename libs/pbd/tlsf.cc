@@ -49,10 +49,15 @@
  *
  */
 
-//#define TLSF_STATISTIC 1
+/* used and max size are always tracked, LuaProc locks the part of its pool
+ * from the high-water-mark of previous instances */
+#define TLSF_STATISTIC 1
+
+/* print statistics when a pool is created and destroyed */
+//#define TLSF_PRINT_STATISTIC 1
 
 #ifndef USE_PRINTF
-#if TLSF_STATISTIC
+#ifdef TLSF_PRINT_STATISTIC
 #define USE_PRINTF      (1)
 #endif
 #endif
@@ -389,11 +394,12 @@ static __inline__ bhdr_t *process_area(void *area, size_t size)
 #include <sys/mman.h>
 #endif
 
-PBD::TLSF::TLSF (std::string name, size_t mem_pool_size)
+PBD::TLSF::TLSF (std::string name, size_t mem_pool_size, bool resident)
     : _name (name)
 {
 	mem_pool_size = ROUNDUP_SIZE (mem_pool_size);
 	char * mem_pool = (char*) ::malloc (mem_pool_size);
+	_size = mem_pool_size;
 
 	assert (mem_pool);
 	assert (mem_pool_size >= sizeof(tlsf_t) + BHDR_OVERHEAD * 8);
@@ -403,8 +409,10 @@ PBD::TLSF::TLSF (std::string name, size_t mem_pool_size)
 #endif
 
 #ifndef PLATFORM_WINDOWS
-	memset (mem_pool, 0, mem_pool_size); // make resident
-	mlock (mem_pool, mem_pool_size);
+	if (resident) {
+		memset (mem_pool, 0, mem_pool_size); // make resident
+		mlock (mem_pool, mem_pool_size);
+	}
 #endif
 
 	bhdr_t *b, *ib;
@@ -447,6 +455,22 @@ PBD::TLSF::~TLSF ()
 	_mp = NULL;
 }
 
+void
+PBD::TLSF::make_resident (size_t bytes)
+{
+#ifndef PLATFORM_WINDOWS
+	if (bytes > _size) {
+		bytes = _size;
+	}
+	/* the pool may already be in use, touch each page without modifying it */
+	for (size_t off = 0; off < bytes; off += 4096) {
+		volatile char* p = _mp + off;
+		*p = *p;
+	}
+	mlock (_mp, bytes);
+#endif
+}
+
 size_t
 PBD::TLSF::get_used_size () const
 {
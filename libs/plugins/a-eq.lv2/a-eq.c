@@ -37,6 +37,8 @@
 
 #include "lv2/lv2plug.in/ns/lv2core/lv2.h"
 
+#include "linear_svf.h"
+
 #ifdef LV2_EXTENDED
 #include <cairo/cairo.h>
 #include "ardour/lv2_extensions.h"
@@ -92,25 +94,6 @@ is_eq(float a, float b, float small) {
 	return (fabsf(a - b) < small);
 }
 
-struct linear_svf {
-	double g, k;
-	double a[3];
-	double m[3];
-	double s[2];
-};
-
-static void linear_svf_reset(struct linear_svf *self)
-{
-	self->s[0] = self->s[1] = 0.0;
-}
-
-static void linear_svf_protect(struct linear_svf *self)
-{
-	if (!isfinite_local (self->s[0]) || !isfinite_local (self->s[1])) {
-		linear_svf_reset (self);
-	}
-}
-
 typedef struct {
 	float* f0[BANDS];
 	float* g[BANDS];
@@ -126,6 +109,7 @@ typedef struct {
 	float* output;
 
 	struct linear_svf v_filter[BANDS];
+	linear_svf_cascade_fn svf_cascade;
 	float v_g[BANDS];
 	float v_bw[BANDS];
 	float v_f0[BANDS];
@@ -162,6 +146,8 @@ instantiate(const LV2_Descriptor* descriptor,
 	for (int i = 0; i < BANDS; i++)
 		linear_svf_reset(&aeq->v_filter[i]);
 
+	aeq->svf_cascade = linear_svf_cascade_select ();
+
 	aeq->need_expose = true;
 #ifdef LV2_EXTENDED
 	aeq->display = NULL;
@@ -269,86 +255,6 @@ activate(LV2_Handle instance)
 		linear_svf_reset(&aeq->v_filter[i]);
 }
 
-// SVF filters
-// http://www.cytomic.com/files/dsp/SvfLinearTrapOptimised2.pdf
-
-static void linear_svf_set_peq(struct linear_svf *self, float gdb, float sample_rate, float cutoff, float bandwidth)
-{
-	double f0 = (double)cutoff;
-	double q = (double)pow(2.0, 0.5 * bandwidth) / (pow(2.0, bandwidth) - 1.0);
-	double sr = (double)sample_rate;
-	double A = pow(10.0, gdb/40.0);
-
-	self->g = tan(M_PI * (f0 / sr));
-	self->k = 1.0 / (q * A);
-
-	self->a[0] = 1.0 / (1.0 + self->g * (self->g + self->k));
-	self->a[1] = self->g * self->a[0];
-	self->a[2] = self->g * self->a[1];
-
-	self->m[0] = 1.0;
-	self->m[1] = self->k * (A * A - 1.0);
-	self->m[2] = 0.0;
-}
-
-static void linear_svf_set_highshelf(struct linear_svf *self, float gdb, float sample_rate, float cutoff, float resonance)
-{
-	double f0 = (double)cutoff;
-	double q = (double)resonance;
-	double sr = (double)sample_rate;
-	double A = pow(10.0, gdb/40.0);
-
-	self->g = tan(M_PI * (f0 / sr));
-	self->k = 1.0 / q;
-
-	self->a[0] = 1.0 / (1.0 + self->g * (self->g + self->k));
-	self->a[1] = self->g * self->a[0];
-	self->a[2] = self->g * self->a[1];
-
-	self->m[0] = A * A;
-	self->m[1] = self->k * (1.0 - A) * A;
-	self->m[2] = 1.0 - A * A;
-}
-
-static void linear_svf_set_lowshelf(struct linear_svf *self, float gdb, float sample_rate, float cutoff, float resonance)
-{
-	double f0 = (double)cutoff;
-	double q = (double)resonance;
-	double sr = (double)sample_rate;
-	double A = pow(10.0, gdb/40.0);
-
-	self->g = tan(M_PI * (f0 / sr));
-	self->k = 1.0 / q;
-
-	self->a[0] = 1.0 / (1.0 + self->g * (self->g + self->k));
-	self->a[1] = self->g * self->a[0];
-	self->a[2] = self->g * self->a[1];
-
-	self->m[0] = 1.0;
-	self->m[1] = self->k * (A - 1.0);
-	self->m[2] = A * A - 1.0;
-}
-
-static float run_linear_svf(struct linear_svf *self, float in)
-{
-	double v[3];
-	double din = (double)in;
-	double out;
-
-	v[2] = din - self->s[1];
-	v[0] = (self->a[0] * self->s[0]) + (self->a[1] * v[2]);
-	v[1] = self->s[1] + (self->a[1] * self->s[0]) + (self->a[2] * v[2]);
-
-	self->s[0] = (2.0 * v[0]) - self->s[0];
-	self->s[1] = (2.0 * v[1]) - self->s[1];
-
-	out = (self->m[0] * din)
-		+ (self->m[1] * v[0])
-		+ (self->m[2] * v[1]);
-
-	return (float)out;
-}
-
 static void set_params(LV2_Handle instance, int band) {
 	Aeq* aeq = (Aeq*)instance;
 
@@ -430,14 +336,11 @@ run(LV2_Handle instance, uint32_t n_samples)
 			block = MIN (64, n_samples);
 		}
 
+		aeq->svf_cascade (aeq->v_filter, BANDS, &input[offset], &output[offset], block);
+
+		const double gain = from_dB(aeq->v_master);
 		for (uint32_t i = 0; i < block; ++i) {
-			float in0, out;
-			in0 = input[i + offset];
-			out = in0;
-			for (uint32_t j = 0; j < BANDS; j++) {
-				out = run_linear_svf(&aeq->v_filter[j], out);
-			}
-			output[i + offset] = out * from_dB(aeq->v_master);
+			output[i + offset] = output[i + offset] * gain;
 		}
 		n_samples -= block;
 		offset += block;
@@ -72,6 +72,7 @@ enum {
 	FS_CHR_DEPTH,
 	FS_CHR_LEVEL,
 	FS_CHR_TYPE,
+	FS_VOICE_THREADS,
 	FS_PORT_LAST
 };
 
@@ -114,6 +115,7 @@ typedef struct {
 	fluid_settings_t* settings;
 	fluid_synth_t*    synth;
 	int               synthId;
+	int               synth_cores; // "synth.cpu-cores" of the synth, set in work
 
 	/* lv2 URIDs */
 	LV2_URID atom_Blank;
@@ -152,6 +154,7 @@ typedef struct {
 	char queue_sf2_file_path[1024];
 	bool reinit_in_progress; // set in run, cleared in work_response
 	bool queue_reinit; // set in restore, cleared in work_response
+	int  voice_threads; // requested "synth.cpu-cores", set in run
 
 	BankProgram program_state[16];
 
@@ -163,6 +166,30 @@ typedef struct {
  * helpers
  */
 
+/* create a synth that renders voices using @cores threads */
+static fluid_synth_t*
+new_synth (fluid_settings_t* settings, int cores)
+{
+	double rate = 48000;
+	fluid_settings_getnum (settings, "synth.sample-rate", &rate);
+	/* fails if fluidsynth was built without mixer threads, use a single core then */
+	fluid_settings_setint (settings, "synth.cpu-cores", cores);
+
+	fluid_synth_t* synth = new_fluid_synth (settings);
+
+	if (!synth) {
+		return NULL;
+	}
+
+	fluid_synth_set_gain (synth, 1.0f);
+	fluid_synth_set_polyphony (synth, 256);
+	fluid_synth_set_sample_rate (synth, (float)rate);
+
+	fluid_synth_set_reverb_on (synth, 0);
+	fluid_synth_set_chorus_on (synth, 0);
+	return synth;
+}
+
 static bool
 load_sf2 (AFluidSynth* self, const char* fn)
 {
@@ -333,7 +360,7 @@ instantiate (const LV2_Descriptor*     descriptor,
 	fluid_settings_setint (self->settings, "synth.threadsafe-api", 0);
 	fluid_settings_setstr (self->settings, "synth.midi-bank-select", "mma");
 
-	self->synth = new_fluid_synth (self->settings);
+	self->synth = new_synth (self->settings, 1);
 
 	if (!self->synth) {
 		lv2_log_error (&self->logger, "a-fluidsynth.lv2: cannot allocate Fluid Synth\n");
@@ -342,13 +369,6 @@ instantiate (const LV2_Descriptor*     descriptor,
 		return NULL;
 	}
 
-	fluid_synth_set_gain (self->synth, 1.0f);
-	fluid_synth_set_polyphony (self->synth, 256);
-	fluid_synth_set_sample_rate (self->synth, (float)rate);
-
-	fluid_synth_set_reverb_on (self->synth, 0);
-	fluid_synth_set_chorus_on (self->synth, 0);
-
 	self->fmidi_event = new_fluid_midi_event ();
 
 	if (!self->fmidi_event) {
@@ -371,6 +391,8 @@ instantiate (const LV2_Descriptor*     descriptor,
 	self->initialized = false;
 	self->reinit_in_progress = false;
 	self->queue_reinit = false;
+	self->synth_cores = 1;
+	self->voice_threads = 1;
 	for (int chn = 0; chn < 16; ++chn) {
 		self->program_state[chn].program = -1;
 	}
@@ -492,6 +514,16 @@ run (LV2_Handle instance, uint32_t n_samples)
 		}
 	}
 
+	const int voice_threads = std::max (1, std::min (8, (int) rintf (*self->p_ports[FS_VOICE_THREADS])));
+	if (voice_threads != self->voice_threads && !self->reinit_in_progress && !self->queue_reinit) {
+		/* the synth is re-created by the worker, when (re)loading the SF2 */
+		self->voice_threads = voice_threads;
+		if (self->initialized) {
+			strcpy (self->queue_sf2_file_path, self->current_sf2_file_path);
+			self->queue_reinit = true;
+		}
+	}
+
 	uint32_t offset = 0;
 
 	LV2_ATOM_SEQUENCE_FOREACH (self->control, ev) {
@@ -648,6 +680,21 @@ work (LV2_Handle                  instance,
 	}
 
 
+	if (self->synth_cores != self->voice_threads) {
+		fluid_synth_t* synth = new_synth (self->settings, self->voice_threads);
+		if (synth) {
+			delete_fluid_synth (self->synth);
+			self->synth = synth;
+			self->synth_cores = self->voice_threads;
+			/* force run() to apply gain, reverb and chorus settings */
+			for (uint32_t p = FS_OUT_GAIN; p < FS_PORT_LAST; ++p) {
+				self->v_ports[p] = NAN;
+			}
+		} else {
+			lv2_log_error (&self->logger, "a-fluidsynth.lv2: cannot allocate Fluid Synth with %d voice threads\n", self->voice_threads);
+		}
+	}
+
 	self->initialized = load_sf2 (self, self->queue_sf2_file_path);
 
 	if (self->initialized) {
@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2016-2017 Damien Zammit <damien@zamaudio.com>
+ * Copyright (C) 2016-2020 Robin Gareus <robin@gareus.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/* Linear trapezoidal state variable filters, and a cascade of them
+ * with the filters processed in parallel SIMD lanes.
+ *
+ * http://www.cytomic.com/files/dsp/SvfLinearTrapOptimised2.pdf
+ *
+ * Filter N of the cascade processes sample (t - N) at step t. Each lane
+ * performs exactly the same operations as run_linear_svf(), so results
+ * are bit-identical to processing the filters one after another.
+ *
+ * This file is shared by the a-* plugins and the unit tests, it is
+ * valid C99 and C++.
+ */
+
+#ifndef _ardour_plugins_linear_svf_h_
+#define _ardour_plugins_linear_svf_h_
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#ifndef isfinite_local
+#ifdef COMPILER_MSVC
+#include <float.h>
+#define isfinite_local(val) (bool)_finite((double)val)
+#else
+#define isfinite_local isfinite
+#endif
+#endif
+
+/* bit-identical results of scalar and vector code require that
+ * multiply and add are not fused */
+#if defined __clang__
+# pragma STDC FP_CONTRACT OFF
+#elif defined __GNUC__
+# pragma GCC optimize ("fp-contract=off")
+#endif
+
+/* max number of filters in a cascade */
+#define LINEAR_SVF_LANES 8
+
+struct linear_svf {
+	double g, k;
+	double a[3];
+	double m[3];
+	double s[2];
+};
+
+static inline void linear_svf_reset(struct linear_svf *self)
+{
+	self->s[0] = self->s[1] = 0.0;
+}
+
+static inline void linear_svf_protect(struct linear_svf *self)
+{
+	if (!isfinite_local (self->s[0]) || !isfinite_local (self->s[1])) {
+		linear_svf_reset (self);
+	}
+}
+
+static inline void linear_svf_set_peq(struct linear_svf *self, float gdb, float sample_rate, float cutoff, float bandwidth)
+{
+	double f0 = (double)cutoff;
+	double q = (double)pow(2.0, 0.5 * bandwidth) / (pow(2.0, bandwidth) - 1.0);
+	double sr = (double)sample_rate;
+	double A = pow(10.0, gdb/40.0);
+
+	self->g = tan(M_PI * (f0 / sr));
+	self->k = 1.0 / (q * A);
+
+	self->a[0] = 1.0 / (1.0 + self->g * (self->g + self->k));
+	self->a[1] = self->g * self->a[0];
+	self->a[2] = self->g * self->a[1];
+
+	self->m[0] = 1.0;
+	self->m[1] = self->k * (A * A - 1.0);
+	self->m[2] = 0.0;
+}
+
+static inline void linear_svf_set_highshelf(struct linear_svf *self, float gdb, float sample_rate, float cutoff, float resonance)
+{
+	double f0 = (double)cutoff;
+	double q = (double)resonance;
+	double sr = (double)sample_rate;
+	double A = pow(10.0, gdb/40.0);
+
+	self->g = tan(M_PI * (f0 / sr));
+	self->k = 1.0 / q;
+
+	self->a[0] = 1.0 / (1.0 + self->g * (self->g + self->k));
+	self->a[1] = self->g * self->a[0];
+	self->a[2] = self->g * self->a[1];
+
+	self->m[0] = A * A;
+	self->m[1] = self->k * (1.0 - A) * A;
+	self->m[2] = 1.0 - A * A;
+}
+
+static inline void linear_svf_set_lowshelf(struct linear_svf *self, float gdb, float sample_rate, float cutoff, float resonance)
+{
+	double f0 = (double)cutoff;
+	double q = (double)resonance;
+	double sr = (double)sample_rate;
+	double A = pow(10.0, gdb/40.0);
+
+	self->g = tan(M_PI * (f0 / sr));
+	self->k = 1.0 / q;
+
+	self->a[0] = 1.0 / (1.0 + self->g * (self->g + self->k));
+	self->a[1] = self->g * self->a[0];
+	self->a[2] = self->g * self->a[1];
+
+	self->m[0] = 1.0;
+	self->m[1] = self->k * (A - 1.0);
+	self->m[2] = A * A - 1.0;
+}
+
+static inline float run_linear_svf(struct linear_svf *self, float in)
+{
+	double v[3];
+	double din = (double)in;
+	double out;
+
+	v[2] = din - self->s[1];
+	v[0] = (self->a[0] * self->s[0]) + (self->a[1] * v[2]);
+	v[1] = self->s[1] + (self->a[1] * self->s[0]) + (self->a[2] * v[2]);
+
+	self->s[0] = (2.0 * v[0]) - self->s[0];
+	self->s[1] = (2.0 * v[1]) - self->s[1];
+
+	out = (self->m[0] * din)
+		+ (self->m[1] * v[0])
+		+ (self->m[2] * v[1]);
+
+	return (float)out;
+}
+
+/* process @n_samples through @n_filters filters in series.
+ * @in and @out may point to the same buffer.
+ */
+typedef void (*linear_svf_cascade_fn) (struct linear_svf* f, uint32_t n_filters, const float* in, float* out, uint32_t n_samples);
+
+static void
+linear_svf_cascade_ref (struct linear_svf* f, uint32_t n_filters, const float* in, float* out, uint32_t n_samples)
+{
+	for (uint32_t i = 0; i < n_samples; ++i) {
+		float o = in[i];
+		for (uint32_t j = 0; j < n_filters; ++j) {
+			o = run_linear_svf (&f[j], o);
+		}
+		out[i] = o;
+	}
+}
+
+/* pipeline ramp-up and ramp-down of the vectorized cascade.
+ * p[j] is the most recent output of filter j.
+ */
+static inline void
+linear_svf_cascade_head (struct linear_svf* f, uint32_t n_filters, const float* in, float* p)
+{
+	for (uint32_t t = 0; t + 1 < n_filters; ++t) {
+		for (uint32_t j = t; j > 0; --j) {
+			p[j] = run_linear_svf (&f[j], p[j - 1]);
+		}
+		p[0] = run_linear_svf (&f[0], in[t]);
+	}
+}
+
+static inline void
+linear_svf_cascade_tail (struct linear_svf* f, uint32_t n_filters, float* out, float* p)
+{
+	for (uint32_t t = 1; t < n_filters; ++t) {
+		for (uint32_t j = n_filters - 1; j >= t; --j) {
+			p[j] = run_linear_svf (&f[j], p[j - 1]);
+		}
+		out[t - 1] = p[n_filters - 1];
+	}
+}
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2_MATH__)
+
+/* SSE2 is part of the x86_64 baseline, and used for scalar double math */
+#include <emmintrin.h>
+
+#define LINEAR_SVF_SSE2
+#define SVF_FN          linear_svf_cascade_sse2
+#define SVF_ATTR
+#define SVF_V           __m128d
+#define SVF_N           2
+#define SVF_LOAD(p)     _mm_loadu_pd (p)
+#define SVF_STORE(p, v) _mm_storeu_pd (p, v)
+#define SVF_SET1(x)     _mm_set1_pd (x)
+#define SVF_ADD(a, b)   _mm_add_pd (a, b)
+#define SVF_SUB(a, b)   _mm_sub_pd (a, b)
+#define SVF_MUL(a, b)   _mm_mul_pd (a, b)
+#define SVF_ROUND(a)    _mm_cvtps_pd (_mm_cvtpd_ps (a))
+/* { a[1], b[0] } */
+#define SVF_SHIFT(a, b) _mm_shuffle_pd (a, b, 1)
+#include "linear_svf_kernel.h"
+
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#include <immintrin.h>
+
+#define LINEAR_SVF_AVX
+#define SVF_FN          linear_svf_cascade_avx
+#define SVF_ATTR        __attribute__ ((target ("avx")))
+#define SVF_V           __m256d
+#define SVF_N           4
+#define SVF_LOAD(p)     _mm256_loadu_pd (p)
+#define SVF_STORE(p, v) _mm256_storeu_pd (p, v)
+#define SVF_SET1(x)     _mm256_set1_pd (x)
+#define SVF_ADD(a, b)   _mm256_add_pd (a, b)
+#define SVF_SUB(a, b)   _mm256_sub_pd (a, b)
+#define SVF_MUL(a, b)   _mm256_mul_pd (a, b)
+#define SVF_ROUND(a)    _mm256_cvtps_pd (_mm256_cvtpd_ps (a))
+/* { a[3], b[0], b[1], b[2] } */
+#define SVF_SHIFT(a, b) _mm256_shuffle_pd (_mm256_permute2f128_pd (a, b, 0x21), b, 5)
+#include "linear_svf_kernel.h"
+#endif
+
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+
+#include <arm_neon.h>
+
+#define LINEAR_SVF_NEON
+#define SVF_FN          linear_svf_cascade_neon
+#define SVF_ATTR
+#define SVF_V           float64x2_t
+#define SVF_N           2
+#define SVF_LOAD(p)     vld1q_f64 (p)
+#define SVF_STORE(p, v) vst1q_f64 (p, v)
+#define SVF_SET1(x)     vdupq_n_f64 (x)
+#define SVF_ADD(a, b)   vaddq_f64 (a, b)
+#define SVF_SUB(a, b)   vsubq_f64 (a, b)
+#define SVF_MUL(a, b)   vmulq_f64 (a, b)
+#define SVF_ROUND(a)    vcvt_f64_f32 (vcvt_f32_f64 (a))
+/* { a[1], b[0] } */
+#define SVF_SHIFT(a, b) vextq_f64 (a, b, 1)
+#include "linear_svf_kernel.h"
+
+#endif
+
+/* pick the best implementation for the CPU at hand */
+static inline linear_svf_cascade_fn
+linear_svf_cascade_select (void)
+{
+#ifdef LINEAR_SVF_AVX
+	__builtin_cpu_init ();
+	if (__builtin_cpu_supports ("avx")) {
+		return linear_svf_cascade_avx;
+	}
+#endif
+#if defined LINEAR_SVF_SSE2
+	return linear_svf_cascade_sse2;
+#elif defined LINEAR_SVF_NEON
+	return linear_svf_cascade_neon;
+#else
+	return linear_svf_cascade_ref;
+#endif
+}
+
+#endif
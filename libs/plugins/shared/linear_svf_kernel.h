@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/* Vectorized linear_svf cascade. This file is included by linear_svf.h
+ * once per instruction set, with SVF_FN, SVF_V and the SVF_* operations
+ * defined. It has no include guard on purpose.
+ */
+
+#define SVF_NV (LINEAR_SVF_LANES / SVF_N)
+
+SVF_ATTR static void
+SVF_FN (struct linear_svf* f, uint32_t n_filters, const float* in, float* out, uint32_t n_samples)
+{
+	if (n_filters == 0 || n_filters > LINEAR_SVF_LANES || n_samples < n_filters) {
+		linear_svf_cascade_ref (f, n_filters, in, out, n_samples);
+		return;
+	}
+
+	const uint32_t last = n_filters - 1;
+
+	float  p[LINEAR_SVF_LANES];
+	double l[9][LINEAR_SVF_LANES];
+
+	linear_svf_cascade_head (f, n_filters, in, p);
+
+	/* transpose to lanes, unused lanes are zero */
+	memset (l, 0, sizeof (l));
+	for (uint32_t j = 0; j < n_filters; ++j) {
+		l[0][j] = f[j].a[0];
+		l[1][j] = f[j].a[1];
+		l[2][j] = f[j].a[2];
+		l[3][j] = f[j].m[0];
+		l[4][j] = f[j].m[1];
+		l[5][j] = f[j].m[2];
+		l[6][j] = f[j].s[0];
+		l[7][j] = f[j].s[1];
+		l[8][j] = p[j];
+	}
+
+	SVF_V a0[SVF_NV], a1[SVF_NV], a2[SVF_NV];
+	SVF_V m0[SVF_NV], m1[SVF_NV], m2[SVF_NV];
+	SVF_V s0[SVF_NV], s1[SVF_NV], y[SVF_NV];
+
+	for (int v = 0; v < SVF_NV; ++v) {
+		a0[v] = SVF_LOAD (&l[0][v * SVF_N]);
+		a1[v] = SVF_LOAD (&l[1][v * SVF_N]);
+		a2[v] = SVF_LOAD (&l[2][v * SVF_N]);
+		m0[v] = SVF_LOAD (&l[3][v * SVF_N]);
+		m1[v] = SVF_LOAD (&l[4][v * SVF_N]);
+		m2[v] = SVF_LOAD (&l[5][v * SVF_N]);
+		s0[v] = SVF_LOAD (&l[6][v * SVF_N]);
+		s1[v] = SVF_LOAD (&l[7][v * SVF_N]);
+		y[v]  = SVF_LOAD (&l[8][v * SVF_N]);
+	}
+
+	const SVF_V two = SVF_SET1 (2.0);
+
+	double o[LINEAR_SVF_LANES];
+
+	for (uint32_t t = last; t < n_samples; ++t) {
+		SVF_V x[SVF_NV];
+		/* the input of filter j is the previous output of filter j - 1 */
+		x[0] = SVF_SHIFT (SVF_SET1 ((double)in[t]), y[0]);
+		for (int v = 1; v < SVF_NV; ++v) {
+			x[v] = SVF_SHIFT (y[v - 1], y[v]);
+		}
+
+		for (int v = 0; v < SVF_NV; ++v) {
+			/* same operations, in the same order, as run_linear_svf() */
+			const SVF_V v2 = SVF_SUB (x[v], s1[v]);
+			const SVF_V v0 = SVF_ADD (SVF_MUL (a0[v], s0[v]), SVF_MUL (a1[v], v2));
+			const SVF_V v1 = SVF_ADD (SVF_ADD (s1[v], SVF_MUL (a1[v], s0[v])), SVF_MUL (a2[v], v2));
+
+			s0[v] = SVF_SUB (SVF_MUL (two, v0), s0[v]);
+			s1[v] = SVF_SUB (SVF_MUL (two, v1), s1[v]);
+
+			y[v] = SVF_ROUND (SVF_ADD (SVF_ADD (SVF_MUL (m0[v], x[v]), SVF_MUL (m1[v], v0)), SVF_MUL (m2[v], v1)));
+		}
+
+		SVF_STORE (&o[(last / SVF_N) * SVF_N], y[last / SVF_N]);
+		out[t - last] = (float)o[last];
+	}
+
+	for (int v = 0; v < SVF_NV; ++v) {
+		SVF_STORE (&l[6][v * SVF_N], s0[v]);
+		SVF_STORE (&l[7][v * SVF_N], s1[v]);
+		SVF_STORE (&l[8][v * SVF_N], y[v]);
+	}
+
+	for (uint32_t j = 0; j < n_filters; ++j) {
+		f[j].s[0] = l[6][j];
+		f[j].s[1] = l[7][j];
+		p[j]      = (float)l[8][j];
+	}
+
+	linear_svf_cascade_tail (f, n_filters, &out[n_samples - last], p);
+}
+
+#undef SVF_NV
+#undef SVF_FN
+#undef SVF_ATTR
+#undef SVF_V
+#undef SVF_N
+#undef SVF_LOAD
+#undef SVF_STORE
+#undef SVF_SET1
+#undef SVF_ADD
+#undef SVF_SUB
+#undef SVF_MUL
+#undef SVF_ROUND
+#undef SVF_SHIFT
@@ -114,6 +114,7 @@ OSC::OSC (Session& s, uint32_t port)
 	, default_gainmode (0)
 	, default_send_size (0)
 	, default_plugin_size (0)
+	, _bundle_feedback (false)
 	, tick (true)
 	, bank_dirty (false)
 	, observer_busy (true)
@@ -324,6 +325,10 @@ OSC::stop ()
 	}
 	_surface.clear();
 
+	// send the final clear messages of the observers
+	_feedback_scheduler.flush ();
+	_feedback_scheduler.clear ();
+
 	/* stop main loop */
 	if (local_server) {
 		g_source_destroy (local_server);
@@ -363,6 +368,9 @@ OSC::stop ()
 void
 OSC::surface_destroy (OSCSurface* sur)
 {
+	/* the surface gets a complete update from new observers */
+	_feedback_scheduler.forget (sur->remote_url);
+
 	OSCSelectObserver* so;
 	if ((so = dynamic_cast<OSCSelectObserver*>(sur->sel_obs)) != 0) {
 		so->clear_observer ();
@@ -426,6 +434,8 @@ OSC::register_callbacks()
 		REGISTER_CALLBACK (serv, X_("/refresh"), "f", refresh_surface);
 		REGISTER_CALLBACK (serv, X_("/strip/list"), "", routes_list);
 		REGISTER_CALLBACK (serv, X_("/strip/list"), "f", routes_list);
+		REGISTER_CALLBACK (serv, X_("/strip/dsp_profile"), "", dsp_profile_list);
+		REGISTER_CALLBACK (serv, X_("/strip/dsp_profile"), "f", dsp_profile_list);
 		REGISTER_CALLBACK (serv, X_("/group/list"), "", group_list);
 		REGISTER_CALLBACK (serv, X_("/group/list"), "f", group_list);
 		REGISTER_CALLBACK (serv, X_("/strip/custom/mode"), "f", custom_mode);
@@ -1310,6 +1320,53 @@ OSC::routes_list (lo_message msg)
 
 }
 
+void
+OSC::dsp_profile_list (lo_message msg)
+{
+	if (!session) {
+		return;
+	}
+	OSCSurface *sur = get_surface(get_address (msg), true);
+	const char* reply_path = sur->feedback[14] ? X_("/reply") : X_("#reply");
+
+	/* cycle budget in usec, all times are in usec */
+	const uint64_t budget = (uint64_t) session->get_block_size () * 1000000 / std::max<samplecnt_t> (1, session->sample_rate());
+
+	for (int n = 0; n < (int) sur->nstrips; ++n) {
+
+		boost::shared_ptr<Route> r = boost::dynamic_pointer_cast<Route> (get_strip (n + 1, get_address (msg)));
+		if (!r) {
+			continue;
+		}
+
+		PBD::TimingHistogram& h (r->dsp_histogram ());
+		lo_message reply = lo_message_new ();
+		lo_message_add_string (reply, X_("dsp_profile"));
+		lo_message_add_int32 (reply, n + 1);
+		lo_message_add_string (reply, r->name().c_str());
+		lo_message_add_int64 (reply, h.count ());
+		lo_message_add_float (reply, h.avg ());
+		lo_message_add_int64 (reply, h.percentile (.5));
+		lo_message_add_int64 (reply, h.percentile (.99));
+		lo_message_add_int64 (reply, h.max ());
+		lo_message_add_int64 (reply, h.count_above (budget));
+		lo_send_message (get_address (msg), reply_path, reply);
+		lo_message_free (reply);
+	}
+
+	lo_message reply = lo_message_new ();
+	lo_message_add_string (reply, X_("end_dsp_profile"));
+	lo_message_add_int64 (reply, budget);
+	PBD::TimingHistogram* gh = session->process_graph_dsp_histogram ();
+	lo_message_add_int64 (reply, gh ? gh->percentile (.99) : 0);
+	lo_message_add_int64 (reply, gh ? gh->max () : 0);
+	PBD::TimingHistogram* wh = session->process_graph_wait_histogram ();
+	lo_message_add_int64 (reply, wh ? wh->percentile (.99) : 0);
+	lo_message_add_int64 (reply, wh ? wh->max () : 0);
+	lo_send_message (get_address (msg), reply_path, reply);
+	lo_message_free (reply);
+}
+
 void
 OSC::surface_list (lo_message msg)
 {
@@ -1357,6 +1414,11 @@ OSC::get_surfaces ()
 		PBD::info << string_compose ("	Expanded flag %1   Track: %2   Jogmode: %3\n", sur->expand_enable, sur->expand, sur->jogmode);
 		PBD::info << string_compose ("	Personal monitor flag %1,   Aux master: %2,   Number of sends: %3\n", sur->cue, sur->aux, sur->sends.size());
 		PBD::info << string_compose ("	Linkset: %1   Device Id: %2\n", sur->linkset, sur->linkid);
+		if (_bundle_feedback) {
+			OSCFeedbackScheduler::Stats fs = _feedback_scheduler.stats (sur->remote_url);
+			PBD::info << string_compose ("	Feedback messages queued: %1   sent: %2 in %3 bundles (%4 bytes)\n", fs.queued, fs.sent, fs.bundles, fs.bytes);
+			PBD::info << string_compose ("	Feedback messages coalesced: %1   deduplicated: %2   dropped: %3   deferred: %4\n", fs.coalesced, fs.deduped, fs.dropped, fs.deferred);
+		}
 	}
 	PBD::info << string_compose ("\nList of LinkSets (%1):\n", link_sets.size());
 	std::map<uint32_t, LinkSet>::iterator it;
@@ -6338,9 +6400,27 @@ OSC::periodic (void)
 			x++;
 		}
 	}
+	if (_bundle_feedback) {
+		_feedback_scheduler.flush ();
+	}
 	return true;
 }
 
+void
+OSC::set_bundle_feedback (bool yn)
+{
+	if (_bundle_feedback == yn) {
+		return;
+	}
+	_bundle_feedback = yn;
+	if (!yn) {
+		/* pending messages are not sent anymore, surfaces are refreshed
+		 * on the next gui_changed () or /refresh anyway
+		 */
+		_feedback_scheduler.clear ();
+	}
+}
+
 XMLNode&
 OSC::get_state ()
 {
@@ -6354,6 +6434,8 @@ OSC::get_state ()
 	node.set_property (X_("gainmode"), default_gainmode);
 	node.set_property (X_("send-page-size"), default_send_size);
 	node.set_property (X_("plug-page-size"), default_plugin_size);
+	node.set_property (X_("bundle-feedback"), _bundle_feedback);
+	node.set_property (X_("feedback-max-rate"), _feedback_scheduler.max_rate ());
 	return node;
 }
 
@@ -6377,6 +6459,15 @@ OSC::set_state (const XMLNode& node, int version)
 	node.get_property (X_("send-page-size"), default_send_size);
 	node.get_property (X_("plugin-page-size"), default_plugin_size);
 
+	bool bundle_feedback;
+	if (node.get_property (X_("bundle-feedback"), bundle_feedback)) {
+		set_bundle_feedback (bundle_feedback);
+	}
+	uint32_t max_rate;
+	if (node.get_property (X_("feedback-max-rate"), max_rate)) {
+		_feedback_scheduler.set_max_rate (max_rate);
+	}
+
 	global_init = true;
 	tick = false;
 
@@ -6900,6 +6991,11 @@ OSC::cue_send_enable (uint32_t id, float state, lo_message msg)
 int
 OSC::float_message (string path, float val, lo_address addr)
 {
+	if (_bundle_feedback) {
+		_feedback_scheduler.queue_float (addr, path, val);
+		return 0;
+	}
+
 	_lo_lock.lock ();
 
 	lo_message reply;
@@ -6917,6 +7013,15 @@ OSC::float_message (string path, float val, lo_address addr)
 int
 OSC::float_message_with_id (std::string path, uint32_t ssid, float value, bool in_line, lo_address addr)
 {
+	if (_bundle_feedback) {
+		if (in_line) {
+			_feedback_scheduler.queue_float (addr, string_compose ("%1/%2", path, ssid), value);
+		} else {
+			_feedback_scheduler.queue_float (addr, path, ssid, value);
+		}
+		return 0;
+	}
+
 	_lo_lock.lock ();
 	lo_message msg = lo_message_new ();
 	if (in_line) {
@@ -6936,6 +7041,11 @@ OSC::float_message_with_id (std::string path, uint32_t ssid, float value, bool i
 int
 OSC::int_message (string path, int val, lo_address addr)
 {
+	if (_bundle_feedback) {
+		_feedback_scheduler.queue_int (addr, path, val);
+		return 0;
+	}
+
 	_lo_lock.lock ();
 
 	lo_message reply;
@@ -6953,6 +7063,15 @@ OSC::int_message (string path, int val, lo_address addr)
 int
 OSC::int_message_with_id (std::string path, uint32_t ssid, int value, bool in_line, lo_address addr)
 {
+	if (_bundle_feedback) {
+		if (in_line) {
+			_feedback_scheduler.queue_int (addr, string_compose ("%1/%2", path, ssid), value);
+		} else {
+			_feedback_scheduler.queue_int (addr, path, ssid, value);
+		}
+		return 0;
+	}
+
 	_lo_lock.lock ();
 	lo_message msg = lo_message_new ();
 	if (in_line) {
@@ -6972,6 +7091,11 @@ OSC::int_message_with_id (std::string path, uint32_t ssid, int value, bool in_li
 int
 OSC::text_message (string path, string val, lo_address addr)
 {
+	if (_bundle_feedback) {
+		_feedback_scheduler.queue_text (addr, path, val);
+		return 0;
+	}
+
 	_lo_lock.lock ();
 
 	lo_message reply;
@@ -6989,6 +7113,15 @@ OSC::text_message (string path, string val, lo_address addr)
 int
 OSC::text_message_with_id (std::string path, uint32_t ssid, std::string val, bool in_line, lo_address addr)
 {
+	if (_bundle_feedback) {
+		if (in_line) {
+			_feedback_scheduler.queue_text (addr, string_compose ("%1/%2", path, ssid), val);
+		} else {
+			_feedback_scheduler.queue_text (addr, path, ssid, val);
+		}
+		return 0;
+	}
+
 	_lo_lock.lock ();
 	lo_message msg = lo_message_new ();
 	if (in_line) {
@@ -48,6 +48,8 @@
 
 #include "pbd/i18n.h"
 
+#include "osc_feedback_scheduler.h"
+
 class OSCControllable;
 class OSCRouteObserver;
 class OSCGlobalObserver;
@@ -261,6 +263,11 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	void get_surfaces ();
 	std::string get_remote_port () { return remote_port; }
 	void set_remote_port (std::string pt) { remote_port = pt; }
+	bool get_bundle_feedback () const { return _bundle_feedback; }
+	void set_bundle_feedback (bool yn);
+	uint32_t get_feedback_max_rate () const { return _feedback_scheduler.max_rate (); }
+	void set_feedback_max_rate (uint32_t bps) { _feedback_scheduler.set_max_rate (bps); }
+	OSCFeedbackScheduler::Stats feedback_stats () const { return _feedback_scheduler.total_stats (); }
 
   protected:
         void thread_init ();
@@ -288,6 +295,8 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	uint32_t default_gainmode;
 	uint32_t default_send_size;
 	uint32_t default_plugin_size;
+	bool _bundle_feedback;
+	OSCFeedbackScheduler _feedback_scheduler;
 	bool tick;
 	bool bank_dirty;
 	bool observer_busy;
@@ -337,6 +346,7 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	int route_get_sends (lo_message msg);
 	int route_get_receives(lo_message msg);
 	void routes_list (lo_message msg);
+	void dsp_profile_list (lo_message msg);
 	int group_list (lo_message msg);
 	void surface_list (lo_message msg);
 	void transport_sample (lo_message msg);
@@ -388,6 +398,7 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	PATH_CALLBACK_MSG(route_get_sends);
 	PATH_CALLBACK_MSG(route_get_receives);
 	PATH_CALLBACK_MSG(routes_list);
+	PATH_CALLBACK_MSG(dsp_profile_list);
 	PATH_CALLBACK_MSG(group_list);
 	PATH_CALLBACK_MSG(sel_previous);
 	PATH_CALLBACK_MSG(sel_next);
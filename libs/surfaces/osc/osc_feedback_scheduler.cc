@@ -0,0 +1,349 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstdlib>
+
+#include <glib.h>
+
+#include "pbd/compose.h"
+
+#include "osc_feedback_scheduler.h"
+
+using namespace ArdourSurface;
+
+/* OSC strings and blobs are padded to 4 bytes, including the terminating 0 */
+static size_t
+osc_pad (size_t len)
+{
+	return (len + 4) & ~(size_t) 3;
+}
+
+OSCFeedbackScheduler::Destination::Destination (std::string const& url)
+	: addr (lo_address_new_from_url (url.c_str ()))
+	, budget (0)
+	, last_refill (g_get_monotonic_time ())
+{
+}
+
+OSCFeedbackScheduler::Destination::~Destination ()
+{
+	if (addr) {
+		lo_address_free (addr);
+	}
+}
+
+OSCFeedbackScheduler::OSCFeedbackScheduler ()
+	: _max_rate (0)
+{
+}
+
+OSCFeedbackScheduler::~OSCFeedbackScheduler ()
+{
+	clear ();
+}
+
+void
+OSCFeedbackScheduler::queue_float (lo_address addr, std::string const& path, float val)
+{
+	Value v;
+	v.type = 'f';
+	v.f = val;
+	queue (addr, path, false, 0, v);
+}
+
+void
+OSCFeedbackScheduler::queue_int (lo_address addr, std::string const& path, int32_t val)
+{
+	Value v;
+	v.type = 'i';
+	v.i = val;
+	queue (addr, path, false, 0, v);
+}
+
+void
+OSCFeedbackScheduler::queue_text (lo_address addr, std::string const& path, std::string const& val)
+{
+	Value v;
+	v.type = 's';
+	v.s = val;
+	queue (addr, path, false, 0, v);
+}
+
+void
+OSCFeedbackScheduler::queue_float (lo_address addr, std::string const& path, uint32_t ssid, float val)
+{
+	Value v;
+	v.type = 'f';
+	v.f = val;
+	queue (addr, path, true, ssid, v);
+}
+
+void
+OSCFeedbackScheduler::queue_int (lo_address addr, std::string const& path, uint32_t ssid, int32_t val)
+{
+	Value v;
+	v.type = 'i';
+	v.i = val;
+	queue (addr, path, true, ssid, v);
+}
+
+void
+OSCFeedbackScheduler::queue_text (lo_address addr, std::string const& path, uint32_t ssid, std::string const& val)
+{
+	Value v;
+	v.type = 's';
+	v.s = val;
+	queue (addr, path, true, ssid, v);
+}
+
+void
+OSCFeedbackScheduler::queue (lo_address addr, std::string const& path, bool has_id, uint32_t ssid, Value const& val)
+{
+	char* curl = lo_address_get_url (addr);
+	if (!curl) {
+		return;
+	}
+	std::string url = curl;
+	free (curl);
+
+	std::string key = has_id ? string_compose ("%1 %2", path, ssid) : path;
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	Destinations::iterator d = _destinations.find (url);
+	if (d == _destinations.end ()) {
+		d = _destinations.insert (std::make_pair (url, new Destination (url))).first;
+	}
+	Destination& dest (*d->second);
+
+	++dest.stats.queued;
+
+	std::map<std::string, size_t>::const_iterator i = dest.index.find (key);
+	if (i != dest.index.end ()) {
+		/* replace the pending value, keep its position */
+		dest.pending[i->second].value = val;
+		++dest.stats.coalesced;
+		return;
+	}
+
+	Pending p;
+	p.path   = path;
+	p.has_id = has_id;
+	p.ssid   = ssid;
+	p.value  = val;
+	p.key    = key;
+
+	dest.index[key] = dest.pending.size ();
+	dest.pending.push_back (p);
+}
+
+void
+OSCFeedbackScheduler::flush ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	int64_t now = g_get_monotonic_time ();
+	for (Destinations::iterator d = _destinations.begin (); d != _destinations.end (); ++d) {
+		flush (*d->second, now);
+	}
+}
+
+void
+OSCFeedbackScheduler::flush (Destination& dest, int64_t now)
+{
+	if (dest.pending.empty () || !dest.addr) {
+		return;
+	}
+
+	if (_max_rate > 0) {
+		/* refill, allow for at most one second worth of burst */
+		dest.budget += (now - dest.last_refill) * _max_rate / 1000000;
+		if (dest.budget > (int64_t) _max_rate) {
+			dest.budget = _max_rate;
+		}
+	}
+	dest.last_refill = now;
+
+	std::vector<Pending>        keep;
+	std::vector<Pending const*> batch;
+	size_t const                bundle_header = 16; // "#bundle\0" + timetag
+	size_t                      batch_size    = bundle_header;
+	bool                        sent_any      = false;
+
+	for (std::vector<Pending>::const_iterator p = dest.pending.begin (); p != dest.pending.end (); ++p) {
+
+		std::map<std::string, Sent>::const_iterator h = dest.history.find (p->key);
+		if (h != dest.history.end () && h->second.value == p->value && now - h->second.when < resend_ms * 1000) {
+			++dest.stats.deduped;
+			continue;
+		}
+
+		/* element size + path + type-tags + arguments */
+		size_t size = 4 + osc_pad (p->path.size ()) + osc_pad (2 + (p->has_id ? 1 : 0)) + (p->has_id ? 4 : 0);
+		size += p->value.type == 's' ? osc_pad (p->value.s.size ()) : 4;
+
+		if (_max_rate > 0) {
+			/* always let one message through per flush, even if it is
+			 * larger than the budget. The budget then goes negative,
+			 * and following flushes are delayed to keep the average rate.
+			 */
+			if ((int64_t) size > dest.budget && sent_any) {
+				if (is_volatile (p->path)) {
+					++dest.stats.dropped;
+				} else {
+					keep.push_back (*p);
+					++dest.stats.deferred;
+				}
+				continue;
+			}
+			dest.budget -= size;
+		}
+
+		if (batch_size + size > max_bundle_size && !batch.empty ()) {
+			send (dest, batch, now);
+			batch.clear ();
+			batch_size = bundle_header;
+		}
+		batch.push_back (&(*p));
+		batch_size += size;
+		sent_any = true;
+	}
+
+	if (!batch.empty ()) {
+		send (dest, batch, now);
+	}
+
+	dest.pending.swap (keep);
+	dest.index.clear ();
+	for (size_t n = 0; n < dest.pending.size (); ++n) {
+		dest.index[dest.pending[n].key] = n;
+	}
+}
+
+void
+OSCFeedbackScheduler::send (Destination& dest, std::vector<Pending const*> const& batch, int64_t now)
+{
+	lo_timetag tt;
+	lo_timetag_now (&tt);
+
+	lo_bundle bundle = lo_bundle_new (tt);
+
+	for (std::vector<Pending const*>::const_iterator p = batch.begin (); p != batch.end (); ++p) {
+		/* paths must remain valid until the bundle is sent, they are owned by dest.pending */
+		lo_bundle_add_message (bundle, (*p)->path.c_str (), make_message (**p));
+	}
+
+	int rv = lo_send_bundle (dest.addr, bundle);
+
+	if (rv < 0) {
+		dest.stats.dropped += batch.size ();
+	} else {
+		dest.stats.sent += batch.size ();
+		dest.stats.bytes += rv;
+		++dest.stats.bundles;
+		for (std::vector<Pending const*>::const_iterator p = batch.begin (); p != batch.end (); ++p) {
+			Sent& s (dest.history[(*p)->key]);
+			s.value = (*p)->value;
+			s.when  = now;
+		}
+	}
+
+	lo_bundle_free_messages (bundle);
+}
+
+lo_message
+OSCFeedbackScheduler::make_message (Pending const& p)
+{
+	lo_message msg = lo_message_new ();
+	if (p.has_id) {
+		lo_message_add_int32 (msg, p.ssid);
+	}
+	switch (p.value.type) {
+		case 'f':
+			lo_message_add_float (msg, p.value.f);
+			break;
+		case 'i':
+			lo_message_add_int32 (msg, p.value.i);
+			break;
+		default:
+			lo_message_add_string (msg, p.value.s.c_str ());
+			break;
+	}
+	return msg;
+}
+
+bool
+OSCFeedbackScheduler::is_volatile (std::string const& path)
+{
+	/* continuously updated, a later value supersedes a lost one */
+	return path.find ("/meter") != std::string::npos
+		|| path.find ("/signal") != std::string::npos
+		|| path == "/heartbeat";
+}
+
+void
+OSCFeedbackScheduler::forget (std::string const& url)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	Destinations::iterator d = _destinations.find (url);
+	if (d == _destinations.end ()) {
+		return;
+	}
+	d->second->pending.clear ();
+	d->second->index.clear ();
+	d->second->history.clear ();
+}
+
+void
+OSCFeedbackScheduler::clear ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	for (Destinations::iterator d = _destinations.begin (); d != _destinations.end (); ++d) {
+		delete d->second;
+	}
+	_destinations.clear ();
+}
+
+OSCFeedbackScheduler::Stats
+OSCFeedbackScheduler::stats (std::string const& url) const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	Destinations::const_iterator d = _destinations.find (url);
+	if (d == _destinations.end ()) {
+		return Stats ();
+	}
+	return d->second->stats;
+}
+
+OSCFeedbackScheduler::Stats
+OSCFeedbackScheduler::total_stats () const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	Stats rv;
+	for (Destinations::const_iterator d = _destinations.begin (); d != _destinations.end (); ++d) {
+		Stats const& s (d->second->stats);
+		rv.queued    += s.queued;
+		rv.sent      += s.sent;
+		rv.bundles   += s.bundles;
+		rv.bytes     += s.bytes;
+		rv.coalesced += s.coalesced;
+		rv.deduped   += s.deduped;
+		rv.dropped   += s.dropped;
+		rv.deferred  += s.deferred;
+	}
+	return rv;
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __osc_oscfeedbackscheduler_h__
+#define __osc_oscfeedbackscheduler_h__
+
+#include <map>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include <lo/lo.h>
+
+#include <glibmm/threads.h>
+
+namespace ArdourSurface {
+
+/* Collects feedback messages per surface (remote url) and sends them
+ * as timestamped OSC bundles from OSC::periodic ().
+ *
+ * - a message that is queued again before the next flush replaces the
+ *   pending one (coalesce)
+ * - a message whose value equals the value last sent to the surface is
+ *   not sent again, unless it was last sent more than resend_ms ago (dedup)
+ * - every surface has a byte budget per second. Messages over budget are
+ *   kept for the next flush, meters are dropped instead (rate limit).
+ *   At least one message is sent per flush, so that messages larger
+ *   than the budget are not deferred forever.
+ */
+class OSCFeedbackScheduler
+{
+  public:
+	OSCFeedbackScheduler ();
+	~OSCFeedbackScheduler ();
+
+	struct Stats {
+		Stats () : queued (0), sent (0), bundles (0), bytes (0), coalesced (0), deduped (0), dropped (0), deferred (0) {}
+		uint64_t queued;    // messages handed to the scheduler
+		uint64_t sent;      // messages that went out in a bundle
+		uint64_t bundles;   // bundles sent
+		uint64_t bytes;     // bundle bytes sent
+		uint64_t coalesced; // replaced by a newer value before sending
+		uint64_t deduped;   // value unchanged from what the surface has
+		uint64_t dropped;   // volatile messages dropped over budget, or send failures
+		uint64_t deferred;  // postponed to a later flush over budget
+	};
+
+	/** max bytes per second per surface, 0: unlimited */
+	void set_max_rate (uint32_t bytes_per_sec) { _max_rate = bytes_per_sec; }
+	uint32_t max_rate () const { return _max_rate; }
+
+	void queue_float (lo_address, std::string const& path, float val);
+	void queue_int (lo_address, std::string const& path, int32_t val);
+	void queue_text (lo_address, std::string const& path, std::string const& val);
+	void queue_float (lo_address, std::string const& path, uint32_t ssid, float val);
+	void queue_int (lo_address, std::string const& path, uint32_t ssid, int32_t val);
+	void queue_text (lo_address, std::string const& path, uint32_t ssid, std::string const& val);
+
+	/** send pending messages of all surfaces, called from the surface thread */
+	void flush ();
+
+	/** drop pending messages and the dedup history for @a url,
+	 * e.g. when a surface is refreshed and expects a full update
+	 */
+	void forget (std::string const& url);
+	void clear ();
+
+	Stats stats (std::string const& url) const;
+	Stats total_stats () const;
+
+  private:
+	struct Value {
+		Value () : type ('f'), f (0), i (0) {}
+
+		bool operator== (Value const& other) const {
+			if (type != other.type) {
+				return false;
+			}
+			switch (type) {
+				case 'f':
+					return f == other.f;
+				case 'i':
+					return i == other.i;
+				default:
+					return s == other.s;
+			}
+		}
+
+		char        type;
+		float       f;
+		int32_t     i;
+		std::string s;
+	};
+
+	struct Pending {
+		std::string path;
+		bool        has_id;
+		uint32_t    ssid;
+		Value       value;
+		std::string key;
+	};
+
+	struct Sent {
+		Value   value;
+		int64_t when;
+	};
+
+	struct Destination {
+		Destination (std::string const&);
+		~Destination ();
+
+		lo_address addr;
+		std::vector<Pending>              pending;
+		std::map<std::string, size_t>     index;   // key -> pending[]
+		std::map<std::string, Sent>       history; // key -> last sent
+		int64_t                           budget;
+		int64_t                           last_refill;
+		Stats                             stats;
+
+	  private:
+		Destination (Destination const&);
+	};
+
+	typedef std::map<std::string, Destination*> Destinations;
+
+	void queue (lo_address, std::string const& path, bool has_id, uint32_t ssid, Value const&);
+	void flush (Destination&, int64_t now);
+	void send (Destination&, std::vector<Pending const*> const&, int64_t now);
+
+	static lo_message make_message (Pending const&);
+	static bool is_volatile (std::string const& path);
+
+	mutable Glib::Threads::Mutex _lock;
+	Destinations                 _destinations;
+	uint32_t                     _max_rate;
+
+	static const int64_t resend_ms       = 1000;
+	static const size_t  max_bundle_size = 1400; // stay below a typical ethernet MTU
+};
+
+} // namespace ArdourSurface
+
+#endif /* __osc_oscfeedbackscheduler_h__ */
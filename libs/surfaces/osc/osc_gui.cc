@@ -145,6 +145,29 @@ OSC_GUI::OSC_GUI (OSC& p)
 	gainmode_combo.set_active ((int)cp.get_gainmode());
 	++n;
 
+	// Feedback bundling
+	label = manage (new Gtk::Label(_("Feedback:")));
+	label->set_alignment(1, .5);
+	table->attach (*label, 0, 1, n, n+1, AttachOptions(FILL|EXPAND), AttachOptions(0));
+	table->attach (bundle_combo, 1, 2, n, n+1, AttachOptions(FILL|EXPAND), AttachOptions(0), 0, 0);
+	std::vector<std::string> bundle_options;
+	bundle_options.push_back (_("One message per change"));
+	bundle_options.push_back (_("Bundled"));
+	bundle_options.push_back (_("Bundled, max 16 kB/s per surface"));
+	bundle_options.push_back (_("Bundled, max 64 kB/s per surface"));
+
+	set_popdown_strings (bundle_combo, bundle_options);
+	if (!cp.get_bundle_feedback ()) {
+		bundle_combo.set_active (0);
+	} else if (cp.get_feedback_max_rate () == 0) {
+		bundle_combo.set_active (1);
+	} else if (cp.get_feedback_max_rate () <= 16384) {
+		bundle_combo.set_active (2);
+	} else {
+		bundle_combo.set_active (3);
+	}
+	++n;
+
 	// debug setting
 	label = manage (new Gtk::Label(_("Debug:")));
 	label->set_alignment(1, .5);
@@ -188,6 +211,7 @@ OSC_GUI::OSC_GUI (OSC& p)
 	debug_combo.signal_changed().connect (sigc::mem_fun (*this, &OSC_GUI::debug_changed));
 	portmode_combo.signal_changed().connect (sigc::mem_fun (*this, &OSC_GUI::portmode_changed));
 	gainmode_combo.signal_changed().connect (sigc::mem_fun (*this, &OSC_GUI::gainmode_changed));
+	bundle_combo.signal_changed().connect (sigc::mem_fun (*this, &OSC_GUI::bundle_changed));
 	port_entry.signal_changed().connect (sigc::mem_fun (*this, &OSC_GUI::port_changed));
 	port_entry.signal_focus_out_event().connect (sigc::mem_fun (*this, &OSC_GUI::port_focus_out));
 	bank_entry.signal_changed().connect (sigc::mem_fun (*this, &OSC_GUI::bank_changed));
@@ -507,6 +531,31 @@ OSC_GUI::debug_changed ()
 	}
 }
 
+void
+OSC_GUI::bundle_changed ()
+{
+	switch (bundle_combo.get_active_row_number ()) {
+		case 0:
+			cp.set_bundle_feedback (false);
+			cp.set_feedback_max_rate (0);
+			break;
+		case 1:
+			cp.set_bundle_feedback (true);
+			cp.set_feedback_max_rate (0);
+			break;
+		case 2:
+			cp.set_bundle_feedback (true);
+			cp.set_feedback_max_rate (16384);
+			break;
+		case 3:
+			cp.set_bundle_feedback (true);
+			cp.set_feedback_max_rate (65536);
+			break;
+		default:
+			break;
+	}
+}
+
 void
 OSC_GUI::portmode_changed ()
 {
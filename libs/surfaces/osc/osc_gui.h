@@ -46,6 +46,7 @@ private:
 	Gtk::SpinButton send_page_entry;
 	Gtk::SpinButton plugin_page_entry;
 	Gtk::ComboBoxText gainmode_combo;
+	Gtk::ComboBoxText bundle_combo;
 	Gtk::ComboBoxText preset_combo;
 	std::vector<std::string> preset_options;
 	std::map<std::string,std::string> preset_files;
@@ -66,6 +67,7 @@ private:
 
 	void debug_changed ();
 	void portmode_changed ();
+	void bundle_changed ();
 	void gainmode_changed ();
 	void clear_device ();
 	void factory_reset ();
@@ -58,6 +58,23 @@ ClientContext::update_state (const NodeState& node_state)
 	_state.insert (node_state);
 }
 
+bool
+ClientContext::meter_due (int64_t now)
+{
+	if (!has_meter_stream () || now < _next_meter_us) {
+		return false;
+	}
+
+	_next_meter_us += _meter_interval_us;
+
+	if (_next_meter_us <= now) {
+		/* do not try to catch up after a stall */
+		_next_meter_us = now + _meter_interval_us;
+	}
+
+	return true;
+}
+
 std::string
 ClientContext::debug_str ()
 {
@@ -21,6 +21,7 @@
 
 #include <set>
 #include <list>
+#include <vector>
 
 #include "message.h"
 #include "state.h"
@@ -34,8 +35,16 @@ typedef std::list<NodeStateMessage> ClientOutputBuffer;
 class ClientContext
 {
 public:
+	enum Protocol {
+		JSON,  /* one text message per node state */
+		Binary /* node states coalesced into binary frames, see frame.h */
+	};
+
 	ClientContext (Client wsi)
-	    : _wsi (wsi){};
+	    : _wsi (wsi)
+	    , _protocol (JSON)
+	    , _meter_interval_us (0)
+	    , _next_meter_us (0){};
 	virtual ~ClientContext (){};
 
 	Client wsi () const
@@ -43,6 +52,34 @@ public:
 		return _wsi;
 	}
 
+	Protocol protocol () const
+	{
+		return _protocol;
+	}
+	void set_protocol (Protocol p)
+	{
+		_protocol = p;
+	}
+
+	/* meter stream, binary clients only. 0: disabled, use Node::strip_meter */
+	bool has_meter_stream () const
+	{
+		return _protocol == Binary && _meter_interval_us > 0;
+	}
+	void set_meter_interval (int64_t us)
+	{
+		_meter_interval_us = us;
+		_next_meter_us     = 0;
+	}
+	bool meter_due (int64_t now);
+
+	/* most recent meter frame, including LWS_PRE headroom. Only the latest
+	 * one is kept: a slow client drops meter frames, never node states */
+	std::vector<unsigned char>& meter_buf ()
+	{
+		return _meter_buf;
+	}
+
 	bool has_state (const NodeState&);
 	void update_state (const NodeState&);
 
@@ -54,7 +91,12 @@ public:
 	std::string debug_str ();
 
 private:
-	Client _wsi;
+	Client   _wsi;
+	Protocol _protocol;
+	int64_t  _meter_interval_us;
+	int64_t  _next_meter_us;
+
+	std::vector<unsigned char> _meter_buf;
 
 	typedef std::set<NodeState> ClientState;
 	ClientState                 _state;
@@ -22,6 +22,7 @@
 
 #include "ardour_websockets.h"
 #include "dispatcher.h"
+#include "server.h"
 #include "state.h"
 
 using namespace ARDOUR;
@@ -38,7 +39,8 @@ WebsocketsDispatcher::NodeMethodMap
 		NODE_METHOD_PAIR (strip_pan)
 		NODE_METHOD_PAIR (strip_mute)
 		NODE_METHOD_PAIR (strip_plugin_enable)
-		NODE_METHOD_PAIR (strip_plugin_param_value);
+		NODE_METHOD_PAIR (strip_plugin_param_value)
+		NODE_METHOD_PAIR (client_protocol);
 
 void
 WebsocketsDispatcher::dispatch (Client client, const NodeStateMessage& msg)
@@ -266,6 +268,24 @@ WebsocketsDispatcher::strip_plugin_param_value_handler (Client client, const Nod
 	}
 }
 
+void
+WebsocketsDispatcher::client_protocol_handler (Client client, const NodeStateMessage& msg)
+{
+	const NodeState& state = msg.state ();
+
+	if (!msg.is_write () || (state.n_val () < 1)) {
+		return;
+	}
+
+	/* val[0] = "json" | "binary", val[1] = meter stream rate in Hz (binary only, optional) */
+	std::string protocol   = state.nth_val (0);
+	int         meter_rate = (state.n_val () > 1) ? static_cast<int> (state.nth_val (1)) : 0;
+
+	server ().set_client_protocol (client,
+	                               protocol == "binary" ? ClientContext::Binary : ClientContext::JSON,
+	                               meter_rate);
+}
+
 void
 WebsocketsDispatcher::update (Client client, std::string node, TypedValue val1)
 {
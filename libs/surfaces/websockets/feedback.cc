@@ -109,6 +109,11 @@ ArdourFeedback::start ()
                                                                          &ArdourFeedback::poll));
 	periodic_timeout->attach (main_loop ()->get_context ());
 
+	// binary clients can subscribe to a faster meter stream
+	Glib::RefPtr<Glib::TimeoutSource> meter_timeout = Glib::TimeoutSource::create (1000 / METER_STREAM_MAX_RATE);
+	_meter_connection = meter_timeout->connect (sigc::mem_fun (*this, &ArdourFeedback::meter_poll));
+	meter_timeout->attach (main_loop ()->get_context ());
+
 	return 0;
 }
 
@@ -116,6 +121,7 @@ int
 ArdourFeedback::stop ()
 {
 	_periodic_connection.disconnect ();
+	_meter_connection.disconnect ();
 	_transport_connections.drop_connections ();
 	
 	return 0;
@@ -179,6 +185,28 @@ ArdourFeedback::poll () const
 	return true;
 }
 
+bool
+ArdourFeedback::meter_poll () const
+{
+	if (!server ().has_meter_clients ()) {
+		return true;
+	}
+
+	BinaryFrame frame (BinaryFrame::Meters, LWS_PRE);
+
+	{
+		Glib::Threads::Mutex::Lock lock (mixer ().mutex ());
+
+		for (ArdourMixer::StripMap::iterator it = mixer ().strips ().begin (); it != mixer ().strips ().end (); ++it) {
+			frame.add_meter (it->first, it->second->meter_level_db ());
+		}
+	}
+
+	server ().update_meter_clients (frame);
+
+	return true;
+}
+
 void
 ArdourFeedback::observe_transport ()
 {
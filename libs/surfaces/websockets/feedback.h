@@ -48,8 +48,10 @@ private:
 	Glib::Threads::Mutex      _client_state_lock;
 	PBD::ScopedConnectionList _transport_connections;
 	sigc::connection          _periodic_connection;
+	sigc::connection          _meter_connection;
 
 	bool poll () const;
+	bool meter_poll () const;
 
 	void observe_transport ();
 	void observe_mixer ();
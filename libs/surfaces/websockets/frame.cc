@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "frame.h"
+
+using namespace ArdourSurface;
+
+/* order defines the binary node ids, append only */
+static const std::string* const node_table[] = {
+	&Node::strip_description,
+	&Node::strip_meter,
+	&Node::strip_gain,
+	&Node::strip_pan,
+	&Node::strip_mute,
+	&Node::strip_plugin_description,
+	&Node::strip_plugin_enable,
+	&Node::strip_plugin_param_description,
+	&Node::strip_plugin_param_value,
+	&Node::transport_tempo,
+	&Node::transport_time,
+	&Node::transport_roll,
+	&Node::transport_record,
+	&Node::client_protocol,
+};
+
+#define N_NODES (sizeof (node_table) / sizeof (node_table[0]))
+
+int
+BinaryFrame::node_id (const std::string& node)
+{
+	for (size_t i = 0; i < N_NODES; ++i) {
+		if (*node_table[i] == node) {
+			return static_cast<int> (i);
+		}
+	}
+	return -1;
+}
+
+std::string
+BinaryFrame::node_name (int id)
+{
+	if (id < 0 || id >= static_cast<int> (N_NODES)) {
+		return std::string ();
+	}
+	return *node_table[id];
+}
+
+BinaryFrame::BinaryFrame (Kind kind, size_t headroom)
+    : _headroom (headroom)
+    , _count (0)
+{
+	_buf.reserve (headroom + 4096);
+	_buf.resize (headroom);
+	put_u8 (kind);
+	put_u8 (version);
+	put_u16 (0);
+}
+
+void
+BinaryFrame::clear ()
+{
+	_buf.resize (_headroom + 4);
+	_count = 0;
+	update_count ();
+}
+
+bool
+BinaryFrame::add_state (const NodeState& state)
+{
+	int id = node_id (state.node ());
+
+	if (id < 0 || _count == UINT16_MAX) {
+		return false;
+	}
+
+	const int n_addr = std::min (state.n_addr (), 255);
+	const int n_val  = std::min (state.n_val (), 255);
+
+	put_u8 (id);
+	put_u8 (n_addr);
+
+	for (int i = 0; i < n_addr; ++i) {
+		put_u32 (state.nth_addr (i));
+	}
+
+	put_u8 (n_val);
+
+	for (int i = 0; i < n_val; ++i) {
+		TypedValue val = state.nth_val (i);
+
+		put_u8 (val.type ());
+
+		switch (val.type ()) {
+			case TypedValue::Empty:
+				break;
+			case TypedValue::Bool:
+				put_u8 (static_cast<bool> (val) ? 1 : 0);
+				break;
+			case TypedValue::Int:
+				put_u32 (static_cast<uint32_t> (static_cast<int> (val)));
+				break;
+			case TypedValue::Double:
+				put_f64 (static_cast<double> (val));
+				break;
+			case TypedValue::String: {
+				std::string s   = static_cast<std::string> (val);
+				size_t      len = std::min<size_t> (s.size (), UINT16_MAX);
+				put_u16 (len);
+				_buf.insert (_buf.end (), s.begin (), s.begin () + len);
+				break;
+			}
+		}
+	}
+
+	++_count;
+	update_count ();
+
+	return true;
+}
+
+void
+BinaryFrame::add_meter (uint32_t strip_id, float db)
+{
+	if (_count == UINT16_MAX) {
+		return;
+	}
+
+	put_u32 (strip_id);
+	put_f32 (db);
+
+	++_count;
+	update_count ();
+}
+
+void
+BinaryFrame::put_u8 (uint8_t v)
+{
+	_buf.push_back (v);
+}
+
+void
+BinaryFrame::put_u16 (uint16_t v)
+{
+	_buf.push_back (v & 0xff);
+	_buf.push_back ((v >> 8) & 0xff);
+}
+
+void
+BinaryFrame::put_u32 (uint32_t v)
+{
+	for (int i = 0; i < 4; ++i) {
+		_buf.push_back ((v >> (8 * i)) & 0xff);
+	}
+}
+
+void
+BinaryFrame::put_u64 (uint64_t v)
+{
+	for (int i = 0; i < 8; ++i) {
+		_buf.push_back ((v >> (8 * i)) & 0xff);
+	}
+}
+
+void
+BinaryFrame::put_f32 (float v)
+{
+	uint32_t u;
+	memcpy (&u, &v, sizeof (u));
+	put_u32 (u);
+}
+
+void
+BinaryFrame::put_f64 (double v)
+{
+	uint64_t u;
+	memcpy (&u, &v, sizeof (u));
+	put_u64 (u);
+}
+
+void
+BinaryFrame::update_count ()
+{
+	_buf[_headroom + 2] = _count & 0xff;
+	_buf[_headroom + 3] = (_count >> 8) & 0xff;
+}
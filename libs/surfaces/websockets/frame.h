@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _ardour_surface_websockets_frame_h_
+#define _ardour_surface_websockets_frame_h_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "state.h"
+
+namespace ArdourSurface {
+
+/* Binary framing for clients that negotiated it via Node::client_protocol.
+ * All integers are little-endian, doubles are IEEE 754 binary64.
+ *
+ *  frame      := kind:u8 version:u8 count:u16 payload
+ *
+ *  kind 'S'   (node states, count = number of states)
+ *   state     := node_id:u8 n_addr:u8 addr:u32[n_addr] n_val:u8 value[n_val]
+ *   value     := type:u8 (TypedValue::Type) data
+ *                Empty: -, Bool: u8, Int: i32, Double: f64, String: len:u16 utf8[len]
+ *
+ *  kind 'M'   (meter stream, count = number of strips)
+ *   meter     := strip_id:u32 level_db:f32
+ *
+ * Node ids are indices into the table returned by BinaryFrame::node_name ()
+ * and must be kept in sync with share/web_surfaces/shared/base/protocol.js
+ */
+class BinaryFrame
+{
+public:
+	enum Kind {
+		NodeStates = 'S',
+		Meters     = 'M'
+	};
+
+	static const uint8_t version = 1;
+
+	/** @param headroom bytes to reserve in front of the frame (LWS_PRE) */
+	BinaryFrame (Kind, size_t headroom = 0);
+
+	void clear ();
+
+	/* append a state, returns false if the node has no binary id */
+	bool add_state (const NodeState&);
+	void add_meter (uint32_t strip_id, float db);
+
+	uint16_t count () const
+	{
+		return _count;
+	}
+	bool empty () const
+	{
+		return _count == 0;
+	}
+
+	/* the complete frame, excluding headroom */
+	unsigned char* data ()
+	{
+		return &_buf[_headroom];
+	}
+	size_t size () const
+	{
+		return _buf.size () - _headroom;
+	}
+
+	static int         node_id (const std::string&);
+	static std::string node_name (int);
+
+private:
+	std::vector<unsigned char> _buf;
+	size_t                     _headroom;
+	uint16_t                   _count;
+
+	void put_u8 (uint8_t);
+	void put_u16 (uint16_t);
+	void put_u32 (uint32_t);
+	void put_u64 (uint64_t);
+	void put_f32 (float);
+	void put_f64 (double);
+	void update_count ();
+};
+
+} // namespace ArdourSurface
+
+#endif // _ardour_surface_websockets_frame_h_
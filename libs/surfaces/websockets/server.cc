@@ -20,6 +20,9 @@
 #include <iostream>
 #endif
 
+#include <algorithm>
+#include <boost/unordered_set.hpp>
+
 #include "dispatcher.h"
 #include "server.h"
 
@@ -184,6 +187,11 @@ WebsocketsServer::update_client (Client wsi, const NodeState& state, bool force)
 		return;
 	}
 
+	if (it->second.has_meter_stream () && state.node () == Node::strip_meter) {
+		/* meters are delivered by update_meter_clients () */
+		return;
+	}
+
 	if (force || !it->second.has_state (state)) {
 		/* write to client only if state was updated */
 		it->second.update_state (state);
@@ -200,6 +208,65 @@ WebsocketsServer::update_all_clients (const NodeState& state, bool force)
 	}
 }
 
+void
+WebsocketsServer::set_client_protocol (Client wsi, ClientContext::Protocol protocol, int meter_rate)
+{
+	ClientContextMap::iterator it = _client_ctx.find (wsi);
+	if (it == _client_ctx.end ()) {
+		return;
+	}
+
+	ClientContext& ctx = it->second;
+
+	ctx.set_protocol (protocol);
+
+	if (protocol != ClientContext::Binary || meter_rate <= 0) {
+		meter_rate = 0;
+		ctx.set_meter_interval (0);
+	} else {
+		meter_rate = std::min (meter_rate, METER_STREAM_MAX_RATE);
+		ctx.set_meter_interval (1000000 / meter_rate);
+	}
+
+	/* acknowledge, the reply is already encoded using the new protocol */
+	ValueVector val;
+	val.push_back (std::string (protocol == ClientContext::Binary ? "binary" : "json"));
+	val.push_back (meter_rate);
+
+	update_client (wsi, NodeState (Node::client_protocol, AddressVector (), val), true);
+}
+
+bool
+WebsocketsServer::has_meter_clients () const
+{
+	for (ClientContextMap::const_iterator it = _client_ctx.begin (); it != _client_ctx.end (); ++it) {
+		if (it->second.has_meter_stream ()) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void
+WebsocketsServer::update_meter_clients (BinaryFrame& frame)
+{
+	/* frame is expected to have LWS_PRE bytes of headroom */
+	int64_t now = g_get_monotonic_time ();
+
+	for (ClientContextMap::iterator it = _client_ctx.begin (); it != _client_ctx.end (); ++it) {
+		if (!it->second.meter_due (now)) {
+			continue;
+		}
+
+		std::vector<unsigned char>& buf = it->second.meter_buf ();
+		buf.resize (LWS_PRE + frame.size ());
+		memcpy (&buf[LWS_PRE], frame.data (), frame.size ());
+
+		lws_callback_on_writable (it->second.wsi ());
+	}
+}
+
 int
 WebsocketsServer::add_client (Client wsi)
 {
@@ -254,11 +321,35 @@ WebsocketsServer::write_client (Client wsi)
 	}
 
 	ClientOutputBuffer& pending = it->second.output_buf ();
+
+	/* one lws_write() call per LWS_CALLBACK_SERVER_WRITEABLE callback */
+
+	std::vector<unsigned char>& meter_buf = it->second.meter_buf ();
+
+	if (!meter_buf.empty ()) {
+		int len = meter_buf.size () - LWS_PRE;
+		int rc  = lws_write (wsi, &meter_buf[LWS_PRE], len, LWS_WRITE_BINARY);
+
+		meter_buf.clear ();
+
+		if (rc != len) {
+			return 1;
+		}
+
+		if (!pending.empty ()) {
+			lws_callback_on_writable (wsi);
+		}
+
+		return 0;
+	}
+
 	if (pending.empty ()) {
 		return 0;
 	}
 
-	/* one lws_write() call per LWS_CALLBACK_SERVER_WRITEABLE callback */
+	if (it->second.protocol () == ClientContext::Binary) {
+		return write_client_binary (it->second);
+	}
 
 	NodeStateMessage msg = pending.front ();
 	pending.pop_front ();
@@ -284,6 +375,52 @@ WebsocketsServer::write_client (Client wsi)
 	return 0;
 }
 
+int
+WebsocketsServer::write_client_binary (ClientContext& ctx)
+{
+	/* coalesce everything that is pending into a single frame,
+	 * only the most recent state of every node/address is sent
+	 */
+	ClientOutputBuffer& pending = ctx.output_buf ();
+
+	boost::unordered_set<std::size_t> seen;
+	std::vector<const NodeState*>     states;
+
+	for (ClientOutputBuffer::reverse_iterator it = pending.rbegin (); it != pending.rend (); ++it) {
+		if (seen.insert (it->state ().node_addr_hash ()).second) {
+			states.push_back (&it->state ());
+		}
+	}
+
+	BinaryFrame frame (BinaryFrame::NodeStates, LWS_PRE);
+
+	for (std::vector<const NodeState*>::reverse_iterator it = states.rbegin (); it != states.rend (); ++it) {
+		if (!frame.add_state (**it)) {
+#ifndef NDEBUG
+			std::cerr << "ArdourWebsockets: cannot encode " << (*it)->debug_str () << std::endl;
+#endif
+		}
+	}
+
+	pending.clear ();
+
+	if (frame.empty ()) {
+		return 0;
+	}
+
+#ifndef NDEBUG
+	std::cerr << "TX binary frame, " << frame.count () << " states, " << frame.size () << " bytes" << std::endl;
+#endif
+
+	int len = frame.size ();
+
+	if (lws_write (ctx.wsi (), frame.data (), len, LWS_WRITE_BINARY) != len) {
+		return 1;
+	}
+
+	return 0;
+}
+
 int
 WebsocketsServer::send_availsurf_hdr (Client wsi)
 {
@@ -32,6 +32,7 @@
 
 #include "client.h"
 #include "component.h"
+#include "frame.h"
 #include "message.h"
 #include "state.h"
 #include "resources.h"
@@ -39,6 +40,9 @@
 // TO DO: make this configurable
 #define WEBSOCKET_LISTEN_PORT 3818
 
+// upper limit for the rate binary clients can request for the meter stream
+#define METER_STREAM_MAX_RATE 50 // Hz
+
 // lws includes integration with the glib event loop starting from v4
 #ifndef LWS_WITH_GLIB
 struct LwsPollFdGlibSource {
@@ -63,6 +67,10 @@ public:
 	void update_client (Client, const NodeState&, bool);
 	void update_all_clients (const NodeState&, bool);
 
+	void set_client_protocol (Client, ClientContext::Protocol, int meter_rate);
+	bool has_meter_clients () const;
+	void update_meter_clients (BinaryFrame&);
+
 private:
 #if LWS_LIBRARY_VERSION_MAJOR < 3
 	struct lws_protocol_vhost_options _lws_vhost_opt;
@@ -82,6 +90,7 @@ private:
 	int del_client (Client);
 	int recv_client (Client, void*, size_t);
 	int write_client (Client);
+	int write_client_binary (ClientContext&);
 	int send_availsurf_hdr (Client);
 	int send_availsurf_body (Client);
 
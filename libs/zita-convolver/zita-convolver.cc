@@ -64,6 +64,7 @@ Convproc::Convproc (void)
 	, _maxpart (0)
 	, _nlevels (0)
 	, _latecnt (0)
+	, _sched (0)
 {
 	memset (_inpbuff, 0, MAXINP * sizeof (float*));
 	memset (_outbuff, 0, MAXOUT * sizeof (float*));
@@ -89,6 +90,15 @@ Convproc::set_skipcnt (uint32_t skipcnt)
 		_skipcnt = skipcnt;
 }
 
+int
+Convproc::set_scheduler (Convsched* sched)
+{
+	if ((_state != ST_IDLE) && (_state != ST_STOP))
+		return Converror::BAD_STATE;
+	_sched = sched;
+	return 0;
+}
+
 int
 Convproc::configure (uint32_t ninp,
                      uint32_t nout,
@@ -297,7 +307,7 @@ Convproc::start_process (int abspri, int policy)
 	reset ();
 
 	for (k = (_minpart == _quantum) ? 1 : 0; k < _nlevels; k++) {
-		_convlev[k]->start (abspri, policy);
+		_convlev[k]->start (abspri, policy, _sched);
 	}
 	_state = ST_PROC;
 	return 0;
@@ -423,6 +433,7 @@ Convlevel::Convlevel (void)
 #ifndef PTW32_VERSION
 	, _pthr (0)
 #endif
+	, _sched (0)
 	, _inp_list (0)
 	, _out_list (0)
 	, _plan_r2c (0)
@@ -598,7 +609,7 @@ Convlevel::reset (uint32_t inpsize,
 }
 
 void
-Convlevel::start (int abspri, int policy)
+Convlevel::start (int abspri, int policy, Convsched* sched)
 {
 	int                min, max;
 	pthread_attr_t     attr;
@@ -607,6 +618,11 @@ Convlevel::start (int abspri, int policy)
 #ifndef PTW32_VERSION
 	_pthr = 0;
 #endif
+	_sched = sched;
+	if (_sched) {
+		_stat = ST_PROC;
+		return;
+	}
 	min   = sched_get_priority_min (policy);
 	max   = sched_get_priority_max (policy);
 	abspri += _prio;
@@ -630,8 +646,17 @@ void
 Convlevel::stop (void)
 {
 	if (_stat != ST_IDLE) {
-		_stat = ST_TERM;
-		_trig.post ();
+		if (_sched) {
+			// No thread to terminate, wait for queued cycles.
+			while (_wait) {
+				_done.wait ();
+				_wait--;
+			}
+			_stat = ST_IDLE;
+		} else {
+			_stat = ST_TERM;
+			_trig.post ();
+		}
 	}
 }
 
@@ -704,6 +729,19 @@ Convlevel::main (void)
 	}
 }
 
+void
+Convlevel::run_sched (void)
+{
+	process (false);
+	_done.post ();
+}
+
+void
+Convsched::run (Convlevel* lev)
+{
+	lev->run_sched ();
+}
+
 void
 Convlevel::process (bool skip)
 {
@@ -825,7 +863,10 @@ Convlevel::readout (bool sync, uint32_t skipcnt)
 			}
 			if (++_opind == 3)
 				_opind = 0;
-			_trig.post ();
+			if (!_sched)
+				_trig.post ();
+			else if (!_sched->schedule (this, _prio))
+				run_sched ();
 			_wait++;
 		} else {
 			process (skipcnt >= 2 * _parsize);
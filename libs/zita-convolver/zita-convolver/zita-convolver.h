@@ -207,6 +207,26 @@ private:
 	uint16_t _out;
 };
 
+class Convlevel;
+
+// Interface to run the partitions of a Convproc on an external
+// thread-pool, instead of using one thread per partition size.
+//
+class LIBZCONVOLVER_API Convsched
+{
+public:
+	virtual ~Convsched (void) {}
+
+	// Queue a cycle of 'lev' to be performed by calling run (lev).
+	// This is called from the process thread. 'prio' is the relative
+	// priority of the level (0: most urgent, negative: less urgent).
+	// If false is returned, the cycle is performed by the caller.
+	virtual bool schedule (Convlevel* lev, int prio) = 0;
+
+protected:
+	static void run (Convlevel* lev);
+};
+
 class LIBZCONVOLVER_API Converror
 {
 public:
@@ -226,6 +246,7 @@ class LIBZCONVOLVER_API Convlevel
 {
 private:
 	friend class Convproc;
+	friend class Convsched;
 
 	enum {
 		OPT_FFTW_MEASURE = 1,
@@ -269,10 +290,12 @@ private:
 	            float**  inpbuff,
 	            float**  outbuff);
 
-	void start (int absprio, int policy);
+	void start (int absprio, int policy, Convsched* sched);
 
 	void process (bool sync);
 
+	void run_sched (void);
+
 	int readout (bool sync, uint32_t skipcnt);
 
 	void stop (void);
@@ -304,6 +327,7 @@ private:
 	int               _bits;      // bit identifiying this level
 	int               _wait;      // number of unfinished cycles
 	pthread_t         _pthr;      // posix thread executing this level
+	Convsched*        _sched;     // external scheduler, if any
 	ZCsema            _trig;      // sema used to trigger a cycle
 	ZCsema            _done;      // sema used to wait for a cycle
 	Inpnode*          _inp_list;  // linked list of active inputs
@@ -412,6 +436,8 @@ public:
 
 	void set_skipcnt (uint32_t skipcnt);
 
+	int set_scheduler (Convsched* sched);
+
 	int reset (void);
 
 	int start_process (int abspri, int policy);
@@ -443,6 +469,7 @@ private:
 	uint32_t   _inpsize;         // size of input buffers
 	uint32_t   _latecnt;         // count of cycles ending too late
 	Convlevel* _convlev[MAXLEV]; // array of processors
+	Convsched* _sched;           // external scheduler, if any
 	void*      _dummy[64];
 
 	static float _mac_cost;
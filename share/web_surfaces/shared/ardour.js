@@ -17,7 +17,7 @@
  */
 
 import { Component } from './base/component.js';
-import { StateNode } from './base/protocol.js';
+import { Message, StateNode } from './base/protocol.js';
 import MessageChannel from './base/channel.js';
 import Mixer from './components/mixer.js';
 import Transport from './components/transport.js';
@@ -39,6 +39,12 @@ export default class ArdourClient extends Component {
 			this._components = [];
 		}
 
+		// Binary framing coalesces all updates of a poll cycle into a single
+		// frame and enables a separate meter stream. Servers that do not know
+		// about it ignore the request and keep sending JSON.
+		this._binary = getOption(options, 'binary', true);
+		this._meterRate = getOption(options, 'meterRate', 30);  // Hz, binary only
+
 		this._autoReconnect = getOption(options, 'autoReconnect', true);
 		this._connected = false;
 
@@ -125,6 +131,11 @@ export default class ArdourClient extends Component {
 
 	async _connect () {
 		await this.channel.open();
+
+		if (this._binary) {
+			this.channel.send(new Message(StateNode.CLIENT_PROTOCOL, [], ['binary', this._meterRate]));
+		}
+
 		this._setConnected(true);
 	}
 
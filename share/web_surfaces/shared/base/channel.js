@@ -34,14 +34,16 @@ export default class MessageChannel {
 
 			this._socket.onerror = (error) => this.onError(error);
 
-			this._socket.onmessage = (event) => {
-				const msg = Message.fromJsonText(event.data);
+			// binary frames are only sent after negotiation, see ArdourClient
+			this._socket.binaryType = 'arraybuffer';
 
-				if (this._pending && (this._pending.nodeAddrId == msg.nodeAddrId)) {
-					this._pending.resolve(msg);
-					this._pending = null;
+			this._socket.onmessage = (event) => {
+				if (event.data instanceof ArrayBuffer) {
+					for (const msg of Message.fromBinaryFrame(event.data)) {
+						this._receive(msg);
+					}
 				} else {
-					this.onMessage(msg, true);
+					this._receive(Message.fromJsonText(event.data));
 				}
 			};
 
@@ -74,6 +76,15 @@ export default class MessageChannel {
 		});
 	}
 
+	_receive (msg) {
+		if (this._pending && (this._pending.nodeAddrId == msg.nodeAddrId)) {
+			this._pending.resolve(msg);
+			this._pending = null;
+		} else {
+			this.onMessage(msg, true);
+		}
+	}
+
 	onClose () {}
 	onError (error) {}
 	onMessage (msg, inbound) {}
@@ -31,7 +31,39 @@ export const StateNode = Object.freeze({
 	TRANSPORT_TEMPO                : 'transport_tempo',
 	TRANSPORT_TIME                 : 'transport_time',
 	TRANSPORT_ROLL                 : 'transport_roll',
-	TRANSPORT_RECORD               : 'transport_record'
+	TRANSPORT_RECORD               : 'transport_record',
+	CLIENT_PROTOCOL                : 'client_protocol'
+});
+
+// Binary node ids, keep in sync with libs/surfaces/websockets/frame.cc
+const BinaryNodeTable = [
+	StateNode.STRIP_DESCRIPTION,
+	StateNode.STRIP_METER,
+	StateNode.STRIP_GAIN,
+	StateNode.STRIP_PAN,
+	StateNode.STRIP_MUTE,
+	StateNode.STRIP_PLUGIN_DESCRIPTION,
+	StateNode.STRIP_PLUGIN_ENABLE,
+	StateNode.STRIP_PLUGIN_PARAM_DESCRIPTION,
+	StateNode.STRIP_PLUGIN_PARAM_VALUE,
+	StateNode.TRANSPORT_TEMPO,
+	StateNode.TRANSPORT_TIME,
+	StateNode.TRANSPORT_ROLL,
+	StateNode.TRANSPORT_RECORD,
+	StateNode.CLIENT_PROTOCOL
+];
+
+const BinaryFrameKind = Object.freeze({
+	NODE_STATES : 0x53, // 'S'
+	METERS      : 0x4d  // 'M'
+});
+
+const BinaryValueType = Object.freeze({
+	EMPTY  : 0,
+	BOOL   : 1,
+	INT    : 2,
+	DOUBLE : 3,
+	STRING : 4
 });
 
 export class Message {
@@ -61,6 +93,77 @@ export class Message {
 		return new Message(rawMsg.node, rawMsg.addr || [], rawMsg.val);
 	}
 
+	// Decodes a binary frame (see libs/surfaces/websockets/frame.h),
+	// a single frame carries any number of messages
+	static fromBinaryFrame (buffer) {
+		const view = new DataView(buffer);
+		const kind = view.getUint8(0);
+		const count = view.getUint16(2, true);
+		const messages = [];
+		let offset = 4;
+
+		if (kind == BinaryFrameKind.METERS) {
+			for (let i = 0; i < count; i++) {
+				const stripId = view.getUint32(offset, true);
+				const db = view.getFloat32(offset + 4, true);
+				offset += 8;
+				messages.push(new Message(StateNode.STRIP_METER, [stripId], [db]));
+			}
+			return messages;
+		}
+
+		if (kind != BinaryFrameKind.NODE_STATES) {
+			throw new Error(`Unknown binary frame kind ${kind}`);
+		}
+
+		const decoder = new TextDecoder('utf-8');
+
+		for (let i = 0; i < count; i++) {
+			const node = BinaryNodeTable[view.getUint8(offset++)];
+			const addr = [];
+			const val = [];
+
+			const nAddr = view.getUint8(offset++);
+
+			for (let j = 0; j < nAddr; j++) {
+				addr.push(view.getUint32(offset, true));
+				offset += 4;
+			}
+
+			const nVal = view.getUint8(offset++);
+
+			for (let j = 0; j < nVal; j++) {
+				switch (view.getUint8(offset++)) {
+					case BinaryValueType.EMPTY:
+						val.push(null);
+						break;
+					case BinaryValueType.BOOL:
+						val.push(view.getUint8(offset++) != 0);
+						break;
+					case BinaryValueType.INT:
+						val.push(view.getInt32(offset, true));
+						offset += 4;
+						break;
+					case BinaryValueType.DOUBLE:
+						val.push(view.getFloat64(offset, true));
+						offset += 8;
+						break;
+					case BinaryValueType.STRING: {
+						const len = view.getUint16(offset, true);
+						offset += 2;
+						val.push(decoder.decode(new Uint8Array(buffer, offset, len)));
+						offset += len;
+						break;
+					}
+				}
+			}
+
+			messages.push(new Message(node, addr, val));
+		}
+
+		return messages;
+	}
+
 	toJsonText () {
 		let val = [];
 